@@ -0,0 +1,148 @@
+/**
+  ******************************************************************************
+  * @file    adc_console.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Non-blocking console output (printf retarget) with compile-time log levels
+
+  * @brief   This file contains typedefs, macros and prototypes of console, which queues text to lock-free ring drained by
+  * 		 UART transmission DMA. _write (syscalls.c) writes to ADC_Console, so printf never waits for UART. Writers reserve
+  * 		 space with exclusive access (LDREX/STREX) and copy without masking interrupts, so console can be written from
+  * 		 thread and any interrupt priority. Text, which does not fit ring, is dropped as a whole and counted.
+  *
+  * 		 Log macros (ADC_CONSOLE_ERROR, _WARNING, _INFO, _DEBUG) are compiled only if their level is not above
+  * 		 ADC_CONSOLE_LEVEL, filtered calls do not evaluate arguments and cost nothing at runtime.
+  * 		 Example: ADC_CONSOLE_DEBUG("block %u\r\n", offset); -> "D block 0" if ADC_CONSOLE_LEVEL >= ADC_CONSOLE_LEVEL_DEBUG
+  ******************************************************************************
+  * @attention printf uses shared stdout stream of newlib, it should be called from thread only. Interrupts should use log
+  * 		   macros or ADC_ConsolePrintf, which format to stack. %f of newlib allocates heap, it should not be used in
+  * 		   interrupts. User has to call ADC_ConsoleTxCplt and ADC_ConsoleError from HAL_UART_TxCpltCallback and
+  * 		   HAL_UART_ErrorCallback, and serve USART and TX DMA channel interrupts.
+  * 		   NOTE: NOTHING IS SENT UNTIL ADC_ConsoleInit. Text written before init (printf, log macros) is only queued, and
+  * 		   text not fitting the ring is dropped, counted in Dropped and never sent. Console should be initialized right
+  * 		   after UART (main.c, USER CODE 2) and its DMA interrupt enabled before first printf.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_CONSOLE_H_
+#define INC_ADC_CONSOLE_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#ifndef 			ADC_CONSOLE_SIZE
+#define 			ADC_CONSOLE_SIZE			1024U			// ring [bytes] | power of 2, holds output of burst at 115200 baud
+#endif
+
+#ifndef 			ADC_CONSOLE_LINE_SIZE
+#define 			ADC_CONSOLE_LINE_SIZE		96U				// longest text of ADC_ConsolePrintf | formatted on stack of caller
+#endif
+
+#if (ADC_CONSOLE_SIZE & (ADC_CONSOLE_SIZE - 1)) != 0
+	#error "ADC_CONSOLE_SIZE has to be power of 2"
+#endif
+
+// Log levels
+#define 			ADC_CONSOLE_LEVEL_NONE		0
+#define 			ADC_CONSOLE_LEVEL_ERROR		1
+#define 			ADC_CONSOLE_LEVEL_WARNING	2
+#define 			ADC_CONSOLE_LEVEL_INFO		3
+#define 			ADC_CONSOLE_LEVEL_DEBUG		4
+
+#ifndef 			ADC_CONSOLE_LEVEL
+#define 			ADC_CONSOLE_LEVEL			ADC_CONSOLE_LEVEL_INFO		// highest compiled level | e.g. -DADC_CONSOLE_LEVEL=4 for debug build
+#endif
+
+#if ADC_CONSOLE_LEVEL >= ADC_CONSOLE_LEVEL_ERROR
+	#define 		ADC_CONSOLE_ERROR(...)		ADC_ConsolePrintf(&ADC_Console, "E " __VA_ARGS__)
+#else
+	#define 		ADC_CONSOLE_ERROR(...)		((void)0)
+#endif
+
+#if ADC_CONSOLE_LEVEL >= ADC_CONSOLE_LEVEL_WARNING
+	#define 		ADC_CONSOLE_WARNING(...)	ADC_ConsolePrintf(&ADC_Console, "W " __VA_ARGS__)
+#else
+	#define 		ADC_CONSOLE_WARNING(...)	((void)0)
+#endif
+
+#if ADC_CONSOLE_LEVEL >= ADC_CONSOLE_LEVEL_INFO
+	#define 		ADC_CONSOLE_INFO(...)		ADC_ConsolePrintf(&ADC_Console, "I " __VA_ARGS__)
+#else
+	#define 		ADC_CONSOLE_INFO(...)		((void)0)
+#endif
+
+#if ADC_CONSOLE_LEVEL >= ADC_CONSOLE_LEVEL_DEBUG
+	#define 		ADC_CONSOLE_DEBUG(...)		ADC_ConsolePrintf(&ADC_Console, "D " __VA_ARGS__)
+#else
+	#define 		ADC_CONSOLE_DEBUG(...)		((void)0)
+#endif
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Console typedef | indexes are free-running and masked on access
+  * 		Writers: Reserved (claimed space), Committed (space readable by DMA), published by last nested writer
+  * 		DMA:     Tail (sent bytes), Sending (bytes of transfer in progress), owned by context holding Busy
+  */
+typedef struct{
+
+	UART_HandleTypeDef* huart;					// UART with linked transmission DMA channel | NULL: text is queued until init
+
+	uint8_t             Ring[ADC_CONSOLE_SIZE];
+
+	volatile uint32_t   Reserved;
+
+	volatile uint32_t   Committed;
+
+	volatile uint32_t   Writers;				// writers copying to ring (nested by interrupts)
+
+	volatile uint32_t   Tail;
+
+	volatile uint32_t   Sending;
+
+	volatile uint32_t   Busy;					// 1: DMA transfer is started or in progress
+
+	volatile uint32_t   Written;				// number of queued bytes
+
+	volatile uint32_t   Dropped;				// number of bytes, which did not fit ring
+
+	volatile uint32_t   Peak;					// highest number of queued bytes | sizing of ADC_CONSOLE_SIZE
+
+}ADC_ConsoleTypeDef;
+
+
+/* Variables -------------------------------------------------------------------------- */
+extern ADC_ConsoleTypeDef ADC_Console;			// console of stdout (_write) and log macros | usable before ADC_ConsoleInit
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_ConsoleInit(ADC_ConsoleTypeDef* con, UART_HandleTypeDef* huart, DMA_HandleTypeDef* hdmaTx);
+
+uint32_t                   ADC_ConsoleWrite(ADC_ConsoleTypeDef* con, const char* data, uint32_t length);
+
+uint32_t                   ADC_ConsoleSpace(const ADC_ConsoleTypeDef* con);
+
+uint32_t                   ADC_ConsolePrintf(ADC_ConsoleTypeDef* con, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+void                       ADC_ConsoleTxCplt(ADC_ConsoleTypeDef* con, UART_HandleTypeDef* huart);
+
+void                       ADC_ConsoleError(ADC_ConsoleTypeDef* con, UART_HandleTypeDef* huart);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_CONSOLE_H_ */
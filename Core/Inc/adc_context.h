@@ -0,0 +1,216 @@
+/**
+  ******************************************************************************
+  * @file    adc_context.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Inline hot path for ADC driver
+
+  * @brief   This file contains published driver context and static inline accessors of latest, averaged and scaled values.
+  * 		 Context is validated once (ADC_ContextInit), so accessors do not search ranks, check parameters or cross into
+  * 		 adc_driver.c. Out-of-line versions (ADC_Context* functions) and ADC_ReadChannel/ADC_GetValue stay available.
+  ******************************************************************************
+  * @attention Context has to be re-initialized after change of ranks or DMA storage, change of resolution requires ADC_ContextRescale
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_CONTEXT_H_
+#define INC_ADC_CONTEXT_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#define 			ADC_CONTEXT_CHANNELS		32			// size of channel to rank lookup | covers 5-bit channel field of SQRx registers
+#define 			ADC_CONTEXT_NO_RANK			0xFFU		// lookup value of channel, which is not converted
+
+#ifndef 			ADC_CONTEXT_POOL_SIZE
+#define 			ADC_CONTEXT_POOL_SIZE		2U			// contexts of ADC_ContextCreate (static pool, adc_pool.h) | 0: no pool
+#endif
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Published driver context | read by inline accessors
+  */
+typedef struct{
+
+	const ADC_BufferTypeDef* badc;						// buffer of ADC | DMA storage, averaging depth and polled values
+
+	uint8_t  RankOfChannel[ADC_CONTEXT_CHANNELS];		// channel to rank lookup | ADC_CONTEXT_NO_RANK if channel is not converted
+
+	uint8_t  Channels;									// number of converted channels (ranks)
+
+	uint8_t  Slave;										// 1 if ADC is Slave in dual mode (upper half-words of dual mode storage)
+
+	uint8_t  Oversampled;								// 1 if averaging is done by hardware oversampler (latest sample holds sum of averaged measures)
+
+	uint8_t  Packed;									// 1 if DMA storage is packed to bytes (BufferPacked)
+
+	uint16_t Scans;										// number of whole scans in DMA storage
+
+	uint8_t  Q15Shift;									// left shift aligning averaged value to MSB | 0 for left-aligned data
+
+	float    Scale;										// max / ADC resolution | multiplies averaged value
+
+}ADC_ContextTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_ContextInit(ADC_ContextTypeDef* ctx, ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, float max);
+
+uint16_t                   ADC_ContextLatest(const ADC_ContextTypeDef* ctx, uint8_t channel);
+
+uint16_t                   ADC_ContextAveraged(const ADC_ContextTypeDef* ctx, uint8_t channel);
+
+float                      ADC_ContextScaled(const ADC_ContextTypeDef* ctx, uint8_t channel);
+
+int16_t                    ADC_ContextQ15(const ADC_ContextTypeDef* ctx, uint8_t channel);
+
+HAL_StatusTypeDef          ADC_ContextRescale(ADC_ContextTypeDef* ctx, ADC_HandleTypeDef* hadc, float max);
+
+#if ADC_CONTEXT_POOL_SIZE > 0
+ADC_ContextTypeDef*        ADC_ContextCreate(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, float max);
+
+HAL_StatusTypeDef          ADC_ContextDestroy(ADC_ContextTypeDef* ctx);
+#endif
+
+
+/* Inline accessors ------------------------------------------------------------------------  */
+/**
+  * @brief  Returns sample of channel at given scan of DMA storage | independent (half-word or packed) or dual mode storage
+  */
+static inline uint16_t ADC_InlineSample(const ADC_ContextTypeDef* ctx, uint32_t id){
+
+	if(ctx->badc->BufferMultiMode == NULL){
+		return (ctx->Packed == 0) ? ctx->badc->BufferADC[id] : ctx->badc->BufferPacked[id];
+	}
+
+	return (ctx->Slave == 0) ? __ADC_DUAL_MASTER_DATA(ctx->badc->BufferMultiMode[id]) : __ADC_DUAL_SLAVE_DATA(ctx->badc->BufferMultiMode[id]);
+}
+
+/**
+  * @brief  Returns scan being converted right now | 0 if ADC works without DMA or storage is not deeper than averaging depth
+  */
+static inline uint16_t ADC_InlineCurrentScan(const ADC_ContextTypeDef* ctx){
+
+	if(ctx->badc->hdma == NULL){
+		return 0;
+	}
+
+	uint32_t written = ctx->badc->BufferLength - __HAL_DMA_GET_COUNTER(ctx->badc->hdma);	// transfers written in current DMA block
+
+	return (uint16_t)(written / ctx->Channels);
+}
+
+/**
+  * @brief  Latest converted value of channel | latest completed scan of DMA storage or latest polled value
+  * @param  ctx     - pointer to context initialized by ADC_ContextInit
+  * @param  channel - number of converted channel
+  * @retval value   - converted value | 0 if channel is not converted
+  */
+static inline uint16_t ADC_InlineLatest(const ADC_ContextTypeDef* ctx, uint8_t channel){
+
+	uint8_t rank = ctx->RankOfChannel[channel & (ADC_CONTEXT_CHANNELS - 1U)];
+
+	if(rank == ADC_CONTEXT_NO_RANK){
+		return 0;
+	}
+
+	if(ctx->badc->hdma == NULL){
+		return ctx->badc->ADC_Buff[rank];
+	}
+
+	uint16_t scan = ADC_InlineCurrentScan(ctx);
+
+	scan = (scan == 0) ? (ctx->Scans - 1U) : (scan - 1U);	// scan before the one being converted
+
+	return ADC_InlineSample(ctx, (uint32_t)scan * ctx->Channels + rank);
+}
+
+/**
+  * @brief  Averaged value of channel | same result as ADC_Averaging
+  * @param  ctx     - pointer to context initialized by ADC_ContextInit
+  * @param  channel - number of converted channel
+  * @retval value   - averaged value | 0 if channel is not converted
+  */
+static inline uint16_t ADC_InlineAveraged(const ADC_ContextTypeDef* ctx, uint8_t channel){
+
+	uint8_t rank     = ctx->RankOfChannel[channel & (ADC_CONTEXT_CHANNELS - 1U)];
+	uint8_t measures = ctx->badc->AveragedMeasures;
+
+	if(rank == ADC_CONTEXT_NO_RANK || measures == 0){
+		return 0;
+	}
+
+	// ADC without DMA storage | latest polled value
+	if(ctx->badc->BufferADC == NULL && ctx->badc->BufferMultiMode == NULL){
+		return ctx->badc->ADC_Buff[rank];
+	}
+
+	// averaging done by hardware oversampler | sum of averaged measures is divided like in software
+	if(ctx->Oversampled != 0){
+		return (uint16_t)(ADC_InlineLatest(ctx, channel) / measures);
+	}
+
+	uint16_t first = 0;	// first averaged scan
+
+	// storage deeper than averaging depth | averaging latest completed scans
+	if(ctx->badc->hdma != NULL && ctx->Scans > measures){
+		first = (uint16_t)((ADC_InlineCurrentScan(ctx) + ctx->Scans - measures) % ctx->Scans);
+	}
+
+	uint32_t id  = (uint32_t)first * ctx->Channels + rank;
+	uint32_t sum = 0;
+
+	for(uint8_t i = 0; i < measures; ++i){
+		sum += ADC_InlineSample(ctx, id);
+
+		// moving to next scan | wrapping without modulo
+		id += ctx->Channels;
+		if(id >= ctx->badc->BufferLength){
+			id -= ctx->badc->BufferLength;
+		}
+	}
+
+	return (uint16_t)(sum / measures);
+}
+
+/**
+  * @brief  Scaled averaged value of channel | result of ADC_GetValue (up to float rounding), divide replaced with multiply by precomputed scale
+  * @param  ctx     - pointer to context initialized by ADC_ContextInit
+  * @param  channel - number of converted channel
+  * @retval value   - scaled value
+  */
+static inline float ADC_InlineScaled(const ADC_ContextTypeDef* ctx, uint8_t channel){
+
+	return (float)ADC_InlineAveraged(ctx, channel) * ctx->Scale;
+}
+
+/**
+  * @brief  Averaged value of channel as Q15 fraction | mid-scale is 0, full scale is aligned to MSB by precomputed shift
+  * @param  ctx     - pointer to context initialized by ADC_ContextInit
+  * @param  channel - number of converted channel
+  * @retval value   - Q15 value | left-aligned data is consumed without shifting or dividing
+  */
+static inline int16_t ADC_InlineQ15(const ADC_ContextTypeDef* ctx, uint8_t channel){
+
+	return __ADC_Q15((uint32_t)ADC_InlineAveraged(ctx, channel) << ctx->Q15Shift);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_CONTEXT_H_ */
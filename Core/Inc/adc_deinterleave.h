@@ -0,0 +1,77 @@
+/**
+  ******************************************************************************
+  * @file    adc_deinterleave.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Dual mode de-interleaving for ADC driver
+
+  * @brief   This file contains typedefs and prototypes of optional stage, which splits completed parts of dual mode DMA storage
+  * 		 into contiguous Master (ADC1) and Slave (ADC2) buffers. On F1 family Master's half-words are extracted by spare
+  * 		 DMA1 channel in memory-to-memory mode (word to half-word transfer keeps lower half-word), so CPU extracts only Slave.
+  ******************************************************************************
+  * @attention ADC_DeinterleaveStart runs in DMA interrupt of Master (ADC_BlockCpltCallback), Slave's CPU loop included. It costs
+  * 		   about 6 cycles per transfer (~12 us for 128 transfers at 64 MHz, estimate). If interrupt time matters, pass
+  * 		   NULL Slave's buffer and read Slave's half-words from thread (__ADC_DUAL_SLAVE_DATA). DMA offload pays off above
+  * 		   ~25 transfers per block, shorter blocks are cheaper without spare channel (see ReadME, CPU Cost Estimates).
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_DEINTERLEAVE_H_
+#define INC_ADC_DEINTERLEAVE_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+// starts transfer of spare DMA channel | replaced by simulation in host build, where addresses do not fit 32 bits
+#if !defined(__ADC_DMA_START_COPY)
+#define 			__ADC_DMA_START_COPY(__DMA__, __SRC__, __DST__, __LENGTH__)															\
+						HAL_DMA_Start_IT((__DMA__), (uint32_t)(__SRC__), (uint32_t)(__DST__), (__LENGTH__))
+#endif
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Dual mode de-interleaving typedef | Master and Slave buffers have the same length as dual mode DMA storage
+  */
+typedef struct{
+
+	DMA_HandleTypeDef* hdma;					// spare DMA channel in memory-to-memory mode | NULL: Master is extracted by CPU
+
+	uint16_t*          BufferMaster;			// contiguous Master's (ADC1) conversions
+
+	uint16_t*          BufferSlave;				// contiguous Slave's (ADC2) conversions | NULL if Slave is not needed
+
+	uint16_t           BufferLength;			// number of half-words in each buffer
+
+	volatile uint8_t   Ready;					// set when Master's part of latest block is transferred
+
+	volatile uint32_t  Blocks;					// number of de-interleaved blocks
+
+	volatile uint32_t  Fallbacks;				// number of blocks extracted by CPU, because DMA channel was still busy
+
+}ADC_DeinterleaveTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_DeinterleaveInit(ADC_DeinterleaveTypeDef* dint, DMA_HandleTypeDef* hdma, uint16_t* master, uint16_t* slave, uint16_t length);
+
+HAL_StatusTypeDef          ADC_DeinterleaveStart(ADC_DeinterleaveTypeDef* dint, const ADC_BufferTypeDef* badc, uint16_t offset, uint16_t transfers);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_DEINTERLEAVE_H_ */
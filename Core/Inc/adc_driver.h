@@ -29,6 +29,10 @@ extern "C" {
 #include "main.h"
 #include "stm32_family.h"
 
+#if defined(ADC_SIM)
+	#include "adc_sim.h"				// host simulation | peripherals remapped to simulated registers, virtual time
+#endif
+
 
 /* Universal Macros (Object Type)------------------------------------------------------ */
 #define 			SQR_1				    1
@@ -37,40 +41,182 @@ extern "C" {
 #define				SQR_4					4
 
 #define 			ADC_MAX_CHANNELS       16											// maximum number of ADC's channels
-#define 			ADC_AVERAGED_MEASURES  5											// common number of measures from one channel to be averaged
-#define 			ADC_BUFF_SIZE 		   (ADC_AVERAGED_MEASURES * ADC_MAX_CHANNELS)	// ADC Buffers' Size, includes size of all channels and their number of averaged measures
+#define 			ADC_AVERAGED_MEASURES  5											// default number of measures from one channel to be averaged
+#define 			ADC_MAX_INSTANCES      3											// maximum number of ADC instances registered by driver (ADC1, ADC2, ADC3)
 
-/* Variables--------------------------------------------------------------------------- */
-static volatile int ADC_CONVERTED_CHANNELS =  4;	// default value of converted which will be overwrite by program in runtime after auto-detect process
+#ifndef 			ADC_CALIBRATION_RETRIES
+#define 			ADC_CALIBRATION_RETRIES 3											// number of calibration attempts before init fails
+#endif
 
+/* Memory placement Macros ------------------------------------------------------------- */
+#ifndef 			ADC_PLACEMENT
+#define 			ADC_PLACEMENT			1											// 1: storage of DEFINE macros is placed in dedicated sections of linker script | 0: default .bss
+#endif
 
+#ifndef 			ADC_HISTORY_NOINIT
+#define 			ADC_HISTORY_NOINIT		0											// 1: storage of ADC_HISTORY_DEFINE is not zeroed by startup (.noinit) | used where CCM is not present
+#endif
+
+#if (ADC_PLACEMENT == 1) && !defined(ADC_SIM)
+	#define 		__ADC_DMA_DATA			__attribute__((section(".bss.adc_dma"), aligned(4)))							// read or written by DMA | grouped at start of .bss, zeroed, never in CCM
+	#define 		__ADC_NOINIT			__attribute__((section(".noinit")))												// not zeroed by startup | contents are undefined after power-up
+	#if defined(STM32_MEM_CCM)
+		#define 	__ADC_CPU_DATA			__attribute__((section(".ccmram")))												// accessed by CPU only | CCM SRAM, no arbitration with DMA, not initialized by startup
+	#elif (ADC_HISTORY_NOINIT == 1)
+		#define 	__ADC_CPU_DATA			__ADC_NOINIT
+	#else
+		#define 	__ADC_CPU_DATA
+	#endif
+#else
+	#define 		__ADC_DMA_DATA			__attribute__((aligned(4)))
+	#define 		__ADC_NOINIT
+	#define 		__ADC_CPU_DATA
+#endif
+
+/* Buffer sizing Macros ---------------------------------------------------------------- */
+#define 			ADC_BUFFER_LENGTH(__CHANNELS__, __MEASURES__)   ((__CHANNELS__) * (__MEASURES__))	// number of DMA transfers needed by given number of channels and averaged measures
+
+/**
+  * @brief  Statically allocates DMA storage for ADC in independent mode, sized exactly to channels and averaged measures
+  * 		Single scan is allocated when averaging is offloaded to hardware oversampler (ADC_AVERAGING_SCANS)
+  * 		Example: ADC_BUFFER_DEFINE(badc1, 4, ADC_AVERAGED_MEASURES); -> 4 * 5 half-words = 40 bytes of DMA storage
+  */
+#define 			ADC_BUFFER_DEFINE(__NAME__, __CHANNELS__, __MEASURES__)																	\
+						ADC_BUFFER_DEFINE_EX(__NAME__, (__CHANNELS__), (__MEASURES__), ADC_AVERAGING_SCANS(__MEASURES__))
 
-/* Typedefs --------------------------------------------------------------------------- */
 /**
-  * @brief  DMA buffer typedef for ADCs in dual mode
+  * @brief  Statically allocates DMA storage for ADC in independent mode with DMA block deeper than averaging depth
+  * 		DMA interrupts (half and full transfer) occur once per (__SCANS__ / 2) scans of all channels
+  * 		Example: ADC_BUFFER_DEFINE_EX(badc1, 4, 8, 64); -> 4 * 64 half-words, averaging of 8 latest measures
   */
-typedef union{
-		uint32_t BufferMultiMode [ADC_BUFF_SIZE];
-		uint16_t BufferADC_Master[ADC_BUFF_SIZE];
-		uint16_t BufferADC_Slave [ADC_BUFF_SIZE];
+#define 			ADC_BUFFER_DEFINE_EX(__NAME__, __CHANNELS__, __MEASURES__, __SCANS__)														\
+						static uint16_t __NAME__##_Storage[ADC_BUFFER_LENGTH((__CHANNELS__), (__SCANS__))] __ADC_DMA_DATA;						\
+						ADC_BufferTypeDef __NAME__ = {																					\
+							.BufferADC        = __NAME__##_Storage,																		\
+							.BufferMultiMode  = NULL,																					\
+							.BufferLength     = ADC_BUFFER_LENGTH((__CHANNELS__), (__SCANS__)),											\
+							.AveragedMeasures = (__MEASURES__)																			\
+						}
 
-}DMA_DualmodeBufferTypeDef;
+/**
+  * @brief  Statically allocates DMA storage for ADCs in dual mode, sized exactly to channels and averaged measures
+  * 		Buffer is shared by Master and Slave, each word stores one conversion of both ADCs
+  */
+#define 			ADC_BUFFER_DEFINE_MULTIMODE(__NAME__, __CHANNELS__, __MEASURES__)															\
+						ADC_BUFFER_DEFINE_MULTIMODE_EX(__NAME__, (__CHANNELS__), (__MEASURES__), (__MEASURES__))
 
 /**
-  * @brief  DMA buffer typedef for ADCs in independent mode
+  * @brief  Statically allocates DMA storage for ADCs in dual mode with DMA block deeper than averaging depth
   */
-typedef union{
-	uint16_t BufferADC[ADC_BUFF_SIZE];
+#define 			ADC_BUFFER_DEFINE_MULTIMODE_EX(__NAME__, __CHANNELS__, __MEASURES__, __SCANS__)											\
+						static uint32_t __NAME__##_Storage[ADC_BUFFER_LENGTH((__CHANNELS__), (__SCANS__))] __ADC_DMA_DATA;						\
+						ADC_BufferTypeDef __NAME__ = {																					\
+							.BufferADC        = NULL,																					\
+							.BufferMultiMode  = __NAME__##_Storage,																		\
+							.BufferLength     = ADC_BUFFER_LENGTH((__CHANNELS__), (__SCANS__)),											\
+							.AveragedMeasures = (__MEASURES__)																			\
+						}
 
-}DMA_IndependentModeBufferTypeDef;
+/**
+  * @brief  Statically allocates DMA storage for ADC in independent mode packed to bytes | halves storage of 8-bit and 6-bit resolution
+  * 		DMA memory data alignment has to be set to byte (DMA_MDATAALIGN_BYTE), peripheral alignment stays half-word
+  * 		Blocks passed to ADC_BlockCpltCallback are bytes, so stages reading half-words (history, DSP) are not used with packed storage
+  * 		Example: ADC_BUFFER_DEFINE_PACKED(badc1, 4, 8); -> 4 * 8 bytes = 32 bytes of DMA storage
+  */
+#define 			ADC_BUFFER_DEFINE_PACKED(__NAME__, __CHANNELS__, __MEASURES__)																\
+						static uint8_t __NAME__##_Storage[ADC_BUFFER_LENGTH((__CHANNELS__), (__MEASURES__))] __ADC_DMA_DATA;				\
+						ADC_BufferTypeDef __NAME__ = {																					\
+							.BufferPacked     = __NAME__##_Storage,																		\
+							.BufferMultiMode  = NULL,																					\
+							.BufferLength     = ADC_BUFFER_LENGTH((__CHANNELS__), (__MEASURES__)),										\
+							.AveragedMeasures = (__MEASURES__)																			\
+						}
+
+// checks if DMA stores conversions packed to bytes
+#define 			__ADC_IS_PACKED(__DMA__)				(((__DMA__) != NULL) && ((__DMA__)->Init.MemDataAlignment == DMA_MDATAALIGN_BYTE))
+
+/* Hardware averaging Macros ----------------------------------------------------------- */
+#ifndef 			ADC_HW_AVERAGING
+#define 			ADC_HW_AVERAGING		1											// 1: ADC_Init offloads averaging of independent mode DMA to hardware oversampler (G4/L4/H7) | 0: software only
+#endif
 
+#ifndef 			ADC_HW_AVERAGING_RESOLUTION
+#define 			ADC_HW_AVERAGING_RESOLUTION	4095U									// maximal data register value assumed by ADC_BUFFER_DEFINE while sizing storage | 12-bit right-aligned, 0xFFF0U if left-aligned
+#endif
+
+// number of scans stored in DMA storage to average given number of measures
+#define 			ADC_AVERAGING_SCANS(__MEASURES__)		(ADC_HW_AVERAGING_SUPPORTED((__MEASURES__), ADC_HW_AVERAGING_RESOLUTION) ? 1 : (__MEASURES__))
+
+/**
+  * @brief  Checks if averaging of ADC is done by hardware oversampler | ratio equal to averaged measures without shift in independent mode DMA,
+  * 		latest sample of channel holds sum of averaged measures
+  */
+#define 			__ADC_IS_HW_AVERAGING(__HANDLE__, __BUFFER__)																			\
+						((ADC_HW_AVERAGING == 1) && ((__BUFFER__)->BufferADC != NULL) && ((__BUFFER__)->AveragedMeasures > 1U) &&			\
+						 !__ADC_IS_PACKED((__BUFFER__)->hdma) &&																				\
+						 (__ADC_OVERSAMPLING_RATIO(__HANDLE__) == (__BUFFER__)->AveragedMeasures) && (__ADC_OVERSAMPLING_SHIFT(__HANDLE__) == 0U))
+
+/* Fast path Macros ------------------------------------------------------------------- */
+#ifndef 			ADC_FAST_PATH
+#define 			ADC_FAST_PATH			1											// 1: steady-state reads, restarts and DMA re-arming access registers directly | 0: HAL functions are called
+#endif
+
+/* Cycle counter Macros --------------------------------------------------------------- */
+#if !defined(__ADC_CYCLES) && defined(DWT_CTRL_CYCCNTENA_Msk)
+	#define 		__ADC_CYCLES()			(DWT->CYCCNT)																	// core clock cycles | DWT of Cortex-M3/M4/M7
+	#define 		__ADC_CYCLES_ENABLE()	do{ CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; }while(0)
+#elif !defined(__ADC_CYCLES)
+	#define 		__ADC_CYCLES()			(0U)																			// Cortex-M0/M0+ has no cycle counter
+	#define 		__ADC_CYCLES_ENABLE()	((void)0)
+#elif !defined(__ADC_CYCLES_ENABLE)
+	#define 		__ADC_CYCLES_ENABLE()	((void)0)																		// __ADC_CYCLES provided by build (e.g. virtual time on host)
+#endif
+
+/* Critical section Macros ------------------------------------------------------------ */
+#if !defined(__ADC_CRITICAL_ENTER)
+	#define 		__ADC_CRITICAL_ENTER()	uint32_t __adc_primask = __get_PRIMASK(); __disable_irq()						// nestable | restores previous PRIMASK on exit
+	#define 		__ADC_CRITICAL_EXIT()	__set_PRIMASK(__adc_primask)
+	#define 		__ADC_CRITICAL_YIELD()	do{ __set_PRIMASK(__adc_primask); __ISB(); __disable_irq(); }while(0)			// lets pending interrupts run inside critical section of caller
+#endif
+
+/* Dual mode data Macros ---------------------------------------------------------------- */
+#define 			__ADC_DUAL_MASTER_DATA(__WORD__)	((uint16_t)((__WORD__)      ))				// Master (ADC1) conversion is stored in lower half-word of dual mode data register
+#define 			__ADC_DUAL_SLAVE_DATA(__WORD__)		((uint16_t)((__WORD__) >> 16))				// Slave  (ADC2) conversion is stored in upper half-word of dual mode data register
+
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  ADC buffer typedef. DMA storage is not a part of object, it is provided by caller (ADC_BufferAssign functions)
+  * 		or allocated statically with ADC_BUFFER_DEFINE macros, so only storage of used mode exists in RAM
+  */
 typedef struct{
 
-	DMA_DualmodeBufferTypeDef 		 ddma;				// dma buffer for dual mode
+	union{
+		uint16_t* BufferADC;					// dma storage for independent mode | NULL if ADC works in dual mode or without DMA
+		uint8_t*  BufferPacked;					// the same storage packed to bytes | DMA memory data alignment set to byte, resolution of 8 bits or lower
+	};
+
+	uint32_t* BufferMultiMode;					// dma storage for dual mode        | NULL if ADC works in independent mode or without DMA
+
+	uint16_t  BufferLength;						// number of DMA transfers stored in storage | multiple of converted channels
+
+	uint8_t   AveragedMeasures;					// number of latest measures from one channel to be averaged | lower or equal to number of scans in storage
+
+	volatile uint8_t   Discontinuous;			// 1: acquisition was restarted (overrun, error, stall), samples before next block are missing
+												//    cleared after ADC_BlockCpltCallback of first block following restart
 
-	DMA_IndependentModeBufferTypeDef idma;				// dma buffer for independent mode
+	DMA_HandleTypeDef* hdma;					// DMA handle which fills storage | set by init, used to find latest converted scan
 
-	uint32_t ADC_Buff[ADC_MAX_CHANNELS];
+	volatile uint32_t  HalfBlocks;				// number of DMA half transfer interrupts
+	volatile uint32_t  FullBlocks;				// number of DMA full transfer interrupts
+
+	volatile uint32_t  Errors;					// number of DMA and other errors reported by HAL (HAL_ADC_ErrorCallback) | overruns are not included
+	volatile uint32_t  Overruns;				// number of detected ADC overruns (OVR)
+	uint32_t  Restarts;							// number of acquisition restarts after errors or stalls
+	uint32_t  Progress;							// DMA progress seen by previous ADC_Supervise call
+
+	uint16_t  ADC_Buff[ADC_MAX_CHANNELS];		// latest values converted without DMA, indexed by rank
 
 }ADC_BufferTypeDef;
 
@@ -82,6 +228,8 @@ typedef struct{
 
 	uint8_t ranks[ADC_MAX_CHANNELS];					// Channels for all ranks | auto detect
 
+	uint8_t NbrOfConversions;							// number of converted channels of this ADC | auto detect
+
 }ADC_ChannelsTypeDef;
 
 
@@ -99,11 +247,23 @@ typedef struct{
 	#define __ADC_IS_DMA_ENABLED(__HANDLE__)                                                												\
 											((((__HANDLE__)->DMA_Handle == NULL)   ? 0 : 1))
 
+	/* Resolution macros for F1 family | fixed 12 bits, simulated build models RES field of F2/F3/F4 -------- */
+	#if !defined(__ADC_RESOLUTION)
 	#define __ADC_RESOLUTION(__HANDLE__)                                                    												\
 											(4095U)
 
+	#define __ADC_SET_RESOLUTION(__HANDLE__, __BITS__)                                      												\
+											((void)0)																							// fixed 12-bit resolution
+
+	#define __ADC_ALIGNED_SHIFT(__HANDLE__, __BITS__)                                       												\
+											((READ_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_ALIGN) != 0U) ? 4U : 0U)		// left-aligned 12-bit data occupies bits 15:4
+
+	#define __ADC_DATA_SHIFT(__HANDLE__)                                                    												\
+											(__ADC_ALIGNED_SHIFT((__HANDLE__), 12U))													// left shift of converted value in data register
+	#endif
+
 	#define __ADC_DMA_MODE(__HANDLE__)                                                      												\
-											(((((__HANDLE__)->DMA_Handle->Instance->CCR >> DMA_CCR_CIRC_Pos) & 0x1U))? 0:1)
+											(((((__HANDLE__)->DMA_Handle->Instance->CCR >> DMA_CCR_CIRC_Pos) & 0x1U))? 1:0)
 
 	#define __ADC_EOC(__HANDLE__)                                                           												\
 											((((__HANDLE__)->Instance->SR          >> ADC_SR_EOC_Pos) & 0x1U))
@@ -111,6 +271,51 @@ typedef struct{
 	#define __ADC_MODE(__HANDLE__)                                                          												\
 											((((__HANDLE__)->Instance->CR2         >> ADC_CR2_CONT_Pos) & 0x1U))
 
+	/* Sampling time and single conversion macros | used by sampling time tuning ---------------- */
+	#define __ADC_SAMPLETIME(__HANDLE__, __CHANNEL__)                                       												\
+											(((__CHANNEL__) < 10U) ? (((__HANDLE__)->Instance->SMPR2 >> (3U * (__CHANNEL__))) & 0x7U) :			\
+											                         (((__HANDLE__)->Instance->SMPR1 >> (3U * ((__CHANNEL__) - 10U))) & 0x7U))	// channels 0 - 9 in SMPR2, following channels in SMPR1
+
+	#define __ADC_SET_SAMPLETIME(__HANDLE__, __CHANNEL__, __CODE__)                         												\
+											(((__CHANNEL__) < 10U) ? MODIFY_REG((__HANDLE__)->Instance->SMPR2, 0x7UL << (3U * (__CHANNEL__)), (uint32_t)(__CODE__) << (3U * (__CHANNEL__))) :	\
+											                         MODIFY_REG((__HANDLE__)->Instance->SMPR1, 0x7UL << (3U * ((__CHANNEL__) - 10U)), (uint32_t)(__CODE__) << (3U * ((__CHANNEL__) - 10U))))
+
+	#define __ADC_CONV_CTRL(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->CR2)																		// register of continuous mode and DMA requests
+
+	#define __ADC_SET_SINGLE_CONVERSION(__HANDLE__, __CHANNEL__)                            												\
+											do{ CLEAR_BIT((__HANDLE__)->Instance->SQR1, ADC_SQR1_L);											\
+												MODIFY_REG((__HANDLE__)->Instance->SQR3, ADC_SQR3_SQ1, (uint32_t)(__CHANNEL__) << ADC_SQR3_SQ1_Pos);		\
+												CLEAR_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_CONT | ADC_CR2_DMA); }while(0)							// one conversion per start, read from data register
+
+	/* Direct register fast path macros for F1 family | no locking, no state machine -------- */
+	#define __ADC_READ_DATA(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->DR)
+
+	#define __ADC_READ_MULTIMODE_DATA(__HANDLE__)                                           												\
+											(ADC1->DR)																						// Master's DR contains Slave's data in upper half-word
+
+	#define __ADC_SW_START(__HANDLE__)                                                      												\
+											(SET_BIT((__HANDLE__)->Instance->CR2, (ADC_CR2_SWSTART | ADC_CR2_EXTTRIG)))
+
+	#define __ADC_DMA_SET_COUNTER(__DMA__, __COUNTER__)                                     												\
+											((__DMA__)->Instance->CNDTR = (__COUNTER__))
+
+	#define __ADC_DMA_WAIT_DISABLED(__DMA__)                                                												\
+											((void)0)																						// channel is disabled immediately
+
+	#define __ADC_DMA_REQUESTS_RESTART(__HANDLE__)                                          												\
+											((void)0)																						// ADC keeps generating DMA requests
+
+	/* Overrun macros for F1 family | ADC of F1 has no OVR flag, data register is overwritten silently -------- */
+	#if !defined(__ADC_IS_OVERRUN)
+	#define __ADC_IS_OVERRUN(__HANDLE__)                                                    												\
+											(0U)
+
+	#define __ADC_CLEAR_OVERRUN(__HANDLE__)                                                 												\
+											((void)0)
+	#endif
+
 
 	// ====================================================================
 	// RANK DEFINITIONS (RANK 1 do RANK 16)
@@ -197,6 +402,16 @@ typedef struct{
 											 ((((__HANDLE__)->Instance->CR1 >> ADC_CR1_RES_Pos) & 0b11) == 0b01) ? 1023U : 				    \
 											 ((((__HANDLE__)->Instance->CR1 >> ADC_CR1_RES_Pos) & 0b11) == 0b10) ? 255U  : 63U )
 
+	#define __ADC_SET_RESOLUTION(__HANDLE__, __BITS__)                                      												\
+											do{ (__HANDLE__)->Init.Resolution = ((12U - (__BITS__)) / 2U) << ADC_CR1_RES_Pos;							\
+												MODIFY_REG((__HANDLE__)->Instance->CR1, ADC_CR1_RES, (__HANDLE__)->Init.Resolution); }while(0)		// 12, 10, 8, 6 bits -> RES = 00, 01, 10, 11
+
+	#define __ADC_ALIGNED_SHIFT(__HANDLE__, __BITS__)                                       												\
+											((READ_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_ALIGN) != 0U) ? (((__BITS__) == 6U) ? 2U : (16U - (__BITS__))) : 0U)		// left-aligned 6-bit data is aligned to byte
+
+	#define __ADC_DATA_SHIFT(__HANDLE__)                                                    												\
+											(__ADC_ALIGNED_SHIFT((__HANDLE__), 12U - 2U * (((__HANDLE__)->Instance->CR1 >> ADC_CR1_RES_Pos) & 0x3U)))													// left shift of converted value in data register
+
 	#define __ADC_DMA_MODE(__HANDLE__)                                                      												\
 											(((__HANDLE__)->DMA_Handle->Init.Mode == DMA_NORMAL) ? 0U : 1U)
 
@@ -206,6 +421,49 @@ typedef struct{
 	#define __ADC_MODE(__HANDLE__)                                                          												\
 											((((__HANDLE__)->Instance->CR2 >> ADC_CR2_CONT_Pos) & 0x1U))
 
+	/* Sampling time and single conversion macros | used by sampling time tuning ---------------- */
+	#define __ADC_SAMPLETIME(__HANDLE__, __CHANNEL__)                                       												\
+											(((__CHANNEL__) < 10U) ? (((__HANDLE__)->Instance->SMPR2 >> (3U * (__CHANNEL__))) & 0x7U) :			\
+											                         (((__HANDLE__)->Instance->SMPR1 >> (3U * ((__CHANNEL__) - 10U))) & 0x7U))	// channels 0 - 9 in SMPR2, following channels in SMPR1
+
+	#define __ADC_SET_SAMPLETIME(__HANDLE__, __CHANNEL__, __CODE__)                         												\
+											(((__CHANNEL__) < 10U) ? MODIFY_REG((__HANDLE__)->Instance->SMPR2, 0x7UL << (3U * (__CHANNEL__)), (uint32_t)(__CODE__) << (3U * (__CHANNEL__))) :	\
+											                         MODIFY_REG((__HANDLE__)->Instance->SMPR1, 0x7UL << (3U * ((__CHANNEL__) - 10U)), (uint32_t)(__CODE__) << (3U * ((__CHANNEL__) - 10U))))
+
+	#define __ADC_CONV_CTRL(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->CR2)																		// register of continuous mode and DMA requests
+
+	#define __ADC_SET_SINGLE_CONVERSION(__HANDLE__, __CHANNEL__)                            												\
+											do{ CLEAR_BIT((__HANDLE__)->Instance->SQR1, ADC_SQR1_L);											\
+												MODIFY_REG((__HANDLE__)->Instance->SQR3, ADC_SQR3_SQ1, (uint32_t)(__CHANNEL__) << ADC_SQR3_SQ1_Pos);		\
+												CLEAR_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_CONT | ADC_CR2_DMA); }while(0)							// one conversion per start, read from data register
+
+	/* Direct register fast path macros for F2 family | no locking, no state machine -------- */
+	#define __ADC_READ_DATA(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->DR)
+
+	#define __ADC_READ_MULTIMODE_DATA(__HANDLE__)                                           												\
+											(ADC->CDR)
+
+	#define __ADC_SW_START(__HANDLE__)                                                      												\
+											(SET_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_SWSTART))
+
+	#define __ADC_DMA_SET_COUNTER(__DMA__, __COUNTER__)                                     												\
+											((__DMA__)->Instance->NDTR = (__COUNTER__))
+
+	#define __ADC_DMA_WAIT_DISABLED(__DMA__)                                                												\
+											do{ while(((__DMA__)->Instance->CR & DMA_SxCR_EN) != 0U){} }while(0)								// stream finishes current transfer before it is disabled
+
+	#define __ADC_DMA_REQUESTS_RESTART(__HANDLE__)                                          												\
+											do{ CLEAR_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_DMA); SET_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_DMA); }while(0)	// ADC stops DMA requests after last transfer in normal mode
+
+	/* Overrun macros | OVR stops conversions and DMA requests until DMA is restarted ------------------------- */
+	#define __ADC_IS_OVERRUN(__HANDLE__)                                                    												\
+											((((__HANDLE__)->Instance->SR >> ADC_SR_OVR_Pos) & 0x1U))
+
+	#define __ADC_CLEAR_OVERRUN(__HANDLE__)                                                 												\
+											(WRITE_REG((__HANDLE__)->Instance->SR, ~ADC_SR_OVR))											// rc_w0 | writing 1 to other flags keeps them, no read-modify-write race with EOC/STRT
+
 	// ====================================================================
 	// RANK DEFINITIONS (RANK 1 do RANK 16)
 	// ====================================================================
@@ -274,7 +532,7 @@ typedef struct{
 
 	#include "stm32f3xx.h"			// Including lib, which contains READ_REG and READ_BIT functions
 
-	#define  ADC_CCR_OFFSET 0x300	// CCR reg address offset from base ADC1 address
+	#define  ADC_CCR_OFFSET 0x308	// CCR reg address offset from base ADC1 address | common registers start at 0x300 with CSR
 
 
 	/* Macros Function type for core of F3 family-------------------------------------- */
@@ -292,6 +550,16 @@ typedef struct{
 											 ((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_RES_Pos) & 0b11) == 0b01) ? 1023U : 			    \
 											 ((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_RES_Pos) & 0b11) == 0b10) ? 255U  : 63U )
 
+	#define __ADC_SET_RESOLUTION(__HANDLE__, __BITS__)                                      												\
+											do{ (__HANDLE__)->Init.Resolution = ((12U - (__BITS__)) / 2U) << ADC_CFGR_RES_Pos;							\
+												MODIFY_REG((__HANDLE__)->Instance->CFGR, ADC_CFGR_RES, (__HANDLE__)->Init.Resolution); }while(0)		// 12, 10, 8, 6 bits -> RES = 00, 01, 10, 11
+
+	#define __ADC_ALIGNED_SHIFT(__HANDLE__, __BITS__)                                       												\
+											((READ_BIT((__HANDLE__)->Instance->CFGR, ADC_CFGR_ALIGN) != 0U) ? (((__BITS__) == 6U) ? 2U : (16U - (__BITS__))) : 0U)		// left-aligned 6-bit data is aligned to byte
+
+	#define __ADC_DATA_SHIFT(__HANDLE__)                                                    												\
+											(__ADC_ALIGNED_SHIFT((__HANDLE__), 12U - 2U * (((__HANDLE__)->Instance->CFGR >> ADC_CFGR_RES_Pos) & 0x3U)))													// left shift of converted value in data register
+
 	#define __ADC_DMA_MODE(__HANDLE__)                                                      												\
 											(((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_DMACFG_Pos) & 0x1U)))
 
@@ -301,6 +569,51 @@ typedef struct{
 	#define __ADC_MODE(__HANDLE__)                                                          												\
 											((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_CONT_Pos) & 0x1U))
 
+	/* Sampling time and single conversion macros | used by sampling time tuning ---------------- */
+	#define __ADC_SAMPLETIME(__HANDLE__, __CHANNEL__)                                       												\
+											(((__CHANNEL__) < 10U) ? (((__HANDLE__)->Instance->SMPR1 >> (3U * (__CHANNEL__))) & 0x7U) :			\
+											                         (((__HANDLE__)->Instance->SMPR2 >> (3U * ((__CHANNEL__) - 10U))) & 0x7U))	// channels 0 - 9 in SMPR1, following channels in SMPR2
+
+	#define __ADC_SET_SAMPLETIME(__HANDLE__, __CHANNEL__, __CODE__)                         												\
+											(((__CHANNEL__) < 10U) ? MODIFY_REG((__HANDLE__)->Instance->SMPR1, 0x7UL << (3U * (__CHANNEL__)), (uint32_t)(__CODE__) << (3U * (__CHANNEL__))) :	\
+											                         MODIFY_REG((__HANDLE__)->Instance->SMPR2, 0x7UL << (3U * ((__CHANNEL__) - 10U)), (uint32_t)(__CODE__) << (3U * ((__CHANNEL__) - 10U))))
+
+	#define __ADC_CONV_CTRL(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->CFGR)																		// register of continuous mode and DMA requests
+
+	#define __ADC_SET_SINGLE_CONVERSION(__HANDLE__, __CHANNEL__)                            												\
+											do{ CLEAR_BIT((__HANDLE__)->Instance->SQR1, ADC_SQR1_L);											\
+												MODIFY_REG((__HANDLE__)->Instance->SQR1, ADC_SQR1_SQ1, (uint32_t)(__CHANNEL__) << ADC_SQR1_SQ1_Pos);		\
+												CLEAR_BIT((__HANDLE__)->Instance->CFGR, ADC_CFGR_CONT | ADC_CFGR_DMAEN); }while(0)							// one conversion per start, read from data register
+
+	/* Direct register fast path macros for F3 family | no locking, no state machine -------- */
+	#define  ADC_CDR_OFFSET 0x30C	// CDR reg address offset from base ADC1 address
+
+	#define __ADC_READ_DATA(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->DR)
+
+	#define __ADC_READ_MULTIMODE_DATA(__HANDLE__)                                           												\
+											(READ_REG(*(volatile uint32_t *)(ADC1_BASE + ADC_CDR_OFFSET)))
+
+	#define __ADC_SW_START(__HANDLE__)                                                      												\
+											(SET_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART))
+
+	#define __ADC_DMA_SET_COUNTER(__DMA__, __COUNTER__)                                     												\
+											((__DMA__)->Instance->CNDTR = (__COUNTER__))
+
+	#define __ADC_DMA_WAIT_DISABLED(__DMA__)                                                												\
+											((void)0)																						// channel is disabled immediately
+
+	#define __ADC_DMA_REQUESTS_RESTART(__HANDLE__)                                          												\
+											do{ if(READ_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART) != 0U){ SET_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTP); while(READ_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART) != 0U){} } SET_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART); }while(0)	// one-shot DMA (DMACFG = 0 / DMNGT = 01) stops requests after last transfer | re-enabled only by new ADSTART
+
+	/* Overrun macros | with OVRMOD = 0 data register is preserved and DMA requests stop until DMA is restarted */
+	#define __ADC_IS_OVERRUN(__HANDLE__)                                                    												\
+											((((__HANDLE__)->Instance->ISR >> ADC_ISR_OVR_Pos) & 0x1U))
+
+	#define __ADC_CLEAR_OVERRUN(__HANDLE__)                                                 												\
+											(WRITE_REG((__HANDLE__)->Instance->ISR, ADC_ISR_OVR))											// flag is cleared by writing 1
+
 	// ====================================================================
 	// RANK DEFINITIONS (RANK 1 do RANK 16)
 	// ====================================================================
@@ -388,6 +701,16 @@ typedef struct{
 											 ((((__HANDLE__)->Instance->CR1 >> ADC_CR1_RES_Pos) & 0b11) == 0b01) ? 1023U : 				    \
 											 ((((__HANDLE__)->Instance->CR1 >> ADC_CR1_RES_Pos) & 0b11) == 0b10) ? 255U  : 63U )
 
+	#define __ADC_SET_RESOLUTION(__HANDLE__, __BITS__)                                      												\
+											do{ (__HANDLE__)->Init.Resolution = ((12U - (__BITS__)) / 2U) << ADC_CR1_RES_Pos;							\
+												MODIFY_REG((__HANDLE__)->Instance->CR1, ADC_CR1_RES, (__HANDLE__)->Init.Resolution); }while(0)		// 12, 10, 8, 6 bits -> RES = 00, 01, 10, 11
+
+	#define __ADC_ALIGNED_SHIFT(__HANDLE__, __BITS__)                                       												\
+											((READ_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_ALIGN) != 0U) ? (((__BITS__) == 6U) ? 2U : (16U - (__BITS__))) : 0U)		// left-aligned 6-bit data is aligned to byte
+
+	#define __ADC_DATA_SHIFT(__HANDLE__)                                                    												\
+											(__ADC_ALIGNED_SHIFT((__HANDLE__), 12U - 2U * (((__HANDLE__)->Instance->CR1 >> ADC_CR1_RES_Pos) & 0x3U)))													// left shift of converted value in data register
+
 	#define __ADC_DMA_MODE(__HANDLE__)                                                      												\
 											(((__HANDLE__)->DMA_Handle->Init.Mode == DMA_NORMAL) ? 0U : 1U)
 
@@ -397,6 +720,49 @@ typedef struct{
 	#define __ADC_MODE(__HANDLE__)                                                          												\
 											((((__HANDLE__)->Instance->CR2 >> ADC_CR2_CONT_Pos) & 0x1U))
 
+	/* Sampling time and single conversion macros | used by sampling time tuning ---------------- */
+	#define __ADC_SAMPLETIME(__HANDLE__, __CHANNEL__)                                       												\
+											(((__CHANNEL__) < 10U) ? (((__HANDLE__)->Instance->SMPR2 >> (3U * (__CHANNEL__))) & 0x7U) :			\
+											                         (((__HANDLE__)->Instance->SMPR1 >> (3U * ((__CHANNEL__) - 10U))) & 0x7U))	// channels 0 - 9 in SMPR2, following channels in SMPR1
+
+	#define __ADC_SET_SAMPLETIME(__HANDLE__, __CHANNEL__, __CODE__)                         												\
+											(((__CHANNEL__) < 10U) ? MODIFY_REG((__HANDLE__)->Instance->SMPR2, 0x7UL << (3U * (__CHANNEL__)), (uint32_t)(__CODE__) << (3U * (__CHANNEL__))) :	\
+											                         MODIFY_REG((__HANDLE__)->Instance->SMPR1, 0x7UL << (3U * ((__CHANNEL__) - 10U)), (uint32_t)(__CODE__) << (3U * ((__CHANNEL__) - 10U))))
+
+	#define __ADC_CONV_CTRL(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->CR2)																		// register of continuous mode and DMA requests
+
+	#define __ADC_SET_SINGLE_CONVERSION(__HANDLE__, __CHANNEL__)                            												\
+											do{ CLEAR_BIT((__HANDLE__)->Instance->SQR1, ADC_SQR1_L);											\
+												MODIFY_REG((__HANDLE__)->Instance->SQR3, ADC_SQR3_SQ1, (uint32_t)(__CHANNEL__) << ADC_SQR3_SQ1_Pos);		\
+												CLEAR_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_CONT | ADC_CR2_DMA); }while(0)							// one conversion per start, read from data register
+
+	/* Direct register fast path macros for F4 family | no locking, no state machine -------- */
+	#define __ADC_READ_DATA(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->DR)
+
+	#define __ADC_READ_MULTIMODE_DATA(__HANDLE__)                                           												\
+											(ADC->CDR)
+
+	#define __ADC_SW_START(__HANDLE__)                                                      												\
+											(SET_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_SWSTART))
+
+	#define __ADC_DMA_SET_COUNTER(__DMA__, __COUNTER__)                                     												\
+											((__DMA__)->Instance->NDTR = (__COUNTER__))
+
+	#define __ADC_DMA_WAIT_DISABLED(__DMA__)                                                												\
+											do{ while(((__DMA__)->Instance->CR & DMA_SxCR_EN) != 0U){} }while(0)								// stream finishes current transfer before it is disabled
+
+	#define __ADC_DMA_REQUESTS_RESTART(__HANDLE__)                                          												\
+											do{ CLEAR_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_DMA); SET_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_DMA); }while(0)	// ADC stops DMA requests after last transfer in normal mode
+
+	/* Overrun macros | OVR stops conversions and DMA requests until DMA is restarted ------------------------- */
+	#define __ADC_IS_OVERRUN(__HANDLE__)                                                    												\
+											((((__HANDLE__)->Instance->SR >> ADC_SR_OVR_Pos) & 0x1U))
+
+	#define __ADC_CLEAR_OVERRUN(__HANDLE__)                                                 												\
+											(WRITE_REG((__HANDLE__)->Instance->SR, ~ADC_SR_OVR))											// rc_w0 | writing 1 to other flags keeps them, no read-modify-write race with EOC/STRT
+
 	// ====================================================================
 	// RANK DEFINITIONS (RANK 1 do RANK 16)
 	// ====================================================================
@@ -462,14 +828,407 @@ typedef struct{
 	#define ADC_NBR_OF_CONVERSIONS_BITPOS	ADC_SQR1_L_Pos
 
 
+#elif defined(STM32G4_FAMILY) || defined(STM32L4_FAMILY)
+
+	#if defined(STM32G4_FAMILY)
+		#include "stm32g4xx.h"		// Including lib, which contains READ_REG and READ_BIT functions
+	#else
+		#include "stm32l4xx.h"		// Including lib, which contains READ_REG and READ_BIT functions
+	#endif
+
+
+	/* Macros Function type for core of G4 and L4 family | register layout of F3 ADC, common registers found by instance ------ */
+	#if defined(ADC_MULTIMODE_SUPPORT)
+	#define __ADC_IS_DMA_MULTIMODE(__HANDLE__)                                              												\
+											((READ_BIT(__LL_ADC_COMMON_INSTANCE((__HANDLE__)->Instance)->CCR, ADC_CCR_DUAL) != 0U) ? 1U : 0U)
+	#else
+	#define __ADC_IS_DMA_MULTIMODE(__HANDLE__)                                              												\
+											(0U)																							// single ADC devices (e.g. L43x)
+	#endif
+
+	#define __ADC_IS_CONV_STARTED(__HANDLE__)                                               												\
+											(((((__HANDLE__)->Instance->CR >> ADC_CR_ADSTART_Pos) & 0x1U)))
+
+	#define __ADC_IS_DMA_ENABLED(__HANDLE__)                                                												\
+											((READ_BIT((__HANDLE__)->Instance->CFGR, ADC_CFGR_DMAEN)))
+
+	#define __ADC_RESOLUTION(__HANDLE__)                                                    												\
+											(((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_RES_Pos) & 0b11) == 0b00) ? 4095U : 			    \
+											 ((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_RES_Pos) & 0b11) == 0b01) ? 1023U : 			    \
+											 ((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_RES_Pos) & 0b11) == 0b10) ? 255U  : 63U )
+
+	#define __ADC_SET_RESOLUTION(__HANDLE__, __BITS__)                                      												\
+											do{ (__HANDLE__)->Init.Resolution = ((12U - (__BITS__)) / 2U) << ADC_CFGR_RES_Pos;							\
+												MODIFY_REG((__HANDLE__)->Instance->CFGR, ADC_CFGR_RES, (__HANDLE__)->Init.Resolution); }while(0)		// 12, 10, 8, 6 bits -> RES = 00, 01, 10, 11
+
+	#define __ADC_ALIGNED_SHIFT(__HANDLE__, __BITS__)                                       												\
+											((READ_BIT((__HANDLE__)->Instance->CFGR, ADC_CFGR_ALIGN) != 0U) ? (((__BITS__) == 6U) ? 2U : (16U - (__BITS__))) : 0U)		// left-aligned 6-bit data is aligned to byte
+
+	#define __ADC_DATA_SHIFT(__HANDLE__)                                                    												\
+											(__ADC_ALIGNED_SHIFT((__HANDLE__), 12U - 2U * (((__HANDLE__)->Instance->CFGR >> ADC_CFGR_RES_Pos) & 0x3U)))													// left shift of converted value in data register
+
+	#define __ADC_DMA_MODE(__HANDLE__)                                                      												\
+											(((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_DMACFG_Pos) & 0x1U)))
+
+	#define __ADC_EOC(__HANDLE__)                                                           												\
+											((((__HANDLE__)->Instance->ISR >> ADC_ISR_EOC_Pos) & 0x1U))
+
+	#define __ADC_MODE(__HANDLE__)                                                          												\
+											((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_CONT_Pos) & 0x1U))
+
+	/* Sampling time and single conversion macros | used by sampling time tuning ---------------- */
+	#define __ADC_SAMPLETIME(__HANDLE__, __CHANNEL__)                                       												\
+											(((__CHANNEL__) < 10U) ? (((__HANDLE__)->Instance->SMPR1 >> (3U * (__CHANNEL__))) & 0x7U) :			\
+											                         (((__HANDLE__)->Instance->SMPR2 >> (3U * ((__CHANNEL__) - 10U))) & 0x7U))	// channels 0 - 9 in SMPR1, following channels in SMPR2
+
+	#define __ADC_SET_SAMPLETIME(__HANDLE__, __CHANNEL__, __CODE__)                         												\
+											(((__CHANNEL__) < 10U) ? MODIFY_REG((__HANDLE__)->Instance->SMPR1, 0x7UL << (3U * (__CHANNEL__)), (uint32_t)(__CODE__) << (3U * (__CHANNEL__))) :	\
+											                         MODIFY_REG((__HANDLE__)->Instance->SMPR2, 0x7UL << (3U * ((__CHANNEL__) - 10U)), (uint32_t)(__CODE__) << (3U * ((__CHANNEL__) - 10U))))
+
+	#define __ADC_CONV_CTRL(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->CFGR)																		// register of continuous mode and DMA requests
+
+	#define __ADC_SET_SINGLE_CONVERSION(__HANDLE__, __CHANNEL__)                            												\
+											do{ CLEAR_BIT((__HANDLE__)->Instance->SQR1, ADC_SQR1_L);											\
+												MODIFY_REG((__HANDLE__)->Instance->SQR1, ADC_SQR1_SQ1, (uint32_t)(__CHANNEL__) << ADC_SQR1_SQ1_Pos);		\
+												CLEAR_BIT((__HANDLE__)->Instance->CFGR, ADC_CFGR_CONT | ADC_CFGR_DMAEN); }while(0)							// one conversion per start, read from data register
+
+	/* Direct register fast path macros for G4 and L4 family | no locking, no state machine -------- */
+	#define __ADC_READ_DATA(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->DR)
+
+	#define __ADC_READ_MULTIMODE_DATA(__HANDLE__)                                           												\
+											(READ_REG(__LL_ADC_COMMON_INSTANCE((__HANDLE__)->Instance)->CDR))
+
+	#define __ADC_SW_START(__HANDLE__)                                                      												\
+											(SET_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART))
+
+	#define __ADC_DMA_SET_COUNTER(__DMA__, __COUNTER__)                                     												\
+											((__DMA__)->Instance->CNDTR = (__COUNTER__))
+
+	#define __ADC_DMA_WAIT_DISABLED(__DMA__)                                                												\
+											((void)0)																						// channel is disabled immediately
+
+	#define __ADC_DMA_REQUESTS_RESTART(__HANDLE__)                                          												\
+											do{ if(READ_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART) != 0U){ SET_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTP); while(READ_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART) != 0U){} } SET_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART); }while(0)	// one-shot DMA (DMACFG = 0 / DMNGT = 01) stops requests after last transfer | re-enabled only by new ADSTART
+
+	/* Overrun macros | with OVRMOD = 0 data register is preserved and DMA requests stop until DMA is restarted */
+	#define __ADC_IS_OVERRUN(__HANDLE__)                                                    												\
+											((((__HANDLE__)->Instance->ISR >> ADC_ISR_OVR_Pos) & 0x1U))
+
+	#define __ADC_CLEAR_OVERRUN(__HANDLE__)                                                 												\
+											(WRITE_REG((__HANDLE__)->Instance->ISR, ADC_ISR_OVR))											// flag is cleared by writing 1
+
+	/* Hardware oversampler macros | CFGR2: ROVSE, OVSR = log2(ratio) - 1, OVSS = shift | written only while ADSTART = 0 */
+	#define ADC_HW_OVERSAMPLER				1
+	#define ADC_OVERSAMPLING_MAX_RATIO		256U													// ratio 2, 4, ... 256
+	#define ADC_OVERSAMPLING_MAX_SHIFT		8U
+	#define ADC_OVERSAMPLING_POW2			1														// ratio has to be power of 2
+
+	#define __ADC_OVERSAMPLING_SET(__HANDLE__, __RATIO__, __SHIFT__)                        												\
+											(MODIFY_REG((__HANDLE__)->Instance->CFGR2, ADC_CFGR2_ROVSE | ADC_CFGR2_OVSR | ADC_CFGR2_OVSS,						\
+											           ((__RATIO__) <= 1U) ? 0U : (ADC_CFGR2_ROVSE | ((30U - __CLZ(__RATIO__)) << ADC_CFGR2_OVSR_Pos) | ((uint32_t)(__SHIFT__) << ADC_CFGR2_OVSS_Pos))))
+
+	#define __ADC_OVERSAMPLING_RATIO(__HANDLE__)                                            												\
+											((READ_BIT((__HANDLE__)->Instance->CFGR2, ADC_CFGR2_ROVSE) == 0U) ? 1U : (2U << (((__HANDLE__)->Instance->CFGR2 & ADC_CFGR2_OVSR) >> ADC_CFGR2_OVSR_Pos)))
+
+	#define __ADC_OVERSAMPLING_SHIFT(__HANDLE__)                                            												\
+											((READ_BIT((__HANDLE__)->Instance->CFGR2, ADC_CFGR2_ROVSE) == 0U) ? 0U : (((__HANDLE__)->Instance->CFGR2 & ADC_CFGR2_OVSS) >> ADC_CFGR2_OVSS_Pos))
+
+	// ====================================================================
+	// RANK DEFINITIONS (RANK 1 do RANK 16)
+	// ====================================================================
+
+	// RANKS 1 - 4 (Register SQR1)
+	// --------------------------------------------------------------------
+	#define ADC_RANK1_REG                   SQR_1
+	#define ADC_RANK1_BITPOS                ADC_SQR1_SQ1_Pos
+
+	#define ADC_RANK2_REG                   SQR_1
+	#define ADC_RANK2_BITPOS                ADC_SQR1_SQ2_Pos
+
+	#define ADC_RANK3_REG                   SQR_1
+	#define ADC_RANK3_BITPOS                ADC_SQR1_SQ3_Pos
+
+	#define ADC_RANK4_REG                   SQR_1
+	#define ADC_RANK4_BITPOS                ADC_SQR1_SQ4_Pos
+
+
+	// RANKS 5 - 9 (Register SQR2)
+	// --------------------------------------------------------------------
+	#define ADC_RANK5_REG                   SQR_2
+	#define ADC_RANK5_BITPOS                ADC_SQR2_SQ5_Pos
+
+	#define ADC_RANK6_REG                   SQR_2
+	#define ADC_RANK6_BITPOS                ADC_SQR2_SQ6_Pos
+
+	#define ADC_RANK7_REG                   SQR_2
+	#define ADC_RANK7_BITPOS                ADC_SQR2_SQ7_Pos
+
+	#define ADC_RANK8_REG                   SQR_2
+	#define ADC_RANK8_BITPOS                ADC_SQR2_SQ8_Pos
+
+	#define ADC_RANK9_REG                   SQR_2
+	#define ADC_RANK9_BITPOS                ADC_SQR2_SQ9_Pos
+
+
+	// RANKS 10 - 14 (Register SQR3)
+	// --------------------------------------------------------------------
+	#define ADC_RANK10_REG                  SQR_3
+	#define ADC_RANK10_BITPOS               ADC_SQR3_SQ10_Pos
+
+	#define ADC_RANK11_REG                  SQR_3
+	#define ADC_RANK11_BITPOS               ADC_SQR3_SQ11_Pos
+
+	#define ADC_RANK12_REG                  SQR_3
+	#define ADC_RANK12_BITPOS               ADC_SQR3_SQ12_Pos
+
+	#define ADC_RANK13_REG                  SQR_3
+	#define ADC_RANK13_BITPOS               ADC_SQR3_SQ13_Pos
+
+	#define ADC_RANK14_REG                  SQR_3
+	#define ADC_RANK14_BITPOS               ADC_SQR3_SQ14_Pos
+
+
+	// RANKS 15 - 16 (Register SQR4)
+	// --------------------------------------------------------------------
+	#define ADC_RANK15_REG                  SQR_4
+	#define ADC_RANK15_BITPOS               ADC_SQR4_SQ15_Pos
+
+	#define ADC_RANK16_REG                  SQR_4
+	#define ADC_RANK16_BITPOS               ADC_SQR4_SQ16_Pos
+
+	// Number of Converted Channels
+	#define ADC_NBR_OF_CONVERSIONS_REG		SQR_1
+	#define ADC_NBR_OF_CONVERSIONS_BITPOS	ADC_SQR1_L_Pos
+
+
+#elif defined(STM32H7_FAMILY)
+
+	#include "stm32h7xx.h"			// Including lib, which contains READ_REG and READ_BIT functions
+
+
+	/* Macros Function type for core of H7 family | DMNGT replaces DMAEN/DMACFG, resolution codes depend on silicon revision ------ */
+	#define __ADC_IS_DMA_MULTIMODE(__HANDLE__)                                              												\
+											((READ_BIT(__LL_ADC_COMMON_INSTANCE((__HANDLE__)->Instance)->CCR, ADC_CCR_DUAL) != 0U) ? 1U : 0U)
+
+	#define __ADC_IS_CONV_STARTED(__HANDLE__)                                               												\
+											(((((__HANDLE__)->Instance->CR >> ADC_CR_ADSTART_Pos) & 0x1U)))
+
+	#define __ADC_IS_DMA_ENABLED(__HANDLE__)                                                												\
+											((READ_BIT((__HANDLE__)->Instance->CFGR, ADC_CFGR_DMNGT_0)))										// DMNGT = 01: DMA one shot, 11: DMA circular
+
+	#define __ADC_RESOLUTION(__HANDLE__)                                                    												\
+											(((__HANDLE__)->Init.Resolution == ADC_RESOLUTION_16B) ? 65535U : 			    					\
+											 ((__HANDLE__)->Init.Resolution == ADC_RESOLUTION_14B) ? 16383U : 			    					\
+											 ((__HANDLE__)->Init.Resolution == ADC_RESOLUTION_12B) ? 4095U  : 			    					\
+											 ((__HANDLE__)->Init.Resolution == ADC_RESOLUTION_10B) ? 1023U  : 255U )							// RES field is encoded per revision by HAL
+
+	#define __ADC_SET_RESOLUTION(__HANDLE__, __BITS__)                                      												\
+											do{ (__HANDLE__)->Init.Resolution = ((__BITS__) == 16U) ? ADC_RESOLUTION_16B :						\
+																				((__BITS__) == 14U) ? ADC_RESOLUTION_14B :						\
+																				((__BITS__) == 12U) ? ADC_RESOLUTION_12B :						\
+																				((__BITS__) == 10U) ? ADC_RESOLUTION_10B : ADC_RESOLUTION_8B;	\
+												LL_ADC_SetResolution((__HANDLE__)->Instance, (__HANDLE__)->Init.Resolution); }while(0)		// RES encoding of revision is handled by LL
+
+	#define __ADC_ALIGNED_SHIFT(__HANDLE__, __BITS__)                                       												\
+											((((__HANDLE__)->Instance->CFGR2 >> ADC_CFGR2_LSHIFT_Pos) & 0xFU))		// no ALIGN bit | data is shifted left by LSHIFT regardless of resolution
+
+	#define __ADC_DATA_SHIFT(__HANDLE__)                                                    												\
+											(__ADC_ALIGNED_SHIFT((__HANDLE__), 16U))													// left shift of converted value in data register
+
+	#define __ADC_DMA_MODE(__HANDLE__)                                                      												\
+											(((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_DMNGT_Pos) & 0x3U) == 0x3U) ? 1U : 0U)
+
+	#define __ADC_EOC(__HANDLE__)                                                           												\
+											((((__HANDLE__)->Instance->ISR >> ADC_ISR_EOC_Pos) & 0x1U))
+
+	#define __ADC_MODE(__HANDLE__)                                                          												\
+											((((__HANDLE__)->Instance->CFGR >> ADC_CFGR_CONT_Pos) & 0x1U))
+
+	/* Sampling time and single conversion macros | used by sampling time tuning ---------------- */
+	#define __ADC_SAMPLETIME(__HANDLE__, __CHANNEL__)                                       												\
+											(((__CHANNEL__) < 10U) ? (((__HANDLE__)->Instance->SMPR1 >> (3U * (__CHANNEL__))) & 0x7U) :			\
+											                         (((__HANDLE__)->Instance->SMPR2 >> (3U * ((__CHANNEL__) - 10U))) & 0x7U))	// channels 0 - 9 in SMPR1, following channels in SMPR2
+
+	#define __ADC_SET_SAMPLETIME(__HANDLE__, __CHANNEL__, __CODE__)                         												\
+											(((__CHANNEL__) < 10U) ? MODIFY_REG((__HANDLE__)->Instance->SMPR1, 0x7UL << (3U * (__CHANNEL__)), (uint32_t)(__CODE__) << (3U * (__CHANNEL__))) :	\
+											                         MODIFY_REG((__HANDLE__)->Instance->SMPR2, 0x7UL << (3U * ((__CHANNEL__) - 10U)), (uint32_t)(__CODE__) << (3U * ((__CHANNEL__) - 10U))))
+
+	#define __ADC_CONV_CTRL(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->CFGR)																		// register of continuous mode and DMA requests
+
+	#define __ADC_SET_SINGLE_CONVERSION(__HANDLE__, __CHANNEL__)                            												\
+											do{ CLEAR_BIT((__HANDLE__)->Instance->SQR1, ADC_SQR1_L);											\
+												MODIFY_REG((__HANDLE__)->Instance->SQR1, ADC_SQR1_SQ1, (uint32_t)(__CHANNEL__) << ADC_SQR1_SQ1_Pos);		\
+												CLEAR_BIT((__HANDLE__)->Instance->CFGR, ADC_CFGR_CONT | ADC_CFGR_DMNGT); }while(0)							// one conversion per start, read from data register
+
+	/* Direct register fast path macros for H7 family | no locking, no state machine -------- */
+	#define __ADC_READ_DATA(__HANDLE__)                                                     												\
+											((__HANDLE__)->Instance->DR)
+
+	#define __ADC_READ_MULTIMODE_DATA(__HANDLE__)                                           												\
+											(READ_REG(__LL_ADC_COMMON_INSTANCE((__HANDLE__)->Instance)->CDR))								// DAMDF = 10: Master in lower, Slave in upper half-word
+
+	#define __ADC_SW_START(__HANDLE__)                                                      												\
+											(SET_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART))
+
+	#define __ADC_DMA_SET_COUNTER(__DMA__, __COUNTER__)                                     												\
+											(__HAL_DMA_SET_COUNTER((__DMA__), (__COUNTER__)))												// NDTR of DMA1/DMA2 stream (ADC1/ADC2) or CNDTR of BDMA channel (ADC3)
+
+	#define __ADC_DMA_WAIT_DISABLED(__DMA__)                                                												\
+											do{ if(IS_BDMA_CHANNEL_INSTANCE((__DMA__)->Instance) == 0U){ while((((DMA_Stream_TypeDef*)(__DMA__)->Instance)->CR & DMA_SxCR_EN) != 0U){} } }while(0)	// stream finishes current transfer before it is disabled | BDMA channel is disabled immediately
+
+	#define __ADC_DMA_REQUESTS_RESTART(__HANDLE__)                                          												\
+											do{ if(READ_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART) != 0U){ SET_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTP); while(READ_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART) != 0U){} } SET_BIT((__HANDLE__)->Instance->CR, ADC_CR_ADSTART); }while(0)	// one-shot DMA (DMACFG = 0 / DMNGT = 01) stops requests after last transfer | re-enabled only by new ADSTART
+
+	/* Overrun macros | with OVRMOD = 0 data register is preserved and DMA requests stop until DMA is restarted */
+	#define __ADC_IS_OVERRUN(__HANDLE__)                                                    												\
+											((((__HANDLE__)->Instance->ISR >> ADC_ISR_OVR_Pos) & 0x1U))
+
+	#define __ADC_CLEAR_OVERRUN(__HANDLE__)                                                 												\
+											(WRITE_REG((__HANDLE__)->Instance->ISR, ADC_ISR_OVR))											// flag is cleared by writing 1
+
+	/* Hardware oversampler macros | CFGR2: ROVSE, OVSR = ratio - 1, OVSS = shift | written only while ADSTART = 0 */
+	#define ADC_HW_OVERSAMPLER				1
+	#define ADC_OVERSAMPLING_MAX_RATIO		1024U													// any ratio 1 ... 1024
+	#define ADC_OVERSAMPLING_MAX_SHIFT		11U
+	#define ADC_OVERSAMPLING_POW2			0
+
+	#define __ADC_OVERSAMPLING_SET(__HANDLE__, __RATIO__, __SHIFT__)                        												\
+											(MODIFY_REG((__HANDLE__)->Instance->CFGR2, ADC_CFGR2_ROVSE | ADC_CFGR2_OVSR | ADC_CFGR2_OVSS,						\
+											           ((__RATIO__) <= 1U) ? 0U : (ADC_CFGR2_ROVSE | (((uint32_t)(__RATIO__) - 1U) << ADC_CFGR2_OVSR_Pos) | ((uint32_t)(__SHIFT__) << ADC_CFGR2_OVSS_Pos))))
+
+	#define __ADC_OVERSAMPLING_RATIO(__HANDLE__)                                            												\
+											((READ_BIT((__HANDLE__)->Instance->CFGR2, ADC_CFGR2_ROVSE) == 0U) ? 1U : ((((__HANDLE__)->Instance->CFGR2 & ADC_CFGR2_OVSR) >> ADC_CFGR2_OVSR_Pos) + 1U))
+
+	#define __ADC_OVERSAMPLING_SHIFT(__HANDLE__)                                            												\
+											((READ_BIT((__HANDLE__)->Instance->CFGR2, ADC_CFGR2_ROVSE) == 0U) ? 0U : (((__HANDLE__)->Instance->CFGR2 & ADC_CFGR2_OVSS) >> ADC_CFGR2_OVSS_Pos))
+
+	// ====================================================================
+	// RANK DEFINITIONS (RANK 1 do RANK 16)
+	// ====================================================================
+
+	// RANKS 1 - 4 (Register SQR1)
+	// --------------------------------------------------------------------
+	#define ADC_RANK1_REG                   SQR_1
+	#define ADC_RANK1_BITPOS                ADC_SQR1_SQ1_Pos
+
+	#define ADC_RANK2_REG                   SQR_1
+	#define ADC_RANK2_BITPOS                ADC_SQR1_SQ2_Pos
+
+	#define ADC_RANK3_REG                   SQR_1
+	#define ADC_RANK3_BITPOS                ADC_SQR1_SQ3_Pos
+
+	#define ADC_RANK4_REG                   SQR_1
+	#define ADC_RANK4_BITPOS                ADC_SQR1_SQ4_Pos
+
+
+	// RANKS 5 - 9 (Register SQR2)
+	// --------------------------------------------------------------------
+	#define ADC_RANK5_REG                   SQR_2
+	#define ADC_RANK5_BITPOS                ADC_SQR2_SQ5_Pos
+
+	#define ADC_RANK6_REG                   SQR_2
+	#define ADC_RANK6_BITPOS                ADC_SQR2_SQ6_Pos
+
+	#define ADC_RANK7_REG                   SQR_2
+	#define ADC_RANK7_BITPOS                ADC_SQR2_SQ7_Pos
+
+	#define ADC_RANK8_REG                   SQR_2
+	#define ADC_RANK8_BITPOS                ADC_SQR2_SQ8_Pos
+
+	#define ADC_RANK9_REG                   SQR_2
+	#define ADC_RANK9_BITPOS                ADC_SQR2_SQ9_Pos
+
+
+	// RANKS 10 - 14 (Register SQR3)
+	// --------------------------------------------------------------------
+	#define ADC_RANK10_REG                  SQR_3
+	#define ADC_RANK10_BITPOS               ADC_SQR3_SQ10_Pos
+
+	#define ADC_RANK11_REG                  SQR_3
+	#define ADC_RANK11_BITPOS               ADC_SQR3_SQ11_Pos
+
+	#define ADC_RANK12_REG                  SQR_3
+	#define ADC_RANK12_BITPOS               ADC_SQR3_SQ12_Pos
+
+	#define ADC_RANK13_REG                  SQR_3
+	#define ADC_RANK13_BITPOS               ADC_SQR3_SQ13_Pos
+
+	#define ADC_RANK14_REG                  SQR_3
+	#define ADC_RANK14_BITPOS               ADC_SQR3_SQ14_Pos
+
+
+	// RANKS 15 - 16 (Register SQR4)
+	// --------------------------------------------------------------------
+	#define ADC_RANK15_REG                  SQR_4
+	#define ADC_RANK15_BITPOS               ADC_SQR4_SQ15_Pos
+
+	#define ADC_RANK16_REG                  SQR_4
+	#define ADC_RANK16_BITPOS               ADC_SQR4_SQ16_Pos
+
+	// Number of Converted Channels
+	#define ADC_NBR_OF_CONVERSIONS_REG		SQR_1
+	#define ADC_NBR_OF_CONVERSIONS_BITPOS	ADC_SQR1_L_Pos
+
+
 #endif
 
 
+/* Hardware oversampler Macros | families without oversampler average in software only ------------------------- */
+#if !defined(ADC_HW_OVERSAMPLER)
+	#define ADC_HW_OVERSAMPLER				0
+	#define ADC_OVERSAMPLING_MAX_RATIO		1U
+	#define ADC_OVERSAMPLING_MAX_SHIFT		0U
+	#define ADC_OVERSAMPLING_POW2			0
+	#define __ADC_OVERSAMPLING_RATIO(__HANDLE__)	(1U)
+	#define __ADC_OVERSAMPLING_SHIFT(__HANDLE__)	(0U)
+#endif
+
+/**
+  * @brief  Checks if given averaging depth can be offloaded | sum of measures is accumulated unshifted and has to fit 16-bit storage,
+  * 		so dividing it gives the same result as software averaging. Ratio limit is compared only if some uint8_t depth exceeds it
+  */
+#if (ADC_HW_OVERSAMPLER == 0)
+	#define ADC_HW_AVERAGING_SUPPORTED(__MEASURES__, __RESOLUTION__)	(0)
+#else
+	#if (ADC_OVERSAMPLING_MAX_RATIO > 0xFFU)
+		#define __ADC_OVERSAMPLING_RATIO_FITS(__MEASURES__)		(1)														// every depth of AveragedMeasures fits ratio limit
+	#else
+		#define __ADC_OVERSAMPLING_RATIO_FITS(__MEASURES__)		((__MEASURES__) <= ADC_OVERSAMPLING_MAX_RATIO)
+	#endif
+	#define ADC_HW_AVERAGING_SUPPORTED(__MEASURES__, __RESOLUTION__)																\
+						((ADC_HW_AVERAGING == 1) && ((__MEASURES__) > 1) && __ADC_OVERSAMPLING_RATIO_FITS(__MEASURES__) &&						\
+						 ((ADC_OVERSAMPLING_POW2 == 0) || (((__MEASURES__) & ((__MEASURES__) - 1)) == 0)) &&										\
+						 ((uint32_t)(__RESOLUTION__) * (__MEASURES__) <= 0xFFFFU))
+#endif
+
+// maximal single conversion stored in data register | shifted by left alignment
+#define 			__ADC_DATA_MAX(__HANDLE__)				((uint32_t)__ADC_RESOLUTION(__HANDLE__) << __ADC_DATA_SHIFT(__HANDLE__))
+
+// maximal value stored in data register | accumulated oversampled conversions are limited by 16-bit DMA storage, left alignment applies to oversampled result
+#define 			__ADC_FULL_SCALE(__HANDLE__)																							\
+											(((((uint32_t)__ADC_RESOLUTION(__HANDLE__) * __ADC_OVERSAMPLING_RATIO(__HANDLE__)) >> __ADC_OVERSAMPLING_SHIFT(__HANDLE__)) << __ADC_DATA_SHIFT(__HANDLE__)) > 0xFFFFU ? 0xFFFFU :	\
+											 ((((uint32_t)__ADC_RESOLUTION(__HANDLE__) * __ADC_OVERSAMPLING_RATIO(__HANDLE__)) >> __ADC_OVERSAMPLING_SHIFT(__HANDLE__)) << __ADC_DATA_SHIFT(__HANDLE__)))
+
+// Q15 fraction of left-aligned value | unsigned data is offset binary, inverting MSB gives two's complement around mid-scale
+#define 			__ADC_Q15(__VALUE__)					((int16_t)((uint16_t)(__VALUE__) ^ 0x8000U))
+
+
 /* Functions Prototypes --------------------------------------------------------------------  */
 HAL_StatusTypeDef          ADC_Init(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc);
 
 HAL_StatusTypeDef          ADC_InitMultimode(ADC_HandleTypeDef* hadcMaster, ADC_BufferTypeDef* badc);
 
+HAL_StatusTypeDef          ADC_BufferAssign(ADC_BufferTypeDef* badc, uint16_t* storage, uint16_t length, uint8_t measures);
+
+HAL_StatusTypeDef          ADC_BufferAssignPacked(ADC_BufferTypeDef* badc, uint8_t* storage, uint16_t length, uint8_t measures);
+
+HAL_StatusTypeDef          ADC_BufferAssignMultimode(ADC_BufferTypeDef* badc, uint32_t* storage, uint16_t length, uint8_t measures);
+
+HAL_StatusTypeDef          ADC_SetAveragedMeasures(ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, uint8_t measures);
+
 HAL_StatusTypeDef          ADC_ReadChannel(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef* cadc, ADC_BufferTypeDef* badc, uint8_t channel, uint16_t*  retval);
 
 __weak HAL_StatusTypeDef   ADC_GetValue(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef* cadc, ADC_BufferTypeDef* badc, float max, uint8_t channel, float * retval);
@@ -480,5 +1239,19 @@ HAL_StatusTypeDef          ADC_GetRank(ADC_ChannelsTypeDef *cadc, uint8_t channe
 
 HAL_StatusTypeDef          ADC_Averaging(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, uint8_t channel , uint16_t* retval);
 
+HAL_StatusTypeDef          ADC_Recover(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc);
+
+HAL_StatusTypeDef          ADC_Supervise(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc);
+
+HAL_StatusTypeDef          ADC_CheckOverrun(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc);
+
+HAL_StatusTypeDef          ADC_SetOversampling(ADC_HandleTypeDef* hadc, uint16_t ratio, uint8_t shift);
+
+HAL_StatusTypeDef          ADC_GetOversampling(ADC_HandleTypeDef* hadc, uint16_t* ratio, uint8_t* shift);
+
+HAL_StatusTypeDef          ADC_SetResolution(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, uint8_t bits);
+
+__weak void                ADC_BlockCpltCallback(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, uint16_t offset, uint16_t transfers);
+
 
 #endif /* INC_ADC_DRIVER_H_ */
@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************
+  * @file    adc_dsp.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Arithmetic kernels for ADC driver
+
+  * @brief   This file contains prototypes of summation, RMS and FIR kernels working on dense arrays of samples (ADC_HistoryWindow).
+  * 		 On cores with DSP extension (STM32_CORE_DSP) kernels process two 16-bit samples per instruction (SMLAD, SMLALD),
+  * 		 other cores use portable reference implementation. Kernels are selected at compile time.
+  ******************************************************************************
+  * @attention SIMD kernels treat samples as signed half-words and correct offset of MSB, so full 16-bit range (left-aligned data)
+  * 		   is accepted. ADC_DspFir accumulates in 32 bits and expects right-aligned data, ADC_DspFirQ15 consumes left-aligned data.
+  * 		   Sum of |coeffs| times the highest sample has to fit 31 bits, e.g. 16 full-scale taps of 12-bit data (Tests/test_dsp.c).
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_DSP_H_
+#define INC_ADC_DSP_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Private Macros ------------------------------------------------------------------- */
+#if defined(ADC_DSP_EMULATE)
+
+	/* Intrinsics emulated in C | allows building SIMD kernels on host to check equivalence with reference kernels ------ */
+	#define ADC_DSP_SIMD
+
+	#define __ADC_SMLAD(__X__, __Y__, __ACC__)																										\
+											((uint32_t)((int32_t)(__ACC__) + 																	\
+											 (int32_t)(int16_t)(__X__)         * (int32_t)(int16_t)(__Y__) + 									\
+											 (int32_t)(int16_t)((__X__) >> 16) * (int32_t)(int16_t)((__Y__) >> 16)))
+
+	#define __ADC_SMLALD(__X__, __Y__, __ACC__)																									\
+											((uint64_t)((int64_t)(__ACC__) + 																	\
+											 (int64_t)((int32_t)(int16_t)(__X__)         * (int32_t)(int16_t)(__Y__)) + 						\
+											 (int64_t)((int32_t)(int16_t)((__X__) >> 16) * (int32_t)(int16_t)((__Y__) >> 16))))
+
+	#define __ADC_PKHBT(__X__, __Y__, __SHIFT__)																									\
+											((((uint32_t)(__X__)) & 0x0000FFFFUL) | ((((uint32_t)(__Y__)) << (__SHIFT__)) & 0xFFFF0000UL))
+
+	#define __ADC_PKHTB(__X__, __Y__, __SHIFT__)																									\
+											((((uint32_t)(__X__)) & 0xFFFF0000UL) | ((((uint32_t)(__Y__)) >> (__SHIFT__)) & 0x0000FFFFUL))
+
+#elif defined(STM32_CORE_DSP)
+
+	/* Intrinsics of DSP extension of Cortex-M4/M7/M33 core --------------------------------------------------------------- */
+	#define ADC_DSP_SIMD
+
+	#define __ADC_SMLAD(__X__, __Y__, __ACC__)		(__SMLAD((__X__), (__Y__), (__ACC__)))
+
+	#define __ADC_SMLALD(__X__, __Y__, __ACC__)		(__SMLALD((__X__), (__Y__), (__ACC__)))
+
+	#define __ADC_PKHBT(__X__, __Y__, __SHIFT__)		(__PKHBT((__X__), (__Y__), (__SHIFT__)))
+
+	#define __ADC_PKHTB(__X__, __Y__, __SHIFT__)		(__PKHTB((__X__), (__Y__), (__SHIFT__)))
+
+#endif
+
+#define 			__ADC_DSP_PAIR(__PTR__)		(__UNALIGNED_UINT32_READ((__PTR__)))	// two following half-words | LDR supports unaligned access on M3/M4/M7
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+uint32_t                   ADC_DspSum(const uint16_t* x, uint16_t n);
+
+uint64_t                   ADC_DspSumSquares(const uint16_t* x, uint16_t n);
+
+uint16_t                   ADC_DspMean(const uint16_t* x, uint16_t n);
+
+uint16_t                   ADC_DspRms(const uint16_t* x, uint16_t n);
+
+int32_t                    ADC_DspFir(const int16_t* coeffs, const uint16_t* x, uint16_t taps);
+
+int16_t                    ADC_DspFirQ15(const int16_t* coeffs, const uint16_t* x, uint16_t taps);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_DSP_H_ */
@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file    adc_history.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Channel-major sample history for ADC driver
+
+  * @brief   This file contains typedefs, macros and prototypes of optional stage, which transposes rank-interleaved DMA blocks
+  * 		 into per-channel contiguous ring buffers. Filters, FFTs and statistics can work on dense arrays of one channel.
+  * 		 Each ring is stored twice (mirrored), so window of latest samples is always contiguous in memory.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_HISTORY_H_
+#define INC_ADC_HISTORY_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#define 			ADC_HISTORY_STORAGE_LENGTH(__CHANNELS__, __DEPTH__)	((__CHANNELS__) * 2 * (__DEPTH__))	// number of samples stored by history | every ring is mirrored
+
+/**
+  * @brief  Statically allocates channel-major history | __DEPTH__ has to be power of 2
+  * 		Example: ADC_HISTORY_DEFINE(hist1, 4, 64); -> 4 rings of 64 latest samples, 1024 bytes of storage
+  * 		Storage is read and written by CPU only, it is placed in CCM SRAM where present (__ADC_CPU_DATA)
+  */
+#define 			ADC_HISTORY_DEFINE(__NAME__, __CHANNELS__, __DEPTH__)																		\
+						static uint16_t __NAME__##_Storage[ADC_HISTORY_STORAGE_LENGTH((__CHANNELS__), (__DEPTH__))] __attribute__((aligned(4))) __ADC_CPU_DATA;	\
+						ADC_HistoryTypeDef __NAME__ = {																					\
+							.Storage  = __NAME__##_Storage,																				\
+							.Depth    = (__DEPTH__),																					\
+							.Channels = (__CHANNELS__)																					\
+						}
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Channel-major history typedef | ring of channel (rank) r starts at Storage[r * 2 * Depth]
+  */
+typedef struct{
+
+	uint16_t* Storage;							// storage of all rings | ADC_HISTORY_STORAGE_LENGTH(Channels, Depth) half-words, aligned to word
+
+	uint16_t  Depth;							// number of samples kept per channel | power of 2
+
+	uint8_t   Channels;							// number of converted channels (ranks) in DMA block
+
+	uint8_t   Rank;								// rank of next sample in interleaved stream | non-zero when block ended inside scan
+
+	uint16_t  Head;								// index of next written sample in every ring
+
+	uint32_t  Scans;							// number of complete scans pushed to history
+
+}ADC_HistoryTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_HistoryInit(ADC_HistoryTypeDef* hist, uint16_t* storage, uint8_t channels, uint16_t depth);
+
+HAL_StatusTypeDef          ADC_HistoryPush(ADC_HistoryTypeDef* hist, const uint16_t* block, uint16_t transfers);
+
+HAL_StatusTypeDef          ADC_HistoryPushMultimode(ADC_HistoryTypeDef* hist, const uint32_t* block, uint16_t transfers, uint8_t slave);
+
+const uint16_t*            ADC_HistoryWindow(ADC_HistoryTypeDef* hist, uint8_t rank, uint16_t samples);
+
+void                       ADC_HistoryReset(ADC_HistoryTypeDef* hist);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_HISTORY_H_ */
@@ -0,0 +1,113 @@
+/**
+  ******************************************************************************
+  * @file    adc_latency.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   End-to-end latency tracking for ADC driver
+
+  * @brief   This file contains typedefs, macros and prototypes of latency instrumentation from capture of DMA block to its consumer.
+  * 		 Block is stamped in DMA callback (ADC_LatencyCapture, or Stamp of scheduler event), every pipeline stage and
+  * 		 consumer read marks time elapsed since that stamp. Each stage keeps log2 histogram, min/mean/max and
+  * 		 deadline-miss counter. Statistics are exported as snapshots or as text for diagnostics output.
+  *
+  * 		 Example:
+  * 		 	ADC_BlockCpltCallback:  ADC_LatencyCapture(&lat);
+  * 		 	filter handler:         ADC_LatencyMark(&lat, 0, event->Stamp);
+  * 		 	control loop:           ADC_LatencyConsume(&lat, 1);
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_LATENCY_H_
+#define INC_ADC_LATENCY_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_scheduler.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#ifndef ADC_LATENCY_MAX_STAGES
+	#define 		ADC_LATENCY_MAX_STAGES	4				// number of tracked stages (including consumers)
+#endif
+
+#ifndef ADC_LATENCY_BINS
+	#define 		ADC_LATENCY_BINS		24				// bin k counts latencies in [2^(k-1), 2^k) cycles | last bin counts all above
+#endif
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Latency of one stage typedef | all times in cycles of latency clock
+  */
+typedef struct{
+
+	const char* Name;							// name of stage used in text export
+
+	uint32_t    Deadline;						// maximal allowed time since capture | 0: not checked
+
+	uint32_t    Count;							// number of marked blocks
+
+	uint32_t    Misses;							// number of blocks marked after deadline
+
+	uint32_t    Min;							// minimal latency
+
+	uint32_t    Max;							// maximal latency
+
+	uint64_t    Sum;							// sum of latencies
+
+	uint32_t    Bins[ADC_LATENCY_BINS];			// log2 histogram
+
+}ADC_LatencyStageTypeDef;
+
+/**
+  * @brief  Latency tracker typedef
+  */
+typedef struct{
+
+	ADC_LatencyStageTypeDef Stages[ADC_LATENCY_MAX_STAGES];
+
+	ADC_SchedClockTypeDef   Clock;				// time source | __ADC_CYCLES when NULL passed to init, should be the same as scheduler's
+
+	volatile uint32_t       LastCapture;		// stamp of latest captured block
+
+	volatile uint32_t       Captures;			// number of captured blocks
+
+}ADC_LatencyTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_LatencyInit(ADC_LatencyTypeDef* lat, ADC_SchedClockTypeDef clock);
+
+HAL_StatusTypeDef          ADC_LatencyConfigStage(ADC_LatencyTypeDef* lat, uint8_t stage, const char* name, uint32_t deadline);
+
+uint32_t                   ADC_LatencyCapture(ADC_LatencyTypeDef* lat);
+
+uint32_t                   ADC_LatencyMark(ADC_LatencyTypeDef* lat, uint8_t stage, uint32_t capture);
+
+uint32_t                   ADC_LatencyConsume(ADC_LatencyTypeDef* lat, uint8_t stage);
+
+HAL_StatusTypeDef          ADC_LatencyGetStage(ADC_LatencyTypeDef* lat, uint8_t stage, ADC_LatencyStageTypeDef* snapshot);
+
+uint32_t                   ADC_LatencyPercentile(const ADC_LatencyStageTypeDef* snapshot, uint16_t permille);
+
+void                       ADC_LatencyReset(ADC_LatencyTypeDef* lat);
+
+uint16_t                   ADC_LatencyFormat(ADC_LatencyTypeDef* lat, char* text, uint16_t size);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_LATENCY_H_ */
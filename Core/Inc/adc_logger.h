@@ -0,0 +1,167 @@
+/**
+  ******************************************************************************
+  * @file    adc_logger.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Circular trend logger to internal flash for ADC driver
+
+  * @brief   This file contains typedefs, macros and prototypes of optional stage, which downsamples rank-interleaved DMA
+  * 		 blocks into per-channel summaries (min, max, mean of interval) and keeps minutes of them in flash pages reserved
+  * 		 by linker script (region ADC_LOG), so trend before reset can be analysed post-mortem. Summaries are compressed
+  * 		 into page-sized batches in RAM: minimum as zigzag delta of previous minimum, maximum and mean as offsets above
+  * 		 minimum, all as variable length integers (1 byte for offsets below 128). Closed batches are queued and programmed
+  * 		 by ADC_LoggerProcess in small steps (one page erase or ADC_LOGGER_CHUNK half-words), so acquisition callbacks
+  * 		 only downsample and encode. Pages are written as a ring, the oldest page is overwritten.
+  *
+  * 		 Page: header (ADC_LOGGER_HEADER_SIZE bytes) + payload of records, all little endian.
+  * 		 	0  magic (ADC_LOGGER_MAGIC)          2  number of records           4  sequence of page (uint32)
+  * 		 	8  index of first interval (uint32)  12 channels                    14 length of payload [bytes]
+  * 		 	16 erase count of page (uint32)      20 scans per interval          22 CRC-16/CCITT of header and payload
+  * 		 Record: per channel varint(zigzag(min - previous min)), varint(max - min), varint(mean - min).
+  * 		 Previous minimum is 0 for the first record of page, so every page is decoded on its own (Tools/adc_log_extract.c).
+  ******************************************************************************
+  * @attention F1 flash is single bank: core stalls while page is erased (~20 ms) or half-word is programmed (~52 us) unless
+  * 		   it runs from RAM, DMA keeps transferring. DMA storage should hold more than 20 ms of conversions.
+  * 		   ADC_LOGGER_BASE and ADC_LOGGER_PAGES have to match region ADC_LOG of linker script.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_LOGGER_H_
+#define INC_ADC_LOGGER_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+#include "adc_store.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#ifndef 			ADC_LOGGER_BASE
+#define 			ADC_LOGGER_BASE				0x0801B000U		// first address of region ADC_LOG | 16 KB below ADC_STORE
+#endif
+
+#ifndef 			ADC_LOGGER_PAGES
+#define 			ADC_LOGGER_PAGES			16U				// pages of region ADC_LOG
+#endif
+
+#ifndef 			ADC_LOGGER_BATCHES
+#define 			ADC_LOGGER_BATCHES			2U				// page images in RAM | one is filled while others wait for programming
+#endif
+
+#ifndef 			ADC_LOGGER_CHUNK
+#define 			ADC_LOGGER_CHUNK			8U				// half-words programmed per ADC_LoggerProcess call | ~0.4 ms on F1
+#endif
+
+#define 			ADC_LOGGER_PAGE_SIZE		FLASH_PAGE_SIZE
+#define 			ADC_LOGGER_MAGIC			0x1A6CU			// marks programmed page
+#define 			ADC_LOGGER_HEADER_SIZE		24U
+#define 			ADC_LOGGER_PAYLOAD_SIZE		(ADC_LOGGER_PAGE_SIZE - ADC_LOGGER_HEADER_SIZE)
+#define 			ADC_LOGGER_RECORD_MAX(__CHANNELS__)	((__CHANNELS__) * 9U)	// worst case record | 3 varints of 17 bits per channel
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Page image typedef | payload of one page
+  */
+typedef struct{
+
+	uint8_t  Payload[ADC_LOGGER_PAYLOAD_SIZE];	// compressed records
+
+	uint32_t FirstInterval;						// index of first interval of page
+
+	uint16_t Length;							// used bytes of payload
+
+	uint16_t Records;							// number of records (intervals)
+
+	uint16_t PreviousMin[ADC_MAX_CHANNELS];	// minima of last record | base of delta of next one
+
+}ADC_LoggerBatchTypeDef;
+
+/**
+  * @brief  Logger states of background programming
+  */
+typedef enum{
+
+	ADC_LOGGER_IDLE    = 0,						// next step erases target page of queued image
+	ADC_LOGGER_PROGRAM = 1						// next steps program queued image
+
+}ADC_LoggerStateType;
+
+/**
+  * @brief  Flash logger typedef
+  */
+typedef struct{
+
+	ADC_LoggerBatchTypeDef Batches[ADC_LOGGER_BATCHES];	// ring of page images | Head is filled, Tail is programmed
+
+	volatile uint8_t Head;						// number of closed pages | written by acquisition context, free-running
+
+	volatile uint8_t Tail;						// number of programmed pages | written by ADC_LoggerProcess, free-running
+
+	uint8_t  Channels;							// number of converted channels (ranks) in DMA block
+
+	uint8_t  Rank;								// rank of next sample in interleaved stream
+
+	uint16_t Interval;							// scans summarised by one record
+
+	uint16_t Scans;								// scans of current interval
+
+	uint16_t Min[ADC_MAX_CHANNELS];			// accumulators of current interval
+
+	uint16_t Max[ADC_MAX_CHANNELS];
+
+	uint32_t Sum[ADC_MAX_CHANNELS];
+
+	uint32_t Intervals;							// index of next closed interval | continues after reset
+
+	uint8_t  State;								// ADC_LoggerStateType
+
+	uint8_t  Page;								// page receiving queued batch
+
+	uint16_t Position;							// next programmed half-word of page
+
+	uint16_t Header[ADC_LOGGER_HEADER_SIZE / 2U];	// header of programmed page
+
+	uint32_t Sequence;							// sequence of next programmed page
+
+	uint32_t Erases[ADC_LOGGER_PAGES];			// erase count of page | wear accounting
+
+	uint32_t Dropped;							// records lost because all page images were queued or page failed
+
+	uint32_t Errors;							// number of failed flash operations | page is skipped
+
+	uint32_t PagesWritten;						// number of programmed pages
+
+	uint32_t RawBytes;							// size of records without compression (3 half-words per channel)
+
+	uint32_t StoredBytes;						// size of compressed records
+
+}ADC_LoggerTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_LoggerInit(ADC_LoggerTypeDef* log, uint8_t channels, uint16_t interval);
+
+HAL_StatusTypeDef          ADC_LoggerPush(ADC_LoggerTypeDef* log, const uint16_t* block, uint16_t transfers);
+
+HAL_StatusTypeDef          ADC_LoggerFlush(ADC_LoggerTypeDef* log);
+
+uint8_t                    ADC_LoggerProcess(ADC_LoggerTypeDef* log);
+
+uint32_t                   ADC_LoggerWear(const ADC_LoggerTypeDef* log);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_LOGGER_H_ */
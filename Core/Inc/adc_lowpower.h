@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file    adc_lowpower.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Low-power acquisition loop for ADC driver
+
+  * @brief   This file contains typedefs and prototypes of event-driven acquisition loop. Core sleeps (WFI) until DMA completes
+  * 		 half of storage or other event is signalled, processes completed block and sleeps again.
+  * 		 Wake-up-to-process latency and duty cycle are measured with core cycle counter (__ADC_CYCLES).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_LOWPOWER_H_
+#define INC_ADC_LOWPOWER_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Block handler | called in thread context with completed part of DMA storage
+  */
+typedef void (*ADC_BlockHandlerTypeDef)(ADC_BufferTypeDef* badc, uint16_t offset, uint16_t transfers, void* arg);
+
+/**
+  * @brief  Low-power acquisition loop typedef
+  */
+typedef struct{
+
+	ADC_BufferTypeDef* badc;					// buffer of ADC with DMA | blocks are detected by HalfBlocks/FullBlocks counters
+
+	uint8_t            SuspendTick;				// 1: SysTick is suspended while sleeping, so only DMA and events wake core
+
+	volatile uint32_t  Events;					// events signalled by ADC_LowPowerSignal (e.g. from other interrupts)
+
+	uint32_t           SeenBlocks;				// HalfBlocks + FullBlocks processed or skipped so far
+
+	uint32_t           Processed;				// number of processed blocks
+
+	uint32_t           Missed;					// number of blocks overwritten before processing
+
+	uint32_t           Wakeups;					// number of wake-ups (including SysTick and other interrupts)
+
+	uint32_t           Latencies;				// number of blocks processed right after wake-up | latency samples
+
+	uint32_t           LatencyMax;				// maximal wake-up-to-process latency [cycles]
+
+	uint64_t           LatencySum;				// sum of wake-up-to-process latencies [cycles]
+
+	uint64_t           SleepCycles;				// cycles spent in WFI
+
+	uint64_t           ActiveCycles;			// cycles spent outside WFI
+
+	uint32_t           Stamp;					// cycle counter at end of last sleep | private
+
+}ADC_LowPowerTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_LowPowerInit(ADC_LowPowerTypeDef* lp, ADC_BufferTypeDef* badc, uint8_t suspendTick);
+
+HAL_StatusTypeDef          ADC_LowPowerWait(ADC_LowPowerTypeDef* lp, uint16_t* offset, uint16_t* transfers);
+
+void                       ADC_LowPowerRun(ADC_LowPowerTypeDef* lp, ADC_BlockHandlerTypeDef handler, void* arg);
+
+void                       ADC_LowPowerSignal(ADC_LowPowerTypeDef* lp);
+
+uint32_t                   ADC_LowPowerDutyCycle(const ADC_LowPowerTypeDef* lp);
+
+uint32_t                   ADC_LowPowerLatencyMean(const ADC_LowPowerTypeDef* lp);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_LOWPOWER_H_ */
@@ -0,0 +1,145 @@
+/**
+  ******************************************************************************
+  * @file    adc_modbus.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Modbus RTU slave serving ADC driver values
+
+  * @brief   This file contains typedefs, macros and prototypes of optional stage, which answers Modbus RTU requests (read
+  * 		 input registers, function 0x04) on UART with DMA reception ended by idle line and DMA transmission. Registers
+  * 		 are served from image refreshed by ADC_ModbusRefresh once per DMA block (ADC_BlockCpltCallback), so response is
+  * 		 built in UART interrupt by copying and its latency does not depend on averaging, scaling or number of channels.
+  * 		 Image is double buffered, refresh never tears registers of response being built.
+  *
+  * 		 Input registers (ADC_MODBUS_REG_x), 32-bit values are sent as two registers, high word first:
+  * 		 	0x0000 + rank  scaled averaged value of rank (ADC_InlineScaled * gain, saturated to 0 ... 0xFFFF)
+  * 		 	0x0010 + rank  averaged value of rank (ADC_InlineAveraged)
+  * 		 	0x0020         status flags (ADC_MODBUS_STATUS_x)       0x0021  number of converted channels (ranks)
+  * 		 	0x0022         completed DMA blocks (32-bit)            0x0024  DMA and ADC errors (32-bit)
+  * 		 	0x0026         overruns (32-bit)                        0x0028  image refreshes (32-bit)
+  * 		 	0x002A         served requests (32-bit)                 0x002C  frames with CRC error (32-bit)
+  ******************************************************************************
+  * @attention Frame end is detected by idle line (1 character) instead of 3.5 characters of RTU specification, UART of F1
+  * 		   has no receiver timeout. Master has to keep frame continuous, which all PLC masters do.
+  * 		   User has to call ADC_ModbusRxEvent, ADC_ModbusTxCplt and ADC_ModbusError from HAL_UARTEx_RxEventCallback,
+  * 		   HAL_UART_TxCpltCallback and HAL_UART_ErrorCallback, and serve USART and both DMA channel interrupts.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_MODBUS_H_
+#define INC_ADC_MODBUS_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+#include "adc_context.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#define 			ADC_MODBUS_FRAME_SIZE		256U			// longest RTU frame (address, PDU of 253 bytes, CRC)
+#define 			ADC_MODBUS_MAX_READ			125U			// registers of one read request
+
+// Input registers
+#define 			ADC_MODBUS_REG_SCALED		0x0000U
+#define 			ADC_MODBUS_REG_AVERAGED		0x0010U
+#define 			ADC_MODBUS_REG_STATUS		0x0020U
+#define 			ADC_MODBUS_REG_CHANNELS		0x0021U
+#define 			ADC_MODBUS_REG_BLOCKS		0x0022U
+#define 			ADC_MODBUS_REG_ERRORS		0x0024U
+#define 			ADC_MODBUS_REG_OVERRUNS		0x0026U
+#define 			ADC_MODBUS_REG_REFRESHES	0x0028U
+#define 			ADC_MODBUS_REG_REQUESTS		0x002AU
+#define 			ADC_MODBUS_REG_CRC_ERRORS	0x002CU
+#define 			ADC_MODBUS_REGISTERS		0x002EU			// size of register image
+
+// Status flags
+#define 			ADC_MODBUS_STATUS_VALID			0x0001U		// image holds converted values
+#define 			ADC_MODBUS_STATUS_DISCONTINUOUS	0x0002U		// acquisition was restarted since previous refresh
+#define 			ADC_MODBUS_STATUS_ERROR			0x0004U		// DMA, ADC error or overrun since previous refresh
+#define 			ADC_MODBUS_STATUS_SATURATED		0x0008U		// scaled value of some rank did not fit register
+
+// Function codes and exceptions
+#define 			ADC_MODBUS_READ_INPUT		0x04U
+#define 			ADC_MODBUS_ILLEGAL_FUNCTION	0x01U
+#define 			ADC_MODBUS_ILLEGAL_ADDRESS	0x02U
+#define 			ADC_MODBUS_ILLEGAL_VALUE	0x03U
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Modbus RTU slave typedef
+  */
+typedef struct{
+
+	UART_HandleTypeDef*       huart;			// UART with linked reception and transmission DMA channels
+
+	const ADC_ContextTypeDef* ctx;				// context of served ADC
+
+	GPIO_TypeDef*             DePort;			// driver enable of RS-485 transceiver | NULL if not used
+
+	uint16_t                  DePin;
+
+	uint8_t                   Address;			// slave address | 1 ... 247
+
+	float                     Gain;				// multiplies scaled value before rounding to register (e.g. 1000: mV)
+
+	uint16_t                  Image[2][ADC_MODBUS_REGISTERS];	// register images | one is served, other is refreshed
+
+	volatile uint8_t          Active;			// served image
+
+	uint8_t                   RxFrame[ADC_MODBUS_FRAME_SIZE];	// reception DMA buffer
+
+	uint8_t                   TxFrame[ADC_MODBUS_FRAME_SIZE];	// transmission DMA buffer
+
+	uint32_t                  LastErrors;		// counters of buffer at previous refresh | status flags
+
+	uint32_t                  LastOverruns;
+
+	volatile uint32_t         Refreshes;		// number of refreshed images
+
+	volatile uint32_t         Requests;			// number of answered requests (including exceptions)
+
+	volatile uint32_t         Exceptions;		// number of exception responses
+
+	volatile uint32_t         CrcErrors;		// number of frames with wrong CRC or shorter than 4 bytes
+
+	volatile uint32_t         Ignored;			// number of valid frames addressed to other slaves or broadcast
+
+	volatile uint32_t         UartErrors;		// number of UART errors (noise, framing, overrun) | reception is restarted
+
+}ADC_ModbusTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_ModbusInit(ADC_ModbusTypeDef* mb, UART_HandleTypeDef* huart, DMA_HandleTypeDef* hdmaRx, DMA_HandleTypeDef* hdmaTx,
+										  const ADC_ContextTypeDef* ctx, uint8_t address, float gain);
+
+HAL_StatusTypeDef          ADC_ModbusSetDriverEnable(ADC_ModbusTypeDef* mb, GPIO_TypeDef* port, uint16_t pin);
+
+HAL_StatusTypeDef          ADC_ModbusStart(ADC_ModbusTypeDef* mb);
+
+void                       ADC_ModbusRefresh(ADC_ModbusTypeDef* mb);
+
+void                       ADC_ModbusRxEvent(ADC_ModbusTypeDef* mb, UART_HandleTypeDef* huart, uint16_t size);
+
+void                       ADC_ModbusTxCplt(ADC_ModbusTypeDef* mb, UART_HandleTypeDef* huart);
+
+void                       ADC_ModbusError(ADC_ModbusTypeDef* mb, UART_HandleTypeDef* huart);
+
+uint16_t                   ADC_ModbusCrc(const uint8_t* data, uint16_t length);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_MODBUS_H_ */
@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * @file    adc_pool.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Static fixed-size block pools for driver objects
+
+  * @brief   This file contains typedefs, macros and prototypes of pools, which hand out fixed-size blocks of static storage
+  * 		 for objects created at runtime (contexts, histories and their storage, stages). Capacity is set at compile time
+  * 		 by ADC_POOL_DEFINE, allocation and release are O(1) (free list of block indexes), blocks never fragment and heap
+  * 		 (_sbrk) is not used. Every pool keeps number of used blocks, its high-water mark and failed allocations,
+  * 		 ADC_PoolFormat reports all pools used so far.
+  *
+  * 		 Example: ADC_POOL_DEFINE(ctxPool, ADC_ContextTypeDef, 2);                      -> 2 contexts
+  * 		 		  ADC_POOL_DEFINE_BLOCKS(capPool, ADC_HISTORY_STORAGE_LENGTH(4, 64) * 2U, 2); -> 2 capture storages
+  * 		 		  ADC_ContextTypeDef* ctx = ADC_PoolAlloc(&ctxPool);
+  * 		 Contexts have built-in pool of ADC_CONTEXT_POOL_SIZE blocks (ADC_ContextCreate, adc_context.c).
+  ******************************************************************************
+  * @attention Blocks are not cleared, init functions of stages initialize their objects. Storage of ADC_POOL_DEFINE macros
+  * 		   is placed in .noinit (__ADC_NOINIT), so large pools do not lengthen zeroing of .bss at startup.
+  * 		   Allocation and release can be called from interrupts, they mask interrupts for a few instructions.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_POOL_H_
+#define INC_ADC_POOL_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#define 			ADC_POOL_NONE				0xFFFFU			// end of free list
+#define 			ADC_POOL_IN_USE				0xFFFEU			// link of allocated block | detects double release
+#define 			ADC_POOL_MAX_CAPACITY		0xFFFDU
+
+/**
+  * @brief  Statically allocates pool of __CAPACITY__ objects of __TYPE__ | storage keeps alignment of type
+  */
+#define 			ADC_POOL_DEFINE(__NAME__, __TYPE__, __CAPACITY__)																			\
+						static __TYPE__ __NAME__##_Storage[(__CAPACITY__)] __ADC_NOINIT;														\
+						static uint16_t __NAME__##_Next[(__CAPACITY__)] __ADC_NOINIT;														\
+						ADC_PoolTypeDef __NAME__ = {																						\
+							.Storage   = (uint8_t*)__NAME__##_Storage,																		\
+							.Next      = __NAME__##_Next,																					\
+							.Name      = #__NAME__,																							\
+							.BlockSize = sizeof(__TYPE__),																					\
+							.Capacity  = (__CAPACITY__),																					\
+							.FreeHead  = ADC_POOL_NONE																						\
+						}
+
+/**
+  * @brief  Statically allocates pool of __CAPACITY__ raw blocks of __SIZE__ bytes | blocks are aligned to 8 bytes (DMA, uint64_t)
+  */
+#define 			ADC_POOL_DEFINE_BLOCKS(__NAME__, __SIZE__, __CAPACITY__)																	\
+						static uint64_t __NAME__##_Storage[(__CAPACITY__) * (((__SIZE__) + 7U) / 8U)] __ADC_NOINIT;						\
+						static uint16_t __NAME__##_Next[(__CAPACITY__)] __ADC_NOINIT;														\
+						ADC_PoolTypeDef __NAME__ = {																						\
+							.Storage   = (uint8_t*)__NAME__##_Storage,																		\
+							.Next      = __NAME__##_Next,																					\
+							.Name      = #__NAME__,																							\
+							.BlockSize = (((__SIZE__) + 7U) / 8U) * 8U,																		\
+							.Capacity  = (__CAPACITY__),																					\
+							.FreeHead  = ADC_POOL_NONE																						\
+						}
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Fixed-size block pool typedef | blocks Fresh ... Capacity - 1 were never allocated, released blocks form free list
+  */
+typedef struct ADC_PoolTypeDef{
+
+	uint8_t*                Storage;				// Capacity blocks of BlockSize bytes
+
+	uint16_t*               Next;					// free list links (index of next free block) | ADC_POOL_IN_USE for allocated blocks
+
+	const char*             Name;					// name in reports | name of pool variable for ADC_POOL_DEFINE
+
+	struct ADC_PoolTypeDef* Link;					// next pool of report list
+
+	uint16_t                BlockSize;				// [bytes]
+
+	uint16_t                Capacity;				// number of blocks
+
+	uint16_t                Fresh;					// number of blocks taken from storage at least once
+
+	uint16_t                FreeHead;				// first released block | ADC_POOL_NONE if none
+
+	uint16_t                Used;					// number of allocated blocks
+
+	uint16_t                Peak;					// high-water mark of Used | sizing of capacity
+
+	uint32_t                Failures;				// number of allocations from exhausted pool
+
+	uint8_t                 Listed;					// 1: pool is in report list
+
+}ADC_PoolTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_PoolInit(ADC_PoolTypeDef* pool, void* storage, uint16_t* next, uint16_t blockSize, uint16_t capacity, const char* name);
+
+void*                      ADC_PoolAlloc(ADC_PoolTypeDef* pool);
+
+HAL_StatusTypeDef          ADC_PoolFree(ADC_PoolTypeDef* pool, void* block);
+
+uint16_t                   ADC_PoolFormat(char* text, uint16_t size);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_POOL_H_ */
@@ -0,0 +1,184 @@
+/**
+  ******************************************************************************
+  * @file    adc_scheduler.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Cooperative run-to-completion scheduler for ADC driver
+
+  * @brief   This file contains typedefs, macros and prototypes of small event scheduler, which replaces superloop processing.
+  * 		 Interrupt callbacks (DMA half/full, analog watchdog, timers) post events to prioritised queues, handlers run
+  * 		 to completion in thread context. Every handler has cycle budget, overruns of budget are counted.
+  * 		 All memory is allocated statically inside scheduler structure. Time source is selectable, so scheduler
+  * 		 can be run on host with virtual time.
+  *
+  * 		 Example:
+  * 		 	void ADC_BlockCpltCallback(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, uint16_t offset, uint16_t transfers){
+  * 		 		ADC_SchedPost(&sched, filterId, (offset == 0) ? ADC_EVENT_HALF : ADC_EVENT_FULL, badc, offset, transfers);
+  * 		 	}
+  * 		 	void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef* hadc){
+  * 		 		ADC_SchedPost(&sched, alarmId, ADC_EVENT_AWD, hadc, 0, 0);
+  * 		 	}
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_SCHEDULER_H_
+#define INC_ADC_SCHEDULER_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#ifndef ADC_SCHED_PRIORITIES
+	#define 		ADC_SCHED_PRIORITIES	3				// number of priority levels | 0 is the highest
+#endif
+
+#ifndef ADC_SCHED_QUEUE_LENGTH
+	#define 		ADC_SCHED_QUEUE_LENGTH	8				// number of events per priority queue | power of 2
+#endif
+
+#ifndef ADC_SCHED_MAX_HANDLERS
+	#define 		ADC_SCHED_MAX_HANDLERS	8				// number of registered handlers
+#endif
+
+#if (ADC_SCHED_QUEUE_LENGTH & (ADC_SCHED_QUEUE_LENGTH - 1)) != 0
+	#error "ADC_SCHED_QUEUE_LENGTH has to be power of 2"
+#endif
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Event types
+  */
+typedef enum{
+
+	ADC_EVENT_HALF  = 0,						// first half of DMA storage completed
+	ADC_EVENT_FULL  = 1,						// second half of DMA storage completed
+	ADC_EVENT_AWD   = 2,						// analog watchdog out of window
+	ADC_EVENT_TIMER = 3,						// timer period elapsed
+	ADC_EVENT_USER  = 4							// application defined
+
+}ADC_EventType;
+
+/**
+  * @brief  Event typedef | copied into queue by value
+  */
+typedef struct{
+
+	void*    Source;							// posting object (buffer, ADC handle, timer handle)
+
+	uint32_t Stamp;								// time of post [cycles of scheduler clock]
+
+	uint16_t Offset;							// offset of completed block in DMA storage [transfers]
+
+	uint16_t Transfers;							// number of transfers in completed block
+
+	uint8_t  Handler;							// id of handler returned by ADC_SchedRegister
+
+	uint8_t  Type;								// ADC_EventType
+
+}ADC_EventTypeDef;
+
+/**
+  * @brief  Event handler | runs to completion in thread context
+  */
+typedef void (*ADC_EventHandlerTypeDef)(const ADC_EventTypeDef* event, void* arg);
+
+/**
+  * @brief  Scheduler clock | returns free-running 32-bit time, e.g. virtual time on host
+  */
+typedef uint32_t (*ADC_SchedClockTypeDef)(void);
+
+/**
+  * @brief  Registered handler typedef
+  */
+typedef struct{
+
+	ADC_EventHandlerTypeDef Function;			// handler function
+
+	void*    Arg;								// argument passed to handler
+
+	uint32_t Budget;							// maximal execution time [cycles] | 0: unlimited
+
+	uint32_t Runs;								// number of executions
+
+	uint32_t Overruns;							// number of executions above budget
+
+	uint32_t CyclesLast;						// execution time of last run [cycles]
+
+	uint32_t CyclesMax;							// maximal execution time [cycles]
+
+	uint8_t  Priority;							// queue of handler's events | 0 is the highest
+
+}ADC_SchedHandlerTypeDef;
+
+/**
+  * @brief  Priority queue typedef | ring of events, Head and Tail are free-running
+  */
+typedef struct{
+
+	ADC_EventTypeDef  Events[ADC_SCHED_QUEUE_LENGTH];
+
+	volatile uint16_t Head;						// written by posting context
+
+	volatile uint16_t Tail;						// written by dispatching context
+
+	uint16_t          HighWater;				// maximal number of queued events
+
+	uint32_t          Dropped;					// number of events posted to full queue
+
+}ADC_SchedQueueTypeDef;
+
+/**
+  * @brief  Scheduler typedef
+  */
+typedef struct{
+
+	ADC_SchedHandlerTypeDef Handlers[ADC_SCHED_MAX_HANDLERS];
+
+	ADC_SchedQueueTypeDef   Queues[ADC_SCHED_PRIORITIES];
+
+	ADC_SchedClockTypeDef   Clock;				// time source | __ADC_CYCLES when NULL passed to init
+
+	uint32_t                Dispatched;			// number of dispatched events
+
+	uint8_t                 NbrOfHandlers;		// number of registered handlers
+
+}ADC_SchedTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_SchedInit(ADC_SchedTypeDef* sched, ADC_SchedClockTypeDef clock);
+
+HAL_StatusTypeDef          ADC_SchedRegister(ADC_SchedTypeDef* sched, ADC_EventHandlerTypeDef function, void* arg, uint8_t priority, uint32_t budget, uint8_t* id);
+
+HAL_StatusTypeDef          ADC_SchedPost(ADC_SchedTypeDef* sched, uint8_t id, ADC_EventType type, void* source, uint16_t offset, uint16_t transfers);
+
+uint8_t                    ADC_SchedRunOnce(ADC_SchedTypeDef* sched);
+
+void                       ADC_SchedRun(ADC_SchedTypeDef* sched);
+
+uint16_t                   ADC_SchedPending(ADC_SchedTypeDef* sched);
+
+__weak void                ADC_SchedIdleCallback(ADC_SchedTypeDef* sched);
+
+__weak void                ADC_SchedOverrunCallback(ADC_SchedTypeDef* sched, uint8_t id, uint32_t cycles);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_SCHEDULER_H_ */
@@ -0,0 +1,177 @@
+/**
+  ******************************************************************************
+  * @file    adc_shell.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Command shell over UART for ADC driver tuning and diagnostics
+
+  * @brief   This file contains typedefs, macros and prototypes of optional stage, which serves line-oriented commands on
+  * 		 UART. Bytes are received by circular DMA to RX ring without interrupts, responses are written to console
+  * 		 (adc_console.h) of the same UART, so shell, printf and log macros share one transmission path. Lines are
+  * 		 parsed and executed only by ADC_ShellProcess called from main loop (or scheduler handler), so acquisition is
+  * 		 never stalled. Output never blocks: text, which does not fit console ring, is dropped and counted. Long dumps
+  * 		 (trace, capture) are streamed over following ADC_ShellProcess calls, as console ring drains.
+  *
+  * 		 Commands:
+  * 		 	help                    list of commands
+  * 		 	ch                      channels: rank, averaged value, scaled value [mV], sampling time code
+  * 		 	stats                   buffer and shell counters, latency of stages (if attached), pools
+  * 		 	trace <rank> [n]        latest n samples of rank from history (if attached)
+  * 		 	cap <scans>             captures next scans of all ranks from history and dumps them
+  * 		 	avg <measures>          averaging depth (ADC_SetAveragedMeasures)
+  * 		 	smp <channel> <code>    sampling time code (SMPx) of channel
+  * 		 	os <ratio> <shift>      hardware oversampler (ADC_SetOversampling) | G4, L4, H7
+  * 		 	res <bits>              resolution (ADC_SetResolution), context is rescaled | F2, F3, F4, G4, L4, H7
+  * 		 	save                    persists configuration through ADC_ShellStoreCallback
+  ******************************************************************************
+  * @attention Reception is restarted by ADC_ShellProcess after UART error. Console has to be initialized on the same UART
+  * 		   (ADC_ConsoleInit) before ADC_ShellInit, transmission needs its interrupts and callbacks, reception needs none.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_SHELL_H_
+#define INC_ADC_SHELL_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+#include "adc_context.h"
+#include "adc_console.h"
+#include "adc_history.h"
+#include "adc_latency.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#ifndef 			ADC_SHELL_RX_SIZE
+#define 			ADC_SHELL_RX_SIZE			128U			// RX ring [bytes] | holds input between ADC_ShellProcess calls
+#endif
+
+#ifndef 			ADC_SHELL_LINE_SIZE
+#define 			ADC_SHELL_LINE_SIZE			64U				// longest command line
+#endif
+
+#ifndef 			ADC_SHELL_TEXT_SIZE
+#define 			ADC_SHELL_TEXT_SIZE			256U			// longest formatted output (e.g. latency of all stages)
+#endif
+
+#ifndef 			ADC_SHELL_CAPTURE_SIZE
+#define 			ADC_SHELL_CAPTURE_SIZE		256U			// samples of trace or capture snapshot
+#endif
+
+#define 			ADC_SHELL_MAGIC				0x53484C31U		// "SHL1" | marks valid configuration
+#define 			ADC_SHELL_NO_CODE			0xFFU			// sampling time code of channel, which is not converted
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Persisted configuration typedef | plain data, stored and loaded as a whole
+  */
+typedef struct{
+
+	uint32_t Magic;										// ADC_SHELL_MAGIC if configuration is valid
+
+	uint8_t  AveragedMeasures;							// averaging depth
+
+	uint8_t  Bits;										// resolution set by res command | 0: default resolution
+
+	uint8_t  Shift;										// oversampler shift | used if Ratio is not 0
+
+	uint8_t  Reserved;
+
+	uint16_t Ratio;										// oversampler ratio | 0: oversampler is not configured
+
+	uint8_t  Code[ADC_CONTEXT_CHANNELS];				// sampling time code of channel | ADC_SHELL_NO_CODE if channel is not converted
+
+}ADC_ShellConfigTypeDef;
+
+/**
+  * @brief  Command shell typedef
+  */
+typedef struct{
+
+	UART_HandleTypeDef*  huart;					// UART with linked reception DMA channel (circular)
+
+	ADC_ConsoleTypeDef*  con;					// console of the same UART | output of shell
+
+	ADC_HandleTypeDef*   hadc;					// served ADC
+
+	ADC_BufferTypeDef*   badc;
+
+	ADC_ChannelsTypeDef* cadc;
+
+	ADC_ContextTypeDef*  ctx;					// context of served ADC | rescaled by res command
+
+	ADC_HistoryTypeDef*  hist;					// history of samples (trace, cap) | NULL if not attached
+
+	ADC_LatencyTypeDef*  lat;					// latency statistics (stats) | NULL if not attached
+
+	uint8_t  RxRing[ADC_SHELL_RX_SIZE];			// written by circular DMA
+
+	uint16_t RxTail;							// next read byte of RX ring
+
+	char     Line[ADC_SHELL_LINE_SIZE];			// line being edited
+
+	uint8_t  LineLength;
+
+	uint8_t  LineOverflow;						// 1: line is longer than buffer, it is dropped at end of line
+
+	char     Text[ADC_SHELL_TEXT_SIZE];			// formatting buffer
+
+	uint16_t Capture[ADC_SHELL_CAPTURE_SIZE];	// snapshot of dumped samples | rank-major
+
+	uint8_t  DumpRanks;							// ranks of snapshot | 0: no dump in progress
+
+	uint8_t  DumpFirst;							// rank of first column
+
+	uint16_t DumpScans;							// scans of snapshot
+
+	uint16_t DumpIndex;							// next dumped scan
+
+	uint16_t CaptureScans;						// scans of armed capture | 0: capture is not armed
+
+	uint32_t CaptureStart;						// scans of history when capture was armed
+
+	uint8_t  Bits;								// resolution set by res command | 0: default
+
+	uint32_t Commands;							// number of executed commands
+
+	uint32_t Dropped;							// number of output bytes, which did not fit console ring
+
+	uint32_t RxRestarts;						// number of reception restarts after UART error
+
+}ADC_ShellTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_ShellInit(ADC_ShellTypeDef* shell, UART_HandleTypeDef* huart, DMA_HandleTypeDef* hdmaRx, ADC_ConsoleTypeDef* con,
+										 ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, ADC_ContextTypeDef* ctx);
+
+HAL_StatusTypeDef          ADC_ShellAttach(ADC_ShellTypeDef* shell, ADC_HistoryTypeDef* hist, ADC_LatencyTypeDef* lat);
+
+HAL_StatusTypeDef          ADC_ShellStart(ADC_ShellTypeDef* shell);
+
+void                       ADC_ShellProcess(ADC_ShellTypeDef* shell);
+
+HAL_StatusTypeDef          ADC_ShellLoad(ADC_ShellTypeDef* shell);
+
+uint16_t                   ADC_ShellPrint(ADC_ShellTypeDef* shell, const char* format, ...);
+
+__weak HAL_StatusTypeDef   ADC_ShellLoadCallback(ADC_ShellTypeDef* shell, ADC_ShellConfigTypeDef* config);
+
+__weak HAL_StatusTypeDef   ADC_ShellStoreCallback(ADC_ShellTypeDef* shell, const ADC_ShellConfigTypeDef* config);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_SHELL_H_ */
@@ -0,0 +1,373 @@
+/**
+  ******************************************************************************
+  * @file    adc_sim.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Virtual-time simulation of ADC and DMA for host builds
+
+  * @brief   This file contains typedefs and prototypes of deterministic simulation of F1 ADC1/ADC2 and DMA1 Channel 1.
+  * 		 Driver is compiled unchanged for host with ADC_SIM defined: peripheral instances (ADC1, ADC2, DMA1, DMA1_ChannelX)
+  * 		 are remapped to simulated registers, HAL ADC/DMA functions are provided by simulation and __ADC_CYCLES returns
+  * 		 virtual time. Time is counted in core clock cycles. Conversion time is derived from SMPR1/SMPR2 sampling time
+  * 		 and ADC clock divider, DMA transfers update CNDTR and storage, half/full interrupts are delivered with configurable
+  * 		 latency, like HAL DMA interrupt handler does. Faults (DMA error, overrun, calibration failure, stuck conversion)
+  * 		 are injected at chosen times or randomly with seed, recovery time and throughput loss are reported per fault type.
+  * 		 Spare DMA channel of de-interleaving is modelled in memory-to-memory mode with PSIZE/MSIZE truncation.
+  * 		 Hardware oversampler of G4/L4/H7 (ratio, shift) is modelled per ADC: each rank accumulates ratio conversions.
+  * 		 Resolution of F2/F3/F4 (12, 10, 8, 6 bits) is modelled per ADC: conversions are truncated, left alignment follows F4.
+  * 		 Settling of sampling capacitor is modelled per channel with RC time constant of source: sample moves from value held
+  * 		 after previous conversion towards input by 1 - exp(-sampling time / Tau).
+  * 		 Window of flash holding reserved regions of linker script is emulated with NOR semantics (half-word programming
+  * 		 of erased cells only, page erase) and program/erase times; power loss tears chosen operation and fails following ones.
+  *
+  * 		 Example:
+  * 		 	ADC_SimInit(&sim, 6);                              // ADC clock = 72 MHz / 6
+  * 		 	ADC1->SQR1 = ...; ADC1->SMPR2 = ...; ADC1->CR1 = ADC_CR1_SCAN; ADC1->CR2 = ADC_CR2_CONT;
+  * 		 	ADC_Init(&hadc1, &badc1, &cadc1);
+  * 		 	ADC_SimRun(&sim, 72000000ULL * 3600U, 72000U, consumer, NULL);	// one hour, consumer every 1 ms
+  ******************************************************************************
+  * @attention Host only | adc_lowpower.c uses WFI and is not part of simulated build
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_SIM_H_
+#define INC_ADC_SIM_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "main.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#define 			ADC_SIM_CHANNELS		18				// analog inputs of F1 ADC (16 external, temperature, VREFINT)
+
+#define 			ADC_SIM_NEVER			UINT64_MAX		// time of event which is not scheduled
+
+// Peripheral instances remapped to simulated registers
+#undef 	ADC1
+#undef 	ADC2
+#undef 	ADC12_COMMON
+#undef 	DMA1
+#undef 	DMA1_Channel1
+#undef 	DMA1_Channel2
+#undef 	DMA1_Channel3
+#undef 	DMA1_Channel4
+#undef 	DMA1_Channel5
+#undef 	DMA1_Channel6
+#undef 	DMA1_Channel7
+
+#define 			ADC1					(&ADC_SimRegs.Adc[0])
+#define 			ADC2					(&ADC_SimRegs.Adc[1])
+#define 			ADC12_COMMON			((ADC_Common_TypeDef*)&ADC_SimRegs.Adc[0])
+#define 			DMA1					(&ADC_SimRegs.Dma)
+#define 			DMA1_Channel1			(&ADC_SimRegs.Channel[0])
+#define 			DMA1_Channel2			(&ADC_SimRegs.Channel[1])
+#define 			DMA1_Channel3			(&ADC_SimRegs.Channel[2])
+#define 			DMA1_Channel4			(&ADC_SimRegs.Channel[3])
+#define 			DMA1_Channel5			(&ADC_SimRegs.Channel[4])
+#define 			DMA1_Channel6			(&ADC_SimRegs.Channel[5])
+#define 			DMA1_Channel7			(&ADC_SimRegs.Channel[6])
+
+// Virtual time and interrupt masking | interrupts are delivered only inside ADC_SimAdvance, so driver code runs atomically
+#define 			__ADC_CYCLES()			ADC_SimCycles()
+#define 			__ADC_CYCLES_ENABLE()	((void)0)
+#define 			__ADC_CRITICAL_ENTER()	do{}while(0)
+#define 			__ADC_CRITICAL_EXIT()	do{}while(0)
+#define 			__ADC_CRITICAL_YIELD()	do{}while(0)
+
+// Overrun flag of F2/F3/F4 modelled on F1 registers
+#define 			__ADC_IS_OVERRUN(__HANDLE__)		ADC_SimIsOverrun((__HANDLE__)->Instance)
+#define 			__ADC_CLEAR_OVERRUN(__HANDLE__)		ADC_SimClearOverrun((__HANDLE__)->Instance)
+
+// Hardware oversampler of G4/L4/H7 modelled on F1 registers | limits of G4/L4 unless build selects H7 limits
+#define 			ADC_HW_OVERSAMPLER								1
+#define 			__ADC_OVERSAMPLING_SET(__HANDLE__, __RATIO__, __SHIFT__)	ADC_SimSetOversampling((__HANDLE__)->Instance, (__RATIO__), (__SHIFT__))
+#define 			__ADC_OVERSAMPLING_RATIO(__HANDLE__)			ADC_SimOversamplingRatio((__HANDLE__)->Instance)
+#define 			__ADC_OVERSAMPLING_SHIFT(__HANDLE__)			ADC_SimOversamplingShift((__HANDLE__)->Instance)
+
+// Resolution of F2/F3/F4 modelled on F1 registers | left-aligned 6-bit data is aligned to byte
+#define 			__ADC_RESOLUTION(__HANDLE__)					ADC_SimResolution((__HANDLE__)->Instance)
+#define 			__ADC_SET_RESOLUTION(__HANDLE__, __BITS__)		ADC_SimSetResolution((__HANDLE__)->Instance, (__BITS__))
+#define 			__ADC_ALIGNED_SHIFT(__HANDLE__, __BITS__)		((READ_BIT((__HANDLE__)->Instance->CR2, ADC_CR2_ALIGN) != 0U) ? (((__BITS__) == 6U) ? 2U : (16U - (__BITS__))) : 0U)
+#define 			__ADC_DATA_SHIFT(__HANDLE__)					(__ADC_ALIGNED_SHIFT((__HANDLE__), ADC_SimResolutionBits((__HANDLE__)->Instance)))
+
+// Spare DMA channel of de-interleaving modelled in memory-to-memory mode | started with host pointers, CPAR/CMAR cannot hold them
+#define 			__ADC_DMA_START_COPY(__DMA__, __SRC__, __DST__, __LENGTH__)	ADC_SimStartCopy((__DMA__), (__SRC__), (__DST__), (__LENGTH__))
+#define 			ADC_SIM_COPY_CYCLES				5U				// core clock cycles per memory-to-memory transfer (estimate)
+
+// Emulated flash | reads of reserved regions are remapped to emulated window
+#define 			ADC_SIM_FLASH_BASE				0x0801B000U		// last 20 KB of 128 KB device | covers reserved regions of linker script
+#define 			ADC_SIM_FLASH_SIZE				0x5000U
+#define 			ADC_SIM_FLASH_PAGES				(ADC_SIM_FLASH_SIZE / FLASH_PAGE_SIZE)
+#define 			ADC_SIM_FLASH_PROGRAM_CYCLES	(52U * 72U)		// half-word programming time of F1 (52 us at 72 MHz)
+#define 			ADC_SIM_FLASH_ERASE_CYCLES		(20U * 72000U)	// page erase time of F1 (20 ms at 72 MHz)
+
+#define 			__ADC_FLASH_READ16(__ADDRESS__)					ADC_SimFlashRead16((__ADDRESS__))
+
+#ifndef 			ADC_OVERSAMPLING_MAX_RATIO
+#define 			ADC_OVERSAMPLING_MAX_RATIO		256U			// H7: 1024U
+#define 			ADC_OVERSAMPLING_MAX_SHIFT		8U				// H7: 11U
+#define 			ADC_OVERSAMPLING_POW2			1				// H7: 0
+#endif
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Simulated registers
+  */
+typedef struct{
+
+	ADC_TypeDef         Adc[2];					// ADC1, ADC2
+
+	DMA_TypeDef         Dma;					// DMA1 flags
+
+	DMA_Channel_TypeDef Channel[7];				// DMA1 channels | Channel 1 serves ADC1
+
+}ADC_SimRegsTypeDef;
+
+/**
+  * @brief  Analog signal | returns converted value of channel at given time
+  */
+typedef uint16_t (*ADC_SimSignalTypeDef)(uint8_t adc, uint8_t channel, uint64_t time, void* arg);
+
+/**
+  * @brief  Consumer | runs at virtual time of call, returns its execution time [cycles], during which DMA keeps transferring
+  */
+typedef uint32_t (*ADC_SimConsumerTypeDef)(void* arg);
+
+/**
+  * @brief  Injected fault types
+  */
+typedef enum{
+
+	ADC_SIM_FAULT_DMA_ERROR   = 0,				// DMA transfer error | channel disabled by hardware, HAL error callback
+	ADC_SIM_FAULT_OVR         = 1,				// ADC overrun | conversions and DMA requests stop until OVR is cleared (F2/F3/F4 behaviour)
+	ADC_SIM_FAULT_CALIBRATION = 2,				// next HAL_ADCEx_Calibration_Start fails
+	ADC_SIM_FAULT_STUCK       = 3,				// conversion in progress never ends until ADC is stopped
+	ADC_SIM_FAULTS            = 4
+
+}ADC_SimFaultType;
+
+/**
+  * @brief  Fault injection and recovery statistics typedef | fault is recovered by first DMA transfer after it
+  */
+typedef struct{
+
+	uint64_t Next;								// time of next injection | ADC_SIM_NEVER if not scheduled
+
+	uint64_t MeanInterval;						// mean interval of random injections [cycles] | 0: one-shot
+
+	uint64_t Start;								// time of oldest unrecovered injection
+
+	uint64_t Blackout;							// sum of recovery times | time without transferred data [cycles]
+
+	uint64_t RecoveryMax;						// maximal recovery time [cycles]
+
+	uint64_t Lost;								// conversions not transferred while fault was active
+
+	uint32_t Injected;							// number of injections
+
+	uint32_t Recovered;							// number of recoveries
+
+	uint8_t  Active;							// 1: fault is not recovered yet
+
+}ADC_SimFaultTypeDef;
+
+/**
+  * @brief  Simulated ADC typedef
+  */
+typedef struct{
+
+	ADC_HandleTypeDef*   hadc;					// handle passed to HAL start functions | used for callbacks
+
+	ADC_SimSignalTypeDef Signal;				// analog signal | NULL: constant Level of channel
+
+	void*                SignalArg;				// argument passed to signal
+
+	uint16_t             Level[ADC_SIM_CHANNELS];	// constant converted values
+
+	float                Tau[ADC_SIM_CHANNELS];	// RC time constant of source and sampling capacitor [ADC clock cycles] | 0: ideal source
+
+	float                Held;					// value held by sampling capacitor after previous conversion
+
+	uint32_t             TriggerPeriod;			// external trigger period [cycles] | 0: software start or continuous mode
+
+	uint64_t             NextTrigger;			// time of next external trigger
+
+	uint64_t             ConvEnd;				// time of end of conversion in progress
+
+	uint64_t             Conversions;			// number of completed conversions
+
+	uint16_t             OversamplingRatio;		// conversions accumulated per rank | 0 or 1: oversampler disabled
+
+	uint8_t              OversamplingShift;		// right shift of accumulated sum
+
+	uint8_t              Resolution;			// bits of converted value | 0: 12 bits
+
+	uint8_t              Rank;					// rank of conversion in progress
+
+	uint8_t              Busy;					// 1: scan in progress
+
+}ADC_SimAdcTypeDef;
+
+/**
+  * @brief  Emulated flash typedef | window of ADC_SIM_FLASH_SIZE bytes at ADC_SIM_FLASH_BASE
+  */
+typedef struct{
+
+	uint8_t  Memory[ADC_SIM_FLASH_SIZE];		// content of flash | 0xFF when erased
+
+	uint32_t Erases[ADC_SIM_FLASH_PAGES];		// number of erases of page | wear
+
+	uint64_t Programs;							// number of programmed half-words
+
+	uint32_t PowerLossAfter;					// operations (half-word programs, page erases) until power loss | 0: no power loss scheduled
+
+	uint8_t  PowerLost;							// 1: operation was torn, following operations fail until ADC_SimFlashPowerUp
+
+	uint8_t  Locked;							// 1: flash control register is locked (HAL_FLASH_Lock)
+
+}ADC_SimFlashTypeDef;
+
+/**
+  * @brief  Simulated DMA channel typedef
+  */
+typedef struct{
+
+	DMA_Channel_TypeDef* Channel;				// registers of channel serving ADC1 | DMA1_Channel1
+
+	void*    Memory;							// storage latched by HAL start function | CMAR cannot hold host pointer
+
+	uint16_t Reload;							// number of transfers latched when channel is enabled
+
+	uint8_t  Enabled;							// channel enable latched by simulation
+
+	uint64_t HalfDue;							// delivery time of pending half transfer interrupt
+
+	uint64_t FullDue;							// delivery time of pending transfer complete interrupt
+
+	uint64_t Transfers;							// number of transfers
+
+	uint64_t Interrupts;						// number of delivered interrupts
+
+}ADC_SimDmaTypeDef;
+
+/**
+  * @brief  Simulated memory-to-memory DMA channel typedef | spare channel of de-interleaving, copied at end of transfer
+  */
+typedef struct{
+
+	DMA_HandleTypeDef* hdma;					// handle of transfer in progress | NULL: channel idle
+
+	const void*        Source;					// source latched by start function | width of PSIZE
+
+	void*              Destination;				// destination latched by start function | width of MSIZE, truncated source
+
+	uint32_t           Length;					// number of transfers
+
+	uint64_t           Due;						// completion time | ADC_SIM_NEVER if channel is idle
+
+	uint64_t           Transfers;				// number of transfers
+
+	uint32_t           Blocks;					// number of completed blocks
+
+}ADC_SimCopyTypeDef;
+
+/**
+  * @brief  Simulation typedef
+  */
+typedef struct{
+
+	ADC_SimAdcTypeDef Adc[2];					// ADC1, ADC2 | ADC2 follows ADC1 in dual mode
+
+	ADC_SimDmaTypeDef Dma;						// DMA1 Channel 1
+
+	ADC_SimCopyTypeDef Copy;					// spare DMA channel in memory-to-memory mode
+
+	uint64_t          Now;						// virtual time [cycles]
+
+	uint32_t          AdcClockDivider;			// core clock cycles per ADC clock cycle (APB2 and ADC prescalers)
+
+	uint32_t          IrqLatency;				// delay between DMA event and callback [cycles]
+
+	uint64_t          Lost;						// conversions not transferred by DMA (normal mode finished or channel disabled)
+
+	uint64_t          ConsumerRuns;				// number of consumer runs
+
+	uint64_t          ConsumerOverruns;			// number of consumer runs longer than period
+
+	ADC_SimFaultTypeDef Faults[ADC_SIM_FAULTS];	// fault injection schedule and statistics
+
+	uint64_t          Seed;						// state of pseudo-random generator of random injections
+
+	uint8_t           Overrun;					// 1: ADC1 overrun, conversions and DMA requests stopped
+
+	uint8_t           OverrunInterrupt;			// 1: overrun is reported by HAL_ADC_ErrorCallback (OVRIE), 0: driver has to poll OVR flag
+
+	uint8_t           CalibrationFails;			// number of following calibrations which fail
+
+	ADC_SimFlashTypeDef Flash;					// emulated flash | kept by ADC_SimFlashPowerUp, so content survives simulated reset
+
+}ADC_SimTypeDef;
+
+
+/* Variables -------------------------------------------------------------------------- */
+extern ADC_SimRegsTypeDef ADC_SimRegs;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_SimInit(ADC_SimTypeDef* sim, uint32_t adcClockDivider);
+
+void                       ADC_SimAdvance(ADC_SimTypeDef* sim, uint64_t cycles);
+
+void                       ADC_SimRun(ADC_SimTypeDef* sim, uint64_t duration, uint32_t period, ADC_SimConsumerTypeDef consumer, void* arg);
+
+uint32_t                   ADC_SimConversionTime(ADC_SimTypeDef* sim, uint8_t adc, uint8_t channel);
+
+uint32_t                   ADC_SimCycles(void);
+
+uint32_t                   ADC_SimIsOverrun(ADC_TypeDef* instance);
+
+void                       ADC_SimClearOverrun(ADC_TypeDef* instance);
+
+void                       ADC_SimSetOversampling(ADC_TypeDef* instance, uint16_t ratio, uint8_t shift);
+
+uint32_t                   ADC_SimOversamplingRatio(ADC_TypeDef* instance);
+
+uint32_t                   ADC_SimOversamplingShift(ADC_TypeDef* instance);
+
+void                       ADC_SimSetResolution(ADC_TypeDef* instance, uint8_t bits);
+
+uint32_t                   ADC_SimResolution(ADC_TypeDef* instance);
+
+uint8_t                    ADC_SimResolutionBits(ADC_TypeDef* instance);
+
+HAL_StatusTypeDef          ADC_SimFaultAt(ADC_SimTypeDef* sim, ADC_SimFaultType type, uint64_t time);
+
+HAL_StatusTypeDef          ADC_SimFaultRandom(ADC_SimTypeDef* sim, ADC_SimFaultType type, uint64_t meanInterval, uint32_t seed);
+
+uint16_t                   ADC_SimFaultFormat(ADC_SimTypeDef* sim, char* text, uint16_t size);
+
+HAL_StatusTypeDef          ADC_SimStartCopy(DMA_HandleTypeDef* hdma, const void* source, void* destination, uint32_t length);
+
+uint16_t                   ADC_SimFlashRead16(uint32_t address);
+
+void                       ADC_SimFlashPowerLoss(ADC_SimTypeDef* sim, uint32_t operations);
+
+void                       ADC_SimFlashPowerUp(ADC_SimTypeDef* sim);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_SIM_H_ */
@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file    adc_store.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Flash key/value store for ADC driver configuration and calibration
+
+  * @brief   This file contains typedefs, macros and prototypes of log-structured store kept in flash pages reserved by linker
+  * 		 script (region ADC_STORE). Records (key, length, data, CRC) are appended to active page, newer record of key
+  * 		 supersedes older one. Pages are used as a ring: when active page is full, next page is opened and the oldest
+  * 		 page is compacted (its live records are copied) and erased, so all pages wear evenly. One erased page is kept
+  * 		 after active page, so compaction always has room. Record is valid only after its CRC is programmed, which is
+  * 		 the last half-word of record, so power loss at any moment leaves previous value of key readable. Mount scans
+  * 		 pages once and builds RAM index (record offset per key), reads are O(1).
+  ******************************************************************************
+  * @attention Flash programming stalls core for ~52 us per half-word and page erase for ~20 ms, write from main loop only.
+  * 		   ADC_STORE_BASE and ADC_STORE_PAGES have to match region ADC_STORE of linker script.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_STORE_H_
+#define INC_ADC_STORE_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#ifndef 			ADC_STORE_BASE
+#define 			ADC_STORE_BASE				0x0801F000U		// first address of region ADC_STORE | last 4 KB of 128 KB device
+#endif
+
+#ifndef 			ADC_STORE_PAGES
+#define 			ADC_STORE_PAGES				4U				// pages of region ADC_STORE | at least 3 (active, erased, data)
+#endif
+
+#ifndef 			ADC_STORE_KEYS
+#define 			ADC_STORE_KEYS				16U				// size of RAM index | keys 1 ... ADC_STORE_KEYS - 1, 0 marks filler
+#endif
+
+#ifndef 			ADC_STORE_MAX_LENGTH
+#define 			ADC_STORE_MAX_LENGTH		128U			// longest value [bytes] | space of one record is reserved in every page
+#endif
+
+#define 			ADC_STORE_PAGE_SIZE			FLASH_PAGE_SIZE
+#define 			ADC_STORE_MAGIC				0xADC5U			// marks formatted page
+#define 			ADC_STORE_HEADER_SIZE		16U				// page header | magic, erase count, sequence, sequence check, erase count check
+#define 			ADC_STORE_RECORD_SIZE(__LENGTH__)	(6U + (((__LENGTH__) + 1U) & ~1U))	// key, length, data padded to half-word, CRC
+#define 			ADC_STORE_RESERVE			ADC_STORE_RECORD_SIZE(ADC_STORE_MAX_LENGTH)	// end of page used only by compaction | absorbs record torn while copying
+
+// Keys used by driver modules
+#define 			ADC_STORE_KEY_TUNING		1U				// ADC_TuningTypeDef | sampling time tuning result
+#define 			ADC_STORE_KEY_CALIBRATION	2U				// calibration factor of ADC
+#define 			ADC_STORE_KEY_SCALE			3U				// scale factors of channels
+#define 			ADC_STORE_KEY_SHELL			4U				// ADC_ShellConfigTypeDef | configuration saved by shell
+
+// Flash read | remapped to emulated flash in simulated build
+#ifndef 			__ADC_FLASH_READ16
+#define 			__ADC_FLASH_READ16(__ADDRESS__)		(*(__IO uint16_t*)(__ADDRESS__))
+#endif
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Flash store typedef | RAM state rebuilt by ADC_StoreMount
+  */
+typedef struct{
+
+	uint16_t Index[ADC_STORE_KEYS];				// offset of latest record of key in region | 0: key is not stored
+
+	uint32_t Erases[ADC_STORE_PAGES];			// erase count of page | wear accounting, kept in page header
+
+	uint32_t Sequence;							// sequence number of active page | increments on every opened page
+
+	uint16_t Head;								// offset of first free half-word in active page
+
+	uint8_t  Active;							// page receiving records
+
+	uint8_t  Mounted;							// 1 if store was mounted
+
+}ADC_StoreTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_StoreMount(ADC_StoreTypeDef* store);
+
+HAL_StatusTypeDef          ADC_StoreRead(ADC_StoreTypeDef* store, uint16_t key, void* data, uint16_t size, uint16_t* length);
+
+HAL_StatusTypeDef          ADC_StoreWrite(ADC_StoreTypeDef* store, uint16_t key, const void* data, uint16_t length);
+
+HAL_StatusTypeDef          ADC_StoreDelete(ADC_StoreTypeDef* store, uint16_t key);
+
+uint32_t                   ADC_StoreWear(const ADC_StoreTypeDef* store);
+
+uint16_t                   ADC_StoreCrc(uint16_t crc, const uint8_t* data, uint16_t length);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_STORE_H_ */
@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file    adc_tuning.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Sampling time auto-tuning for ADC driver
+
+  * @brief   This file contains typedefs, macros and prototypes of optional stage, which selects sampling time (SMPx code)
+  * 		 of every converted channel from measured settling error. Channel is converted right after channel preceding it
+  * 		 in scan, its first conversion is compared with reference taken from consecutive conversion of the channel
+  * 		 with the longest sampling time. The shortest sampling time meeting target error is applied, so scan throughput
+  * 		 is maximised. Result is validated with checksum and can be persisted with load/store callbacks.
+  ******************************************************************************
+  * @attention Tuning runs on stopped ADC with software trigger, before ADC_Init, with inputs at representative levels
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_ADC_TUNING_H_
+#define INC_ADC_TUNING_H_
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include "adc_driver.h"
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#define 			ADC_TUNING_CHANNELS			32			// size of per channel results | covers 5-bit channel field of SQRx registers
+#define 			ADC_TUNING_CODES			8			// sampling time settings of SMPx field | ascending sampling time on all families
+#define 			ADC_TUNING_MAGIC			0x534D5052U	// "SMPR" | marks valid tuning result
+
+#ifndef 			ADC_TUNING_REPEATS
+#define 			ADC_TUNING_REPEATS			8			// measurements averaged per sampling time | suppresses noise
+#endif
+
+#ifndef 			ADC_TUNING_TIMEOUT
+#define 			ADC_TUNING_TIMEOUT			10U			// timeout of single conversion [ms]
+#endif
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+/**
+  * @brief  Sampling time tuning result typedef | plain data, stored and loaded as a whole
+  */
+typedef struct{
+
+	uint32_t Magic;										// ADC_TUNING_MAGIC if result is valid
+
+	uint32_t Tuned;										// bit mask of tuned channels
+
+	uint16_t Target;									// target settling error [LSB]
+
+	uint8_t  Code[ADC_TUNING_CHANNELS];					// selected SMPx code of channel | shortest sampling time meeting target
+
+	uint16_t Error[ADC_TUNING_CHANNELS];				// settling error measured with selected code [LSB]
+
+	uint32_t Checksum;									// checksum of fields above | validated before result is applied
+
+}ADC_TuningTypeDef;
+
+
+/* Functions Prototypes --------------------------------------------------------------------  */
+HAL_StatusTypeDef          ADC_TuningInit(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef* cadc, ADC_TuningTypeDef* tune, uint16_t target);
+
+HAL_StatusTypeDef          ADC_TuningRun(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef* cadc, ADC_TuningTypeDef* tune, uint16_t target);
+
+HAL_StatusTypeDef          ADC_TuningApply(ADC_HandleTypeDef* hadc, const ADC_TuningTypeDef* tune);
+
+uint32_t                   ADC_TuningChecksum(const ADC_TuningTypeDef* tune);
+
+__weak HAL_StatusTypeDef   ADC_TuningLoadCallback(ADC_HandleTypeDef* hadc, ADC_TuningTypeDef* tune);
+
+__weak HAL_StatusTypeDef   ADC_TuningStoreCallback(ADC_HandleTypeDef* hadc, const ADC_TuningTypeDef* tune);
+
+__weak void                ADC_TuningStoreErrorCallback(ADC_HandleTypeDef* hadc, const ADC_TuningTypeDef* tune);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ADC_TUNING_H_ */
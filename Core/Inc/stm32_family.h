@@ -133,4 +133,22 @@
   #define STM32MP1_FAMILY
 #endif
 
+/* ----------------------------- CORE FEATURES ----------------------------- */
+/* Cortex-M4/M7/M33 cores of these families execute DSP extension (SIMD) instructions, e.g. __PKHBT, __SADD16, __SMLAD */
+#if defined(STM32F3_FAMILY) || defined(STM32F4_FAMILY) || defined(STM32F7_FAMILY) || defined(STM32G4_FAMILY) || \
+    defined(STM32H7_FAMILY) || defined(STM32L4_FAMILY) || defined(STM32L5_FAMILY) || defined(STM32WB_FAMILY) || \
+    defined(STM32WL_FAMILY)
+  #define STM32_CORE_DSP
+#endif
+
+/* ----------------------------- MEMORY FEATURES ----------------------------- */
+/* Core coupled memory (CCM SRAM) of these devices is reached by CPU only, DMA has no access to it */
+#if defined(STM32F303x8) || defined(STM32F303xC) || defined(STM32F303xE) || defined(STM32F328xx) || \
+    defined(STM32F334x8) || defined(STM32F358xx) || defined(STM32F398xx) || \
+    defined(STM32F405xx) || defined(STM32F407xx) || defined(STM32F415xx) || defined(STM32F417xx) || \
+    defined(STM32F427xx) || defined(STM32F429xx) || defined(STM32F437xx) || defined(STM32F439xx) || \
+    defined(STM32F469xx) || defined(STM32F479xx)
+  #define STM32_MEM_CCM
+#endif
+
 #endif /* __STM32_FAMILY_H */
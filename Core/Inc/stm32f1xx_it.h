@@ -58,6 +58,8 @@ void SysTick_Handler(void);
 void DMA1_Channel1_IRQHandler(void);
 void EXTI15_10_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void DMA1_Channel7_IRQHandler(void);
+void USART2_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -0,0 +1,362 @@
+/**
+  ******************************************************************************
+  * @file      adc_console.c
+  * @author    Bartosz Rychlicki
+  * @Title     Non-blocking console output (printf retarget) with compile-time log levels
+  * @brief     This file contains functions' bodies of lock-free ring writing, publishing and DMA draining
+  ******************************************************************************
+  * @attention Writers preempt each other only by nesting (interrupts), so writer, which leaves last, leaves when all copies
+  * 		   are done and publishes them. Exception entry and return clear exclusive monitor, so STREX of preempted
+  * 		   context fails and it retries with fresh values. Cores without exclusive access (Cortex-M0/M0+) and simulator
+  * 		   use short critical sections instead.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_console.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+// Private Macros
+#define ADC_CONSOLE_MASK			(ADC_CONSOLE_SIZE - 1U)
+
+#if (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)) && !defined(ADC_SIM)
+	#define ADC_CONSOLE_EXCLUSIVE	1									// LDREX/STREX of Cortex-M3/M4/M7
+#else
+	#define ADC_CONSOLE_EXCLUSIVE	0
+#endif
+
+// Private functions prototypes
+static uint32_t ADC_ConsoleAdd(volatile uint32_t* value, int32_t delta);
+static uint8_t  ADC_ConsoleReserve(ADC_ConsoleTypeDef* con, uint32_t length, uint32_t* start);
+static void     ADC_ConsolePublish(ADC_ConsoleTypeDef* con);
+static uint8_t  ADC_ConsoleClaim(ADC_ConsoleTypeDef* con);
+static void     ADC_ConsoleKick(ADC_ConsoleTypeDef* con);
+
+// Variables
+ADC_ConsoleTypeDef ADC_Console __ADC_DMA_DATA;			// ring is read by DMA | zeroed, so it can be written before init
+
+
+/**
+  * @brief Console init function, configures transmission DMA channel, links it to UART and starts sending queued text
+  * 	   stdout is made unbuffered, so printf does not allocate stream buffer from heap and every call reaches ring
+  * @param  con     - pointer to console structure (ADC_Console for printf)
+  * @param  huart   - pointer to initialized UART handle (e.g. USART2)
+  * @param  hdmaTx  - pointer to handle of transmission DMA channel with Instance set (e.g. DMA1_Channel7 for USART2)
+  * @retval status  - HAL status if init went successfully
+  */
+HAL_StatusTypeDef ADC_ConsoleInit(ADC_ConsoleTypeDef* con, UART_HandleTypeDef* huart, DMA_HandleTypeDef* hdmaTx){
+
+	// checking if correct parameters were provided
+	if(con == NULL || huart == NULL || hdmaTx == NULL){
+		return HAL_ERROR;
+	}
+
+	// transmission | contiguous part of ring
+	hdmaTx->Init.Direction           = DMA_MEMORY_TO_PERIPH;
+	hdmaTx->Init.PeriphInc           = DMA_PINC_DISABLE;
+	hdmaTx->Init.MemInc              = DMA_MINC_ENABLE;
+	hdmaTx->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdmaTx->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+	hdmaTx->Init.Mode                = DMA_NORMAL;
+	hdmaTx->Init.Priority            = DMA_PRIORITY_LOW;		// ADC's DMA keeps priority over console
+
+	if(HAL_DMA_Init(hdmaTx) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	__HAL_LINKDMA(huart, hdmatx, *hdmaTx);
+
+	// text queued before init is kept
+	con->huart = huart;
+
+	if(con == &ADC_Console){
+		setvbuf(stdout, NULL, _IONBF, 0);
+	}
+
+	ADC_ConsoleKick(con);
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Console write function, copies text to ring as a whole or drops it | never blocks, safe in interrupts
+  * @param  con     - pointer to console structure
+  * @param  data    - pointer to text
+  * @param  length  - length of text [bytes]
+  * @retval length  - number of queued bytes | 0 if text was dropped
+  */
+uint32_t ADC_ConsoleWrite(ADC_ConsoleTypeDef* con, const char* data, uint32_t length){
+
+	uint32_t start;
+
+	if(con == NULL || data == NULL || length == 0){
+		return 0;
+	}
+
+	ADC_ConsoleAdd(&con->Writers, 1);
+
+	uint8_t reserved = ADC_ConsoleReserve(con, length, &start);
+
+	if(reserved != 0){
+		for(uint32_t i = 0; i < length; ++i){
+			con->Ring[(start + i) & ADC_CONSOLE_MASK] = (uint8_t)data[i];
+		}
+
+		ADC_ConsoleAdd(&con->Written, (int32_t)length);
+	}else{
+		ADC_ConsoleAdd(&con->Dropped, (int32_t)length);
+	}
+
+	// last writer publishes copies of all nested writers | also if its own text was dropped
+	if(ADC_ConsoleAdd(&con->Writers, -1) == 0){
+		ADC_ConsolePublish(con);
+	}
+
+	ADC_ConsoleKick(con);
+
+	return (reserved != 0) ? length : 0U;
+}
+
+
+/**
+  * @brief Console space function | free space may shrink before next write, if interrupts write meanwhile
+  * @param  con     - pointer to console structure
+  * @retval space   - free bytes of ring
+  */
+uint32_t ADC_ConsoleSpace(const ADC_ConsoleTypeDef* con){
+
+	if(con == NULL){
+		return 0;
+	}
+
+	return ADC_CONSOLE_SIZE - (con->Reserved - con->Tail);
+}
+
+
+/**
+  * @brief Console print function, formats text on stack and writes it | safe in interrupts (without %f)
+  * @param  con     - pointer to console structure
+  * @param  format  - printf format | text is truncated to ADC_CONSOLE_LINE_SIZE - 1 bytes
+  * @retval length  - number of queued bytes
+  */
+uint32_t ADC_ConsolePrintf(ADC_ConsoleTypeDef* con, const char* format, ...){
+
+	char    text[ADC_CONSOLE_LINE_SIZE];
+	va_list args;
+
+	va_start(args, format);
+	int n = vsnprintf(text, sizeof(text), format, args);
+	va_end(args);
+
+	if(n <= 0){
+		return 0;
+	}
+
+	return ADC_ConsoleWrite(con, text, (n < (int)sizeof(text)) ? (uint32_t)n : (uint32_t)(sizeof(text) - 1U));
+}
+
+
+/**
+  * @brief Console transmission complete function | should be called from HAL_UART_TxCpltCallback
+  * 	   Sent part of ring is released and next part is sent
+  * @param  con     - pointer to console structure
+  * @param  huart   - pointer to UART handle, whose transmission completed
+  */
+void ADC_ConsoleTxCplt(ADC_ConsoleTypeDef* con, UART_HandleTypeDef* huart){
+
+	if(con == NULL || huart != con->huart){
+		return;
+	}
+
+	con->Tail    = con->Tail + con->Sending;
+	con->Sending = 0;
+	con->Busy    = 0;
+
+	ADC_ConsoleKick(con);
+}
+
+
+/**
+  * @brief Console error function | should be called from HAL_UART_ErrorCallback
+  * 	   Transfer aborted by DMA error is counted as dropped and sending continues with next part
+  * @param  con     - pointer to console structure
+  * @param  huart   - pointer to UART handle, whose error occurred
+  */
+void ADC_ConsoleError(ADC_ConsoleTypeDef* con, UART_HandleTypeDef* huart){
+
+	// reception errors (noise, framing, overrun) do not stop transmission
+	if(con == NULL || huart != con->huart || con->Busy == 0 || huart->gState != HAL_UART_STATE_READY){
+		return;
+	}
+
+	ADC_ConsoleAdd(&con->Dropped, (int32_t)con->Sending);
+
+	ADC_ConsoleTxCplt(con, huart);
+}
+
+
+/**
+  * @brief Console add function | atomic read-modify-write
+  * @param  value   - pointer to value
+  * @param  delta   - added number
+  * @retval value   - new value
+  */
+static uint32_t ADC_ConsoleAdd(volatile uint32_t* value, int32_t delta){
+
+	uint32_t result;
+
+#if ADC_CONSOLE_EXCLUSIVE == 1
+	do{
+		result = __LDREXW(value) + (uint32_t)delta;
+	}while(__STREXW(result, value) != 0U);
+#else
+	__ADC_CRITICAL_ENTER();
+	result = *value + (uint32_t)delta;
+	*value = result;
+	__ADC_CRITICAL_EXIT();
+#endif
+
+	return result;
+}
+
+
+/**
+  * @brief Console reserve function, claims space of text at end of ring
+  * @param  con     - pointer to console structure
+  * @param  length  - length of text [bytes]
+  * @param  start   - pointer to index of claimed space
+  * @retval result  - 1 if space was claimed, 0 if text does not fit ring
+  */
+static uint8_t ADC_ConsoleReserve(ADC_ConsoleTypeDef* con, uint32_t length, uint32_t* start){
+
+	uint32_t used;
+
+#if ADC_CONSOLE_EXCLUSIVE == 1
+	do{
+		*start = __LDREXW(&con->Reserved);
+		used   = *start - con->Tail;
+
+		if(length > ADC_CONSOLE_SIZE - used){
+			__CLREX();
+			return 0;
+		}
+	}while(__STREXW(*start + length, &con->Reserved) != 0U);
+#else
+	__ADC_CRITICAL_ENTER();
+	*start = con->Reserved;
+	used   = *start - con->Tail;
+
+	if(length <= ADC_CONSOLE_SIZE - used){
+		con->Reserved = *start + length;
+	}
+	__ADC_CRITICAL_EXIT();
+
+	if(length > ADC_CONSOLE_SIZE - used){
+		return 0;
+	}
+#endif
+
+	// peak is statistics only | lost update of racing writers is harmless
+	if(used + length > con->Peak){
+		con->Peak = used + length;
+	}
+
+	return 1;
+}
+
+
+/**
+  * @brief Console publish function, makes all reserved space readable by DMA | called when no writer is copying
+  * @param  con     - pointer to console structure
+  */
+static void ADC_ConsolePublish(ADC_ConsoleTypeDef* con){
+
+#if ADC_CONSOLE_EXCLUSIVE == 1
+	// interrupt between load and store may reserve and publish more | store fails and fresh end is published
+	do{
+		(void)__LDREXW(&con->Committed);
+	}while(__STREXW(con->Reserved, &con->Committed) != 0U);
+#else
+	__ADC_CRITICAL_ENTER();
+	con->Committed = con->Reserved;
+	__ADC_CRITICAL_EXIT();
+#endif
+}
+
+
+/**
+  * @brief Console claim function, takes ownership of DMA transmission
+  * @param  con     - pointer to console structure
+  * @retval result  - 1 if ownership was taken, 0 if transmission is in progress
+  */
+static uint8_t ADC_ConsoleClaim(ADC_ConsoleTypeDef* con){
+
+#if ADC_CONSOLE_EXCLUSIVE == 1
+	do{
+		if(__LDREXW(&con->Busy) != 0U){
+			__CLREX();
+			return 0;
+		}
+	}while(__STREXW(1U, &con->Busy) != 0U);
+
+	return 1;
+#else
+	uint8_t result = 0;
+
+	__ADC_CRITICAL_ENTER();
+	if(con->Busy == 0){
+		con->Busy = 1;
+		result    = 1;
+	}
+	__ADC_CRITICAL_EXIT();
+
+	return result;
+#endif
+}
+
+
+/**
+  * @brief Console kick function, starts DMA transmission of next contiguous committed part if DMA is idle
+  * @param  con     - pointer to console structure
+  */
+static void ADC_ConsoleKick(ADC_ConsoleTypeDef* con){
+
+	if(con->huart == NULL){
+		return;
+	}
+
+	// owner releases Busy before its last check, so text committed meanwhile is sent by owner or by writer
+	while(con->Committed != con->Tail){
+
+		if(ADC_ConsoleClaim(con) == 0){
+			return;
+		}
+
+		uint32_t pending = con->Committed - con->Tail;
+		uint32_t start   = con->Tail & ADC_CONSOLE_MASK;
+
+		if(pending == 0){
+			con->Busy = 0;
+			continue;
+		}
+
+		// DMA reads contiguous memory | part after wrap is sent by next transfer
+		uint32_t length = (pending < ADC_CONSOLE_SIZE - start) ? pending : (ADC_CONSOLE_SIZE - start);
+
+		// set before start | completion interrupt can come before return of HAL call
+		con->Sending = length;
+
+		if(HAL_UART_Transmit_DMA(con->huart, &con->Ring[start], (uint16_t)length) != HAL_OK){
+			con->Sending = 0;
+			con->Busy    = 0;			// UART is busy with other transfer | retried by next write
+		}
+
+		return;
+	}
+}
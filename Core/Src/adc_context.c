@@ -0,0 +1,179 @@
+
+/**
+  ******************************************************************************
+  * @file      adc_context.c
+  * @author    Bartosz Rychlicki
+  * @Title     Inline hot path for ADC driver
+  * @brief     This file contains context init function and out-of-line versions of inline accessors
+  ******************************************************************************
+  * @attention Out-of-line versions keep stable symbols for users, which cannot include inline accessors
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_context.h"
+#include "adc_pool.h"
+
+// Variables
+#if ADC_CONTEXT_POOL_SIZE > 0
+ADC_POOL_DEFINE(ADC_ContextPool, ADC_ContextTypeDef, ADC_CONTEXT_POOL_SIZE);		// contexts of ADC_ContextCreate | reported by ADC_PoolFormat
+#endif
+
+
+/**
+  * @brief Context init function, validates ADC configuration once and publishes it for inline accessors
+  * 	   Should be called after ADC_Init (ranks are detected) and after every change of ranks or storage
+  * @param  ctx     - pointer to context structure
+  * @param  hadc    - pointer to ADC handle
+  * @param  badc    - pointer to ADC buffer structure
+  * @param  cadc    - pointer to ADC channels structure
+  * @param  max     - value corresponding to full scale of ADC (e.g. 3.3f for voltage)
+  * @retval status  - HAL status if context was initialized
+  */
+HAL_StatusTypeDef ADC_ContextInit(ADC_ContextTypeDef* ctx, ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, float max){
+
+	// checking if correct parameters were provided
+	if(ctx == NULL || hadc == NULL || badc == NULL || cadc == NULL){
+		return HAL_ERROR;
+	}
+
+	// checking if ranks were detected
+	if(cadc->NbrOfConversions == 0 || cadc->NbrOfConversions > ADC_MAX_CHANNELS){
+		return HAL_ERROR;
+	}
+
+	// checking if DMA storage contains whole scans
+	if((badc->BufferADC != NULL || badc->BufferMultiMode != NULL) && (badc->BufferLength == 0 || (badc->BufferLength % cadc->NbrOfConversions) != 0)){
+		return HAL_ERROR;
+	}
+
+	ctx->badc        = badc;
+	ctx->Channels    = cadc->NbrOfConversions;
+	ctx->Slave       = (hadc->Instance != ADC1) ? 1U : 0U;
+	ctx->Scans       = badc->BufferLength / cadc->NbrOfConversions;
+	ctx->Oversampled = __ADC_IS_HW_AVERAGING(hadc, badc) ? 1U : 0U;						// averaged value is in units of ADC resolution
+	ctx->Packed      = __ADC_IS_PACKED(badc->hdma) ? 1U : 0U;
+
+	// deriving scale from current resolution
+	ADC_ContextRescale(ctx, hadc, max);
+
+	// building channel to rank lookup | replaces search of ADC_GetRank
+	for(int i = 0; i < ADC_CONTEXT_CHANNELS; ++i){
+		ctx->RankOfChannel[i] = ADC_CONTEXT_NO_RANK;
+	}
+
+	for(int i = cadc->NbrOfConversions - 1; i >= 0; --i){
+		ctx->RankOfChannel[cadc->ranks[i] & (ADC_CONTEXT_CHANNELS - 1U)] = (uint8_t)i;	// first rank of channel wins, as in ADC_GetRank
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Context rescale function, re-derives scale of published context from current resolution | called after ADC_SetResolution
+  * @param  ctx     - pointer to context initialized by ADC_ContextInit
+  * @param  hadc    - pointer to ADC handle
+  * @param  max     - value corresponding to full scale of ADC (e.g. 3.3f for voltage)
+  * @retval status  - HAL status if scale was derived
+  */
+HAL_StatusTypeDef ADC_ContextRescale(ADC_ContextTypeDef* ctx, ADC_HandleTypeDef* hadc, float max){
+
+	// checking if correct parameters were provided
+	if(ctx == NULL || hadc == NULL){
+		return HAL_ERROR;
+	}
+
+	uint32_t fullScale = ctx->Oversampled ? __ADC_DATA_MAX(hadc) : __ADC_FULL_SCALE(hadc);
+
+	ctx->Scale    = max / (float)fullScale;
+	ctx->Q15Shift = 0;
+
+	// aligning full scale to MSB of half-word | 0 for left-aligned data
+	while(fullScale != 0 && (fullScale << (ctx->Q15Shift + 1U)) <= 0xFFFFU){
+		ctx->Q15Shift++;
+	}
+
+	return HAL_OK;
+}
+
+
+#if ADC_CONTEXT_POOL_SIZE > 0
+/**
+  * @brief Context create function, takes context from static pool and initializes it
+  * 	   For contexts needed only in some configurations (e.g. ADC served by shell or Modbus only if enabled)
+  * @param  hadc    - pointer to ADC handle
+  * @param  badc    - pointer to ADC buffer structure
+  * @param  cadc    - pointer to ADC channels structure
+  * @param  max     - value corresponding to full scale of ADC (e.g. 3.3f for voltage)
+  * @retval ctx     - pointer to initialized context | NULL if pool is exhausted or ADC_ContextInit failed
+  */
+ADC_ContextTypeDef* ADC_ContextCreate(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, float max){
+
+	ADC_ContextTypeDef* ctx = ADC_PoolAlloc(&ADC_ContextPool);
+
+	if(ctx == NULL){
+		return NULL;
+	}
+
+	// block is not cleared by pool | released, if configuration is rejected
+	if(ADC_ContextInit(ctx, hadc, badc, cadc, max) != HAL_OK){
+		ADC_PoolFree(&ADC_ContextPool, ctx);
+		return NULL;
+	}
+
+	return ctx;
+}
+
+
+/**
+  * @brief Context destroy function, returns context created by ADC_ContextCreate to pool
+  * 	   Users of context (shell, Modbus, stages) have to be stopped before
+  * @param  ctx     - pointer to context of ADC_ContextCreate
+  * @retval status  - HAL_ERROR if context does not come from pool or was already destroyed
+  */
+HAL_StatusTypeDef ADC_ContextDestroy(ADC_ContextTypeDef* ctx){
+
+	return ADC_PoolFree(&ADC_ContextPool, ctx);
+}
+#endif
+
+
+/**
+  * @brief Out-of-line version of ADC_InlineLatest
+  */
+uint16_t ADC_ContextLatest(const ADC_ContextTypeDef* ctx, uint8_t channel){
+
+	return ADC_InlineLatest(ctx, channel);
+}
+
+
+/**
+  * @brief Out-of-line version of ADC_InlineAveraged
+  */
+uint16_t ADC_ContextAveraged(const ADC_ContextTypeDef* ctx, uint8_t channel){
+
+	return ADC_InlineAveraged(ctx, channel);
+}
+
+
+/**
+  * @brief Out-of-line version of ADC_InlineScaled
+  */
+float ADC_ContextScaled(const ADC_ContextTypeDef* ctx, uint8_t channel){
+
+	return ADC_InlineScaled(ctx, channel);
+}
+
+
+/**
+  * @brief Out-of-line version of ADC_InlineQ15
+  */
+int16_t ADC_ContextQ15(const ADC_ContextTypeDef* ctx, uint8_t channel){
+
+	return ADC_InlineQ15(ctx, channel);
+}
@@ -0,0 +1,159 @@
+
+/**
+  ******************************************************************************
+  * @file      adc_deinterleave.c
+  * @author    Bartosz Rychlicki
+  * @Title     Dual mode de-interleaving for ADC driver
+  * @brief     This file contains functions' bodies of splitting dual mode DMA storage into Master and Slave buffers
+  ******************************************************************************
+  * @attention F1 DMA truncates 32-bit source to 16-bit destination by keeping lower half-word, which is Master's conversion.
+  * 		   Upper half-word (Slave) cannot be reached with DMA address increments, so it is extracted by CPU.
+  * 		   Interrupt of spare DMA channel has to be enabled and its IRQ handler has to call HAL_DMA_IRQHandler.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_deinterleave.h"
+
+// Private functions prototypes
+#if defined(STM32F1_FAMILY)
+static void ADC_DeinterleaveCpltCallback(DMA_HandleTypeDef* hdma);
+#endif
+
+
+/**
+  * @brief De-interleaving init function, configures spare DMA channel in memory-to-memory mode
+  * @param  dint    - pointer to de-interleaving structure
+  * @param  hdma    - pointer to handle of spare DMA channel with Instance set (e.g. DMA1_Channel2) | NULL: CPU extracts both ADCs
+  * @param  master  - pointer to Master's buffer, length equal to dual mode DMA storage
+  * @param  slave   - pointer to Slave's buffer, length equal to dual mode DMA storage | NULL if Slave is not needed
+  * @param  length  - number of half-words in each buffer
+  * @retval status  - HAL status if init went successfully
+  */
+HAL_StatusTypeDef ADC_DeinterleaveInit(ADC_DeinterleaveTypeDef* dint, DMA_HandleTypeDef* hdma, uint16_t* master, uint16_t* slave, uint16_t length){
+
+	// checking if correct parameters were provided
+	if(dint == NULL || master == NULL || length == 0){
+		return HAL_ERROR;
+	}
+
+	dint->hdma         = hdma;
+	dint->BufferMaster = master;
+	dint->BufferSlave  = slave;
+	dint->BufferLength = length;
+	dint->Ready        = 0;
+	dint->Blocks       = 0;
+	dint->Fallbacks    = 0;
+
+	if(hdma == NULL){
+		return HAL_OK; // CPU only de-interleaving
+	}
+
+	#if defined(STM32F1_FAMILY)
+
+		// word read from dual mode storage, half-word written to Master's buffer | DMA keeps lower half-word
+		hdma->Init.Direction           = DMA_MEMORY_TO_MEMORY;
+		hdma->Init.PeriphInc           = DMA_PINC_ENABLE;
+		hdma->Init.MemInc              = DMA_MINC_ENABLE;
+		hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+		hdma->Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+		hdma->Init.Mode                = DMA_NORMAL;
+		hdma->Init.Priority            = DMA_PRIORITY_LOW;		// ADC's DMA keeps priority over de-interleaving
+
+		if(HAL_DMA_Init(hdma) != HAL_OK){
+			return HAL_ERROR;
+		}
+
+		hdma->Parent               = dint;						// de-interleaving structure is found in completion callback
+		hdma->XferCpltCallback     = ADC_DeinterleaveCpltCallback;
+		hdma->XferHalfCpltCallback = NULL;						// half transfer interrupt is not needed
+
+		return HAL_OK;
+
+	#else
+
+		// other families do not truncate words in memory-to-memory mode (FIFO packs both half-words)
+		return HAL_ERROR;
+
+	#endif
+}
+
+
+/**
+  * @brief De-interleaving start function | should be called from ADC_BlockCpltCallback of Master
+  * 	   Master's part is transferred by DMA (Ready is set in DMA interrupt), Slave's part is extracted by CPU before return
+  * @param  dint      - pointer to de-interleaving structure
+  * @param  badc      - pointer to ADC buffer with dual mode storage
+  * @param  offset    - index of first completed transfer in DMA storage
+  * @param  transfers - number of completed transfers
+  * @retval status    - HAL status if de-interleaving was started
+  */
+HAL_StatusTypeDef ADC_DeinterleaveStart(ADC_DeinterleaveTypeDef* dint, const ADC_BufferTypeDef* badc, uint16_t offset, uint16_t transfers){
+
+	// checking if correct parameters were provided
+	if(dint == NULL || badc == NULL || badc->BufferMultiMode == NULL){
+		return HAL_ERROR;
+	}
+
+	// security check | if block is beyond buffers' limits
+	if((uint32_t)offset + transfers > dint->BufferLength || (uint32_t)offset + transfers > badc->BufferLength){
+		return HAL_ERROR;
+	}
+
+	const uint32_t* block = &badc->BufferMultiMode[offset];
+
+	dint->Ready = 0;
+
+	// starting Master's transfer if DMA channel finished previous block
+	if(dint->hdma != NULL && dint->hdma->State == HAL_DMA_STATE_READY){
+
+		if(__ADC_DMA_START_COPY(dint->hdma, block, &dint->BufferMaster[offset], transfers) != HAL_OK){
+			return HAL_ERROR;
+		}
+
+	}else{
+
+		// counting blocks, which DMA could not take over
+		if(dint->hdma != NULL){
+			dint->Fallbacks++;
+		}
+
+		// extracting Master's values by CPU
+		for(uint16_t i = 0; i < transfers; ++i){
+			dint->BufferMaster[offset + i] = __ADC_DUAL_MASTER_DATA(block[i]);
+		}
+
+		dint->Ready = 1;
+		dint->Blocks++;
+	}
+
+	// extracting Slave's values by CPU | runs in parallel with Master's DMA transfer, in interrupt context (~6 cycles per transfer)
+	if(dint->BufferSlave != NULL){
+		for(uint16_t i = 0; i < transfers; ++i){
+			dint->BufferSlave[offset + i] = __ADC_DUAL_SLAVE_DATA(block[i]);
+		}
+	}
+
+	return HAL_OK;
+}
+
+
+#if defined(STM32F1_FAMILY)
+
+/**
+  * @brief De-interleaving completion callback | called by HAL_DMA_IRQHandler of spare DMA channel
+  * @param  hdma    - pointer to handle of spare DMA channel
+  */
+static void ADC_DeinterleaveCpltCallback(DMA_HandleTypeDef* hdma){
+
+	ADC_DeinterleaveTypeDef* dint = (ADC_DeinterleaveTypeDef*)hdma->Parent;
+
+	dint->Ready = 1;
+	dint->Blocks++;
+}
+
+#endif
@@ -17,6 +17,7 @@
 
 
 #include "adc_driver.h"
+#include "adc_dsp.h"
 
 // Private variables
 // Container of ADC ranks to return rank's register while number of rank is given
@@ -35,6 +36,34 @@ static 			uint32_t ADC_RANKS_BITPOS[16] = {
     ADC_RANK13_BITPOS, ADC_RANK14_BITPOS, ADC_RANK15_BITPOS, ADC_RANK16_BITPOS
 };
 
+// Container of registered ADC instances to find buffer of ADC, whose DMA interrupt occurred
+static 			ADC_HandleTypeDef* ADC_INSTANCES_HANDLES[ADC_MAX_INSTANCES];
+static 			ADC_BufferTypeDef* ADC_INSTANCES_BUFFERS[ADC_MAX_INSTANCES];
+
+// Private functions prototypes
+static HAL_StatusTypeDef  ADC_RegisterInstance(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc);
+static ADC_BufferTypeDef* ADC_FindBuffer(ADC_HandleTypeDef* hadc);
+static HAL_StatusTypeDef  ADC_RearmDMA(ADC_BufferTypeDef* badc);
+static HAL_StatusTypeDef  ADC_RestartDMA(ADC_BufferTypeDef* badc);
+static HAL_StatusTypeDef  ADC_HandleOverrun(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc);
+static HAL_StatusTypeDef  ADC_Calibrate(ADC_HandleTypeDef* hadc);
+static void               ADC_OffloadAveraging(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc);
+static ADC_HandleTypeDef* ADC_FindHandle(ADC_BufferTypeDef* badc);
+
+#if !defined(STM32F1_FAMILY) || defined(ADC_SIM)
+static void               ADC_RescaleStorage(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, uint8_t from, uint8_t to);
+static uint8_t            ADC_ResolutionBits(uint32_t resolution);
+#endif
+
+// Private Macros | steady-state access to converted values, selected by ADC_FAST_PATH
+#if (ADC_FAST_PATH == 1)
+	#define ADC_GET_VALUE(__HANDLE__)				((uint16_t)__ADC_READ_DATA(__HANDLE__))
+	#define ADC_GET_MULTIMODE_VALUE(__HANDLE__)		((uint32_t)__ADC_READ_MULTIMODE_DATA(__HANDLE__))
+#else
+	#define ADC_GET_VALUE(__HANDLE__)				((uint16_t)HAL_ADC_GetValue(__HANDLE__))
+	#define ADC_GET_MULTIMODE_VALUE(__HANDLE__)		((uint32_t)HAL_ADCEx_MultiModeGetValue(__HANDLE__))
+#endif
+
 /**
   * @brief  ADC1 Initialization Function, performs calibration and starts conversions.
   * @param  hadc  Pointer to ADC handle.
@@ -52,23 +81,15 @@ HAL_StatusTypeDef ADC_Init(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC
 	}
 
 
-	#if !(defined(STM32F2_FAMILY) || defined(STM32F4_FAMILY))
-
-			#if defined(STM32F1_FAMILY)
-
-				// launching calibration for F1 core
-				if(HAL_ADCEx_Calibration_Start(hadc) != HAL_OK){
-					return HAL_ERROR;
-				}
-
-			#else
-				// launching calibration for F3 core
-				if(HAL_ADCEx_Calibration_Start(hadc, ADC_SINGLE_ENDED) != HAL_OK){
-					return HAL_ERROR;
-				}
+	// launching calibration | retried, because single attempt may fail while ADC is settling
+	if(ADC_Calibrate(hadc) != HAL_OK){
+		return HAL_ERROR;
+	}
 
-			#endif
-	#endif
+	// programming hardware oversampler while ADC is stopped | averaging falls back to software if it cannot be offloaded
+	if(__ADC_IS_DMA_ENABLED(hadc) != 0){
+		ADC_OffloadAveraging(hadc, badc);
+	}
 
 
 	// launching ADC
@@ -81,6 +102,30 @@ HAL_StatusTypeDef ADC_Init(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC
 		return HAL_ERROR;
 	}
 
+	// checking if provided DMA storage fits detected number of channels and averaged measures | single scan if averaged by hardware
+	if(__ADC_IS_DMA_ENABLED(hadc) != 0){
+		if(badc->AveragedMeasures == 0 || badc->BufferLength < ADC_BUFFER_LENGTH(cadc->NbrOfConversions, (__ADC_IS_HW_AVERAGING(hadc, badc) ? 1 : badc->AveragedMeasures))){
+			return HAL_ERROR;
+		}
+
+		// storage has to contain whole scans of all channels, otherwise ranks would shift between DMA blocks
+		if((badc->BufferLength % cadc->NbrOfConversions) != 0){
+			return HAL_ERROR;
+		}
+
+		badc->hdma = hadc->DMA_Handle; // storing DMA handle to find latest converted scan while averaging
+
+		// storage packed to bytes holds conversions of 8 bits or lower only
+		if(__ADC_IS_PACKED(badc->hdma) && __ADC_DATA_MAX(hadc) > 255U){
+			return HAL_ERROR;
+		}
+
+		// registering instance to count its DMA interrupts
+		if(ADC_RegisterInstance(hadc, badc) != HAL_OK){
+			return HAL_ERROR;
+		}
+	}
+
 
 	// check if dual mode is enabled
 	if(__ADC_IS_DMA_MULTIMODE(hadc) == 0){
@@ -88,8 +133,13 @@ HAL_StatusTypeDef ADC_Init(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC
 			// checking if DMA is enabled
 			if(__ADC_IS_DMA_ENABLED(hadc) != 0){
 
+				// checking if storage for independent mode was provided
+				if(badc->BufferADC == NULL){
+					return HAL_ERROR;
+				}
+
 				// starting DMA with ADC in Independent mode
-				if(HAL_ADC_Start_DMA(hadc, (uint32_t*)badc->idma.BufferADC, ADC_BUFF_SIZE) != HAL_OK){
+				if(HAL_ADC_Start_DMA(hadc, (uint32_t*)badc->BufferADC, badc->BufferLength) != HAL_OK){
 					return HAL_ERROR;
 				}
 			}
@@ -123,39 +173,137 @@ HAL_StatusTypeDef ADC_InitMultimode(ADC_HandleTypeDef* hadcMaster, ADC_BufferTyp
 	if(hadcMaster->Instance != ADC1){
 		return HAL_ERROR;
 	}
-	// checking if buff struct is initialized
-	if(badc == NULL){
+	// checking if buff struct is initialized and has storage for dual mode
+	if(badc == NULL || badc->BufferMultiMode == NULL || badc->AveragedMeasures == 0){
 		return HAL_ERROR;
 	}
 
-	// For F2 and F4 family Calibration function does not exist
-	#if !(defined(STM32F2_FAMILY) || defined(STM32F4_FAMILY))
+	// starting calibration of Master
+	if(ADC_Calibrate(hadcMaster) != HAL_OK){
+		return HAL_ERROR;
+	}
 
-		#if defined(STM32F1_FAMILY)
+	badc->hdma = hadcMaster->DMA_Handle; // DMA of Master fills storage shared by both ADCs
 
-			// starting calibration for F1 Core
-			if(HAL_ADCEx_Calibration_Start(hadcMaster) != HAL_OK){
-				return HAL_ERROR;
-			}
+	// registering Master instance to count its DMA interrupts
+	if(ADC_RegisterInstance(hadcMaster, badc) != HAL_OK){
+		return HAL_ERROR;
+	}
 
-		#else
+	// launching dual mode conversion
+	if(HAL_ADCEx_MultiModeStart_DMA(hadcMaster, badc->BufferMultiMode, badc->BufferLength) != HAL_OK){
+		return HAL_ERROR;
+	}
 
-			// starting calibration for F3 Core
-			if(HAL_ADCEx_Calibration_Start(hadcMaster, ADC_SINGLE_ENDED) != HAL_OK){
-				return HAL_ERROR;
-			}
 
-			#endif
-	#endif
+	return HAL_OK;
 
-	// launching dual mode conversion
-	if(HAL_ADCEx_MultiModeStart_DMA(hadcMaster, badc->ddma.BufferMultiMode, ADC_BUFF_SIZE) != HAL_OK){
+}
+
+
+/**
+  * @brief ADC buffer assign function, attaches caller-provided DMA storage for independent mode
+  * @param  badc     - pointer to ADC buffer structure
+  * @param  storage  - pointer to storage of at least ADC_BUFFER_LENGTH(channels, ADC_AVERAGING_SCANS(measures)) half-words
+  * @param  length   - number of half-words in storage
+  * @param  measures - number of measures from one channel to be averaged
+  * @retval status   - HAL status if storage was attached successfully
+  */
+HAL_StatusTypeDef ADC_BufferAssign(ADC_BufferTypeDef* badc, uint16_t* storage, uint16_t length, uint8_t measures){
+
+	// checking if correct parameters were provided | single scan is enough if averaging can be offloaded to hardware
+	if(badc == NULL || storage == NULL || measures == 0 || length < ADC_AVERAGING_SCANS(measures)){
+		return HAL_ERROR;
+	}
+
+	badc->BufferADC        = storage;
+	badc->BufferMultiMode  = NULL;		// independent mode does not use dual mode storage
+	badc->BufferLength     = length;
+	badc->AveragedMeasures = measures;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief ADC buffer assign function, attaches caller-provided DMA storage packed to bytes for independent mode
+  * 	   DMA memory data alignment has to be set to byte, resolution has to be 8 bits or lower
+  * @param  badc     - pointer to ADC buffer structure
+  * @param  storage  - pointer to storage of at least ADC_BUFFER_LENGTH(channels, measures) bytes
+  * @param  length   - number of bytes in storage
+  * @param  measures - number of measures from one channel to be averaged
+  * @retval status   - HAL status if storage was attached successfully
+  */
+HAL_StatusTypeDef ADC_BufferAssignPacked(ADC_BufferTypeDef* badc, uint8_t* storage, uint16_t length, uint8_t measures){
+
+	// checking if correct parameters were provided | averaging of packed storage is done in software
+	if(badc == NULL || storage == NULL || measures == 0 || length < measures){
+		return HAL_ERROR;
+	}
+
+	badc->BufferPacked     = storage;
+	badc->BufferMultiMode  = NULL;		// independent mode does not use dual mode storage
+	badc->BufferLength     = length;
+	badc->AveragedMeasures = measures;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief ADC buffer assign function, attaches caller-provided DMA storage for dual mode | storage is shared by Master and Slave
+  * @param  badc     - pointer to ADC buffer structure
+  * @param  storage  - pointer to storage of at least ADC_BUFFER_LENGTH(channels, measures) words
+  * @param  length   - number of words in storage
+  * @param  measures - number of measures from one channel to be averaged
+  * @retval status   - HAL status if storage was attached successfully
+  */
+HAL_StatusTypeDef ADC_BufferAssignMultimode(ADC_BufferTypeDef* badc, uint32_t* storage, uint16_t length, uint8_t measures){
+
+	// checking if correct parameters were provided
+	if(badc == NULL || storage == NULL || measures == 0 || length < measures){
 		return HAL_ERROR;
 	}
 
+	badc->BufferADC        = NULL;		// dual mode does not use independent mode storage
+	badc->BufferMultiMode  = storage;
+	badc->BufferLength     = length;
+	badc->AveragedMeasures = measures;
 
 	return HAL_OK;
+}
+
+
+/**
+  * @brief ADC averaging depth set function, changes number of averaged measures in runtime
+  * @param  badc     - pointer to ADC buffer structure
+  * @param  cadc     - pointer to ADC channels structure | number of conversions has to be detected by init
+  * @param  measures - number of latest measures from one channel to be averaged
+  * @retval status   - HAL status if storage holds enough scans for given number of measures
+  * 				   HAL_BUSY if averaging is done by hardware oversampler | depth is changed by re-init of stopped ADC
+  */
+HAL_StatusTypeDef ADC_SetAveragedMeasures(ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, uint8_t measures){
+
+	// checking if correct parameters were provided
+	if(badc == NULL || cadc == NULL || measures == 0){
+		return HAL_ERROR;
+	}
+
+	// oversampler ratio cannot be changed while conversions are in progress
+	ADC_HandleTypeDef* hadc = ADC_FindHandle(badc);
+
+	if(hadc != NULL && __ADC_IS_HW_AVERAGING(hadc, badc) && measures != badc->AveragedMeasures){
+		return HAL_BUSY;
+	}
 
+	// checking if storage holds enough scans of all channels
+	if(badc->BufferLength < ADC_BUFFER_LENGTH(cadc->NbrOfConversions, measures)){
+		return HAL_ERROR;
+	}
+
+	badc->AveragedMeasures = measures;
+
+	return HAL_OK;
 }
 
 
@@ -192,46 +340,30 @@ HAL_StatusTypeDef ADC_ReadChannel(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef*
 		// iterating through all ranks to read value from correct channel's rank in ADC without DMA
 		for(int i  = 0 ; i <= rank ; ++i){
 
-			 if(__ADC_IS_DMA_MULTIMODE(hadc) == 0){  // single conversion | independent mode
+			 uint16_t value = 0;
 
-				 uint16_t value = 0;
+			 if(__ADC_IS_DMA_MULTIMODE(hadc) == 0){  // single conversion | independent mode
 
 				 // getting converted value
-				 value = HAL_ADC_GetValue(hadc);
+				 value = ADC_GET_VALUE(hadc);
 
-				 // checking if converted value is valid
-				 if(value > __ADC_RESOLUTION(hadc) || value < 0){
-					 return HAL_ERROR;
-				 }
+			}else{									 // single conversion | dual mode
 
-				 // overwriting value in buffer only if process of reading from given channel is executed
-				 if(i == rank){
-					 badc->ADC_Buff[rank] = value;
-				 }
+				 // getting converted value of both ADCs and extracting half-word of this instance
+				 uint32_t dual = ADC_GET_MULTIMODE_VALUE(hadc);
 
-			}else{
-				// single conversion | dual mode
-
-				uint32_t value = 0;
-
-				// getting converted value
-				value = HAL_ADCEx_MultiModeGetValue(hadc);
-
-				// checking if converted value is valid
-				if(value > __ADC_RESOLUTION(hadc) || value < 0){
-					 return HAL_ERROR;
-				}
-
-				// overwriting value in buffer only if process of reading from given channel is executed
-				if(i == rank){
-					value = HAL_ADCEx_MultiModeGetValue(hadc);
-				}
+				 value = (hadc->Instance == ADC1) ? __ADC_DUAL_MASTER_DATA(dual) : __ADC_DUAL_SLAVE_DATA(dual);
 			}
-		}
 
-		// security check | if converted value is higher than ADC's resolution or less than 0
-		if(badc->ADC_Buff[channel] > __ADC_RESOLUTION(hadc) || badc->ADC_Buff[channel] < 0){
-			return  HAL_ERROR;
+			 // checking if converted value is valid
+			 if(value > __ADC_FULL_SCALE(hadc)){
+				 return HAL_ERROR;
+			 }
+
+			 // overwriting value in buffer only if process of reading from given channel is executed
+			 if(i == rank){
+				 badc->ADC_Buff[rank] = value;
+			 }
 		}
 
 		//overwriting converted value of ADC | otherwise no assign of value will be conducted
@@ -239,39 +371,35 @@ HAL_StatusTypeDef ADC_ReadChannel(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef*
 
 		// re-launching ADC if its mode is non-continuous
 		if(__ADC_MODE(hadc) == 0){
-			if(HAL_ADC_Start(hadc) != HAL_OK){
-				return HAL_ERROR;
-			}
+
+			#if (ADC_FAST_PATH == 1)
+				__ADC_SW_START(hadc);
+			#else
+				if(HAL_ADC_Start(hadc) != HAL_OK){
+					return HAL_ERROR;
+				}
+			#endif
 		}
 
 	}else{								  // DMA Enabled
 
+		// restarting DMA if ADC stopped on overrun | latest samples are kept in storage, next block is flagged as discontinuous
+		if(ADC_CheckOverrun(hadc, badc) == HAL_ERROR){
+			return HAL_ERROR;
+		}
+
 		// averaging converted values from given channel
 		if(ADC_Averaging(hadc, badc, cadc, channel, retval) != HAL_OK){ // averaging transfer
 			return HAL_ERROR;
 		}
 
-		// re-launching conversion for DMA in normal mode | with checking if ADC/ADCs are in independent or dual mode
-		if(__ADC_IS_DMA_MULTIMODE(hadc) != 0){     // ADC in dual mode | DMA [ON]
-
-			// re-launching ADC in dual mode conversion with DMA
-			if(__ADC_DMA_MODE(hadc) == 0){
-				if(HAL_ADCEx_MultiModeStart_DMA(hadc, badc->ddma.BufferMultiMode, ADC_BUFF_SIZE) != HAL_OK){
-					return HAL_ERROR;
-				}
-			}
-
-		}else{									   // ADC in independent mode | DMA [ON]
-
-			// re-launching ADC in independent conversion with DMA
-			if(__ADC_DMA_MODE(hadc) != 0){
-				if(HAL_ADC_Start_DMA(hadc, (uint32_t*)badc->idma.BufferADC, ADC_BUFF_SIZE) != HAL_OK){
-					return HAL_ERROR;
-				}
+		// re-arming DMA in normal mode | circular mode is re-armed by hardware
+		if(__ADC_DMA_MODE(hadc) == 0){
+			if(ADC_RearmDMA(badc) != HAL_OK){
+				return HAL_ERROR;
 			}
 		}
 
-
 	}
 
 
@@ -289,7 +417,12 @@ HAL_StatusTypeDef ADC_ReadChannel(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef*
 __weak HAL_StatusTypeDef  ADC_GetValue(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef* cadc, ADC_BufferTypeDef* badc, float max, uint8_t channel, float * retval){
 
 	uint16_t binaryType = 0; 							// init of variable which stores converted value from channel
-	uint32_t adcResolutiion = __ADC_RESOLUTION(hadc);  // reading ADC resolution
+	uint32_t adcResolutiion = __ADC_FULL_SCALE(hadc);  // reading ADC resolution | scaled by hardware oversampler
+
+	// sum accumulated by hardware averaging is divided by averaged measures | value is in units of ADC resolution
+	if(__ADC_IS_HW_AVERAGING(hadc, badc)){
+		adcResolutiion = __ADC_DATA_MAX(hadc);
+	}
 
 	// reading channel's cconverted value
 	if(ADC_ReadChannel(hadc, cadc, badc, channel, &binaryType) != HAL_OK){
@@ -310,8 +443,335 @@ __weak HAL_StatusTypeDef  ADC_GetValue(ADC_HandleTypeDef* hadc, ADC_ChannelsType
  */
 void               HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc){
 
-	UNUSED(hadc); // unused variable to avoid warnings
+	ADC_BufferTypeDef* badc = ADC_FindBuffer(hadc);
+
+	// counting DMA full transfer interrupts of registered ADC
+	if(badc != NULL){
+		badc->FullBlocks++;
+
+		// passing second half of DMA storage to processing stages
+		ADC_BlockCpltCallback(hadc, badc, badc->BufferLength / 2U, badc->BufferLength - badc->BufferLength / 2U);
+
+		badc->Discontinuous = 0;	// following blocks are contiguous with this one
+	}
+
+}
+
+/*
+ * @brief Implementation of half transfer callback function | counts DMA half transfer interrupts of registered ADC
+ */
+void               HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc){
+
+	ADC_BufferTypeDef* badc = ADC_FindBuffer(hadc);
+
+	// counting DMA half transfer interrupts of registered ADC
+	if(badc != NULL){
+		badc->HalfBlocks++;
+
+		// passing first half of DMA storage to processing stages
+		ADC_BlockCpltCallback(hadc, badc, 0, badc->BufferLength / 2U);
+
+		badc->Discontinuous = 0;	// following blocks are contiguous with this one
+	}
+
+}
+
+/**
+  * @brief Empty implementation of DMA block callback | called from DMA interrupt when part of DMA storage is completed and will not be
+  * 	   overwritten until next half of block. Processing stages (e.g. ADC_HistoryPush) should be called in user implementation
+  * @param  hadc      - pointer to ADC handle, whose DMA interrupt occurred
+  * @param  badc      - pointer to ADC buffer registered with ADC handle
+  * @param  offset    - index of first completed transfer in DMA storage
+  * @param  transfers - number of completed transfers
+  */
+__weak void        ADC_BlockCpltCallback(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, uint16_t offset, uint16_t transfers){
+
+	UNUSED(hadc);      // unused variables to avoid warnings
+	UNUSED(badc);
+	UNUSED(offset);
+	UNUSED(transfers);
+
+}
+
+/**
+  * @brief Implementation of error callback function | counts errors of registered ADC and restarts its acquisition
+  * 	   Called by HAL on DMA transfer error (DMA channel is disabled by hardware) and ADC overrun (OVR interrupt)
+  */
+void               HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc){
+
+	ADC_BufferTypeDef* badc = ADC_FindBuffer(hadc);
+
+	if(badc == NULL){
+		return;
+	}
+
+	// overrun | HAL has already cleared OVR flag, only DMA has to be restarted
+	if((hadc->ErrorCode & HAL_ADC_ERROR_OVR) != 0){
+		CLEAR_BIT(hadc->ErrorCode, HAL_ADC_ERROR_OVR);
+
+		ADC_HandleOverrun(hadc, badc);
+		return;
+	}
+
+	badc->Errors++;
+
+	ADC_Recover(hadc, badc);
+
+}
+
+/**
+  * @brief ADC recover function, stops ADC with its DMA and starts acquisition again from beginning of storage
+  * @param  hadc    - pointer to ADC handle | Master is taken from DMA handle in dual mode
+  * @param  badc    - pointer to ADC buffer structure
+  * @retval status  - HAL status if acquisition was restarted
+  */
+HAL_StatusTypeDef  ADC_Recover(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc){
+
+	// checking if correct parameters were provided
+	if(hadc == NULL || badc == NULL){
+		return HAL_ERROR;
+	}
+
+	badc->Restarts++;
+	badc->Discontinuous = 1;
+
+	// ADC without DMA | restarting conversions only
+	if(badc->hdma == NULL){
+		HAL_ADC_Stop(hadc);
+
+		return HAL_ADC_Start(hadc);
+	}
+
+	hadc = (ADC_HandleTypeDef*)badc->hdma->Parent;	// ADC linked with DMA | Master in dual mode
+
+	if(badc->BufferMultiMode != NULL){		// ADCs in dual mode
+
+		HAL_ADCEx_MultiModeStop_DMA(hadc);	// status ignored | DMA may already be stopped by error
+
+		return HAL_ADCEx_MultiModeStart_DMA(hadc, badc->BufferMultiMode, badc->BufferLength);
+	}
+
+	HAL_ADC_Stop_DMA(hadc);					// status ignored | DMA may already be stopped by error
+
+	return HAL_ADC_Start_DMA(hadc, (uint32_t*)badc->BufferADC, badc->BufferLength);
+}
+
+/**
+  * @brief ADC supervise function, detects stalled acquisition (stuck conversion, DMA stopped without error interrupt)
+  * 	   and restarts it. Should be called periodically with period longer than conversion of one scan
+  * @param  hadc    - pointer to ADC handle
+  * @param  badc    - pointer to ADC buffer structure
+  * @retval status  - HAL_OK if DMA made progress since previous call, HAL_TIMEOUT if stall was detected and acquisition restarted,
+  * 				  HAL_ERROR if restart failed
+  */
+HAL_StatusTypeDef  ADC_Supervise(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc){
+
+	// checking if correct parameters were provided | ADC without DMA is not supervised
+	if(hadc == NULL || badc == NULL || badc->hdma == NULL){
+		return HAL_ERROR;
+	}
+
+	// overrun stops DMA requests | restarting DMA
+	if(__ADC_IS_OVERRUN(hadc) != 0){
+		return (ADC_HandleOverrun(hadc, badc) == HAL_OK) ? HAL_TIMEOUT : HAL_ERROR;
+	}
+
+	// progress signature | number of completed half blocks and position of DMA inside storage
+	uint32_t progress = ((badc->HalfBlocks + badc->FullBlocks) << 16) + (uint32_t)__HAL_DMA_GET_COUNTER(badc->hdma);
+
+	if(progress != badc->Progress){
+		badc->Progress = progress;
+		return HAL_OK;
+	}
+
+	// no transfer since previous call
+	if(ADC_Recover(hadc, badc) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	return HAL_TIMEOUT;
+}
+
+/**
+  * @brief ADC overrun check function, detects OVR flag and restarts DMA | F1 family has no OVR flag, nothing is detected
+  * @param  hadc    - pointer to ADC handle
+  * @param  badc    - pointer to ADC buffer structure
+  * @retval status  - HAL_OK if no overrun occurred, HAL_BUSY if overrun was handled (badc->Discontinuous is set),
+  * 				  HAL_ERROR if parameters are incorrect or DMA restart failed
+  */
+HAL_StatusTypeDef  ADC_CheckOverrun(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc){
+
+	// checking if correct parameters were provided
+	if(hadc == NULL || badc == NULL){
+		return HAL_ERROR;
+	}
 
+	if(__ADC_IS_OVERRUN(hadc) == 0){
+		return HAL_OK;
+	}
+
+	return (ADC_HandleOverrun(hadc, badc) == HAL_OK) ? HAL_BUSY : HAL_ERROR;
+}
+
+/**
+  * @brief ADC hardware oversampler configuration function | each regular conversion returns (sum of ratio conversions) >> shift
+  * 	   Should be called while regular conversions are stopped, e.g. before ADC_Init
+  * @param  hadc    - pointer to ADC handle
+  * @param  ratio   - number of accumulated conversions | 1 disables oversampler, G4/L4: power of 2 up to 256, H7: up to 1024
+  * @param  shift   - right shift of accumulated sum | G4/L4: up to 8, H7: up to 11
+  * @retval status  - HAL_ERROR if family has no oversampler, parameters are incorrect or result exceeds 16-bit DMA storage,
+  * 				  HAL_BUSY if conversions are in progress
+  */
+HAL_StatusTypeDef  ADC_SetOversampling(ADC_HandleTypeDef* hadc, uint16_t ratio, uint8_t shift){
+
+	// checking if correct parameters were provided
+	if(hadc == NULL || ratio == 0){
+		return HAL_ERROR;
+	}
+
+	#if (ADC_HW_OVERSAMPLER == 1)
+
+		if(ratio > ADC_OVERSAMPLING_MAX_RATIO || shift > ADC_OVERSAMPLING_MAX_SHIFT){
+			return HAL_ERROR;
+		}
+
+		#if (ADC_OVERSAMPLING_POW2 == 1)
+			if((ratio & (ratio - 1U)) != 0){
+				return HAL_ERROR;
+			}
+		#endif
+
+		// oversampled value has to fit 16-bit storage | including left alignment
+		if(((((uint32_t)__ADC_RESOLUTION(hadc) * ratio) >> shift) << __ADC_DATA_SHIFT(hadc)) > 0xFFFFU){
+			return HAL_ERROR;
+		}
+
+		// oversampler is configured only while regular conversions are stopped
+		if(__ADC_IS_CONV_STARTED(hadc) != 0){
+			return HAL_BUSY;
+		}
+
+		__ADC_OVERSAMPLING_SET(hadc, ratio, shift);
+
+		return HAL_OK;
+
+	#else
+
+		// no oversampler | only disabled configuration is accepted
+		return (ratio == 1 && shift == 0) ? HAL_OK : HAL_ERROR;
+
+	#endif
+}
+
+/**
+  * @brief ADC hardware oversampler read function
+  * @param  hadc    - pointer to ADC handle
+  * @param  ratio   - pointer to number of accumulated conversions | 1 if oversampler is disabled or does not exist
+  * @param  shift   - pointer to right shift of accumulated sum
+  * @retval status  - HAL status if configuration was read
+  */
+HAL_StatusTypeDef  ADC_GetOversampling(ADC_HandleTypeDef* hadc, uint16_t* ratio, uint8_t* shift){
+
+	// checking if correct parameters were provided
+	if(hadc == NULL || ratio == NULL || shift == NULL){
+		return HAL_ERROR;
+	}
+
+	*ratio = (uint16_t)__ADC_OVERSAMPLING_RATIO(hadc);
+	*shift = (uint8_t)__ADC_OVERSAMPLING_SHIFT(hadc);
+
+	return HAL_OK;
+}
+
+/**
+  * @brief ADC resolution set function, switches resolution of regular conversions in runtime | lower resolution converts in fewer ADC clock cycles
+  * 	   (F2/F4: 15, 13, 11, 9 cycles + sampling time for 12, 10, 8, 6 bits), e.g. fast bursts of transient capture and 12 bits in steady state.
+  * 	   Running acquisition is stopped and started again, samples kept in storage are shifted to new resolution, so averaging stays continuous.
+  * 	   ADC_GetValue follows resolution by itself, published contexts are updated with ADC_ContextRescale
+  * @param  hadc    - pointer to ADC handle
+  * @param  badc    - pointer to ADC buffer structure
+  * @param  bits    - resolution | F2/F3/F4/G4/L4: 12, 10, 8, 6, H7: 16, 14, 12, 10, 8, F1: 12 only (simulated build: 12, 10, 8, 6)
+  * @retval status  - HAL_ERROR if resolution is not supported, does not fit storage packed to bytes or oversampled result exceeds 16 bits
+  */
+HAL_StatusTypeDef  ADC_SetResolution(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, uint8_t bits){
+
+	// checking if correct parameters were provided
+	if(hadc == NULL || badc == NULL){
+		return HAL_ERROR;
+	}
+
+	#if defined(STM32F1_FAMILY) && !defined(ADC_SIM)
+
+		// fixed 12-bit resolution
+		return (bits == 12) ? HAL_OK : HAL_ERROR;
+
+	#else
+
+		#if defined(STM32H7_FAMILY)
+			if(bits < 8 || bits > 16 || (bits & 1U) != 0){
+				return HAL_ERROR;
+			}
+		#else
+			if(bits < 6 || bits > 12 || (bits & 1U) != 0){
+				return HAL_ERROR;
+			}
+		#endif
+
+		uint8_t shift = __ADC_ALIGNED_SHIFT(hadc, bits);		// left alignment of new resolution
+
+		// storage packed to bytes holds conversions of 8 bits or lower only | including left alignment
+		if(__ADC_IS_PACKED(hadc->DMA_Handle) && (((1UL << bits) - 1U) << shift) > 0xFFU){
+			return HAL_ERROR;
+		}
+
+		// oversampled value has to fit 16-bit storage
+		if((((((1UL << bits) - 1U) * __ADC_OVERSAMPLING_RATIO(hadc)) >> __ADC_OVERSAMPLING_SHIFT(hadc)) << shift) > 0xFFFFU){
+			return HAL_ERROR;
+		}
+
+		uint8_t previous = ADC_ResolutionBits(__ADC_RESOLUTION(hadc));
+		uint8_t previousShift = __ADC_DATA_SHIFT(hadc);
+
+		if(previous == bits && previousShift == shift){
+			return HAL_OK;
+		}
+
+		uint8_t running = (__ADC_IS_CONV_STARTED(hadc) != 0) ? 1U : 0U;
+		ADC_HandleTypeDef* hdmaAdc = (badc->hdma != NULL) ? (ADC_HandleTypeDef*)badc->hdma->Parent : hadc;	// ADC linked with DMA | Master in dual mode
+
+		// resolution is written only while regular conversions are stopped
+		if(running != 0){
+			if(badc->hdma == NULL){
+				HAL_ADC_Stop(hadc);
+			}else if(badc->BufferMultiMode != NULL){
+				HAL_ADCEx_MultiModeStop_DMA(hdmaAdc);
+			}else{
+				HAL_ADC_Stop_DMA(hdmaAdc);
+			}
+		}
+
+		__ADC_SET_RESOLUTION(hadc, bits);
+
+		// shifting stored samples to new resolution | latest values stay valid until storage is refilled, left aligned data keeps its MSB position
+		ADC_RescaleStorage(hadc, badc, previous + previousShift, bits + shift);
+
+		if(running == 0){
+			return HAL_OK;
+		}
+
+		badc->Discontinuous = 1;	// conversions are missing while resolution is switched
+
+		if(badc->hdma == NULL){
+			return HAL_ADC_Start(hadc);
+		}
+
+		if(badc->BufferMultiMode != NULL){
+			return HAL_ADCEx_MultiModeStart_DMA(hdmaAdc, badc->BufferMultiMode, badc->BufferLength);
+		}
+
+		return HAL_ADC_Start_DMA(hdmaAdc, (uint32_t*)badc->BufferADC, badc->BufferLength);
+
+	#endif
 }
 
 /**
@@ -334,8 +794,8 @@ HAL_StatusTypeDef  ADC_ConfigGetRanksOfChannels(ADC_HandleTypeDef* hadc, ADC_Cha
 		return HAL_ERROR;
 	}
 
-	// Overwriting macro which stores info of number of channels to be converted
-	ADC_CONVERTED_CHANNELS = numberOfConversions;
+	// Overwriting number of channels to be converted by this ADC
+	cadc->NbrOfConversions = (uint8_t)numberOfConversions;
 
 
 	// reading ranks' assigned channels
@@ -392,8 +852,10 @@ HAL_StatusTypeDef  ADC_ConfigGetRanksOfChannels(ADC_HandleTypeDef* hadc, ADC_Cha
   */
 HAL_StatusTypeDef  ADC_GetRank(ADC_ChannelsTypeDef *cadc, uint8_t channel, uint8_t* rank){
 
-	// iterating though all buffer's elements to return given channel's rank
-	for(int i = 0 ; i < ADC_MAX_CHANNELS; ++i ){
+	*rank = ADC_MAX_CHANNELS; // marking rank as not found
+
+	// iterating though all converted ranks to return given channel's rank
+	for(int i = 0 ; i < cadc->NbrOfConversions; ++i ){
 		if(cadc->ranks[i] == channel){
 			*rank = (uint8_t)i;
 
@@ -411,7 +873,7 @@ HAL_StatusTypeDef  ADC_GetRank(ADC_ChannelsTypeDef *cadc, uint8_t channel, uint8
 
 /**
   * @brief ADC averaging function. ADC's channels' values oscillate in 40 Hz, function averages measures from exact number of conversions.
-  * 	   Macro: ADC_AVERAGED_MEASURES stores information about number of latest conversions to be measured
+  * 	   Field: AveragedMeasures of ADC buffer stores information about number of latest conversions to be measured
   * @param  hadc    - pointer to ADC handle
   * @param  badc    - ADC buffer, which stores converted values
   * @param  retval  - pointer to returning value | overwrite value from 0 to 15
@@ -419,7 +881,7 @@ HAL_StatusTypeDef  ADC_GetRank(ADC_ChannelsTypeDef *cadc, uint8_t channel, uint8
   */
 HAL_StatusTypeDef ADC_Averaging(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, uint8_t channel , uint16_t* retval){
 
-	uint64_t sum = 0; // sum of values from averaged channel
+	uint32_t sum = 0; // sum of values from averaged channel | up to 255 measures of 16-bit values fit in 32 bits
 	uint8_t rank;     // channel's rank
 
 	// Getting channel rank
@@ -427,58 +889,364 @@ HAL_StatusTypeDef ADC_Averaging(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc
 		return HAL_ERROR;
 	}
 
-	if(__ADC_IS_DMA_MULTIMODE(hadc) == 0){ // ADC in independent mode
-		if(sizeof(badc->idma.BufferADC)/sizeof(badc->idma.BufferADC[0]) < ADC_AVERAGED_MEASURES){
-			return HAL_ERROR;
-		}
-
+	// checking if averaging is configured
+	if(badc->AveragedMeasures == 0){
+		return HAL_ERROR;
+	}
 
-	}else{								   // ADC in dual mode
+	// checking if storage of used mode exists | dual mode is recognized by attached dual mode storage, because Slave has no multimode bits
+	if(badc->BufferMultiMode == NULL && badc->BufferADC == NULL){
+		return HAL_ERROR;
+	}
 
-		if(hadc->Instance == ADC1){
 
-			// Extracting ADC1 values from dual mode buffer
-			for(int  i = 0 ; i < ADC_BUFF_SIZE ; ++i){
-				badc->ddma.BufferADC_Master[i] = (uint16_t)((badc->ddma.BufferMultiMode[i] >> 16));
-			}
+	int id = 0; 														// current position of averaged value
+	int scans = badc->BufferLength / cadc->NbrOfConversions;			// number of whole scans of all channels in storage
+	int first = 0;														// first averaged scan
+	int packed = __ADC_IS_PACKED(badc->hdma);							// storage packed to bytes
 
-		}else{
+	// averaging done by hardware oversampler | latest completed scan holds sum of averaged measures, divided like in software
+	if(__ADC_IS_HW_AVERAGING(hadc, badc)){
+		int latest = scans - 1;
 
-			// Extracting ADC2 values from dual mode buffer
-			for(int  i = 0 ; i < ADC_BUFF_SIZE ; ++i){
-				badc->ddma.BufferADC_Slave[i] = (uint16_t)((badc->ddma.BufferMultiMode[i]));
-			}
+		if(badc->hdma != NULL && scans > 1){
+			int written = badc->BufferLength - (int)__HAL_DMA_GET_COUNTER(badc->hdma);	// transfers written in current DMA block
 
+			latest = (written / cadc->NbrOfConversions + scans - 1) % scans;			// scan before the one being converted
 		}
 
+		*retval = (uint16_t)(badc->BufferADC[latest * cadc->NbrOfConversions + rank] / badc->AveragedMeasures);
+
+		return HAL_OK;
+	}
+
+	// storage deeper than averaging depth | averaging latest completed scans, found by DMA's remaining transfers counter
+	if(badc->hdma != NULL && scans > badc->AveragedMeasures){
+		int written = badc->BufferLength - (int)__HAL_DMA_GET_COUNTER(badc->hdma);	// transfers written in current DMA block
+		int current = written / cadc->NbrOfConversions;								// scan being converted right now
 
+		first = (current + scans - badc->AveragedMeasures) % scans;
 	}
 
+	// single channel in independent mode without wrap of storage | averaged measures are dense array, summed by kernel (SIMD on DSP cores)
+	if(cadc->NbrOfConversions == 1 && badc->BufferMultiMode == NULL && packed == 0 && (first + badc->AveragedMeasures) <= scans){
+		*retval = (uint16_t)(ADC_DspSum(&badc->BufferADC[first], badc->AveragedMeasures) / badc->AveragedMeasures);
 
-	int id = 0; // current position of averaged value
+		return HAL_OK;
+	}
 
-	for( int i = 0; i < ADC_AVERAGED_MEASURES; ++i){
-		id = (i * ADC_CONVERTED_CHANNELS + rank); // id calculation base on multiplying current iteration by number of conversions to be measures, cause DMA stores continuously conversion though channels until last index of DMA buffer occurs
+	for( int i = 0; i < badc->AveragedMeasures; ++i){
+		id = (((first + i) % scans) * cadc->NbrOfConversions + rank); // id calculation base on multiplying scan by number of conversions to be measures, cause DMA stores continuously conversion though channels until last index of DMA buffer occurs
 
 		// security check | if calculated id is beyond array limits
-		if(id >= ADC_BUFF_SIZE){
+		if(id >= badc->BufferLength){
 			return HAL_ERROR;
 		}
 
 		// adding to sum variable next value correlated to current channel
-		sum += ((__ADC_IS_DMA_MULTIMODE(hadc) == 0)
-					 ? badc->idma.BufferADC[id] 							 // adding value of ADC in independent mode
+		sum += ((badc->BufferMultiMode == NULL)
+					 ? (packed ? badc->BufferPacked[id] : badc->BufferADC[id]) 					// adding value of ADC in independent mode
 				      :((hadc->Instance == ADC1)
-					 ? badc->ddma.BufferADC_Master[id]
-	                  : badc->ddma.BufferADC_Slave[id]));                   // adding value of ADC in dual mode | checking instance
+					 ? __ADC_DUAL_MASTER_DATA(badc->BufferMultiMode[id])
+	                  : __ADC_DUAL_SLAVE_DATA(badc->BufferMultiMode[id])));                   // adding value of ADC in dual mode | extracting half-word of instance
 	}
 
-	*retval = (uint16_t)(sum / ADC_AVERAGED_MEASURES); // averaging by dividing sum with number of averaged conversions
+	*retval = (uint16_t)(sum / badc->AveragedMeasures); // averaging by dividing sum with number of averaged conversions
 
 	return HAL_OK;
 }
 
 
+/**
+  * @brief ADC instance register function | stores pair of handle and buffer to find buffer in DMA callbacks
+  * @param  hadc    - pointer to ADC handle
+  * @param  badc    - pointer to ADC buffer structure
+  * @retval status  - HAL status if instance was registered or was already registered
+  */
+static HAL_StatusTypeDef ADC_RegisterInstance(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc){
+
+	// iterating through registered instances | re-init of ADC overwrites its buffer
+	for(int i = 0; i < ADC_MAX_INSTANCES; ++i){
+		if(ADC_INSTANCES_HANDLES[i] == hadc || ADC_INSTANCES_HANDLES[i] == NULL){
+			ADC_INSTANCES_HANDLES[i] = hadc;
+			ADC_INSTANCES_BUFFERS[i] = badc;
+
+			return HAL_OK;
+		}
+	}
+
+	return HAL_ERROR; // no free slot for instance
+}
+
+/**
+  * @brief ADC buffer find function | returns buffer registered with given ADC handle
+  * @param  hadc    - pointer to ADC handle
+  * @retval badc    - pointer to ADC buffer structure or NULL if ADC was not registered
+  */
+static ADC_BufferTypeDef* ADC_FindBuffer(ADC_HandleTypeDef* hadc){
+
+	for(int i = 0; i < ADC_MAX_INSTANCES; ++i){
+		if(ADC_INSTANCES_HANDLES[i] == hadc){
+			return ADC_INSTANCES_BUFFERS[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+  * @brief ADC DMA re-arm function for DMA in normal mode | re-arms only if whole storage was transferred
+  * 	   Fast path writes DMA and ADC registers directly, otherwise HAL start functions are called
+  * @param  badc    - pointer to ADC buffer structure with DMA handle stored by init
+  * @retval status  - HAL status if DMA was re-armed or transfer is still in progress
+  */
+static HAL_StatusTypeDef ADC_RearmDMA(ADC_BufferTypeDef* badc){
+
+	DMA_HandleTypeDef* hdma = badc->hdma;
+
+	// checking if DMA was stored by init
+	if(hdma == NULL){
+		return HAL_ERROR;
+	}
+
+	// transfer of storage still in progress | nothing to re-arm
+	if(__HAL_DMA_GET_COUNTER(hdma) != 0){
+		return HAL_OK;
+	}
+
+	return ADC_RestartDMA(badc);
+}
+
+/**
+  * @brief ADC DMA restart function, starts transfer from beginning of storage regardless of its progress
+  * 	   Fast path writes DMA and ADC registers directly, otherwise HAL start functions are called
+  * @param  badc    - pointer to ADC buffer structure with DMA handle stored by init
+  * @retval status  - HAL status if DMA was restarted
+  */
+static HAL_StatusTypeDef ADC_RestartDMA(ADC_BufferTypeDef* badc){
 
+	DMA_HandleTypeDef* hdma = badc->hdma;
+	ADC_HandleTypeDef* hadc = (ADC_HandleTypeDef*)hdma->Parent;	// ADC linked with DMA | Master in dual mode
 
+	#if (ADC_FAST_PATH == 1)
 
+		// re-loading number of transfers | memory address stays unchanged
+		__HAL_DMA_DISABLE(hdma);
+		__ADC_DMA_WAIT_DISABLED(hdma);
+		__HAL_DMA_CLEAR_FLAG(hdma, __HAL_DMA_GET_TC_FLAG_INDEX(hdma) | __HAL_DMA_GET_HT_FLAG_INDEX(hdma) | __HAL_DMA_GET_TE_FLAG_INDEX(hdma));
+		__ADC_DMA_SET_COUNTER(hdma, badc->BufferLength);
+		__HAL_DMA_ENABLE_IT(hdma, DMA_IT_TC | DMA_IT_HT | DMA_IT_TE);	// HAL interrupt handler disables them after last transfer in normal mode
+		hdma->ErrorCode = HAL_DMA_ERROR_NONE;
+		hdma->State     = HAL_DMA_STATE_BUSY;							// error handler leaves READY | HAL_DMA_Abort of stop functions disables only BUSY channel
+		__HAL_DMA_ENABLE(hdma);
+
+		// F2/F4 toggle DMA bit, F3/G4/L4/H7 stop ADC and issue ADSTART again | one-shot DMA requests resume only then
+		__ADC_DMA_REQUESTS_RESTART(hadc);
+
+		// re-launching conversions if ADC does not convert continuously
+		if(__ADC_MODE(hadc) == 0){
+			__ADC_SW_START(hadc);
+		}
+
+	#else
+
+		if(badc->BufferMultiMode != NULL){		// ADCs in dual mode
+
+			if(HAL_ADCEx_MultiModeStart_DMA(hadc, badc->BufferMultiMode, badc->BufferLength) != HAL_OK){
+				return HAL_ERROR;
+			}
+
+		}else{									// ADC in independent mode
+
+			if(HAL_ADC_Start_DMA(hadc, (uint32_t*)badc->BufferADC, badc->BufferLength) != HAL_OK){
+				return HAL_ERROR;
+			}
+		}
+
+	#endif
+
+	return HAL_OK;
+}
+
+/**
+  * @brief ADC overrun handle function, counts overrun, clears OVR flag and restarts DMA and conversions
+  * @param  hadc    - pointer to ADC handle, whose overrun occurred
+  * @param  badc    - pointer to ADC buffer structure
+  * @retval status  - HAL status if acquisition was restarted
+  */
+static HAL_StatusTypeDef ADC_HandleOverrun(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc){
+
+	badc->Overruns++;
+	badc->Discontinuous = 1;	// conversions between overrun and restart are lost
+
+	__ADC_CLEAR_OVERRUN(hadc);
+
+	// ADC without DMA | relaunching conversions only
+	if(badc->hdma == NULL){
+		__ADC_SW_START(hadc);
+		return HAL_OK;
+	}
+
+	#if (ADC_FAST_PATH == 1)
+
+		if(ADC_RestartDMA(badc) != HAL_OK){
+			return HAL_ERROR;
+		}
+
+		// conversions were stopped by overrun | continuous mode has to be started again as well
+		if(__ADC_MODE(hadc) != 0){
+			__ADC_SW_START((ADC_HandleTypeDef*)badc->hdma->Parent);
+		}
+
+		return HAL_OK;
+
+	#else
+
+		return ADC_Recover(hadc, badc);
+
+	#endif
+}
+
+/**
+  * @brief ADC averaging offload function, programs hardware oversampler to accumulate averaged measures of each conversion
+  * 	   Oversampler configured by user, dual mode, families without oversampler and depths, whose sum does not fit 16 bits,
+  * 	   are left to software averaging
+  * @param  hadc    - pointer to ADC handle | conversions are stopped
+  * @param  badc    - pointer to ADC buffer structure
+  */
+static void ADC_OffloadAveraging(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc){
+
+	#if (ADC_HW_AVERAGING == 1) && (ADC_HW_OVERSAMPLER == 1)
+
+		// oversampler configured by user is kept | sum does not fit storage packed to bytes
+		if(badc->BufferADC == NULL || __ADC_IS_PACKED(hadc->DMA_Handle) || __ADC_OVERSAMPLING_RATIO(hadc) != 1U){
+			return;
+		}
+
+		if(ADC_HW_AVERAGING_SUPPORTED(badc->AveragedMeasures, __ADC_DATA_MAX(hadc))){
+			(void)ADC_SetOversampling(hadc, badc->AveragedMeasures, 0);	// unshifted sum | division is identical to software averaging
+		}
+
+	#else
+
+		UNUSED(hadc);
+		UNUSED(badc);
+
+	#endif
+}
+
+/**
+  * @brief ADC handle find function | looks for registered handle of buffer
+  * @param  badc    - pointer to ADC buffer structure
+  * @retval hadc    - pointer to ADC handle | NULL if buffer is not registered
+  */
+static ADC_HandleTypeDef* ADC_FindHandle(ADC_BufferTypeDef* badc){
+
+	for(int i = 0; i < ADC_MAX_INSTANCES; ++i){
+		if(ADC_INSTANCES_BUFFERS[i] == badc){
+			return ADC_INSTANCES_HANDLES[i];
+		}
+	}
+
+	return NULL;
+}
+
+#if !defined(STM32F1_FAMILY) || defined(ADC_SIM)
+
+/**
+  * @brief ADC storage rescale function, shifts samples of ADC kept in storage and polled values to new resolution
+  * @param  hadc    - pointer to ADC handle | its half-words are rescaled in dual mode storage
+  * @param  badc    - pointer to ADC buffer structure
+  * @param  from    - previous resolution in bits
+  * @param  to      - new resolution in bits
+  */
+static void ADC_RescaleStorage(ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, uint8_t from, uint8_t to){
+
+	uint8_t up    = (to > from) ? 1U : 0U;
+	uint8_t shift = up ? (to - from) : (from - to);
+
+	for(int i = 0; i < ADC_MAX_CHANNELS; ++i){
+		badc->ADC_Buff[i] = up ? (uint16_t)(badc->ADC_Buff[i] << shift) : (uint16_t)(badc->ADC_Buff[i] >> shift);
+	}
+
+	if(badc->BufferMultiMode != NULL){				// dual mode | only half-word of this instance
+
+		uint32_t slave = (hadc->Instance == ADC1) ? 0U : 16U;
+
+		for(int i = 0; i < badc->BufferLength; ++i){
+			uint32_t value = (badc->BufferMultiMode[i] >> slave) & 0xFFFFU;
+
+			value = up ? ((value << shift) & 0xFFFFU) : (value >> shift);
+			badc->BufferMultiMode[i] = (badc->BufferMultiMode[i] & ~(0xFFFFUL << slave)) | (value << slave);
+		}
+
+	}else if(badc->BufferADC != NULL){
+
+		for(int i = 0; i < badc->BufferLength; ++i){
+			if(__ADC_IS_PACKED(hadc->DMA_Handle)){
+				badc->BufferPacked[i] = up ? (uint8_t)(badc->BufferPacked[i] << shift) : (uint8_t)(badc->BufferPacked[i] >> shift);
+			}else{
+				badc->BufferADC[i]    = up ? (uint16_t)(badc->BufferADC[i] << shift)    : (uint16_t)(badc->BufferADC[i] >> shift);
+			}
+		}
+	}
+}
+
+/**
+  * @brief ADC resolution bits function | converts maximal converted value to number of bits
+  * @param  resolution - maximal converted value (__ADC_RESOLUTION)
+  * @retval bits       - number of bits
+  */
+static uint8_t ADC_ResolutionBits(uint32_t resolution){
+
+	uint8_t bits = 0;
+
+	while(resolution != 0){
+		resolution >>= 1;
+		bits++;
+	}
+
+	return bits;
+}
+
+#endif
+
+/**
+  * @brief ADC calibration function | calibration does not exist in F2 and F4 family
+  * @param  hadc    - pointer to ADC handle
+  * @retval status  - HAL status if calibration succeeded within ADC_CALIBRATION_RETRIES attempts
+  */
+static HAL_StatusTypeDef ADC_Calibrate(ADC_HandleTypeDef* hadc){
+
+	#if !(defined(STM32F2_FAMILY) || defined(STM32F4_FAMILY))
+
+		for(int i = 0; i < ADC_CALIBRATION_RETRIES; ++i){
+
+			#if defined(STM32F1_FAMILY)
+				// launching calibration for F1 core
+				if(HAL_ADCEx_Calibration_Start(hadc) == HAL_OK){
+					return HAL_OK;
+				}
+			#elif defined(STM32H7_FAMILY)
+				// launching offset and linearity calibration for H7 core
+				if(HAL_ADCEx_Calibration_Start(hadc, ADC_CALIB_OFFSET_LINEARITY, ADC_SINGLE_ENDED) == HAL_OK){
+					return HAL_OK;
+				}
+			#else
+				// launching calibration for F3, G4 and L4 core
+				if(HAL_ADCEx_Calibration_Start(hadc, ADC_SINGLE_ENDED) == HAL_OK){
+					return HAL_OK;
+				}
+			#endif
+		}
+
+		return HAL_ERROR;
+
+	#else
+
+		UNUSED(hadc);
+
+		return HAL_OK;
+
+	#endif
+}
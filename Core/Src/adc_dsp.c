@@ -0,0 +1,224 @@
+
+/**
+  ******************************************************************************
+  * @file      adc_dsp.c
+  * @author    Bartosz Rychlicki
+  * @Title     Arithmetic kernels for ADC driver
+  * @brief     This file contains functions' bodies of summation, RMS and FIR kernels | SIMD and reference implementation
+  ******************************************************************************
+  * @attention Reference implementation is used on cores without DSP extension (F0, F1, L0, G0 ...)
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_dsp.h"
+
+// Private functions prototypes
+static uint32_t ADC_DspSqrt(uint32_t value);
+
+// Private Macros
+#define ADC_DSP_ONES		0x00010001U		// pair of half-words equal to 1 | SMLAD with it sums two samples
+#define ADC_DSP_OFFSET		0x80008000U		// MSB of both half-words | XOR turns unsigned samples into signed ones offset by 0x8000
+
+
+/**
+  * @brief Summation kernel
+  * @param  x       - pointer to dense array of samples
+  * @param  n       - number of samples
+  * @retval sum     - sum of samples
+  */
+uint32_t ADC_DspSum(const uint16_t* x, uint16_t n){
+
+	uint32_t sum = 0;
+	uint16_t i   = 0;
+
+	#if defined(ADC_DSP_SIMD)
+
+		// two samples per instruction | samples are offset to signed range, so left-aligned samples are summed exactly
+		for(; (uint16_t)(i + 1U) < n; i += 2U){
+			sum = __ADC_SMLAD(__ADC_DSP_PAIR(&x[i]) ^ ADC_DSP_OFFSET, ADC_DSP_ONES, sum);
+		}
+
+		sum += (uint32_t)i << 15;		// removing offset of summed samples
+
+	#endif
+
+	// reference implementation and odd sample
+	for(; i < n; ++i){
+		sum += x[i];
+	}
+
+	return sum;
+}
+
+
+/**
+  * @brief Sum of squares kernel | used by RMS and variance
+  * @param  x       - pointer to dense array of samples
+  * @param  n       - number of samples
+  * @retval sum     - sum of squared samples
+  */
+uint64_t ADC_DspSumSquares(const uint16_t* x, uint16_t n){
+
+	uint64_t sum = 0;
+	uint16_t i   = 0;
+
+	#if defined(ADC_DSP_SIMD)
+
+		uint32_t offsetSum = 0;
+
+		// two squares per instruction | (s + 0x8000)^2 = s^2 + 2^16 * s + 2^30, where s is sample offset to signed range
+		for(; (uint16_t)(i + 1U) < n; i += 2U){
+			uint32_t pair = __ADC_DSP_PAIR(&x[i]) ^ ADC_DSP_OFFSET;
+
+			sum       = __ADC_SMLALD(pair, pair, sum);
+			offsetSum = __ADC_SMLAD(pair, ADC_DSP_ONES, offsetSum);
+		}
+
+		sum += ((uint64_t)(int64_t)(int32_t)offsetSum << 16) + ((uint64_t)i << 30);
+
+	#endif
+
+	// reference implementation and odd sample
+	for(; i < n; ++i){
+		sum += (uint32_t)x[i] * x[i];
+	}
+
+	return sum;
+}
+
+
+/**
+  * @brief Mean kernel
+  * @param  x       - pointer to dense array of samples
+  * @param  n       - number of samples
+  * @retval mean    - mean of samples | 0 if n is 0
+  */
+uint16_t ADC_DspMean(const uint16_t* x, uint16_t n){
+
+	if(n == 0){
+		return 0;
+	}
+
+	return (uint16_t)(ADC_DspSum(x, n) / n);
+}
+
+
+/**
+  * @brief RMS kernel
+  * @param  x       - pointer to dense array of samples
+  * @param  n       - number of samples
+  * @retval rms     - root mean square of samples | 0 if n is 0
+  */
+uint16_t ADC_DspRms(const uint16_t* x, uint16_t n){
+
+	if(n == 0){
+		return 0;
+	}
+
+	return (uint16_t)ADC_DspSqrt((uint32_t)(ADC_DspSumSquares(x, n) / n));
+}
+
+
+/**
+  * @brief FIR kernel, computes one output of filter over window of samples
+  * @param  coeffs  - pointer to Q15 coefficients, coeffs[k] multiplies x[k]
+  * @param  x       - pointer to dense array of taps samples (ADC_HistoryWindow)
+  * @param  taps    - number of coefficients
+  * @retval y       - filtered value in units of samples (accumulator shifted by 15)
+  */
+int32_t ADC_DspFir(const int16_t* coeffs, const uint16_t* x, uint16_t taps){
+
+	int32_t  acc = 0;
+	uint16_t i   = 0;
+
+	#if defined(ADC_DSP_SIMD)
+
+		// two taps per instruction
+		for(; (uint16_t)(i + 1U) < taps; i += 2U){
+			acc = (int32_t)__ADC_SMLAD(__ADC_DSP_PAIR(&coeffs[i]), __ADC_DSP_PAIR(&x[i]), (uint32_t)acc);
+		}
+
+	#endif
+
+	// reference implementation and odd tap
+	for(; i < taps; ++i){
+		acc += (int32_t)coeffs[i] * (int32_t)x[i];
+	}
+
+	return acc >> 15;
+}
+
+
+/**
+  * @brief FIR kernel working on left-aligned samples consumed as Q15 fractions | MSB is inverted, so mid-scale is 0
+  * @param  coeffs  - pointer to Q15 coefficients, coeffs[k] multiplies x[k]
+  * @param  x       - pointer to dense array of taps left-aligned samples (ADC_HistoryWindow)
+  * @param  taps    - number of coefficients
+  * @retval y       - filtered Q15 value | saturated
+  */
+int16_t ADC_DspFirQ15(const int16_t* coeffs, const uint16_t* x, uint16_t taps){
+
+	int64_t  acc = 0;
+	uint16_t i   = 0;
+
+	#if defined(ADC_DSP_SIMD)
+
+		// two taps per instruction | 64-bit accumulator does not overflow for any number of taps
+		for(; (uint16_t)(i + 1U) < taps; i += 2U){
+			acc = (int64_t)__ADC_SMLALD(__ADC_DSP_PAIR(&coeffs[i]), __ADC_DSP_PAIR(&x[i]) ^ ADC_DSP_OFFSET, (uint64_t)acc);
+		}
+
+	#endif
+
+	// reference implementation and odd tap
+	for(; i < taps; ++i){
+		acc += (int32_t)coeffs[i] * (int32_t)__ADC_Q15(x[i]);
+	}
+
+	acc >>= 15;
+
+	if(acc > INT16_MAX){
+		return INT16_MAX;
+	}
+
+	if(acc < INT16_MIN){
+		return INT16_MIN;
+	}
+
+	return (int16_t)acc;
+}
+
+
+/**
+  * @brief Integer square root | avoids linking libm
+  * @param  value   - radicand
+  * @retval root    - floor of square root
+  */
+static uint32_t ADC_DspSqrt(uint32_t value){
+
+	uint32_t root = 0;
+	uint32_t bit  = 1UL << 30;
+
+	// highest power of 4 lower or equal to value
+	while(bit > value){
+		bit >>= 2;
+	}
+
+	while(bit != 0){
+		if(value >= root + bit){
+			value -= root + bit;
+			root   = (root >> 1) + bit;
+		}else{
+			root >>= 1;
+		}
+
+		bit >>= 2;
+	}
+
+	return root;
+}
@@ -0,0 +1,222 @@
+
+/**
+  ******************************************************************************
+  * @file      adc_history.c
+  * @author    Bartosz Rychlicki
+  * @Title     Channel-major sample history for ADC driver
+  * @brief     This file contains functions' bodies of transposition of rank-interleaved DMA blocks into per-channel rings
+  ******************************************************************************
+  * @attention On cores with DSP extension (ADC_DSP_SIMD) pairs of scans are transposed with word-wide loads and PKHBT/PKHTB,
+  * 		   host build with ADC_DSP_EMULATE runs the same path with intrinsics emulated in C (Tests/test_history.c)
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_history.h"
+#include "adc_dsp.h"
+
+// Private functions prototypes
+static inline void ADC_HistoryWrite(ADC_HistoryTypeDef* hist, uint16_t sample);
+
+#if defined(ADC_DSP_SIMD)
+static uint16_t    ADC_HistoryTransposePairs(ADC_HistoryTypeDef* hist, const uint16_t* block, uint16_t transfers);
+#endif
+
+
+/**
+  * @brief History init function, attaches caller-provided storage
+  * @param  hist     - pointer to history structure
+  * @param  storage  - pointer to ADC_HISTORY_STORAGE_LENGTH(channels, depth) half-words, aligned to word
+  * @param  channels - number of converted channels (ranks) in DMA block
+  * @param  depth    - number of samples kept per channel | power of 2
+  * @retval status   - HAL status if history was initialized
+  */
+HAL_StatusTypeDef ADC_HistoryInit(ADC_HistoryTypeDef* hist, uint16_t* storage, uint8_t channels, uint16_t depth){
+
+	// checking if correct parameters were provided
+	if(hist == NULL || storage == NULL || channels == 0 || channels > ADC_MAX_CHANNELS){
+		return HAL_ERROR;
+	}
+
+	// checking if depth is power of 2 | ring index is wrapped with mask
+	if(depth == 0 || (depth & (depth - 1)) != 0){
+		return HAL_ERROR;
+	}
+
+	hist->Storage  = storage;
+	hist->Depth    = depth;
+	hist->Channels = channels;
+
+	ADC_HistoryReset(hist);
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief History reset function, drops all stored samples
+  * @param  hist    - pointer to history structure
+  */
+void ADC_HistoryReset(ADC_HistoryTypeDef* hist){
+
+	hist->Rank  = 0;
+	hist->Head  = 0;
+	hist->Scans = 0;
+}
+
+
+/**
+  * @brief History push function, transposes rank-interleaved block of ADC in independent mode
+  * 	   Should be called from ADC_BlockCpltCallback with completed part of DMA storage
+  * @param  hist      - pointer to history structure
+  * @param  block     - pointer to first transfer of completed part of DMA storage
+  * @param  transfers - number of transfers in block | may end inside scan, next block continues from that rank
+  * @retval status    - HAL status if block was pushed
+  */
+HAL_StatusTypeDef ADC_HistoryPush(ADC_HistoryTypeDef* hist, const uint16_t* block, uint16_t transfers){
+
+	// checking if correct parameters were provided
+	if(hist == NULL || hist->Storage == NULL || block == NULL){
+		return HAL_ERROR;
+	}
+
+	#if defined(ADC_DSP_SIMD)
+
+		// word-wide transposition of pairs of whole scans
+		uint16_t done = ADC_HistoryTransposePairs(hist, block, transfers);
+
+		block     += done;
+		transfers -= done;
+
+	#endif
+
+	// transposing rest of block sample by sample
+	for(uint16_t i = 0; i < transfers; ++i){
+		ADC_HistoryWrite(hist, block[i]);
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief History push function, transposes rank-interleaved block of ADCs in dual mode
+  * @param  hist      - pointer to history structure
+  * @param  block     - pointer to first transfer of completed part of dual mode DMA storage
+  * @param  transfers - number of transfers (words) in block
+  * @param  slave     - 0: Master's (ADC1) half-words are pushed, otherwise Slave's (ADC2)
+  * @retval status    - HAL status if block was pushed
+  */
+HAL_StatusTypeDef ADC_HistoryPushMultimode(ADC_HistoryTypeDef* hist, const uint32_t* block, uint16_t transfers, uint8_t slave){
+
+	// checking if correct parameters were provided
+	if(hist == NULL || hist->Storage == NULL || block == NULL){
+		return HAL_ERROR;
+	}
+
+	for(uint16_t i = 0; i < transfers; ++i){
+		ADC_HistoryWrite(hist, (slave == 0) ? __ADC_DUAL_MASTER_DATA(block[i]) : __ADC_DUAL_SLAVE_DATA(block[i]));
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief History window function, returns dense array of latest samples of one channel | window ends with latest complete scan
+  * 	   After block ended inside scan (Rank != 0), ranks below Rank already hold sample of scan in progress in place of
+  * 	   the oldest one, so window of whole depth is exact for these ranks only at scan boundary
+  * @param  hist    - pointer to history structure
+  * @param  rank    - rank of channel in scan (ADC_GetRank)
+  * @param  samples - number of latest samples in window | lower or equal to depth, lower than depth while block ends inside scan
+  * @retval pointer - pointer to oldest sample of window, samples are ordered from oldest to latest | NULL if parameters are incorrect
+  */
+const uint16_t* ADC_HistoryWindow(ADC_HistoryTypeDef* hist, uint8_t rank, uint16_t samples){
+
+	// checking if correct parameters were provided
+	if(hist == NULL || hist->Storage == NULL || rank >= hist->Channels || samples > hist->Depth){
+		return NULL;
+	}
+
+	// mirrored copy of ring makes [Head - samples, Head) contiguous at offset Head + Depth - samples
+	return &hist->Storage[(uint32_t)rank * 2U * hist->Depth + hist->Head + hist->Depth - samples];
+}
+
+
+/**
+  * @brief History write function, writes one interleaved sample to ring of its rank and its mirror
+  * @param  hist    - pointer to history structure
+  * @param  sample  - converted value
+  */
+static inline void ADC_HistoryWrite(ADC_HistoryTypeDef* hist, uint16_t sample){
+
+	uint16_t* ring = &hist->Storage[(uint32_t)hist->Rank * 2U * hist->Depth];
+
+	ring[hist->Head]               = sample;
+	ring[hist->Head + hist->Depth] = sample;
+
+	// moving to next rank | scan completed, moving head of all rings
+	if(++hist->Rank >= hist->Channels){
+		hist->Rank  = 0;
+		hist->Head  = (hist->Head + 1U) & (hist->Depth - 1U);
+		hist->Scans++;
+	}
+}
+
+
+#if defined(ADC_DSP_SIMD)
+
+/**
+  * @brief History word-wide transposition function. Word of rank r and r + 1 is loaded from two following scans,
+  * 	   PKHBT/PKHTB pack both samples of rank r and both samples of rank r + 1 into words stored in rings
+  * @param  hist      - pointer to history structure
+  * @param  block     - pointer to first transfer of block
+  * @param  transfers - number of transfers in block
+  * @retval done      - number of transposed transfers | 0 if block or history layout does not allow word access
+  */
+static uint16_t ADC_HistoryTransposePairs(ADC_HistoryTypeDef* hist, const uint16_t* block, uint16_t transfers){
+
+	uint16_t channels = hist->Channels;
+
+	// word access requires scan starting at aligned address, even number of ranks and even position in rings
+	if(hist->Rank != 0 || (channels & 1U) != 0 || (hist->Head & 1U) != 0 || ((uintptr_t)block & 3U) != 0 || hist->Depth < 2){
+		return 0;
+	}
+
+	uint16_t pairs = transfers / (2U * channels);	// number of pairs of whole scans in block
+	uint32_t ring  = 2U * hist->Depth;				// distance between rings of following ranks
+
+	for(uint16_t p = 0; p < pairs; ++p){
+
+		const uint32_t* scan0 = (const uint32_t*)&block[(uint32_t)p * 2U * channels];
+		const uint32_t* scan1 = scan0 + channels / 2U;
+
+		for(uint16_t r = 0; r < channels; r += 2U){
+
+			uint32_t w0 = scan0[r / 2U];		// rank r and r + 1 of scan 0
+			uint32_t w1 = scan1[r / 2U];		// rank r and r + 1 of scan 1
+
+			uint32_t even = __ADC_PKHBT(w0, w1, 16);	// rank r     of scan 0 and 1
+			uint32_t odd  = __ADC_PKHTB(w1, w0, 16);	// rank r + 1 of scan 0 and 1
+
+			uint32_t* dst0 = (uint32_t*)&hist->Storage[r * ring + hist->Head];
+			uint32_t* dst1 = (uint32_t*)&hist->Storage[(r + 1U) * ring + hist->Head];
+
+			dst0[0]                = even;
+			dst0[hist->Depth / 2U] = even;		// mirrored copy
+			dst1[0]                = odd;
+			dst1[hist->Depth / 2U] = odd;		// mirrored copy
+		}
+
+		hist->Head   = (hist->Head + 2U) & (hist->Depth - 1U);
+		hist->Scans += 2U;
+	}
+
+	return (uint16_t)(pairs * 2U * channels);
+}
+
+#endif
@@ -0,0 +1,286 @@
+
+/**
+  ******************************************************************************
+  * @file      adc_latency.c
+  * @author    Bartosz Rychlicki
+  * @Title     End-to-end latency tracking for ADC driver
+  * @brief     This file contains functions' bodies of block stamping, per stage histograms, deadline checks and export
+  ******************************************************************************
+  * @attention Every stage should be marked from one context only | snapshots are taken in critical section
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_latency.h"
+#include <stdio.h>
+#include <string.h>
+
+// Private functions prototypes
+static uint32_t ADC_LatencyCycles(void);
+static void     ADC_LatencyClearStage(ADC_LatencyStageTypeDef* st);
+
+
+/**
+  * @brief Latency tracker init function
+  * @param  lat     - pointer to latency tracker structure
+  * @param  clock   - time source | NULL: core cycle counter (__ADC_CYCLES), scheduler's clock when stamps of events are used
+  * @retval status  - HAL status if tracker was initialized
+  */
+HAL_StatusTypeDef ADC_LatencyInit(ADC_LatencyTypeDef* lat, ADC_SchedClockTypeDef clock){
+
+	// checking if correct parameters were provided
+	if(lat == NULL){
+		return HAL_ERROR;
+	}
+
+	memset(lat, 0, sizeof(ADC_LatencyTypeDef));
+
+	if(clock == NULL){
+		__ADC_CYCLES_ENABLE();
+		clock = ADC_LatencyCycles;
+	}
+
+	lat->Clock = clock;
+
+	ADC_LatencyReset(lat);
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Latency stage config function
+  * @param  lat      - pointer to latency tracker structure
+  * @param  stage    - index of stage | lower than ADC_LATENCY_MAX_STAGES
+  * @param  name     - name of stage used in text export | string has to stay valid
+  * @param  deadline - maximal allowed time since capture [cycles] | 0: not checked
+  * @retval status   - HAL status if stage was configured
+  */
+HAL_StatusTypeDef ADC_LatencyConfigStage(ADC_LatencyTypeDef* lat, uint8_t stage, const char* name, uint32_t deadline){
+
+	// checking if correct parameters were provided
+	if(lat == NULL || stage >= ADC_LATENCY_MAX_STAGES){
+		return HAL_ERROR;
+	}
+
+	lat->Stages[stage].Name     = name;
+	lat->Stages[stage].Deadline = deadline;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Latency capture function, stamps completed block | should be called first in ADC_BlockCpltCallback
+  * @param  lat     - pointer to latency tracker structure
+  * @retval stamp   - capture stamp, which should travel with block to following stages
+  */
+uint32_t ADC_LatencyCapture(ADC_LatencyTypeDef* lat){
+
+	uint32_t stamp = lat->Clock();
+
+	lat->LastCapture = stamp;
+	lat->Captures++;
+
+	return stamp;
+}
+
+
+/**
+  * @brief Latency mark function, records time elapsed since capture of block in stage's statistics
+  * @param  lat     - pointer to latency tracker structure
+  * @param  stage   - index of stage
+  * @param  capture - capture stamp of processed block (ADC_LatencyCapture or ADC_EventTypeDef Stamp)
+  * @retval latency - time since capture [cycles] | 0 if stage is incorrect
+  */
+uint32_t ADC_LatencyMark(ADC_LatencyTypeDef* lat, uint8_t stage, uint32_t capture){
+
+	if(stage >= ADC_LATENCY_MAX_STAGES){
+		return 0;
+	}
+
+	ADC_LatencyStageTypeDef* st = &lat->Stages[stage];
+
+	uint32_t latency = lat->Clock() - capture;
+	uint32_t bin     = (latency == 0) ? 0 : 32U - __CLZ(latency);
+
+	if(bin >= ADC_LATENCY_BINS){
+		bin = ADC_LATENCY_BINS - 1U;
+	}
+
+	st->Bins[bin]++;
+	st->Count++;
+	st->Sum += latency;
+
+	if(latency < st->Min){
+		st->Min = latency;
+	}
+
+	if(latency > st->Max){
+		st->Max = latency;
+	}
+
+	if(st->Deadline != 0 && latency > st->Deadline){
+		st->Misses++;
+	}
+
+	return latency;
+}
+
+
+/**
+  * @brief Latency consume function, marks stage against latest captured block | for consumers reading without block stamp
+  * @param  lat     - pointer to latency tracker structure
+  * @param  stage   - index of stage
+  * @retval latency - time since capture of latest block [cycles]
+  */
+uint32_t ADC_LatencyConsume(ADC_LatencyTypeDef* lat, uint8_t stage){
+
+	return ADC_LatencyMark(lat, stage, lat->LastCapture);
+}
+
+
+/**
+  * @brief Latency snapshot function, copies consistent statistics of stage
+  * @param  lat      - pointer to latency tracker structure
+  * @param  stage    - index of stage
+  * @param  snapshot - pointer to returned copy of statistics
+  * @retval status   - HAL status if snapshot was taken
+  */
+HAL_StatusTypeDef ADC_LatencyGetStage(ADC_LatencyTypeDef* lat, uint8_t stage, ADC_LatencyStageTypeDef* snapshot){
+
+	// checking if correct parameters were provided
+	if(lat == NULL || snapshot == NULL || stage >= ADC_LATENCY_MAX_STAGES){
+		return HAL_ERROR;
+	}
+
+	__ADC_CRITICAL_ENTER();
+	*snapshot = lat->Stages[stage];
+	__ADC_CRITICAL_EXIT();
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Latency percentile function, estimates percentile from histogram
+  * @param  snapshot - pointer to statistics of stage
+  * @param  permille - percentile [0.1 %] | e.g. 990 for 99th percentile
+  * @retval latency  - upper bound of bin containing percentile, limited to maximal latency [cycles]
+  */
+uint32_t ADC_LatencyPercentile(const ADC_LatencyStageTypeDef* snapshot, uint16_t permille){
+
+	if(snapshot->Count == 0){
+		return 0;
+	}
+
+	uint64_t target = ((uint64_t)snapshot->Count * permille + 999U) / 1000U;
+	uint64_t sum    = 0;
+	uint32_t bound  = snapshot->Max;
+
+	for(uint32_t k = 0; k < ADC_LATENCY_BINS - 1U; ++k){
+
+		sum += snapshot->Bins[k];
+
+		if(sum >= target){
+			bound = (k == 0) ? 0 : (uint32_t)((1ULL << k) - 1U);
+			break;
+		}
+	}
+
+	return (bound < snapshot->Max) ? bound : snapshot->Max;
+}
+
+
+/**
+  * @brief Latency reset function, clears statistics of all stages | names and deadlines are kept
+  * @param  lat     - pointer to latency tracker structure
+  */
+void ADC_LatencyReset(ADC_LatencyTypeDef* lat){
+
+	for(uint8_t s = 0; s < ADC_LATENCY_MAX_STAGES; ++s){
+
+		__ADC_CRITICAL_ENTER();
+		ADC_LatencyClearStage(&lat->Stages[s]);
+		__ADC_CRITICAL_EXIT();
+	}
+}
+
+
+/**
+  * @brief Latency text export function, one line per used stage:
+  * 	   "<name> n=<count> min=<min> avg=<mean> p99=<p99> max=<max> miss=<misses>/<deadline>"
+  * @param  lat     - pointer to latency tracker structure
+  * @param  text    - pointer to output buffer
+  * @param  size    - size of output buffer
+  * @retval length  - number of written characters (without terminating zero) | output is truncated to size
+  */
+uint16_t ADC_LatencyFormat(ADC_LatencyTypeDef* lat, char* text, uint16_t size){
+
+	uint16_t length = 0;
+
+	if(text == NULL || size == 0){
+		return 0;
+	}
+
+	text[0] = '\0';
+
+	for(uint8_t s = 0; s < ADC_LATENCY_MAX_STAGES && length < size - 1U; ++s){
+
+		ADC_LatencyStageTypeDef st;
+		ADC_LatencyGetStage(lat, s, &st);
+
+		// skipping stages which were never configured nor marked
+		if(st.Count == 0 && st.Name == NULL){
+			continue;
+		}
+
+		int n = snprintf(&text[length], size - length, "%s n=%lu min=%lu avg=%lu p99=%lu max=%lu miss=%lu/%lu\r\n",
+		                 (st.Name != NULL) ? st.Name : "stage",
+		                 (unsigned long)st.Count,
+		                 (unsigned long)((st.Count != 0) ? st.Min : 0),
+		                 (unsigned long)((st.Count != 0) ? st.Sum / st.Count : 0),
+		                 (unsigned long)ADC_LatencyPercentile(&st, 990),
+		                 (unsigned long)st.Max,
+		                 (unsigned long)st.Misses,
+		                 (unsigned long)st.Deadline);
+
+		if(n < 0){
+			break;
+		}
+
+		length = (length + (uint16_t)n < size) ? (uint16_t)(length + n) : (uint16_t)(size - 1U);
+	}
+
+	return length;
+}
+
+
+/**
+  * @brief Latency stage clear function
+  * @param  st      - pointer to statistics of stage
+  */
+static void ADC_LatencyClearStage(ADC_LatencyStageTypeDef* st){
+
+	st->Count  = 0;
+	st->Misses = 0;
+	st->Min    = UINT32_MAX;
+	st->Max    = 0;
+	st->Sum    = 0;
+
+	memset(st->Bins, 0, sizeof(st->Bins));
+}
+
+
+/**
+  * @brief Default latency clock | core cycle counter
+  * @retval cycles  - free-running core cycles
+  */
+static uint32_t ADC_LatencyCycles(void){
+
+	return __ADC_CYCLES();
+}
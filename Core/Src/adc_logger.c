@@ -0,0 +1,451 @@
+/**
+  ******************************************************************************
+  * @file      adc_logger.c
+  * @author    Bartosz Rychlicki
+  * @Title     Circular trend logger to internal flash for ADC driver
+  * @brief     This file contains functions' bodies of downsampling, record compression and background page programming
+  ******************************************************************************
+  * @attention Page is committed by CRC, which is programmed last | page torn by reset or power loss is ignored by
+  * 		   ADC_LoggerInit and extractor. Half-word programming and page erase of F1/F3 flash are used.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_logger.h"
+#include <string.h>
+
+#if !defined(STM32F1_FAMILY) && !defined(STM32F3_FAMILY)
+	#error "ADC logger requires half-word programmed, page erased flash (F1, F3)"
+#endif
+
+#if (ADC_LOGGER_BATCHES < 1) || (ADC_LOGGER_BATCHES > 128)
+	#error "ADC logger requires 1 ... 128 batches"
+#endif
+
+// Private Macros
+#define ADC_LOGGER_PAGE_ADDRESS(__PAGE__)	(ADC_LOGGER_BASE + (uint32_t)(__PAGE__) * ADC_LOGGER_PAGE_SIZE)
+#define ADC_LOGGER_READ(__ADDRESS__)		((uint16_t)__ADC_FLASH_READ16((__ADDRESS__)))
+#define ADC_LOGGER_HEADER_WORDS				(ADC_LOGGER_HEADER_SIZE / 2U)
+#define ADC_LOGGER_CRC_WORD					(ADC_LOGGER_HEADER_WORDS - 1U)		// CRC is the last half-word of header
+#define ADC_LOGGER_QUEUED(__LOG__)			((uint8_t)((__LOG__)->Head - (__LOG__)->Tail))
+
+// Private functions prototypes
+static void     ADC_LoggerRecord(ADC_LoggerTypeDef* log);
+static uint8_t  ADC_LoggerVarint(uint8_t* dst, uint32_t value);
+static void     ADC_LoggerHeader(ADC_LoggerTypeDef* log, const ADC_LoggerBatchTypeDef* batch);
+static uint8_t  ADC_LoggerPageRead(uint8_t page, uint32_t* sequence, uint32_t* next, uint32_t* erases);
+static void     ADC_LoggerSkip(ADC_LoggerTypeDef* log);
+
+
+/**
+  * @brief Logger init function, finds the newest page in flash and continues after it | flash is not modified
+  * @param  log      - pointer to logger structure
+  * @param  channels - number of converted channels (ranks) in DMA block
+  * @param  interval - number of scans summarised by one record
+  * @retval status   - HAL status if logger was initialized
+  */
+HAL_StatusTypeDef ADC_LoggerInit(ADC_LoggerTypeDef* log, uint8_t channels, uint16_t interval){
+
+	// checking if correct parameters were provided
+	if(log == NULL || channels == 0 || channels > ADC_MAX_CHANNELS || interval == 0){
+		return HAL_ERROR;
+	}
+
+	uint8_t  valid[ADC_LOGGER_PAGES];
+	uint32_t wear   = 0;
+	uint8_t  newest = 0;
+	uint8_t  found  = 0;
+
+	memset(log, 0, sizeof(ADC_LoggerTypeDef));
+
+	log->Channels = channels;
+	log->Interval = interval;
+
+	for(uint8_t c = 0; c < channels; ++c){
+		log->Min[c] = 0xFFFFU;
+	}
+
+	// reading headers | newest page holds the highest sequence
+	for(uint8_t p = 0; p < ADC_LOGGER_PAGES; ++p){
+
+		uint32_t sequence;
+		uint32_t next;
+
+		valid[p] = ADC_LoggerPageRead(p, &sequence, &next, &log->Erases[p]);
+
+		if(valid[p] == 0){
+			continue;
+		}
+
+		wear = (log->Erases[p] > wear) ? log->Erases[p] : wear;
+
+		if(found == 0 || sequence >= log->Sequence){
+			newest         = p;
+			log->Sequence  = sequence;
+			log->Intervals = next;
+			found          = 1;
+		}
+	}
+
+	// erase count of erased or torn page is estimated by the most worn page
+	for(uint8_t p = 0; p < ADC_LOGGER_PAGES; ++p){
+		if(valid[p] == 0){
+			log->Erases[p] = wear;
+		}
+	}
+
+	if(found != 0){
+		log->Page      = (uint8_t)((newest + 1U) % ADC_LOGGER_PAGES);
+		log->Sequence += 1U;
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Logger push function, downsamples rank-interleaved block of ADC in independent mode
+  * 	   Should be called from ADC_BlockCpltCallback with completed part of DMA storage. Closed interval is encoded to page
+  * 	   image in RAM, full image is queued for ADC_LoggerProcess, flash is not accessed.
+  * @param  log       - pointer to logger structure
+  * @param  block     - pointer to first transfer of completed part of DMA storage
+  * @param  transfers - number of transfers in block | may end inside scan, next block continues from that rank
+  * @retval status    - HAL status if block was pushed
+  */
+HAL_StatusTypeDef ADC_LoggerPush(ADC_LoggerTypeDef* log, const uint16_t* block, uint16_t transfers){
+
+	// checking if correct parameters were provided
+	if(log == NULL || log->Channels == 0 || block == NULL){
+		return HAL_ERROR;
+	}
+
+	for(uint16_t i = 0; i < transfers; ++i){
+
+		uint8_t  rank   = log->Rank;
+		uint16_t sample = block[i];
+
+		log->Min[rank]  = (sample < log->Min[rank]) ? sample : log->Min[rank];
+		log->Max[rank]  = (sample > log->Max[rank]) ? sample : log->Max[rank];
+		log->Sum[rank] += sample;
+
+		if(++log->Rank < log->Channels){
+			continue;
+		}
+
+		log->Rank = 0;
+
+		if(++log->Scans >= log->Interval){
+			ADC_LoggerRecord(log);
+		}
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Logger flush function, queues partially filled page image | e.g. before planned reset
+  * 	   Should be called from context of ADC_LoggerPush or with acquisition stopped. Interval in progress is not recorded.
+  * @param  log     - pointer to logger structure
+  * @retval status  - HAL_BUSY if all page images are queued
+  */
+HAL_StatusTypeDef ADC_LoggerFlush(ADC_LoggerTypeDef* log){
+
+	// checking if correct parameters were provided
+	if(log == NULL || log->Channels == 0){
+		return HAL_ERROR;
+	}
+
+	if(ADC_LOGGER_QUEUED(log) >= ADC_LOGGER_BATCHES){
+		return HAL_BUSY;
+	}
+
+	if(log->Batches[log->Head % ADC_LOGGER_BATCHES].Records != 0){
+		log->Head++;
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Logger process function, performs one step of programming of the oldest queued page image
+  * 	   Step is erase of target page or ADC_LOGGER_CHUNK half-words, so call it from main loop or scheduler handler until
+  * 	   it returns 0. Payload and header are programmed before CRC, which commits page.
+  * @param  log     - pointer to logger structure
+  * @retval busy    - 1 if flash operation was performed, 0 if no page image is queued
+  */
+uint8_t ADC_LoggerProcess(ADC_LoggerTypeDef* log){
+
+	if(log == NULL || ADC_LOGGER_QUEUED(log) == 0){
+		return 0;
+	}
+
+	ADC_LoggerBatchTypeDef* batch   = &log->Batches[log->Tail % ADC_LOGGER_BATCHES];
+	uint32_t                address = ADC_LOGGER_PAGE_ADDRESS(log->Page);
+	uint16_t                payload = (uint16_t)((batch->Length + 1U) / 2U);	// payload half-words
+
+	HAL_FLASH_Unlock();
+
+	if(log->State != ADC_LOGGER_PROGRAM){
+
+		FLASH_EraseInitTypeDef eraseInit = {0};
+		uint32_t               pageError = 0;
+
+		eraseInit.TypeErase   = FLASH_TYPEERASE_PAGES;
+		eraseInit.PageAddress = address;
+		eraseInit.NbPages     = 1;
+
+		if(HAL_FLASHEx_Erase(&eraseInit, &pageError) != HAL_OK){
+			HAL_FLASH_Lock();
+			ADC_LoggerSkip(log);
+			return 1;
+		}
+
+		log->Erases[log->Page]++;
+
+		ADC_LoggerHeader(log, batch);
+
+		log->State    = ADC_LOGGER_PROGRAM;
+		log->Position = 0;
+
+		HAL_FLASH_Lock();
+		return 1;
+	}
+
+	// payload half-words, then header half-words with CRC as the last one
+	for(uint16_t n = 0; n < ADC_LOGGER_CHUNK && log->Position < payload + ADC_LOGGER_HEADER_WORDS; ++n, ++log->Position){
+
+		uint32_t offset;
+		uint16_t value;
+
+		if(log->Position < payload){
+			uint16_t i = (uint16_t)(log->Position * 2U);
+
+			offset = ADC_LOGGER_HEADER_SIZE + i;
+			value  = (i + 1U < batch->Length) ? (uint16_t)(batch->Payload[i] | (batch->Payload[i + 1U] << 8))
+											  : (uint16_t)(0xFF00U | batch->Payload[i]);	// padding keeps cell erased
+		}else{
+			offset = (uint32_t)(log->Position - payload) * 2U;
+			value  = log->Header[log->Position - payload];
+		}
+
+		if(value != 0xFFFFU && HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, address + offset, value) != HAL_OK){
+			HAL_FLASH_Lock();
+			ADC_LoggerSkip(log);
+			return 1;
+		}
+	}
+
+	HAL_FLASH_Lock();
+
+	if(log->Position >= payload + ADC_LOGGER_HEADER_WORDS){
+		log->PagesWritten++;
+		log->Sequence++;
+		log->Page       = (uint8_t)((log->Page + 1U) % ADC_LOGGER_PAGES);
+		log->State      = ADC_LOGGER_IDLE;
+		batch->Records  = 0;
+		batch->Length   = 0;
+		log->Tail++;							// page image is released for ADC_LoggerPush
+	}
+
+	return 1;
+}
+
+
+/**
+  * @brief Logger wear function
+  * @param  log     - pointer to logger structure
+  * @retval erases  - erase count of the most worn page | pages are written as ring, so counts differ by 1 at most
+  */
+uint32_t ADC_LoggerWear(const ADC_LoggerTypeDef* log){
+
+	uint32_t wear = 0;
+
+	for(uint8_t p = 0; p < ADC_LOGGER_PAGES; ++p){
+		wear = (log->Erases[p] > wear) ? log->Erases[p] : wear;
+	}
+
+	return wear;
+}
+
+
+/**
+  * @brief Logger record function, encodes closed interval to page image and restarts accumulators
+  * 	   Record is dropped if all page images are queued. Image is queued when the next record could not fit.
+  * @param  log     - pointer to logger structure
+  */
+static void ADC_LoggerRecord(ADC_LoggerTypeDef* log){
+
+	uint16_t scans = log->Scans;
+	uint32_t index = log->Intervals++;		// dropped record leaves gap of interval indexes
+
+	log->Scans = 0;
+
+	if(ADC_LOGGER_QUEUED(log) >= ADC_LOGGER_BATCHES){
+
+		log->Dropped++;
+
+		for(uint8_t c = 0; c < log->Channels; ++c){
+			log->Min[c] = 0xFFFFU;
+			log->Max[c] = 0;
+			log->Sum[c] = 0;
+		}
+
+		return;
+	}
+
+	ADC_LoggerBatchTypeDef* batch  = &log->Batches[log->Head % ADC_LOGGER_BATCHES];
+	uint16_t                length = batch->Length;
+
+	// first record of page is encoded against 0 | pages are decoded independently
+	if(batch->Records == 0){
+		batch->FirstInterval = index;
+		memset(batch->PreviousMin, 0, sizeof(batch->PreviousMin));
+	}
+
+	for(uint8_t c = 0; c < log->Channels; ++c){
+
+		uint16_t min   = log->Min[c];
+		uint16_t mean  = (uint16_t)((log->Sum[c] + scans / 2U) / scans);
+		int32_t  delta = (int32_t)min - (int32_t)batch->PreviousMin[c];
+
+		length += ADC_LoggerVarint(&batch->Payload[length], ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));	// zigzag | small deltas of both signs are short
+		length += ADC_LoggerVarint(&batch->Payload[length], (uint32_t)(log->Max[c] - min));
+		length += ADC_LoggerVarint(&batch->Payload[length], (uint32_t)(mean - min));
+
+		batch->PreviousMin[c] = min;
+
+		log->Min[c] = 0xFFFFU;
+		log->Max[c] = 0;
+		log->Sum[c] = 0;
+	}
+
+	log->RawBytes    += (uint32_t)log->Channels * 6U;
+	log->StoredBytes += (uint32_t)(length - batch->Length);
+
+	batch->Length = length;
+	batch->Records++;
+
+	if(ADC_LOGGER_PAYLOAD_SIZE - length < ADC_LOGGER_RECORD_MAX(log->Channels)){
+		log->Head++;						// page image is queued for ADC_LoggerProcess
+	}
+}
+
+
+/**
+  * @brief Logger varint function, encodes value as 7-bit groups, least significant first | MSB marks next group
+  * @param  dst     - pointer to destination | 3 bytes at most for 17-bit value
+  * @param  value   - encoded value
+  * @retval length  - number of written bytes
+  */
+static uint8_t ADC_LoggerVarint(uint8_t* dst, uint32_t value){
+
+	uint8_t length = 0;
+
+	while(value >= 0x80U){
+		dst[length++] = (uint8_t)(value | 0x80U);
+		value >>= 7;
+	}
+
+	dst[length++] = (uint8_t)value;
+
+	return length;
+}
+
+
+/**
+  * @brief Logger header function, builds header of programmed page with CRC of header and payload
+  * @param  log     - pointer to logger structure
+  * @param  batch   - pointer to programmed page image
+  */
+static void ADC_LoggerHeader(ADC_LoggerTypeDef* log, const ADC_LoggerBatchTypeDef* batch){
+
+	uint32_t erases = log->Erases[log->Page];
+	uint8_t  bytes[ADC_LOGGER_HEADER_SIZE - 2U];
+
+	log->Header[0]  = ADC_LOGGER_MAGIC;
+	log->Header[1]  = batch->Records;
+	log->Header[2]  = (uint16_t)log->Sequence;
+	log->Header[3]  = (uint16_t)(log->Sequence >> 16);
+	log->Header[4]  = (uint16_t)batch->FirstInterval;
+	log->Header[5]  = (uint16_t)(batch->FirstInterval >> 16);
+	log->Header[6]  = log->Channels;
+	log->Header[7]  = batch->Length;
+	log->Header[8]  = (uint16_t)erases;
+	log->Header[9]  = (uint16_t)(erases >> 16);
+	log->Header[10] = log->Interval;
+
+	for(uint8_t i = 0; i < ADC_LOGGER_CRC_WORD; ++i){
+		bytes[2U * i]      = (uint8_t)log->Header[i];
+		bytes[2U * i + 1U] = (uint8_t)(log->Header[i] >> 8);
+	}
+
+	uint16_t crc = ADC_StoreCrc(ADC_StoreCrc(0xFFFFU, bytes, sizeof(bytes)), batch->Payload, batch->Length);
+
+	// CRC equal to erased half-word would commit page torn before CRC
+	log->Header[ADC_LOGGER_CRC_WORD] = (crc == 0xFFFFU) ? 0U : crc;
+}
+
+
+/**
+  * @brief Logger page read function, validates header and CRC of programmed page
+  * @param  page     - page of region
+  * @param  sequence - pointer to sequence of page
+  * @param  next     - pointer to index of interval following the last record of page
+  * @param  erases   - pointer to erase count of page
+  * @retval valid    - 1 if page is committed
+  */
+static uint8_t ADC_LoggerPageRead(uint8_t page, uint32_t* sequence, uint32_t* next, uint32_t* erases){
+
+	uint32_t address = ADC_LOGGER_PAGE_ADDRESS(page);
+	uint16_t length  = ADC_LOGGER_READ(address + 14U);
+	uint16_t crc     = 0xFFFFU;
+
+	if(ADC_LOGGER_READ(address) != ADC_LOGGER_MAGIC || length > ADC_LOGGER_PAYLOAD_SIZE){
+		return 0;
+	}
+
+	for(uint32_t i = 0; i < ADC_LOGGER_HEADER_SIZE - 2U + length; i += 2U){
+
+		uint32_t offset   = (i < ADC_LOGGER_HEADER_SIZE - 2U) ? i : i + 2U;	// CRC half-word is skipped
+		uint16_t halfWord = ADC_LOGGER_READ(address + offset);
+		uint8_t  bytes[2] = { (uint8_t)halfWord, (uint8_t)(halfWord >> 8) };
+
+		crc = ADC_StoreCrc(crc, bytes, (i + 1U < ADC_LOGGER_HEADER_SIZE - 2U + length) ? 2U : 1U);
+	}
+
+	crc = (crc == 0xFFFFU) ? 0U : crc;
+
+	if(crc != ADC_LOGGER_READ(address + ADC_LOGGER_CRC_WORD * 2U)){
+		return 0;
+	}
+
+	*sequence = ((uint32_t)ADC_LOGGER_READ(address + 6U) << 16) | ADC_LOGGER_READ(address + 4U);
+	*next     = (((uint32_t)ADC_LOGGER_READ(address + 10U) << 16) | ADC_LOGGER_READ(address + 8U)) + ADC_LOGGER_READ(address + 2U);
+	*erases   = ((uint32_t)ADC_LOGGER_READ(address + 18U) << 16) | ADC_LOGGER_READ(address + 16U);
+
+	return 1;
+}
+
+
+/**
+  * @brief Logger skip function, drops queued page image after failed flash operation | page stays uncommitted
+  * @param  log     - pointer to logger structure
+  */
+static void ADC_LoggerSkip(ADC_LoggerTypeDef* log){
+
+	ADC_LoggerBatchTypeDef* batch = &log->Batches[log->Tail % ADC_LOGGER_BATCHES];
+
+	log->Errors++;
+	log->Dropped   += batch->Records;
+	log->Page       = (uint8_t)((log->Page + 1U) % ADC_LOGGER_PAGES);
+	log->State      = ADC_LOGGER_IDLE;
+	batch->Records  = 0;
+	batch->Length   = 0;
+	log->Tail++;
+}
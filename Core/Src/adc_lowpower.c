@@ -0,0 +1,219 @@
+
+/**
+  ******************************************************************************
+  * @file      adc_lowpower.c
+  * @author    Bartosz Rychlicki
+  * @Title     Low-power acquisition loop for ADC driver
+  * @brief     This file contains functions' bodies of event-driven acquisition loop, which sleeps in WFI between DMA completions
+  ******************************************************************************
+  * @attention Sleep and latency statistics use __ADC_CYCLES. DWT cycle counter is clocked by FCLK, which keeps running
+  * 		   in Sleep mode of STM32F1, so time spent in WFI is counted. On cores without counter statistics stay 0.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_lowpower.h"
+
+
+/**
+  * @brief Low-power loop init function
+  * @param  lp          - pointer to low-power loop structure
+  * @param  badc        - pointer to buffer of ADC started with DMA (ADC_Init / ADC_InitMultimode)
+  * @param  suspendTick - 1: SysTick is suspended for time of WFI | HAL_GetTick does not advance while sleeping
+  * @retval status      - HAL status if loop was initialized
+  */
+HAL_StatusTypeDef ADC_LowPowerInit(ADC_LowPowerTypeDef* lp, ADC_BufferTypeDef* badc, uint8_t suspendTick){
+
+	// checking if correct parameters were provided
+	if(lp == NULL || badc == NULL || badc->hdma == NULL || badc->BufferLength == 0){
+		return HAL_ERROR;
+	}
+
+	__ADC_CYCLES_ENABLE();
+
+	lp->badc         = badc;
+	lp->SuspendTick  = suspendTick;
+	lp->Events       = 0;
+	lp->SeenBlocks   = badc->HalfBlocks + badc->FullBlocks;
+	lp->Processed    = 0;
+	lp->Missed       = 0;
+	lp->Wakeups      = 0;
+	lp->Latencies    = 0;
+	lp->LatencyMax   = 0;
+	lp->LatencySum   = 0;
+	lp->SleepCycles  = 0;
+	lp->ActiveCycles = 0;
+	lp->Stamp        = __ADC_CYCLES();
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Low-power wait function, sleeps until DMA completes next half of storage or event is signalled
+  * 	   Interrupts are masked between check and WFI, so completion cannot slip in between and leave core asleep.
+  * 	   Pending interrupt wakes core from WFI even with PRIMASK set, its handler runs after interrupts are unmasked.
+  * 	   PRIMASK of caller is saved and restored, so function has to be called with interrupts enabled to let DMA callback run.
+  * @param  lp        - pointer to low-power loop structure
+  * @param  offset    - pointer to returned offset (in transfers) of latest completed part of DMA storage
+  * @param  transfers - pointer to returned number of transfers in completed part | 0 if woken by event
+  * @retval status    - HAL_OK if block completed, HAL_BUSY if woken by ADC_LowPowerSignal, HAL_ERROR if parameters are incorrect
+  */
+HAL_StatusTypeDef ADC_LowPowerWait(ADC_LowPowerTypeDef* lp, uint16_t* offset, uint16_t* transfers){
+
+	// checking if correct parameters were provided
+	if(lp == NULL || lp->badc == NULL || offset == NULL || transfers == NULL){
+		return HAL_ERROR;
+	}
+
+	ADC_BufferTypeDef* badc = lp->badc;
+	uint32_t blocks;
+	uint32_t events;
+	uint8_t  slept = 0;
+
+	__ADC_CRITICAL_ENTER();
+
+	for(;;){
+
+		blocks = badc->HalfBlocks + badc->FullBlocks;
+		events = lp->Events;
+
+		if(blocks != lp->SeenBlocks || events != 0){
+			break;
+		}
+
+		uint32_t sleep = __ADC_CYCLES();
+		lp->ActiveCycles += (uint32_t)(sleep - lp->Stamp);
+
+		if(lp->SuspendTick){
+			HAL_SuspendTick();
+		}
+
+		__DSB();
+		__WFI();
+
+		uint32_t wake = __ADC_CYCLES();
+
+		if(lp->SuspendTick){
+			HAL_ResumeTick();
+		}
+
+		lp->SleepCycles += (uint32_t)(wake - sleep);
+		lp->Stamp        = wake;
+		lp->Wakeups++;
+		slept = 1;
+
+		// letting pending interrupt handler (DMA callback) run | PRIMASK of caller is restored, not forced to 0
+		__ADC_CRITICAL_YIELD();
+	}
+
+	lp->Events = 0;
+
+	__ADC_CRITICAL_EXIT();
+
+	// woken by event only
+	if(blocks == lp->SeenBlocks){
+		*offset    = 0;
+		*transfers = 0;
+		return HAL_BUSY;
+	}
+
+	// more than one completion since last call | older halves were already overwritten by DMA
+	lp->Missed    += blocks - lp->SeenBlocks - 1U;
+	lp->SeenBlocks = blocks;
+	lp->Processed++;
+
+	// latest completed half read from DMA counter | remaining above second half length -> DMA fills first half, second is complete
+	uint16_t length    = badc->BufferLength;
+	uint16_t remaining = (uint16_t)__HAL_DMA_GET_COUNTER(badc->hdma);
+
+	if(remaining == 0 || remaining > length - length / 2U){
+		*offset    = length / 2U;
+		*transfers = length - length / 2U;
+	}else{
+		*offset    = 0;
+		*transfers = length / 2U;
+	}
+
+	// wake-up-to-process latency | includes interrupt entry, DMA callback and return to thread
+	if(slept){
+		uint32_t latency = (uint32_t)(__ADC_CYCLES() - lp->Stamp);
+
+		lp->LatencySum += latency;
+		lp->Latencies++;
+
+		if(latency > lp->LatencyMax){
+			lp->LatencyMax = latency;
+		}
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Low-power loop function, never returns. Sleeps between DMA completions and calls handler with every completed block
+  * @param  lp      - pointer to initialized low-power loop structure
+  * @param  handler - block handler | called in thread context, should finish before next half of storage completes
+  * @param  arg     - argument passed to handler
+  */
+void ADC_LowPowerRun(ADC_LowPowerTypeDef* lp, ADC_BlockHandlerTypeDef handler, void* arg){
+
+	uint16_t offset;
+	uint16_t transfers;
+
+	for(;;){
+
+		if(ADC_LowPowerWait(lp, &offset, &transfers) == HAL_OK && handler != NULL){
+			handler(lp->badc, offset, transfers, arg);
+		}
+	}
+}
+
+
+/**
+  * @brief Low-power signal function, wakes loop from ISR or thread without completed DMA block
+  * @param  lp      - pointer to low-power loop structure
+  */
+void ADC_LowPowerSignal(ADC_LowPowerTypeDef* lp){
+
+	if(lp != NULL){
+		lp->Events++;
+	}
+}
+
+
+/**
+  * @brief Low-power duty cycle function
+  * @param  lp      - pointer to low-power loop structure
+  * @retval duty    - part of time spent outside WFI [0.01 %] | 10000 = core never slept
+  */
+uint32_t ADC_LowPowerDutyCycle(const ADC_LowPowerTypeDef* lp){
+
+	uint64_t total = lp->ActiveCycles + lp->SleepCycles;
+
+	if(total == 0){
+		return 0;
+	}
+
+	return (uint32_t)((lp->ActiveCycles * 10000U) / total);
+}
+
+
+/**
+  * @brief Low-power mean latency function
+  * @param  lp      - pointer to low-power loop structure
+  * @retval latency - mean wake-up-to-process latency [cycles]
+  */
+uint32_t ADC_LowPowerLatencyMean(const ADC_LowPowerTypeDef* lp){
+
+	if(lp->Latencies == 0){
+		return 0;
+	}
+
+	return (uint32_t)(lp->LatencySum / lp->Latencies);
+}
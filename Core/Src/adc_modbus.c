@@ -0,0 +1,405 @@
+/**
+  ******************************************************************************
+  * @file      adc_modbus.c
+  * @author    Bartosz Rychlicki
+  * @Title     Modbus RTU slave serving ADC driver values
+  * @brief     This file contains functions' bodies of register image refresh, frame reception, request decoding and response
+  ******************************************************************************
+  * @attention UART works half-duplex (RS-485): reception is restarted when response is transmitted.
+  * 		   Response is built in UART interrupt from served image, other image can be refreshed meanwhile.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_modbus.h"
+#include <string.h>
+
+// Private functions prototypes
+static HAL_StatusTypeDef ADC_ModbusReceive(ADC_ModbusTypeDef* mb);
+static uint16_t          ADC_ModbusRespond(ADC_ModbusTypeDef* mb, uint16_t size);
+static uint16_t          ADC_ModbusException(ADC_ModbusTypeDef* mb, uint8_t function, uint8_t code);
+static inline void       ADC_ModbusPut32(uint16_t* image, uint16_t reg, uint32_t value);
+
+
+/**
+  * @brief Modbus init function, configures reception and transmission DMA channels and links them to UART
+  * @param  mb      - pointer to Modbus structure
+  * @param  huart   - pointer to initialized UART handle (e.g. USART2)
+  * @param  hdmaRx  - pointer to handle of reception DMA channel with Instance set (e.g. DMA1_Channel6 for USART2)
+  * @param  hdmaTx  - pointer to handle of transmission DMA channel with Instance set (e.g. DMA1_Channel7 for USART2)
+  * @param  ctx     - pointer to context of served ADC (ADC_ContextInit)
+  * @param  address - slave address | 1 ... 247
+  * @param  gain    - multiplier of scaled values (e.g. 1000 with max of 3.3 gives millivolts)
+  * @retval status  - HAL status if init went successfully
+  */
+HAL_StatusTypeDef ADC_ModbusInit(ADC_ModbusTypeDef* mb, UART_HandleTypeDef* huart, DMA_HandleTypeDef* hdmaRx, DMA_HandleTypeDef* hdmaTx,
+								 const ADC_ContextTypeDef* ctx, uint8_t address, float gain){
+
+	// checking if correct parameters were provided
+	if(mb == NULL || huart == NULL || hdmaRx == NULL || hdmaTx == NULL || ctx == NULL || ctx->badc == NULL ||
+	   address == 0 || address > 247U || gain <= 0.0f){
+		return HAL_ERROR;
+	}
+
+	memset(mb, 0, sizeof(ADC_ModbusTypeDef));
+
+	mb->huart   = huart;
+	mb->ctx     = ctx;
+	mb->Address = address;
+	mb->Gain    = gain;
+
+	// reception | byte per transfer, stopped by idle line or full frame buffer
+	hdmaRx->Init.Direction           = DMA_PERIPH_TO_MEMORY;
+	hdmaRx->Init.PeriphInc           = DMA_PINC_DISABLE;
+	hdmaRx->Init.MemInc              = DMA_MINC_ENABLE;
+	hdmaRx->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdmaRx->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+	hdmaRx->Init.Mode                = DMA_NORMAL;
+	hdmaRx->Init.Priority            = DMA_PRIORITY_LOW;		// ADC's DMA keeps priority over UART
+
+	// transmission | response is written from frame buffer
+	hdmaTx->Init.Direction           = DMA_MEMORY_TO_PERIPH;
+	hdmaTx->Init.PeriphInc           = DMA_PINC_DISABLE;
+	hdmaTx->Init.MemInc              = DMA_MINC_ENABLE;
+	hdmaTx->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdmaTx->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+	hdmaTx->Init.Mode                = DMA_NORMAL;
+	hdmaTx->Init.Priority            = DMA_PRIORITY_LOW;
+
+	if(HAL_DMA_Init(hdmaRx) != HAL_OK || HAL_DMA_Init(hdmaTx) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	__HAL_LINKDMA(huart, hdmarx, *hdmaRx);
+	__HAL_LINKDMA(huart, hdmatx, *hdmaTx);
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Modbus driver enable function, sets GPIO driving DE (and inverted RE) of RS-485 transceiver
+  * 	   Pin is set during transmission of response and reset when its last bit is sent (transmission complete)
+  * @param  mb      - pointer to Modbus structure
+  * @param  port    - GPIO port of pin configured as output | NULL disables driver enable
+  * @param  pin     - GPIO pin (GPIO_PIN_x)
+  * @retval status  - HAL status if pin was set
+  */
+HAL_StatusTypeDef ADC_ModbusSetDriverEnable(ADC_ModbusTypeDef* mb, GPIO_TypeDef* port, uint16_t pin){
+
+	// checking if correct parameters were provided
+	if(mb == NULL){
+		return HAL_ERROR;
+	}
+
+	mb->DePort = port;
+	mb->DePin  = pin;
+
+	if(port != NULL){
+		HAL_GPIO_WritePin(port, pin, GPIO_PIN_RESET);	// transceiver listens
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Modbus start function, refreshes register image and starts reception of requests
+  * @param  mb      - pointer to initialized Modbus structure
+  * @retval status  - HAL status if reception was started
+  */
+HAL_StatusTypeDef ADC_ModbusStart(ADC_ModbusTypeDef* mb){
+
+	// checking if correct parameters were provided
+	if(mb == NULL || mb->huart == NULL){
+		return HAL_ERROR;
+	}
+
+	ADC_ModbusRefresh(mb);
+
+	return ADC_ModbusReceive(mb);
+}
+
+
+/**
+  * @brief Modbus refresh function, computes registers to image, which is not served, and serves it
+  * 	   Should be called from ADC_BlockCpltCallback (or main loop for ADC without DMA). Scaled values are computed with
+  * 	   one fixed point factor, so refresh uses no floating point per channel.
+  * @param  mb      - pointer to initialized Modbus structure
+  */
+void ADC_ModbusRefresh(ADC_ModbusTypeDef* mb){
+
+	const ADC_ContextTypeDef* ctx   = mb->ctx;
+	const ADC_BufferTypeDef*  badc  = ctx->badc;
+	uint16_t*                 image = mb->Image[mb->Active ^ 1U];
+	uint16_t                  flags = 0;
+
+	// scale of context and gain as Q16 factor | rounding of each value is done in integers
+	float    gain   = ctx->Scale * mb->Gain * 65536.0f;
+	uint32_t factor = (gain >= 4294967040.0f) ? 0xFFFFFFFFU : (uint32_t)(gain + 0.5f);
+
+	memset(image, 0, ADC_MODBUS_REG_STATUS * sizeof(uint16_t));
+
+	for(uint8_t channel = 0; channel < ADC_CONTEXT_CHANNELS; ++channel){
+
+		uint8_t rank = ctx->RankOfChannel[channel];
+
+		if(rank == ADC_CONTEXT_NO_RANK || rank >= ADC_MAX_CHANNELS){
+			continue;
+		}
+
+		uint16_t averaged = ADC_InlineAveraged(ctx, channel);
+		uint64_t scaled   = ((uint64_t)averaged * factor + 0x8000U) >> 16;
+
+		if(scaled > 0xFFFFU){
+			scaled = 0xFFFFU;
+			flags |= ADC_MODBUS_STATUS_SATURATED;
+		}
+
+		image[ADC_MODBUS_REG_SCALED + rank]   = (uint16_t)scaled;
+		image[ADC_MODBUS_REG_AVERAGED + rank] = averaged;
+	}
+
+	uint32_t blocks   = badc->HalfBlocks + badc->FullBlocks;
+	uint32_t errors   = badc->Errors;
+	uint32_t overruns = badc->Overruns;
+
+	if(badc->hdma == NULL || blocks != 0){
+		flags |= ADC_MODBUS_STATUS_VALID;
+	}
+
+	if(badc->Discontinuous != 0){
+		flags |= ADC_MODBUS_STATUS_DISCONTINUOUS;
+	}
+
+	if(errors != mb->LastErrors || overruns != mb->LastOverruns){
+		flags |= ADC_MODBUS_STATUS_ERROR;
+	}
+
+	mb->LastErrors   = errors;
+	mb->LastOverruns = overruns;
+
+	image[ADC_MODBUS_REG_STATUS]   = flags;
+	image[ADC_MODBUS_REG_CHANNELS] = ctx->Channels;
+
+	ADC_ModbusPut32(image, ADC_MODBUS_REG_BLOCKS,     blocks);
+	ADC_ModbusPut32(image, ADC_MODBUS_REG_ERRORS,     errors);
+	ADC_ModbusPut32(image, ADC_MODBUS_REG_OVERRUNS,   overruns);
+	ADC_ModbusPut32(image, ADC_MODBUS_REG_REFRESHES,  mb->Refreshes + 1U);
+	ADC_ModbusPut32(image, ADC_MODBUS_REG_REQUESTS,   mb->Requests);
+	ADC_ModbusPut32(image, ADC_MODBUS_REG_CRC_ERRORS, mb->CrcErrors);
+
+	mb->Refreshes++;
+	mb->Active ^= 1U;							// refreshed image is served from next request
+}
+
+
+/**
+  * @brief Modbus reception event function | should be called from HAL_UARTEx_RxEventCallback
+  * 	   Frame ended by idle line is decoded and response transmission is started, all in UART interrupt
+  * @param  mb      - pointer to Modbus structure
+  * @param  huart   - pointer to UART handle, whose reception event occurred
+  * @param  size    - number of received bytes
+  */
+void ADC_ModbusRxEvent(ADC_ModbusTypeDef* mb, UART_HandleTypeDef* huart, uint16_t size){
+
+	if(mb == NULL || huart != mb->huart || HAL_UARTEx_GetRxEventType(huart) == HAL_UART_RXEVENT_HT){
+		return;
+	}
+
+	uint16_t length = ADC_ModbusRespond(mb, size);
+
+	if(length == 0){
+		ADC_ModbusReceive(mb);		// no response | listening for next frame
+		return;
+	}
+
+	if(mb->DePort != NULL){
+		HAL_GPIO_WritePin(mb->DePort, mb->DePin, GPIO_PIN_SET);
+	}
+
+	if(HAL_UART_Transmit_DMA(huart, mb->TxFrame, length) != HAL_OK){
+		ADC_ModbusTxCplt(mb, huart);
+	}
+}
+
+
+/**
+  * @brief Modbus transmission complete function | should be called from HAL_UART_TxCpltCallback
+  * 	   Last bit of response is sent, transceiver is released and reception is restarted
+  * @param  mb      - pointer to Modbus structure
+  * @param  huart   - pointer to UART handle, whose transmission completed
+  */
+void ADC_ModbusTxCplt(ADC_ModbusTypeDef* mb, UART_HandleTypeDef* huart){
+
+	if(mb == NULL || huart != mb->huart){
+		return;
+	}
+
+	if(mb->DePort != NULL){
+		HAL_GPIO_WritePin(mb->DePort, mb->DePin, GPIO_PIN_RESET);
+	}
+
+	ADC_ModbusReceive(mb);
+}
+
+
+/**
+  * @brief Modbus error function | should be called from HAL_UART_ErrorCallback
+  * 	   Noise, framing or overrun error drops frame being received, reception is restarted
+  * @param  mb      - pointer to Modbus structure
+  * @param  huart   - pointer to UART handle, whose error occurred
+  */
+void ADC_ModbusError(ADC_ModbusTypeDef* mb, UART_HandleTypeDef* huart){
+
+	if(mb == NULL || huart != mb->huart){
+		return;
+	}
+
+	mb->UartErrors++;
+
+	// response in progress restarts reception when it is sent
+	if(huart->gState == HAL_UART_STATE_READY){
+		HAL_UART_AbortReceive(huart);
+		ADC_ModbusReceive(mb);
+	}
+}
+
+
+/**
+  * @brief Modbus CRC function | CRC-16/MODBUS (reflected polynomial 0xA001, initial value 0xFFFF), sent low byte first
+  * @param  data    - pointer to frame
+  * @param  length  - number of bytes
+  * @retval crc     - CRC of frame
+  */
+uint16_t ADC_ModbusCrc(const uint8_t* data, uint16_t length){
+
+	uint16_t crc = 0xFFFFU;
+
+	for(uint16_t i = 0; i < length; ++i){
+		crc ^= data[i];
+
+		for(uint8_t b = 0; b < 8; ++b){
+			crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0xA001U) : (uint16_t)(crc >> 1);
+		}
+	}
+
+	return crc;
+}
+
+
+/**
+  * @brief Modbus receive function, starts DMA reception of next frame ended by idle line
+  * @param  mb      - pointer to Modbus structure
+  * @retval status  - HAL status of reception start
+  */
+static HAL_StatusTypeDef ADC_ModbusReceive(ADC_ModbusTypeDef* mb){
+
+	if(HAL_UARTEx_ReceiveToIdle_DMA(mb->huart, mb->RxFrame, ADC_MODBUS_FRAME_SIZE) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	__HAL_DMA_DISABLE_IT(mb->huart->hdmarx, DMA_IT_HT);	// only idle line and full buffer end frame
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Modbus respond function, decodes request and builds response from served image
+  * @param  mb      - pointer to Modbus structure
+  * @param  size    - number of received bytes
+  * @retval length  - length of response | 0 if request is not answered
+  */
+static uint16_t ADC_ModbusRespond(ADC_ModbusTypeDef* mb, uint16_t size){
+
+	const uint8_t* rx = mb->RxFrame;
+	uint8_t*       tx = mb->TxFrame;
+
+	if(size < 4U || size > ADC_MODBUS_FRAME_SIZE || ADC_ModbusCrc(rx, size - 2U) != (uint16_t)(rx[size - 2U] | (rx[size - 1U] << 8))){
+		mb->CrcErrors++;
+		return 0;
+	}
+
+	// broadcast is not answered | only reads are served
+	if(rx[0] != mb->Address){
+		mb->Ignored++;
+		return 0;
+	}
+
+	mb->Requests++;
+
+	if(rx[1] != ADC_MODBUS_READ_INPUT){
+		return ADC_ModbusException(mb, rx[1], ADC_MODBUS_ILLEGAL_FUNCTION);
+	}
+
+	uint16_t start    = (uint16_t)((rx[2] << 8) | rx[3]);
+	uint16_t quantity = (uint16_t)((rx[4] << 8) | rx[5]);
+
+	if(size != 8U || quantity == 0 || quantity > ADC_MODBUS_MAX_READ){
+		return ADC_ModbusException(mb, rx[1], ADC_MODBUS_ILLEGAL_VALUE);
+	}
+
+	if((uint32_t)start + quantity > ADC_MODBUS_REGISTERS){
+		return ADC_ModbusException(mb, rx[1], ADC_MODBUS_ILLEGAL_ADDRESS);
+	}
+
+	const uint16_t* image = &mb->Image[mb->Active][start];
+
+	tx[0] = mb->Address;
+	tx[1] = ADC_MODBUS_READ_INPUT;
+	tx[2] = (uint8_t)(quantity * 2U);
+
+	for(uint16_t i = 0; i < quantity; ++i){
+		tx[3U + 2U * i]  = (uint8_t)(image[i] >> 8);		// registers are big endian
+		tx[4U + 2U * i]  = (uint8_t)image[i];
+	}
+
+	uint16_t length = (uint16_t)(3U + quantity * 2U);
+	uint16_t crc    = ADC_ModbusCrc(tx, length);
+
+	tx[length]      = (uint8_t)crc;
+	tx[length + 1U] = (uint8_t)(crc >> 8);
+
+	return (uint16_t)(length + 2U);
+}
+
+
+/**
+  * @brief Modbus exception function, builds exception response
+  * @param  mb       - pointer to Modbus structure
+  * @param  function - function code of request
+  * @param  code     - exception code (ADC_MODBUS_ILLEGAL_x)
+  * @retval length   - length of response
+  */
+static uint16_t ADC_ModbusException(ADC_ModbusTypeDef* mb, uint8_t function, uint8_t code){
+
+	uint8_t* tx = mb->TxFrame;
+
+	mb->Exceptions++;
+
+	tx[0] = mb->Address;
+	tx[1] = (uint8_t)(function | 0x80U);
+	tx[2] = code;
+
+	uint16_t crc = ADC_ModbusCrc(tx, 3U);
+
+	tx[3] = (uint8_t)crc;
+	tx[4] = (uint8_t)(crc >> 8);
+
+	return 5U;
+}
+
+
+/**
+  * @brief Modbus 32-bit register function | high word first
+  */
+static inline void ADC_ModbusPut32(uint16_t* image, uint16_t reg, uint32_t value){
+
+	image[reg]      = (uint16_t)(value >> 16);
+	image[reg + 1U] = (uint16_t)value;
+}
@@ -0,0 +1,205 @@
+/**
+  ******************************************************************************
+  * @file      adc_pool.c
+  * @author    Bartosz Rychlicki
+  * @Title     Static fixed-size block pools for driver objects
+  * @brief     This file contains functions' bodies of O(1) block allocation, release and usage report
+  ******************************************************************************
+  * @attention Statically defined pools need no init: never allocated blocks are taken in order (Fresh), so free list
+  * 		   does not have to be built at startup. Pool joins report list at its first allocation.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_pool.h"
+#include <stdio.h>
+
+// Private functions prototypes
+static void ADC_PoolList(ADC_PoolTypeDef* pool);
+
+// Private variables
+static ADC_PoolTypeDef* ADC_PoolFirst = NULL;		// report list | pools in order of first use
+
+
+/**
+  * @brief Pool init function, attaches caller-provided storage | pools of ADC_POOL_DEFINE need no init
+  * @param  pool      - pointer to pool structure
+  * @param  storage   - pointer to capacity * blockSize bytes, aligned as objects stored in blocks
+  * @param  next      - pointer to capacity half-words of free list links
+  * @param  blockSize - size of block [bytes] | multiple of alignment of stored objects
+  * @param  capacity  - number of blocks | 1 ... ADC_POOL_MAX_CAPACITY
+  * @param  name      - name in reports | can be NULL
+  * @retval status    - HAL status if pool was initialized
+  */
+HAL_StatusTypeDef ADC_PoolInit(ADC_PoolTypeDef* pool, void* storage, uint16_t* next, uint16_t blockSize, uint16_t capacity, const char* name){
+
+	// checking if correct parameters were provided
+	if(pool == NULL || storage == NULL || next == NULL || blockSize == 0 || capacity == 0 || capacity > ADC_POOL_MAX_CAPACITY){
+		return HAL_ERROR;
+	}
+
+	__ADC_CRITICAL_ENTER();
+
+	pool->Storage   = (uint8_t*)storage;
+	pool->Next      = next;
+	pool->Name      = name;
+	pool->BlockSize = blockSize;
+	pool->Capacity  = capacity;
+	pool->Fresh     = 0;
+	pool->FreeHead  = ADC_POOL_NONE;
+	pool->Used      = 0;
+	pool->Peak      = 0;
+	pool->Failures  = 0;
+
+	__ADC_CRITICAL_EXIT();
+
+	ADC_PoolList(pool);
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Pool allocation function | O(1), released blocks are reused first
+  * @param  pool    - pointer to pool structure
+  * @retval block   - pointer to block | NULL if pool is exhausted (counted in Failures)
+  */
+void* ADC_PoolAlloc(ADC_PoolTypeDef* pool){
+
+	uint32_t index = ADC_POOL_NONE;
+
+	if(pool == NULL || pool->Storage == NULL){
+		return NULL;
+	}
+
+	ADC_PoolList(pool);
+
+	__ADC_CRITICAL_ENTER();
+
+	if(pool->FreeHead != ADC_POOL_NONE){
+		index          = pool->FreeHead;
+		pool->FreeHead = pool->Next[index];
+	}else if(pool->Fresh < pool->Capacity){
+		index = pool->Fresh++;
+	}
+
+	if(index != ADC_POOL_NONE){
+		pool->Next[index] = ADC_POOL_IN_USE;
+		pool->Used++;
+		pool->Peak = (pool->Used > pool->Peak) ? pool->Used : pool->Peak;
+	}else{
+		pool->Failures++;
+	}
+
+	__ADC_CRITICAL_EXIT();
+
+	return (index != ADC_POOL_NONE) ? &pool->Storage[index * pool->BlockSize] : NULL;
+}
+
+
+/**
+  * @brief Pool release function | O(1)
+  * @param  pool    - pointer to pool structure
+  * @param  block   - pointer to block returned by ADC_PoolAlloc of this pool
+  * @retval status  - HAL_ERROR if block does not belong to pool or was already released
+  */
+HAL_StatusTypeDef ADC_PoolFree(ADC_PoolTypeDef* pool, void* block){
+
+	HAL_StatusTypeDef status = HAL_ERROR;
+
+	// checking if correct parameters were provided
+	if(pool == NULL || pool->Storage == NULL || block == NULL || (uint8_t*)block < pool->Storage){
+		return HAL_ERROR;
+	}
+
+	uint32_t offset = (uint32_t)((uint8_t*)block - pool->Storage);
+	uint32_t index  = offset / pool->BlockSize;
+
+	// pointer inside block or beyond storage
+	if(offset % pool->BlockSize != 0 || index >= pool->Fresh){
+		return HAL_ERROR;
+	}
+
+	__ADC_CRITICAL_ENTER();
+
+	if(pool->Next[index] == ADC_POOL_IN_USE){
+		pool->Next[index] = pool->FreeHead;
+		pool->FreeHead    = (uint16_t)index;
+		pool->Used--;
+		status = HAL_OK;
+	}
+
+	__ADC_CRITICAL_EXIT();
+
+	return status;
+}
+
+
+/**
+  * @brief Pool text export function, one line per pool used so far:
+  * 	   "<name> used=<used> peak=<peak>/<capacity> block=<size> fail=<failures>"
+  * @param  text    - pointer to output buffer
+  * @param  size    - size of output buffer
+  * @retval length  - number of written characters (without terminating zero) | output is truncated to size
+  */
+uint16_t ADC_PoolFormat(char* text, uint16_t size){
+
+	uint16_t length = 0;
+
+	if(text == NULL || size == 0){
+		return 0;
+	}
+
+	text[0] = '\0';
+
+	for(const ADC_PoolTypeDef* pool = ADC_PoolFirst; pool != NULL && length < size - 1U; pool = pool->Link){
+
+		int n = snprintf(&text[length], size - length, "%s used=%u peak=%u/%u block=%u fail=%lu\r\n",
+		                 (pool->Name != NULL) ? pool->Name : "pool",
+		                 (unsigned)pool->Used,
+		                 (unsigned)pool->Peak,
+		                 (unsigned)pool->Capacity,
+		                 (unsigned)pool->BlockSize,
+		                 (unsigned long)pool->Failures);
+
+		if(n < 0){
+			break;
+		}
+
+		length = (length + (uint16_t)n < size) ? (uint16_t)(length + n) : (uint16_t)(size - 1U);
+	}
+
+	return length;
+}
+
+
+/**
+  * @brief Pool list function, appends pool to report list once
+  * @param  pool    - pointer to pool structure
+  */
+static void ADC_PoolList(ADC_PoolTypeDef* pool){
+
+	if(pool->Listed != 0){
+		return;
+	}
+
+	__ADC_CRITICAL_ENTER();
+
+	if(pool->Listed == 0){
+		ADC_PoolTypeDef** last = &ADC_PoolFirst;
+
+		while(*last != NULL){
+			last = &(*last)->Link;
+		}
+
+		pool->Link   = NULL;
+		pool->Listed = 1;
+		*last        = pool;
+	}
+
+	__ADC_CRITICAL_EXIT();
+}
@@ -0,0 +1,253 @@
+
+/**
+  ******************************************************************************
+  * @file      adc_scheduler.c
+  * @author    Bartosz Rychlicki
+  * @Title     Cooperative run-to-completion scheduler for ADC driver
+  * @brief     This file contains functions' bodies of event posting, prioritised dispatching and handler budget tracking
+  ******************************************************************************
+  * @attention ADC_SchedPost may be called from any interrupt priority | queue update is done in short critical section
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_scheduler.h"
+#include <string.h>
+
+// Private functions prototypes
+static uint32_t ADC_SchedCycles(void);
+
+
+/**
+  * @brief Scheduler init function, drops all handlers and queued events
+  * @param  sched   - pointer to scheduler structure
+  * @param  clock   - time source of post stamps and budgets | NULL: core cycle counter (__ADC_CYCLES)
+  * @retval status  - HAL status if scheduler was initialized
+  */
+HAL_StatusTypeDef ADC_SchedInit(ADC_SchedTypeDef* sched, ADC_SchedClockTypeDef clock){
+
+	// checking if correct parameters were provided
+	if(sched == NULL){
+		return HAL_ERROR;
+	}
+
+	memset(sched, 0, sizeof(ADC_SchedTypeDef));
+
+	if(clock == NULL){
+		__ADC_CYCLES_ENABLE();
+		clock = ADC_SchedCycles;
+	}
+
+	sched->Clock = clock;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Scheduler register function, adds handler of events
+  * @param  sched    - pointer to scheduler structure
+  * @param  function - handler function
+  * @param  arg      - argument passed to handler
+  * @param  priority - priority of handler's events | 0 is the highest, lower than ADC_SCHED_PRIORITIES
+  * @param  budget   - maximal execution time of handler [cycles of scheduler clock] | 0: unlimited
+  * @param  id       - pointer to returned id of handler, used when posting events
+  * @retval status   - HAL status if handler was registered
+  */
+HAL_StatusTypeDef ADC_SchedRegister(ADC_SchedTypeDef* sched, ADC_EventHandlerTypeDef function, void* arg, uint8_t priority, uint32_t budget, uint8_t* id){
+
+	// checking if correct parameters were provided
+	if(sched == NULL || function == NULL || id == NULL || priority >= ADC_SCHED_PRIORITIES){
+		return HAL_ERROR;
+	}
+
+	// checking if there is free slot
+	if(sched->NbrOfHandlers >= ADC_SCHED_MAX_HANDLERS){
+		return HAL_ERROR;
+	}
+
+	ADC_SchedHandlerTypeDef* handler = &sched->Handlers[sched->NbrOfHandlers];
+
+	handler->Function = function;
+	handler->Arg      = arg;
+	handler->Priority = priority;
+	handler->Budget   = budget;
+
+	*id = sched->NbrOfHandlers++;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Scheduler post function, queues event for handler | safe to call from interrupts
+  * @param  sched     - pointer to scheduler structure
+  * @param  id        - id of handler returned by ADC_SchedRegister
+  * @param  type      - type of event
+  * @param  source    - posting object (buffer, ADC handle, timer handle)
+  * @param  offset    - offset of completed block in DMA storage | 0 for non-DMA events
+  * @param  transfers - number of transfers in completed block | 0 for non-DMA events
+  * @retval status    - HAL_OK if event was queued, HAL_BUSY if queue is full (event dropped), HAL_ERROR if parameters are incorrect
+  */
+HAL_StatusTypeDef ADC_SchedPost(ADC_SchedTypeDef* sched, uint8_t id, ADC_EventType type, void* source, uint16_t offset, uint16_t transfers){
+
+	// checking if correct parameters were provided
+	if(sched == NULL || id >= sched->NbrOfHandlers){
+		return HAL_ERROR;
+	}
+
+	ADC_SchedQueueTypeDef* queue = &sched->Queues[sched->Handlers[id].Priority];
+	uint32_t               stamp = sched->Clock();
+
+	__ADC_CRITICAL_ENTER();
+
+	uint16_t used = (uint16_t)(queue->Head - queue->Tail);
+
+	if(used >= ADC_SCHED_QUEUE_LENGTH){
+		queue->Dropped++;
+		__ADC_CRITICAL_EXIT();
+		return HAL_BUSY;
+	}
+
+	ADC_EventTypeDef* event = &queue->Events[queue->Head & (ADC_SCHED_QUEUE_LENGTH - 1U)];
+
+	event->Source    = source;
+	event->Stamp     = stamp;
+	event->Offset    = offset;
+	event->Transfers = transfers;
+	event->Handler   = id;
+	event->Type      = (uint8_t)type;
+
+	queue->Head++;
+
+	if(used + 1U > queue->HighWater){
+		queue->HighWater = used + 1U;
+	}
+
+	__ADC_CRITICAL_EXIT();
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Scheduler dispatch function, runs handler of oldest event of the highest non-empty priority
+  * @param  sched   - pointer to scheduler structure
+  * @retval ran     - 1 if event was dispatched, 0 if all queues are empty
+  */
+uint8_t ADC_SchedRunOnce(ADC_SchedTypeDef* sched){
+
+	for(uint8_t p = 0; p < ADC_SCHED_PRIORITIES; ++p){
+
+		ADC_SchedQueueTypeDef* queue = &sched->Queues[p];
+
+		if(queue->Head == queue->Tail){
+			continue;
+		}
+
+		// copying event out of queue | slot can be reused by interrupt while handler runs
+		ADC_EventTypeDef event = queue->Events[queue->Tail & (ADC_SCHED_QUEUE_LENGTH - 1U)];
+
+		__ADC_CRITICAL_ENTER();
+		queue->Tail++;
+		__ADC_CRITICAL_EXIT();
+
+		ADC_SchedHandlerTypeDef* handler = &sched->Handlers[event.Handler];
+
+		uint32_t start = sched->Clock();
+		handler->Function(&event, handler->Arg);
+		uint32_t cycles = sched->Clock() - start;
+
+		handler->Runs++;
+		handler->CyclesLast = cycles;
+
+		if(cycles > handler->CyclesMax){
+			handler->CyclesMax = cycles;
+		}
+
+		// handler ran above its budget | lower priority events were delayed
+		if(handler->Budget != 0 && cycles > handler->Budget){
+			handler->Overruns++;
+			ADC_SchedOverrunCallback(sched, event.Handler, cycles);
+		}
+
+		sched->Dispatched++;
+
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/**
+  * @brief Scheduler loop function, never returns. Dispatches events and calls idle callback when all queues are empty
+  * @param  sched   - pointer to initialized scheduler structure
+  */
+void ADC_SchedRun(ADC_SchedTypeDef* sched){
+
+	for(;;){
+
+		if(ADC_SchedRunOnce(sched) == 0){
+			ADC_SchedIdleCallback(sched);
+		}
+	}
+}
+
+
+/**
+  * @brief Scheduler pending function
+  * @param  sched   - pointer to scheduler structure
+  * @retval pending - number of queued events of all priorities
+  */
+uint16_t ADC_SchedPending(ADC_SchedTypeDef* sched){
+
+	uint16_t pending = 0;
+
+	for(uint8_t p = 0; p < ADC_SCHED_PRIORITIES; ++p){
+		pending += (uint16_t)(sched->Queues[p].Head - sched->Queues[p].Tail);
+	}
+
+	return pending;
+}
+
+
+/**
+  * @brief Empty implementation of idle callback | called when all queues are empty, e.g. __WFI() may be placed in user implementation
+  * 	   (check of ADC_SchedPending with interrupts disabled before WFI prevents missing event posted in between)
+  * @param  sched   - pointer to scheduler structure
+  */
+__weak void ADC_SchedIdleCallback(ADC_SchedTypeDef* sched){
+
+	UNUSED(sched);     // unused variables to avoid warnings
+
+}
+
+
+/**
+  * @brief Empty implementation of overrun callback | called after handler exceeded its budget
+  * @param  sched   - pointer to scheduler structure
+  * @param  id      - id of handler
+  * @param  cycles  - execution time of handler [cycles of scheduler clock]
+  */
+__weak void ADC_SchedOverrunCallback(ADC_SchedTypeDef* sched, uint8_t id, uint32_t cycles){
+
+	UNUSED(sched);     // unused variables to avoid warnings
+	UNUSED(id);
+	UNUSED(cycles);
+
+}
+
+
+/**
+  * @brief Default scheduler clock | core cycle counter
+  * @retval cycles  - free-running core cycles
+  */
+static uint32_t ADC_SchedCycles(void){
+
+	return __ADC_CYCLES();
+}
@@ -0,0 +1,822 @@
+/**
+  ******************************************************************************
+  * @file      adc_shell.c
+  * @author    Bartosz Rychlicki
+  * @Title     Command shell over UART for ADC driver tuning and diagnostics
+  * @brief     This file contains functions' bodies of line editing, command execution, non-blocking output and dumps
+  ******************************************************************************
+  * @attention All functions run in thread context (ADC_ShellProcess), ISRs only move bytes by DMA.
+  * 		   Snapshot of history is copied while DMA callbacks may push, it can be shifted by one block in rare cases.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_shell.h"
+#include "adc_pool.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Private typedefs
+typedef void (*ADC_ShellHandlerTypeDef)(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+
+typedef struct{
+
+	const char*             Name;
+	ADC_ShellHandlerTypeDef Handler;
+	uint8_t                 MinArgs;			// required numeric arguments
+	const char*             Help;
+
+}ADC_ShellCommandTypeDef;
+
+// Private Macros
+#define ADC_SHELL_MAX_ARGS			3U
+#define ADC_SHELL_PROMPT			"> "
+#define ADC_SHELL_SMP_CODES			8U			// SMPx field is 3 bits on all families
+
+// sampling time can be changed during conversions only on families without ADSTART
+#if defined(STM32F1_FAMILY) || defined(STM32F2_FAMILY) || defined(STM32F4_FAMILY)
+	#define ADC_SHELL_SMP_BUSY(__HANDLE__)		0U
+#else
+	#define ADC_SHELL_SMP_BUSY(__HANDLE__)		__ADC_IS_CONV_STARTED(__HANDLE__)
+#endif
+
+// Private functions prototypes
+static void     ADC_ShellInput(ADC_ShellTypeDef* shell, char c);
+static void     ADC_ShellExecute(ADC_ShellTypeDef* shell);
+static uint16_t ADC_ShellWrite(ADC_ShellTypeDef* shell, const char* data, uint16_t length);
+static uint16_t ADC_ShellSpace(const ADC_ShellTypeDef* shell);
+static void     ADC_ShellStatus(ADC_ShellTypeDef* shell, HAL_StatusTypeDef status);
+static void     ADC_ShellDump(ADC_ShellTypeDef* shell);
+static void     ADC_ShellCaptureCheck(ADC_ShellTypeDef* shell);
+static float    ADC_ShellMax(const ADC_ShellTypeDef* shell);
+
+static void     ADC_ShellCmdHelp(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+static void     ADC_ShellCmdChannels(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+static void     ADC_ShellCmdStats(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+static void     ADC_ShellCmdTrace(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+static void     ADC_ShellCmdCapture(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+static void     ADC_ShellCmdAveraging(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+static void     ADC_ShellCmdSampling(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+static void     ADC_ShellCmdOversampling(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+static void     ADC_ShellCmdResolution(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+static void     ADC_ShellCmdSave(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv);
+
+// Private variables
+static const ADC_ShellCommandTypeDef ADC_ShellCommands[] = {
+
+	{ "help",  ADC_ShellCmdHelp,         0, "list of commands" },
+	{ "ch",    ADC_ShellCmdChannels,     0, "channels: rank, averaged, mV, sampling time code" },
+	{ "stats", ADC_ShellCmdStats,        0, "buffer, shell and latency statistics" },
+	{ "trace", ADC_ShellCmdTrace,        1, "<rank> [n] latest samples of rank" },
+	{ "cap",   ADC_ShellCmdCapture,      1, "<scans> capture next scans of all ranks" },
+	{ "avg",   ADC_ShellCmdAveraging,    1, "<measures> averaging depth" },
+	{ "smp",   ADC_ShellCmdSampling,     2, "<channel> <code> sampling time of channel" },
+	{ "os",    ADC_ShellCmdOversampling, 2, "<ratio> <shift> hardware oversampler" },
+	{ "res",   ADC_ShellCmdResolution,   1, "<bits> resolution" },
+	{ "save",  ADC_ShellCmdSave,         0, "persist configuration" },
+};
+
+
+/**
+  * @brief Shell init function, configures reception DMA channel (circular), links it to UART and writes output to console
+  * @param  shell   - pointer to shell structure
+  * @param  huart   - pointer to initialized UART handle (e.g. USART2)
+  * @param  hdmaRx  - pointer to handle of reception DMA channel with Instance set (e.g. DMA1_Channel6 for USART2)
+  * @param  con     - pointer to console initialized on the same UART (ADC_ConsoleInit), e.g. ADC_Console
+  * @param  hadc    - pointer to ADC handle of served ADC
+  * @param  badc    - pointer to ADC buffer of served ADC
+  * @param  cadc    - pointer to channels structure of served ADC
+  * @param  ctx     - pointer to context of served ADC (ADC_ContextInit)
+  * @retval status  - HAL status if init went successfully
+  */
+HAL_StatusTypeDef ADC_ShellInit(ADC_ShellTypeDef* shell, UART_HandleTypeDef* huart, DMA_HandleTypeDef* hdmaRx, ADC_ConsoleTypeDef* con,
+								ADC_HandleTypeDef* hadc, ADC_BufferTypeDef* badc, ADC_ChannelsTypeDef* cadc, ADC_ContextTypeDef* ctx){
+
+	// checking if correct parameters were provided
+	if(shell == NULL || huart == NULL || hdmaRx == NULL || con == NULL || hadc == NULL || badc == NULL || cadc == NULL || ctx == NULL){
+		return HAL_ERROR;
+	}
+
+	// one transmission path per UART | output of shell is sent by console
+	if(con->huart != huart){
+		return HAL_ERROR;
+	}
+
+	memset(shell, 0, sizeof(ADC_ShellTypeDef));
+
+	shell->huart = huart;
+	shell->con   = con;
+	shell->hadc  = hadc;
+	shell->badc  = badc;
+	shell->cadc  = cadc;
+	shell->ctx   = ctx;
+
+	// reception | circular, position of DMA is polled by ADC_ShellProcess
+	hdmaRx->Init.Direction           = DMA_PERIPH_TO_MEMORY;
+	hdmaRx->Init.PeriphInc           = DMA_PINC_DISABLE;
+	hdmaRx->Init.MemInc              = DMA_MINC_ENABLE;
+	hdmaRx->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdmaRx->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+	hdmaRx->Init.Mode                = DMA_CIRCULAR;
+	hdmaRx->Init.Priority            = DMA_PRIORITY_LOW;		// ADC's DMA keeps priority over UART
+
+	if(HAL_DMA_Init(hdmaRx) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	__HAL_LINKDMA(huart, hdmarx, *hdmaRx);
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Shell attach function, connects optional stages used by commands
+  * @param  shell   - pointer to shell structure
+  * @param  hist    - pointer to history of served ADC (trace, cap) | can be NULL
+  * @param  lat     - pointer to latency statistics (stats) | can be NULL
+  * @retval status  - HAL status if stages were attached
+  */
+HAL_StatusTypeDef ADC_ShellAttach(ADC_ShellTypeDef* shell, ADC_HistoryTypeDef* hist, ADC_LatencyTypeDef* lat){
+
+	// checking if correct parameters were provided
+	if(shell == NULL){
+		return HAL_ERROR;
+	}
+
+	shell->hist = hist;
+	shell->lat  = lat;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Shell start function, starts circular reception and prints prompt
+  * @param  shell   - pointer to initialized shell structure
+  * @retval status  - HAL status if reception was started
+  */
+HAL_StatusTypeDef ADC_ShellStart(ADC_ShellTypeDef* shell){
+
+	// checking if correct parameters were provided
+	if(shell == NULL || shell->huart == NULL){
+		return HAL_ERROR;
+	}
+
+	shell->RxTail = 0;
+
+	if(HAL_UART_Receive_DMA(shell->huart, shell->RxRing, ADC_SHELL_RX_SIZE) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	// ring position is polled | no DMA interrupts during reception
+	__HAL_DMA_DISABLE_IT(shell->huart->hdmarx, DMA_IT_HT | DMA_IT_TC);
+
+	ADC_ShellPrint(shell, "\r\nADC shell, type help\r\n" ADC_SHELL_PROMPT);
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Shell process function, reads received bytes, executes completed lines and continues output
+  * 	   Should be called from main loop (or low priority scheduler handler), never from interrupt
+  * @param  shell   - pointer to started shell structure
+  */
+void ADC_ShellProcess(ADC_ShellTypeDef* shell){
+
+	if(shell == NULL || shell->huart == NULL || shell->huart->hdmarx == NULL){
+		return;
+	}
+
+	// reception stopped by UART error (e.g. overrun) | restarting from beginning of ring
+	if(shell->huart->RxState == HAL_UART_STATE_READY){
+		shell->RxRestarts++;
+		ADC_ShellStart(shell);
+	}
+
+	if(shell->CaptureScans != 0){
+		ADC_ShellCaptureCheck(shell);
+	}
+
+	// input waits until dump is streamed | output of commands is not interleaved
+	if(shell->DumpRanks == 0){
+
+		uint16_t head = (uint16_t)(ADC_SHELL_RX_SIZE - __HAL_DMA_GET_COUNTER(shell->huart->hdmarx));
+
+		head = (head >= ADC_SHELL_RX_SIZE) ? 0U : head;
+
+		while(shell->RxTail != head && shell->DumpRanks == 0){
+			char c = (char)shell->RxRing[shell->RxTail];
+
+			shell->RxTail = (uint16_t)((shell->RxTail + 1U) % ADC_SHELL_RX_SIZE);
+
+			ADC_ShellInput(shell, c);
+		}
+	}
+
+	if(shell->DumpRanks != 0){
+		ADC_ShellDump(shell);
+	}
+}
+
+
+/**
+  * @brief Shell load function, loads configuration through ADC_ShellLoadCallback and applies it
+  * 	   Should be called after ADC_Init. Settings rejected by family or state of ADC (e.g. oversampler of running ADC)
+  * 	   are skipped.
+  * @param  shell   - pointer to initialized shell structure
+  * @retval status  - HAL_ERROR if no valid configuration was loaded
+  */
+HAL_StatusTypeDef ADC_ShellLoad(ADC_ShellTypeDef* shell){
+
+	ADC_ShellConfigTypeDef config;
+
+	// checking if correct parameters were provided
+	if(shell == NULL || shell->hadc == NULL){
+		return HAL_ERROR;
+	}
+
+	if(ADC_ShellLoadCallback(shell, &config) != HAL_OK || config.Magic != ADC_SHELL_MAGIC){
+		return HAL_ERROR;
+	}
+
+	if(ADC_SHELL_SMP_BUSY(shell->hadc) == 0){
+		for(uint8_t channel = 0; channel < ADC_CONTEXT_CHANNELS; ++channel){
+			if(config.Code[channel] < ADC_SHELL_SMP_CODES && shell->ctx->RankOfChannel[channel] != ADC_CONTEXT_NO_RANK){
+				__ADC_SET_SAMPLETIME(shell->hadc, channel, config.Code[channel]);
+			}
+		}
+	}
+
+	if(config.Ratio != 0){
+		ADC_SetOversampling(shell->hadc, config.Ratio, config.Shift);
+	}
+
+	if(config.Bits != 0){
+		float max = ADC_ShellMax(shell);
+
+		if(ADC_SetResolution(shell->hadc, shell->badc, config.Bits) == HAL_OK){
+			ADC_ContextRescale(shell->ctx, shell->hadc, max);
+			shell->Bits = config.Bits;
+		}
+	}
+
+	ADC_SetAveragedMeasures(shell->badc, shell->cadc, config.AveragedMeasures);
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Shell print function, formats text to console | never blocks, text not fitting console ring is dropped
+  * 	   Should be called from thread context (e.g. handlers of scheduler), like ADC_ShellProcess
+  * @param  shell   - pointer to shell structure
+  * @param  format  - printf format
+  * @retval length  - number of queued bytes
+  */
+uint16_t ADC_ShellPrint(ADC_ShellTypeDef* shell, const char* format, ...){
+
+	va_list args;
+
+	va_start(args, format);
+	int n = vsnprintf(shell->Text, ADC_SHELL_TEXT_SIZE, format, args);
+	va_end(args);
+
+	if(n <= 0){
+		return 0;
+	}
+
+	return ADC_ShellWrite(shell, shell->Text, (n < (int)ADC_SHELL_TEXT_SIZE) ? (uint16_t)n : (uint16_t)(ADC_SHELL_TEXT_SIZE - 1U));
+}
+
+
+/**
+  * @brief Empty implementation of configuration load callback | should copy persisted configuration (e.g. from flash)
+  * @param  shell   - pointer to shell structure
+  * @param  config  - pointer to configuration
+  * @retval status  - HAL_OK if configuration was loaded | validated by ADC_ShellLoad
+  */
+__weak HAL_StatusTypeDef ADC_ShellLoadCallback(ADC_ShellTypeDef* shell, ADC_ShellConfigTypeDef* config){
+
+	UNUSED(shell);     // unused variables to avoid warnings
+	UNUSED(config);
+
+	return HAL_ERROR;  // nothing persisted | defaults are kept
+}
+
+
+/**
+  * @brief Empty implementation of configuration store callback | should persist configuration (e.g. in flash)
+  * @param  shell   - pointer to shell structure
+  * @param  config  - pointer to configuration
+  * @retval status  - HAL_OK if configuration was stored
+  */
+__weak HAL_StatusTypeDef ADC_ShellStoreCallback(ADC_ShellTypeDef* shell, const ADC_ShellConfigTypeDef* config){
+
+	UNUSED(shell);     // unused variables to avoid warnings
+	UNUSED(config);
+
+	return HAL_ERROR;  // no storage | save is reported as failed
+}
+
+
+/**
+  * @brief Shell input function, edits line and executes it at end of line | echoes input
+  * @param  shell   - pointer to shell structure
+  * @param  c       - received character
+  */
+static void ADC_ShellInput(ADC_ShellTypeDef* shell, char c){
+
+	if(c == '\r' || c == '\n'){
+
+		// second character of CR LF
+		if(c == '\n' && shell->LineLength == 0 && shell->LineOverflow == 0){
+			return;
+		}
+
+		ADC_ShellPrint(shell, "\r\n");
+
+		if(shell->LineOverflow != 0){
+			ADC_ShellPrint(shell, "line too long\r\n");
+		}else{
+			shell->Line[shell->LineLength] = '\0';
+			ADC_ShellExecute(shell);
+		}
+
+		shell->LineLength   = 0;
+		shell->LineOverflow = 0;
+
+		// prompt follows dump
+		if(shell->DumpRanks == 0){
+			ADC_ShellPrint(shell, ADC_SHELL_PROMPT);
+		}
+
+		return;
+	}
+
+	// backspace or delete
+	if(c == '\b' || c == 0x7F){
+		if(shell->LineLength > 0){
+			shell->LineLength--;
+			ADC_ShellPrint(shell, "\b \b");
+		}
+		return;
+	}
+
+	if(c < ' ' || c > '~'){
+		return;
+	}
+
+	if(shell->LineLength >= ADC_SHELL_LINE_SIZE - 1U){
+		shell->LineOverflow = 1;
+		return;
+	}
+
+	shell->Line[shell->LineLength++] = c;
+
+	ADC_ShellWrite(shell, &c, 1);
+}
+
+
+/**
+  * @brief Shell execute function, splits line to command and numeric arguments and calls handler of command
+  * @param  shell   - pointer to shell structure
+  */
+static void ADC_ShellExecute(ADC_ShellTypeDef* shell){
+
+	char*   save = NULL;
+	char*   name = strtok_r(shell->Line, " \t", &save);
+	long    argv[ADC_SHELL_MAX_ARGS] = {0};
+	uint8_t argc = 0;
+
+	if(name == NULL){
+		return;
+	}
+
+	for(char* token = strtok_r(NULL, " \t", &save); token != NULL; token = strtok_r(NULL, " \t", &save)){
+
+		char* end = NULL;
+
+		if(argc >= ADC_SHELL_MAX_ARGS){
+			ADC_ShellPrint(shell, "too many arguments\r\n");
+			return;
+		}
+
+		argv[argc] = strtol(token, &end, 0);
+
+		if(end == token || *end != '\0'){
+			ADC_ShellPrint(shell, "bad argument: %s\r\n", token);
+			return;
+		}
+
+		argc++;
+	}
+
+	for(uint8_t i = 0; i < sizeof(ADC_ShellCommands) / sizeof(ADC_ShellCommands[0]); ++i){
+
+		const ADC_ShellCommandTypeDef* cmd = &ADC_ShellCommands[i];
+
+		if(strcmp(name, cmd->Name) != 0){
+			continue;
+		}
+
+		if(argc < cmd->MinArgs){
+			ADC_ShellPrint(shell, "usage: %s %s\r\n", cmd->Name, cmd->Help);
+			return;
+		}
+
+		shell->Commands++;
+		cmd->Handler(shell, argc, argv);
+		return;
+	}
+
+	ADC_ShellPrint(shell, "unknown command: %s, type help\r\n", name);
+}
+
+
+/**
+  * @brief Shell write function, writes bytes to console as a whole or drops them
+  * @param  shell   - pointer to shell structure
+  * @param  data    - pointer to bytes
+  * @param  length  - number of bytes
+  * @retval length  - number of queued bytes
+  */
+static uint16_t ADC_ShellWrite(ADC_ShellTypeDef* shell, const char* data, uint16_t length){
+
+	if(length == 0){
+		return 0;
+	}
+
+	if(ADC_ConsoleWrite(shell->con, data, length) == 0U){
+		shell->Dropped += length;
+		return 0;
+	}
+
+	return length;
+}
+
+
+/**
+  * @brief Shell space function
+  * @param  shell   - pointer to shell structure
+  * @retval space   - free bytes of console ring | shared with printf and log macros
+  */
+static uint16_t ADC_ShellSpace(const ADC_ShellTypeDef* shell){
+
+	uint32_t space = ADC_ConsoleSpace(shell->con);
+
+	return (space < UINT16_MAX) ? (uint16_t)space : UINT16_MAX;
+}
+
+
+/**
+  * @brief Shell status function, prints result of driver call
+  * @param  shell   - pointer to shell structure
+  * @param  status  - HAL status
+  */
+static void ADC_ShellStatus(ADC_ShellTypeDef* shell, HAL_StatusTypeDef status){
+
+	static const char* const names[] = { "ok", "error", "busy", "timeout" };
+
+	ADC_ShellPrint(shell, "%s\r\n", ((uint32_t)status < 4U) ? names[status] : "?");
+}
+
+
+/**
+  * @brief Shell dump function, streams lines of snapshot while they fit console ring | scan index, then sample of every rank
+  * @param  shell   - pointer to shell structure
+  */
+static void ADC_ShellDump(ADC_ShellTypeDef* shell){
+
+	uint16_t lineSize = (uint16_t)(8U + 7U * shell->DumpRanks);		// worst case of formatted line
+
+	while(shell->DumpIndex < shell->DumpScans && ADC_ShellSpace(shell) >= lineSize){
+
+		int length = snprintf(shell->Text, ADC_SHELL_TEXT_SIZE, "%u", (unsigned)shell->DumpIndex);
+
+		for(uint8_t r = 0; r < shell->DumpRanks && length > 0 && length < (int)ADC_SHELL_TEXT_SIZE; ++r){
+			length += snprintf(&shell->Text[length], ADC_SHELL_TEXT_SIZE - (uint16_t)length, ",%u",
+							   (unsigned)shell->Capture[(uint32_t)r * shell->DumpScans + shell->DumpIndex]);
+		}
+
+		if(length > 0 && length < (int)ADC_SHELL_TEXT_SIZE - 2){
+			shell->Text[length++] = '\r';
+			shell->Text[length++] = '\n';
+			ADC_ShellWrite(shell, shell->Text, (uint16_t)length);
+		}
+
+		shell->DumpIndex++;
+	}
+
+	// prompt with line typed during dump (armed capture)
+	if(shell->DumpIndex >= shell->DumpScans && ADC_ShellSpace(shell) >= sizeof(ADC_SHELL_PROMPT) + ADC_SHELL_LINE_SIZE){
+		shell->DumpRanks = 0;
+		ADC_ShellPrint(shell, ADC_SHELL_PROMPT "%.*s", (int)shell->LineLength, shell->Line);
+	}
+}
+
+
+/**
+  * @brief Shell capture check function, takes snapshot of armed capture when history holds requested scans
+  * @param  shell   - pointer to shell structure
+  */
+static void ADC_ShellCaptureCheck(ADC_ShellTypeDef* shell){
+
+	ADC_HistoryTypeDef* hist    = shell->hist;
+	uint32_t            elapsed = hist->Scans - shell->CaptureStart;
+	uint16_t            scans   = shell->CaptureScans;
+
+	if(elapsed < scans || shell->DumpRanks != 0){
+		return;
+	}
+
+	shell->CaptureScans = 0;
+
+	// history was overwritten before main loop came | first captured scan is lost
+	if(elapsed > hist->Depth){
+		ADC_ShellPrint(shell, "\r\ncapture lost, %lu scans elapsed\r\n" ADC_SHELL_PROMPT "%.*s", (unsigned long)elapsed,
+					   (int)shell->LineLength, shell->Line);
+		return;
+	}
+
+	for(uint8_t r = 0; r < hist->Channels; ++r){
+
+		const uint16_t* window = ADC_HistoryWindow(hist, r, (uint16_t)elapsed);	// starts with first scan after arming
+
+		memcpy(&shell->Capture[(uint32_t)r * scans], window, scans * sizeof(uint16_t));
+	}
+
+	ADC_ShellPrint(shell, "\r\ncapture %u scans, ranks %u\r\n", (unsigned)scans, (unsigned)hist->Channels);
+
+	shell->DumpFirst = 0;
+	shell->DumpRanks = hist->Channels;
+	shell->DumpScans = scans;
+	shell->DumpIndex = 0;
+}
+
+
+/**
+  * @brief Shell max function | max value of context, recovered from its scale
+  * @param  shell   - pointer to shell structure
+  * @retval max     - value of full scale given to ADC_ContextInit
+  */
+static float ADC_ShellMax(const ADC_ShellTypeDef* shell){
+
+	uint32_t fullScale = shell->ctx->Oversampled ? __ADC_DATA_MAX(shell->hadc) : __ADC_FULL_SCALE(shell->hadc);
+
+	return shell->ctx->Scale * (float)fullScale;
+}
+
+
+/**
+  * @brief Command help | list of commands
+  */
+static void ADC_ShellCmdHelp(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	UNUSED(argc);
+	UNUSED(argv);
+
+	for(uint8_t i = 0; i < sizeof(ADC_ShellCommands) / sizeof(ADC_ShellCommands[0]); ++i){
+		ADC_ShellPrint(shell, "%-6s %s\r\n", ADC_ShellCommands[i].Name, ADC_ShellCommands[i].Help);
+	}
+}
+
+
+/**
+  * @brief Command ch | converted channels
+  */
+static void ADC_ShellCmdChannels(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	UNUSED(argc);
+	UNUSED(argv);
+
+	for(uint8_t channel = 0; channel < ADC_CONTEXT_CHANNELS; ++channel){
+
+		uint8_t rank = shell->ctx->RankOfChannel[channel];
+
+		if(rank == ADC_CONTEXT_NO_RANK){
+			continue;
+		}
+
+		ADC_ShellPrint(shell, "ch %2u rank %2u avg %5u %5lu mV smp %u\r\n", (unsigned)channel, (unsigned)rank,
+					   (unsigned)ADC_InlineAveraged(shell->ctx, channel),
+					   (unsigned long)(ADC_InlineScaled(shell->ctx, channel) * 1000.0f + 0.5f),
+					   (unsigned)__ADC_SAMPLETIME(shell->hadc, channel));
+	}
+}
+
+
+/**
+  * @brief Command stats | counters of buffer and shell, latency of stages
+  */
+static void ADC_ShellCmdStats(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	const ADC_BufferTypeDef* badc = shell->badc;
+
+	UNUSED(argc);
+	UNUSED(argv);
+
+	ADC_ShellPrint(shell, "blocks half=%lu full=%lu errors=%lu overruns=%lu discontinuous=%u avg=%u\r\n",
+				   (unsigned long)badc->HalfBlocks, (unsigned long)badc->FullBlocks, (unsigned long)badc->Errors,
+				   (unsigned long)badc->Overruns, (unsigned)badc->Discontinuous, (unsigned)badc->AveragedMeasures);
+
+	ADC_ShellPrint(shell, "shell commands=%lu dropped=%lu rx restarts=%lu\r\n",
+				   (unsigned long)shell->Commands, (unsigned long)shell->Dropped, (unsigned long)shell->RxRestarts);
+
+	ADC_ShellPrint(shell, "console written=%lu dropped=%lu peak=%lu/%u\r\n",
+				   (unsigned long)shell->con->Written, (unsigned long)shell->con->Dropped, (unsigned long)shell->con->Peak,
+				   (unsigned)ADC_CONSOLE_SIZE);
+
+	if(shell->hist != NULL){
+		ADC_ShellPrint(shell, "history scans=%lu depth=%u\r\n", (unsigned long)shell->hist->Scans, (unsigned)shell->hist->Depth);
+	}
+
+	if(shell->lat != NULL){
+		uint16_t length = ADC_LatencyFormat(shell->lat, shell->Text, ADC_SHELL_TEXT_SIZE);
+
+		ADC_ShellWrite(shell, shell->Text, length);
+	}
+
+	// usage of static pools | empty if no pool was used
+	ADC_ShellWrite(shell, shell->Text, ADC_PoolFormat(shell->Text, ADC_SHELL_TEXT_SIZE));
+}
+
+
+/**
+  * @brief Command trace | snapshot of latest samples of rank
+  */
+static void ADC_ShellCmdTrace(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	ADC_HistoryTypeDef* hist = shell->hist;
+
+	if(hist == NULL){
+		ADC_ShellPrint(shell, "no history attached\r\n");
+		return;
+	}
+
+	long limit   = (hist->Depth < ADC_SHELL_CAPTURE_SIZE) ? hist->Depth : ADC_SHELL_CAPTURE_SIZE;
+	long samples = (argc > 1) ? argv[1] : ((limit < 32) ? limit : 32);
+
+	if(argv[0] < 0 || argv[0] >= hist->Channels || samples <= 0 || samples > limit){
+		ADC_ShellPrint(shell, "rank 0 ... %u, n 1 ... %ld\r\n", (unsigned)(hist->Channels - 1U), limit);
+		return;
+	}
+
+	const uint16_t* window = ADC_HistoryWindow(hist, (uint8_t)argv[0], (uint16_t)samples);
+
+	memcpy(shell->Capture, window, (size_t)samples * sizeof(uint16_t));
+
+	ADC_ShellPrint(shell, "trace rank %ld, %ld samples\r\n", argv[0], samples);
+
+	shell->DumpFirst = (uint8_t)argv[0];
+	shell->DumpRanks = 1;
+	shell->DumpScans = (uint16_t)samples;
+	shell->DumpIndex = 0;
+}
+
+
+/**
+  * @brief Command cap | arms capture of next scans of all ranks
+  */
+static void ADC_ShellCmdCapture(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	ADC_HistoryTypeDef* hist = shell->hist;
+
+	UNUSED(argc);
+
+	if(hist == NULL){
+		ADC_ShellPrint(shell, "no history attached\r\n");
+		return;
+	}
+
+	long limit = ADC_SHELL_CAPTURE_SIZE / hist->Channels;
+
+	limit = (hist->Depth < limit) ? hist->Depth : limit;
+
+	if(argv[0] <= 0 || argv[0] > limit){
+		ADC_ShellPrint(shell, "scans 1 ... %ld\r\n", limit);
+		return;
+	}
+
+	shell->CaptureStart = hist->Scans;
+	shell->CaptureScans = (uint16_t)argv[0];
+
+	ADC_ShellPrint(shell, "capture armed\r\n");
+}
+
+
+/**
+  * @brief Command avg | averaging depth
+  */
+static void ADC_ShellCmdAveraging(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	UNUSED(argc);
+
+	if(argv[0] <= 0 || argv[0] > 255){
+		ADC_ShellStatus(shell, HAL_ERROR);
+		return;
+	}
+
+	ADC_ShellStatus(shell, ADC_SetAveragedMeasures(shell->badc, shell->cadc, (uint8_t)argv[0]));
+}
+
+
+/**
+  * @brief Command smp | sampling time code of converted channel
+  */
+static void ADC_ShellCmdSampling(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	UNUSED(argc);
+
+	if(argv[0] < 0 || argv[0] >= (long)ADC_CONTEXT_CHANNELS || shell->ctx->RankOfChannel[argv[0]] == ADC_CONTEXT_NO_RANK ||
+	   argv[1] < 0 || argv[1] >= (long)ADC_SHELL_SMP_CODES){
+		ADC_ShellStatus(shell, HAL_ERROR);
+		return;
+	}
+
+	if(ADC_SHELL_SMP_BUSY(shell->hadc) != 0){
+		ADC_ShellStatus(shell, HAL_BUSY);
+		return;
+	}
+
+	__ADC_SET_SAMPLETIME(shell->hadc, (uint32_t)argv[0], (uint32_t)argv[1]);
+
+	ADC_ShellStatus(shell, HAL_OK);
+}
+
+
+/**
+  * @brief Command os | hardware oversampler
+  */
+static void ADC_ShellCmdOversampling(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	UNUSED(argc);
+
+	if(argv[0] < 0 || argv[0] > 0xFFFF || argv[1] < 0 || argv[1] > 0xFF){
+		ADC_ShellStatus(shell, HAL_ERROR);
+		return;
+	}
+
+	ADC_ShellStatus(shell, ADC_SetOversampling(shell->hadc, (uint16_t)argv[0], (uint8_t)argv[1]));
+}
+
+
+/**
+  * @brief Command res | resolution, context keeps its max value
+  */
+static void ADC_ShellCmdResolution(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	UNUSED(argc);
+
+	if(argv[0] <= 0 || argv[0] > 16){
+		ADC_ShellStatus(shell, HAL_ERROR);
+		return;
+	}
+
+	float             max    = ADC_ShellMax(shell);
+	HAL_StatusTypeDef status = ADC_SetResolution(shell->hadc, shell->badc, (uint8_t)argv[0]);
+
+	if(status == HAL_OK){
+		ADC_ContextRescale(shell->ctx, shell->hadc, max);
+		shell->Bits = (uint8_t)argv[0];
+	}
+
+	ADC_ShellStatus(shell, status);
+}
+
+
+/**
+  * @brief Command save | persists configuration through ADC_ShellStoreCallback
+  */
+static void ADC_ShellCmdSave(ADC_ShellTypeDef* shell, uint8_t argc, const long* argv){
+
+	ADC_ShellConfigTypeDef config;
+
+	UNUSED(argc);
+	UNUSED(argv);
+
+	memset(&config, 0, sizeof(config));
+
+	config.Magic            = ADC_SHELL_MAGIC;
+	config.AveragedMeasures = shell->badc->AveragedMeasures;
+	config.Bits             = shell->Bits;
+
+	if(ADC_GetOversampling(shell->hadc, &config.Ratio, &config.Shift) != HAL_OK){
+		config.Ratio = 0;
+		config.Shift = 0;
+	}
+
+	for(uint8_t channel = 0; channel < ADC_CONTEXT_CHANNELS; ++channel){
+		config.Code[channel] = (shell->ctx->RankOfChannel[channel] != ADC_CONTEXT_NO_RANK) ?
+							   (uint8_t)__ADC_SAMPLETIME(shell->hadc, channel) : ADC_SHELL_NO_CODE;
+	}
+
+	ADC_ShellStatus(shell, ADC_ShellStoreCallback(shell, &config));
+}
@@ -0,0 +1,1390 @@
+
+/**
+  ******************************************************************************
+  * @file      adc_sim.c
+  * @author    Bartosz Rychlicki
+  * @Title     Virtual-time simulation of ADC and DMA for host builds
+  * @brief     This file contains functions' bodies of event-driven simulation of F1 ADC and DMA and HAL functions used by driver
+  ******************************************************************************
+  * @attention Compiled only with ADC_SIM defined. Simulation jumps from event to event (end of conversion, interrupt delivery),
+  * 		   continuous scans without active DMA are skipped in one step, so hours of acquisition take seconds of host time.
+  * 		   Memory-to-memory DMA is started by __ADC_DMA_START_COPY with host pointers, HAL_DMA_Start_IT reports busy.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#if defined(ADC_SIM)
+
+#include "adc_sim.h"
+#include <stdio.h>
+#include <string.h>
+
+// Public variables
+ADC_SimRegsTypeDef ADC_SimRegs;
+
+// Private variables
+// Simulation driven by HAL functions and __ADC_CYCLES
+static 			ADC_SimTypeDef* ADC_SIM_ACTIVE;
+
+// Conversion time of F1 ADC in ADC clock cycles for SMPx codes | sampling time + 12.5 cycles
+static const 	uint16_t ADC_SIM_CONVERSION_CYCLES[8] = { 14, 20, 26, 41, 54, 68, 84, 252 };
+
+// Private functions prototypes
+static uint8_t  ADC_SimIndex(ADC_TypeDef* instance);
+static uint8_t  ADC_SimIsDual(void);
+static uint8_t  ADC_SimRanks(ADC_TypeDef* regs);
+static uint8_t  ADC_SimChannel(ADC_TypeDef* regs, uint8_t rank);
+static uint16_t ADC_SimSample(ADC_SimTypeDef* sim, uint8_t adc, uint8_t channel);
+static uint16_t ADC_SimSettle(ADC_SimTypeDef* sim, uint8_t adc, uint8_t channel, uint16_t input);
+static uint32_t ADC_SimAlign(ADC_TypeDef* regs, uint32_t data);
+static uint8_t  ADC_SimDmaActive(ADC_SimTypeDef* sim);
+static void     ADC_SimLatchDma(ADC_SimTypeDef* sim);
+static void     ADC_SimStartDma(ADC_SimTypeDef* sim, DMA_HandleTypeDef* hdma, void* memory, uint32_t length);
+static void     ADC_SimStartScan(ADC_SimTypeDef* sim, uint8_t adc, uint64_t time);
+static void     ADC_SimSkipScans(ADC_SimTypeDef* sim, uint8_t adc, uint64_t limit);
+static void     ADC_SimComplete(ADC_SimTypeDef* sim, uint8_t adc);
+static void     ADC_SimTransfer(ADC_SimTypeDef* sim, uint32_t data);
+static uint8_t  ADC_SimDeliver(ADC_SimTypeDef* sim);
+static void     ADC_SimLose(ADC_SimTypeDef* sim, uint64_t conversions);
+static void     ADC_SimCompleteCopy(ADC_SimTypeDef* sim);
+static void     ADC_SimInject(ADC_SimTypeDef* sim, ADC_SimFaultType type);
+static uint64_t ADC_SimRandomInterval(ADC_SimTypeDef* sim, uint64_t mean);
+static uint64_t ADC_SimRandom(ADC_SimTypeDef* sim);
+static uint8_t  ADC_SimFlashOperation(ADC_SimTypeDef* sim, uint32_t address, uint32_t length, uint64_t cycles);
+
+
+/**
+  * @brief Simulation init function, resets virtual time and all simulated registers
+  * @param  sim             - pointer to simulation structure
+  * @param  adcClockDivider - core clock cycles per ADC clock cycle | e.g. 6 for 72 MHz core and 12 MHz ADC clock
+  * @retval status          - HAL status if simulation was initialized
+  */
+HAL_StatusTypeDef ADC_SimInit(ADC_SimTypeDef* sim, uint32_t adcClockDivider){
+
+	// checking if correct parameters were provided
+	if(sim == NULL || adcClockDivider == 0){
+		return HAL_ERROR;
+	}
+
+	memset(sim, 0, sizeof(ADC_SimTypeDef));
+	memset(&ADC_SimRegs, 0, sizeof(ADC_SimRegs));
+
+	sim->AdcClockDivider = adcClockDivider;
+	sim->Dma.Channel     = DMA1_Channel1;
+	sim->Dma.HalfDue     = ADC_SIM_NEVER;
+	sim->Dma.FullDue     = ADC_SIM_NEVER;
+	sim->Copy.Due        = ADC_SIM_NEVER;
+	sim->Seed            = 1U;
+
+	for(uint8_t f = 0; f < ADC_SIM_FAULTS; ++f){
+		sim->Faults[f].Next = ADC_SIM_NEVER;
+	}
+
+	memset(sim->Flash.Memory, 0xFF, sizeof(sim->Flash.Memory));		// erased flash
+	sim->Flash.Locked = 1;
+
+	ADC_SIM_ACTIVE = sim;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Simulation advance function, moves virtual time forward converting, transferring and delivering interrupts
+  * @param  sim     - pointer to simulation structure
+  * @param  cycles  - number of core clock cycles
+  */
+void ADC_SimAdvance(ADC_SimTypeDef* sim, uint64_t cycles){
+
+	uint64_t target = sim->Now + cycles;
+
+	for(;;){
+
+		ADC_SimLatchDma(sim);
+
+		uint64_t next = ADC_SIM_NEVER;
+
+		// next injected fault
+		for(uint8_t f = 0; f < ADC_SIM_FAULTS; ++f){
+			next = (sim->Faults[f].Next < next) ? sim->Faults[f].Next : next;
+		}
+
+		for(uint8_t i = 0; i < 2; ++i){
+
+			ADC_SimAdcTypeDef* a    = &sim->Adc[i];
+			ADC_TypeDef*       regs = &ADC_SimRegs.Adc[i];
+
+			// Slave is converted together with Master in dual mode
+			if(i == 1 && ADC_SimIsDual()){
+				continue;
+			}
+
+			// starting scan of idle, enabled ADC | software start or external trigger, ADC1 stays stopped after overrun
+			if(a->Busy == 0 && (regs->CR2 & ADC_CR2_ADON) != 0 && (regs->SR & ADC_SR_STRT) != 0 && (i != 0 || sim->Overrun == 0)){
+
+				if(a->TriggerPeriod != 0){
+					CLEAR_BIT(regs->CR2, ADC_CR2_SWSTART);		// external trigger selected | software start is ignored
+
+					if(a->NextTrigger <= target){
+						ADC_SimStartScan(sim, i, (a->NextTrigger > sim->Now) ? a->NextTrigger : sim->Now);
+						a->NextTrigger += a->TriggerPeriod;
+					}
+				}else if((regs->CR2 & ADC_CR2_SWSTART) != 0){
+					CLEAR_BIT(regs->CR2, ADC_CR2_SWSTART);
+					ADC_SimStartScan(sim, i, sim->Now);
+				}
+			}
+
+			if(a->Busy != 0){
+
+				// nothing observable until next interrupt or target | skipping whole scans in one step
+				if(a->Rank == 0 && (i != 0 || ADC_SimDmaActive(sim) == 0)){
+					uint64_t limit = (next < target) ? next : target;
+
+					limit = (sim->Dma.HalfDue < limit) ? sim->Dma.HalfDue : limit;
+					limit = (sim->Dma.FullDue < limit) ? sim->Dma.FullDue : limit;
+
+					ADC_SimSkipScans(sim, i, limit);
+				}
+
+				next = (a->ConvEnd < next) ? a->ConvEnd : next;
+			}
+		}
+
+		next = (sim->Dma.HalfDue < next) ? sim->Dma.HalfDue : next;
+		next = (sim->Dma.FullDue < next) ? sim->Dma.FullDue : next;
+		next = (sim->Copy.Due    < next) ? sim->Copy.Due    : next;
+
+		// no event until target
+		if(next > target){
+			sim->Now = target;
+			return;
+		}
+
+		sim->Now = next;
+
+		// completing conversions ending now | Master first, DMA request of Master is served before interrupt delivery
+		for(uint8_t i = 0; i < 2; ++i){
+			if(sim->Adc[i].Busy != 0 && sim->Adc[i].ConvEnd == next){
+				ADC_SimComplete(sim, i);
+			}
+		}
+
+		while(ADC_SimDeliver(sim) != 0){
+		}
+
+		if(sim->Copy.Due == next){
+			ADC_SimCompleteCopy(sim);
+		}
+
+		// injecting faults due now
+		for(uint8_t f = 0; f < ADC_SIM_FAULTS; ++f){
+
+			ADC_SimFaultTypeDef* fault = &sim->Faults[f];
+
+			if(fault->Next == next){
+				fault->Next = (fault->MeanInterval != 0) ? next + ADC_SimRandomInterval(sim, fault->MeanInterval) : ADC_SIM_NEVER;
+
+				ADC_SimInject(sim, (ADC_SimFaultType)f);
+			}
+		}
+	}
+}
+
+
+/**
+  * @brief Simulation run function, calls consumer periodically and advances time by its execution time and idle rest of period
+  * @param  sim      - pointer to simulation structure
+  * @param  duration - simulated time [cycles]
+  * @param  period   - consumer period [cycles] | consumer longer than period is counted and started again right after finishing
+  * @param  consumer - consumer function | NULL: acquisition only
+  * @param  arg      - argument passed to consumer
+  */
+void ADC_SimRun(ADC_SimTypeDef* sim, uint64_t duration, uint32_t period, ADC_SimConsumerTypeDef consumer, void* arg){
+
+	uint64_t end = sim->Now + duration;
+
+	if(consumer == NULL || period == 0){
+		ADC_SimAdvance(sim, duration);
+		return;
+	}
+
+	while(sim->Now < end){
+
+		uint64_t start = sim->Now;
+		uint32_t busy  = consumer(arg);
+
+		sim->ConsumerRuns++;
+
+		if(busy > period){
+			sim->ConsumerOverruns++;
+		}
+
+		uint64_t next = start + ((busy > period) ? busy : period);
+
+		ADC_SimAdvance(sim, ((next < end) ? next : end) - start);
+	}
+}
+
+
+/**
+  * @brief Simulation conversion time function
+  * @param  sim     - pointer to simulation structure
+  * @param  adc     - 0: ADC1, 1: ADC2
+  * @param  channel - number of channel
+  * @retval cycles  - conversion time of channel with its SMPR sampling time [core clock cycles] | multiplied by oversampling ratio
+  */
+uint32_t ADC_SimConversionTime(ADC_SimTypeDef* sim, uint8_t adc, uint8_t channel){
+
+	ADC_TypeDef* regs  = &ADC_SimRegs.Adc[adc];
+	uint32_t     code  = (channel < 10) ? (regs->SMPR2 >> (3U * channel)) : (regs->SMPR1 >> (3U * (channel - 10U)));
+	uint32_t     ratio = (sim->Adc[adc].OversamplingRatio > 1U) ? sim->Adc[adc].OversamplingRatio : 1U;
+
+	return ADC_SIM_CONVERSION_CYCLES[code & 0x7U] * sim->AdcClockDivider * ratio;
+}
+
+
+/**
+  * @brief Simulation clock | source of __ADC_CYCLES in simulated build
+  * @retval cycles  - lower 32 bits of virtual time
+  */
+uint32_t ADC_SimCycles(void){
+
+	return (ADC_SIM_ACTIVE != NULL) ? (uint32_t)ADC_SIM_ACTIVE->Now : 0U;
+}
+
+
+/**
+  * @brief Simulation fault schedule function, injects fault once at given time
+  * @param  sim     - pointer to simulation structure
+  * @param  type    - type of fault
+  * @param  time    - virtual time of injection [cycles] | not earlier than current time
+  * @retval status  - HAL status if fault was scheduled
+  */
+HAL_StatusTypeDef ADC_SimFaultAt(ADC_SimTypeDef* sim, ADC_SimFaultType type, uint64_t time){
+
+	// checking if correct parameters were provided
+	if(sim == NULL || type >= ADC_SIM_FAULTS || time < sim->Now){
+		return HAL_ERROR;
+	}
+
+	sim->Faults[type].Next         = time;
+	sim->Faults[type].MeanInterval = 0;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Simulation random fault function, injects fault repeatedly with intervals uniformly distributed in [1, 2 * mean]
+  * @param  sim          - pointer to simulation structure
+  * @param  type         - type of fault
+  * @param  meanInterval - mean interval between injections [cycles] | 0 disables random injections
+  * @param  seed         - seed of pseudo-random generator | the same seed gives the same sequence of faults
+  * @retval status       - HAL status if faults were scheduled
+  */
+HAL_StatusTypeDef ADC_SimFaultRandom(ADC_SimTypeDef* sim, ADC_SimFaultType type, uint64_t meanInterval, uint32_t seed){
+
+	// checking if correct parameters were provided
+	if(sim == NULL || type >= ADC_SIM_FAULTS){
+		return HAL_ERROR;
+	}
+
+	sim->Seed                      = (seed != 0) ? seed : 1U;	// xorshift state cannot be 0
+	sim->Faults[type].MeanInterval = meanInterval;
+	sim->Faults[type].Next         = (meanInterval != 0) ? sim->Now + ADC_SimRandomInterval(sim, meanInterval) : ADC_SIM_NEVER;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Simulation fault report function, one line per fault type:
+  * 	   "<type> n=<injected> rec=<recovered> avg=<mean recovery> max=<max recovery> lost=<conversions> loss=<blackout share>"
+  * 	   Recovery times are in cycles, blackout share of simulated time is in 0.01 %
+  * @param  sim     - pointer to simulation structure
+  * @param  text    - pointer to output buffer
+  * @param  size    - size of output buffer
+  * @retval length  - number of written characters (without terminating zero)
+  */
+uint16_t ADC_SimFaultFormat(ADC_SimTypeDef* sim, char* text, uint16_t size){
+
+	static const char* const names[ADC_SIM_FAULTS] = { "dma", "ovr", "cal", "stuck" };
+	uint16_t length = 0;
+
+	if(text == NULL || size == 0){
+		return 0;
+	}
+
+	text[0] = '\0';
+
+	for(uint8_t f = 0; f < ADC_SIM_FAULTS && length < size - 1U; ++f){
+
+		ADC_SimFaultTypeDef* fault = &sim->Faults[f];
+
+		int n = snprintf(&text[length], size - length, "%s n=%lu rec=%lu avg=%llu max=%llu lost=%llu loss=%llu\r\n",
+		                 names[f],
+		                 (unsigned long)fault->Injected,
+		                 (unsigned long)fault->Recovered,
+		                 (unsigned long long)((fault->Recovered != 0) ? fault->Blackout / fault->Recovered : 0),
+		                 (unsigned long long)fault->RecoveryMax,
+		                 (unsigned long long)fault->Lost,
+		                 (unsigned long long)((sim->Now != 0) ? fault->Blackout * 10000U / sim->Now : 0));
+
+		if(n < 0){
+			break;
+		}
+
+		length = (length + (uint16_t)n < size) ? (uint16_t)(length + n) : (uint16_t)(size - 1U);
+	}
+
+	return length;
+}
+
+
+/**
+  * @brief Simulation overrun flag function | source of __ADC_IS_OVERRUN in simulated build
+  * @param  instance - ADC registers
+  * @retval flag     - 1 if ADC stopped on overrun
+  */
+uint32_t ADC_SimIsOverrun(ADC_TypeDef* instance){
+
+	return (ADC_SIM_ACTIVE != NULL && instance == ADC1 && ADC_SIM_ACTIVE->Overrun != 0) ? 1U : 0U;
+}
+
+
+/**
+  * @brief Simulation overrun clear function | source of __ADC_CLEAR_OVERRUN in simulated build
+  * 	   Scan restarts from first rank on next software start or trigger
+  * @param  instance - ADC registers
+  */
+void ADC_SimClearOverrun(ADC_TypeDef* instance){
+
+	if(ADC_SIM_ACTIVE != NULL && instance == ADC1){
+		ADC_SIM_ACTIVE->Overrun = 0;
+	}
+}
+
+
+/**
+  * @brief Simulation oversampler configuration function | source of __ADC_OVERSAMPLING_SET in simulated build
+  * @param  instance - ADC registers
+  * @param  ratio    - number of accumulated conversions | 1 disables oversampler
+  * @param  shift    - right shift of accumulated sum
+  */
+void ADC_SimSetOversampling(ADC_TypeDef* instance, uint16_t ratio, uint8_t shift){
+
+	if(ADC_SIM_ACTIVE != NULL){
+		ADC_SIM_ACTIVE->Adc[ADC_SimIndex(instance)].OversamplingRatio = (ratio > 1U) ? ratio : 0U;
+		ADC_SIM_ACTIVE->Adc[ADC_SimIndex(instance)].OversamplingShift = (ratio > 1U) ? shift : 0U;
+	}
+}
+
+
+/**
+  * @brief Simulation oversampler ratio function | source of __ADC_OVERSAMPLING_RATIO in simulated build
+  * @param  instance - ADC registers
+  * @retval ratio    - number of accumulated conversions | 1 if oversampler is disabled
+  */
+uint32_t ADC_SimOversamplingRatio(ADC_TypeDef* instance){
+
+	uint16_t ratio = (ADC_SIM_ACTIVE != NULL) ? ADC_SIM_ACTIVE->Adc[ADC_SimIndex(instance)].OversamplingRatio : 0U;
+
+	return (ratio > 1U) ? ratio : 1U;
+}
+
+
+/**
+  * @brief Simulation oversampler shift function | source of __ADC_OVERSAMPLING_SHIFT in simulated build
+  * @param  instance - ADC registers
+  * @retval shift    - right shift of accumulated sum
+  */
+uint32_t ADC_SimOversamplingShift(ADC_TypeDef* instance){
+
+	return (ADC_SIM_ACTIVE != NULL) ? ADC_SIM_ACTIVE->Adc[ADC_SimIndex(instance)].OversamplingShift : 0U;
+}
+
+
+/**
+  * @brief Simulation resolution configuration function | source of __ADC_SET_RESOLUTION in simulated build
+  * @param  instance - ADC registers
+  * @param  bits     - resolution | 12, 10, 8 or 6 bits
+  */
+void ADC_SimSetResolution(ADC_TypeDef* instance, uint8_t bits){
+
+	if(ADC_SIM_ACTIVE != NULL){
+		ADC_SIM_ACTIVE->Adc[ADC_SimIndex(instance)].Resolution = bits;
+	}
+}
+
+
+/**
+  * @brief Simulation resolution function | source of __ADC_RESOLUTION in simulated build
+  * @param  instance - ADC registers
+  * @retval value    - maximal converted value
+  */
+uint32_t ADC_SimResolution(ADC_TypeDef* instance){
+
+	return (1UL << ADC_SimResolutionBits(instance)) - 1U;
+}
+
+
+/**
+  * @brief Simulation resolution bits function | source of __ADC_DATA_SHIFT in simulated build
+  * @param  instance - ADC registers
+  * @retval bits     - bits of converted value | 12 until resolution is changed
+  */
+uint8_t ADC_SimResolutionBits(ADC_TypeDef* instance){
+
+	uint8_t bits = (ADC_SIM_ACTIVE != NULL) ? ADC_SIM_ACTIVE->Adc[ADC_SimIndex(instance)].Resolution : 0U;
+
+	return (bits != 0U) ? bits : 12U;
+}
+
+
+/**
+  * @brief Simulation memory-to-memory start function | source of __ADC_DMA_START_COPY in simulated build
+  * @param  hdma        - pointer to handle of spare DMA channel configured by HAL_DMA_Init
+  * @param  source      - pointer to source | read with PSIZE width
+  * @param  destination - pointer to destination | written with MSIZE width, wider source is truncated to lower bits
+  * @param  length      - number of transfers
+  * @retval status      - HAL_BUSY if channel did not complete previous transfer
+  */
+HAL_StatusTypeDef ADC_SimStartCopy(DMA_HandleTypeDef* hdma, const void* source, void* destination, uint32_t length){
+
+	// checking if correct parameters were provided
+	if(ADC_SIM_ACTIVE == NULL || hdma == NULL || source == NULL || destination == NULL || length == 0){
+		return HAL_ERROR;
+	}
+
+	ADC_SimCopyTypeDef* c = &ADC_SIM_ACTIVE->Copy;
+
+	if(hdma->State != HAL_DMA_STATE_READY || c->hdma != NULL){
+		return HAL_BUSY;
+	}
+
+	hdma->State    = HAL_DMA_STATE_BUSY;
+	c->hdma        = hdma;
+	c->Source      = source;
+	c->Destination = destination;
+	c->Length      = length;
+	c->Due         = ADC_SIM_ACTIVE->Now + (uint64_t)length * ADC_SIM_COPY_CYCLES + ADC_SIM_ACTIVE->IrqLatency;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Simulation flash read function | source of __ADC_FLASH_READ16 in simulated build
+  * @param  address - address of half-word in flash
+  * @retval data    - content of emulated flash | 0xFFFF outside of emulated window
+  */
+uint16_t ADC_SimFlashRead16(uint32_t address){
+
+	if(ADC_SIM_ACTIVE == NULL || address < ADC_SIM_FLASH_BASE || address + 2U > ADC_SIM_FLASH_BASE + ADC_SIM_FLASH_SIZE){
+		return 0xFFFFU;
+	}
+
+	const uint8_t* cell = &ADC_SIM_ACTIVE->Flash.Memory[address - ADC_SIM_FLASH_BASE];
+
+	return (uint16_t)(cell[0] | (cell[1] << 8));	// little endian
+}
+
+
+/**
+  * @brief Simulation power loss function, schedules power loss during flash operation
+  * @param  sim        - pointer to simulation structure
+  * @param  operations - number of operations (half-word programs, page erases) until power loss, last one is torn | 0: cancels
+  */
+void ADC_SimFlashPowerLoss(ADC_SimTypeDef* sim, uint32_t operations){
+
+	sim->Flash.PowerLossAfter = operations;
+}
+
+
+/**
+  * @brief Simulation power up function | models reset after power loss, content of flash is kept, control register is locked
+  * @param  sim     - pointer to simulation structure
+  */
+void ADC_SimFlashPowerUp(ADC_SimTypeDef* sim){
+
+	sim->Flash.PowerLost      = 0;
+	sim->Flash.PowerLossAfter = 0;
+	sim->Flash.Locked         = 1;
+}
+
+
+/* HAL functions used by driver ------------------------------------------------------ */
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc){
+
+	uint8_t            i = ADC_SimIndex(hadc->Instance);
+	ADC_SimAdcTypeDef* a = &ADC_SIM_ACTIVE->Adc[i];
+
+	a->hadc = hadc;
+
+	SET_BIT(hadc->Instance->CR2, ADC_CR2_ADON);
+	SET_BIT(hadc->Instance->SR,  ADC_SR_STRT);
+
+	if(a->TriggerPeriod != 0){
+		a->NextTrigger = ADC_SIM_ACTIVE->Now + a->TriggerPeriod;
+	}else{
+		SET_BIT(hadc->Instance->CR2, ADC_CR2_SWSTART);
+	}
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc){
+
+	CLEAR_BIT(hadc->Instance->CR2, ADC_CR2_ADON | ADC_CR2_SWSTART);
+	CLEAR_BIT(hadc->Instance->SR,  ADC_SR_STRT | ADC_SR_EOC);
+
+	ADC_SIM_ACTIVE->Adc[ADC_SimIndex(hadc->Instance)].Busy = 0;		// also releases stuck conversion
+
+	if(hadc->Instance == ADC1){
+		ADC_SIM_ACTIVE->Overrun = 0;
+	}
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef* hadc){
+
+	CLEAR_BIT(hadc->Instance->CR2, ADC_CR2_DMA);
+
+	// channel is aborted only if transfer is ongoing, like HAL_DMA_Abort does
+	if(hadc->DMA_Handle != NULL && hadc->DMA_Handle->State == HAL_DMA_STATE_BUSY){
+		CLEAR_BIT(hadc->DMA_Handle->Instance->CCR, DMA_CCR_EN | DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE);
+		hadc->DMA_Handle->State = HAL_DMA_STATE_READY;
+	}
+
+	ADC_SIM_ACTIVE->Dma.HalfDue = ADC_SIM_NEVER;
+	ADC_SIM_ACTIVE->Dma.FullDue = ADC_SIM_NEVER;
+
+	return HAL_ADC_Stop(hadc);
+}
+
+HAL_StatusTypeDef HAL_ADCEx_MultiModeStop_DMA(ADC_HandleTypeDef* hadc){
+
+	HAL_ADC_Stop(&(ADC_HandleTypeDef){ .Instance = ADC2 });
+
+	return HAL_ADC_Stop_DMA(hadc);
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length){
+
+	SET_BIT(hadc->Instance->CR2, ADC_CR2_DMA);
+
+	ADC_SimStartDma(ADC_SIM_ACTIVE, hadc->DMA_Handle, pData, Length);
+
+	return HAL_ADC_Start(hadc);
+}
+
+HAL_StatusTypeDef HAL_ADCEx_MultiModeStart_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length){
+
+	// Slave is enabled by Master's start in dual mode
+	SET_BIT(ADC2->CR2, ADC_CR2_ADON);
+	SET_BIT(ADC2->SR,  ADC_SR_STRT);
+
+	return HAL_ADC_Start_DMA(hadc, pData, Length);
+}
+
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef* hadc, uint32_t Timeout){
+
+	ADC_SimTypeDef* sim = ADC_SIM_ACTIVE;
+	uint64_t        end = sim->Now + (uint64_t)Timeout * 72000U;	// timeout [ms] of 72 MHz core clock
+
+	// advancing virtual time by ADC clock cycles until end of conversion
+	while((hadc->Instance->SR & ADC_SR_EOC) == 0){
+
+		if(sim->Now >= end){
+			return HAL_TIMEOUT;
+		}
+
+		ADC_SimAdvance(sim, sim->AdcClockDivider);
+	}
+
+	// single conversion finished | cleared like HAL does in non-continuous mode
+	CLEAR_BIT(hadc->Instance->SR, ADC_SR_EOC | ADC_SR_STRT);
+
+	return HAL_OK;
+}
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef* hadc){
+
+	return hadc->Instance->DR;
+}
+
+uint32_t HAL_ADCEx_MultiModeGetValue(ADC_HandleTypeDef* hadc){
+
+	UNUSED(hadc);
+
+	return ADC1->DR;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* hadc){
+
+	ADC_SimTypeDef*      sim   = ADC_SIM_ACTIVE;
+	ADC_SimFaultTypeDef* fault = &sim->Faults[ADC_SIM_FAULT_CALIBRATION];
+
+	UNUSED(hadc);
+
+	// injected calibration failure | recovery lasts until acquisition transfers data again
+	if(sim->CalibrationFails != 0){
+		sim->CalibrationFails--;
+
+		if(fault->Active == 0){
+			fault->Active = 1;
+			fault->Start  = sim->Now;
+		}
+
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma){
+
+	hdma->Instance->CCR = hdma->Init.Direction | hdma->Init.PeriphInc | hdma->Init.MemInc | hdma->Init.PeriphDataAlignment
+	                    | hdma->Init.MemDataAlignment | hdma->Init.Mode | hdma->Init.Priority;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef* hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength){
+
+	UNUSED(hdma);
+	UNUSED(SrcAddress);
+	UNUSED(DstAddress);
+	UNUSED(DataLength);
+
+	return HAL_BUSY;	// 32-bit addresses cannot hold host pointers
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void){
+
+	ADC_SIM_ACTIVE->Flash.Locked = 0;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void){
+
+	ADC_SIM_ACTIVE->Flash.Locked = 1;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data){
+
+	ADC_SimTypeDef* sim       = ADC_SIM_ACTIVE;
+	uint8_t         halfWords = (TypeProgram == FLASH_TYPEPROGRAM_HALFWORD) ? 1U : (TypeProgram == FLASH_TYPEPROGRAM_WORD) ? 2U : 4U;
+
+	// F1 programs wider types as following half-words
+	for(uint8_t i = 0; i < halfWords; ++i){
+
+		uint32_t address = Address + 2U * i;
+		uint16_t data    = (uint16_t)(Data >> (16U * i));
+
+		if((address & 1U) != 0 || ADC_SimFlashOperation(sim, address, 2U, ADC_SIM_FLASH_PROGRAM_CYCLES) == 0){
+			return HAL_ERROR;
+		}
+
+		uint8_t* cell    = &sim->Flash.Memory[address - ADC_SIM_FLASH_BASE];
+		uint16_t current = (uint16_t)(cell[0] | (cell[1] << 8));
+
+		// programming error (PGERR) | only erased half-word can be programmed, except of writing 0
+		if(current != 0xFFFFU && data != 0U){
+			return HAL_ERROR;
+		}
+
+		// torn programming | part of cleared bits reaches cells
+		if(sim->Flash.PowerLost != 0){
+			data |= (uint16_t)ADC_SimRandom(sim);
+		}
+
+		cell[0] &= (uint8_t)data;
+		cell[1] &= (uint8_t)(data >> 8);
+		sim->Flash.Programs++;
+
+		if(sim->Flash.PowerLost != 0){
+			return HAL_ERROR;
+		}
+	}
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef* pEraseInit, uint32_t* PageError){
+
+	ADC_SimTypeDef* sim = ADC_SIM_ACTIVE;
+
+	*PageError = 0xFFFFFFFFU;
+
+	for(uint32_t p = 0; p < pEraseInit->NbPages; ++p){
+
+		uint32_t address = pEraseInit->PageAddress + p * FLASH_PAGE_SIZE;
+
+		if((address & (FLASH_PAGE_SIZE - 1U)) != 0 || ADC_SimFlashOperation(sim, address, FLASH_PAGE_SIZE, ADC_SIM_FLASH_ERASE_CYCLES) == 0){
+			*PageError = address;
+			return HAL_ERROR;
+		}
+
+		uint8_t* page = &sim->Flash.Memory[address - ADC_SIM_FLASH_BASE];
+
+		// torn erase | random half-words of page are erased
+		if(sim->Flash.PowerLost != 0){
+			for(uint32_t i = 0; i < FLASH_PAGE_SIZE; i += 2U){
+				if((ADC_SimRandom(sim) & 1U) != 0){
+					page[i]      = 0xFFU;
+					page[i + 1U] = 0xFFU;
+				}
+			}
+
+			*PageError = address;
+			return HAL_ERROR;
+		}
+
+		memset(page, 0xFF, FLASH_PAGE_SIZE);
+		sim->Flash.Erases[(address - ADC_SIM_FLASH_BASE) / FLASH_PAGE_SIZE]++;
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Simulation index function
+  * @param  instance - ADC registers
+  * @retval index    - 0: ADC1, 1: ADC2
+  */
+static uint8_t ADC_SimIndex(ADC_TypeDef* instance){
+
+	return (instance == ADC2) ? 1U : 0U;
+}
+
+
+/**
+  * @brief Simulation dual mode function
+  * @retval dual    - 1 if ADC1 works in dual mode
+  */
+static uint8_t ADC_SimIsDual(void){
+
+	return ((ADC1->CR1 & ADC_CR1_DUALMOD) != 0) ? 1U : 0U;
+}
+
+
+/**
+  * @brief Simulation ranks function
+  * @param  regs    - ADC registers
+  * @retval ranks   - number of conversions in scan | 1 if scan mode is disabled
+  */
+static uint8_t ADC_SimRanks(ADC_TypeDef* regs){
+
+	if((regs->CR1 & ADC_CR1_SCAN) == 0){
+		return 1;
+	}
+
+	return (uint8_t)(((regs->SQR1 & ADC_SQR1_L_Msk) >> ADC_SQR1_L_Pos) + 1U);
+}
+
+
+/**
+  * @brief Simulation channel function
+  * @param  regs    - ADC registers
+  * @param  rank    - rank in scan, counted from 0
+  * @retval channel - channel converted in rank
+  */
+static uint8_t ADC_SimChannel(ADC_TypeDef* regs, uint8_t rank){
+
+	if(rank < 6){
+		return (uint8_t)((regs->SQR3 >> (5U * rank)) & 0x1FU);
+	}else if(rank < 12){
+		return (uint8_t)((regs->SQR2 >> (5U * (rank - 6U))) & 0x1FU);
+	}
+
+	return (uint8_t)((regs->SQR1 >> (5U * (rank - 12U))) & 0x1FU);
+}
+
+
+/**
+  * @brief Simulation sample function
+  * @param  sim     - pointer to simulation structure
+  * @param  adc     - 0: ADC1, 1: ADC2
+  * @param  channel - converted channel
+  * @retval value   - 12-bit converted value | oversampler accumulates conversions spread over conversion time and shifts sum
+  */
+static uint16_t ADC_SimSample(ADC_SimTypeDef* sim, uint8_t adc, uint8_t channel){
+
+	ADC_SimAdcTypeDef* a     = &sim->Adc[adc];
+	uint32_t           ratio = (a->OversamplingRatio > 1U) ? a->OversamplingRatio : 1U;
+	uint32_t           sum   = 0;
+	uint8_t            drop  = (a->Resolution != 0U) ? (12U - a->Resolution) : 0U;	// truncated bits of lower resolution
+
+	if(channel >= ADC_SIM_CHANNELS){
+		return 0;
+	}
+
+	// single conversion | sampling capacitor settles from value held after previous conversion
+	if(ratio == 1U){
+		uint16_t input = (a->Signal == NULL) ? a->Level[channel] : a->Signal(adc, channel, sim->Now, a->SignalArg);
+
+		return (uint16_t)((ADC_SimSettle(sim, adc, channel, input & 0xFFFU) >> drop) >> a->OversamplingShift);
+	}
+
+	if(a->Signal == NULL){
+		return (uint16_t)((((uint32_t)(a->Level[channel] & 0xFFFU) >> drop) * ratio) >> a->OversamplingShift);
+	}
+
+	// k-th accumulated conversion ends (ratio - 1 - k) single conversions before end of oversampled conversion
+	uint64_t single = ADC_SimConversionTime(sim, adc, channel) / ratio;
+
+	for(uint32_t k = 0; k < ratio; ++k){
+		uint64_t back = (uint64_t)(ratio - 1U - k) * single;
+		uint64_t time = (sim->Now > back) ? sim->Now - back : 0U;
+
+		sum += (a->Signal(adc, channel, time, a->SignalArg) & 0xFFFU) >> drop;
+	}
+
+	return (uint16_t)(sum >> a->OversamplingShift);
+}
+
+
+/**
+  * @brief Simulation settling function, charges sampling capacitor from held value towards input during sampling time of channel
+  * @param  sim     - pointer to simulation structure
+  * @param  adc     - 0: ADC1, 1: ADC2
+  * @param  channel - converted channel
+  * @param  input   - settled value of channel
+  * @retval value   - converted value
+  */
+static uint16_t ADC_SimSettle(ADC_SimTypeDef* sim, uint8_t adc, uint8_t channel, uint16_t input){
+
+	ADC_SimAdcTypeDef* a     = &sim->Adc[adc];
+	float              value = (float)input;
+
+	if(a->Tau[channel] > 0.0f){
+		ADC_TypeDef* regs     = &ADC_SimRegs.Adc[adc];
+		uint32_t     code     = (channel < 10) ? (regs->SMPR2 >> (3U * channel)) : (regs->SMPR1 >> (3U * (channel - 10U)));
+		float        sampling = (float)ADC_SIM_CONVERSION_CYCLES[code & 0x7U] - 12.5f;		// conversion lasts sampling time + 12.5 cycles
+
+		// exp(-x) as (1 - x / 1024)^1024 | no libm in simulated build
+		float residual = 1.0f - sampling / a->Tau[channel] / 1024.0f;
+
+		residual = (residual > 0.0f) ? residual : 0.0f;
+
+		for(uint8_t i = 0; i < 10; ++i){
+			residual *= residual;
+		}
+
+		value = a->Held + ((float)input - a->Held) * (1.0f - residual);
+	}
+
+	a->Held = value;
+
+	return (uint16_t)(value + 0.5f);
+}
+
+
+/**
+  * @brief Simulation alignment function, places converted value in data register | ALIGN bit of each ADC
+  * @param  regs    - ADC registers
+  * @param  data    - converted value
+  * @retval data    - content of data register | left-aligned value keeps its MSB at bit 15, 6-bit value is aligned to byte
+  */
+static uint32_t ADC_SimAlign(ADC_TypeDef* regs, uint32_t data){
+
+	uint8_t bits = ADC_SimResolutionBits(regs);
+
+	if((regs->CR2 & ADC_CR2_ALIGN) == 0){
+		return data;
+	}
+
+	return (data << ((bits == 6U) ? 2U : (16U - bits))) & 0xFFFFU;
+}
+
+
+/**
+  * @brief Simulation DMA activity function
+  * @param  sim     - pointer to simulation structure
+  * @retval active  - 1 if conversions of ADC1 are transferred to storage
+  */
+static uint8_t ADC_SimDmaActive(ADC_SimTypeDef* sim){
+
+	return (sim->Dma.Enabled != 0 && sim->Dma.Channel->CNDTR != 0 && (ADC1->CR2 & ADC_CR2_DMA) != 0) ? 1U : 0U;
+}
+
+
+/**
+  * @brief Simulation DMA latch function, observes channel enable written by driver | number of transfers is latched on enable
+  * @param  sim     - pointer to simulation structure
+  */
+static void ADC_SimLatchDma(ADC_SimTypeDef* sim){
+
+	ADC_SimDmaTypeDef* d  = &sim->Dma;
+	uint8_t            en = ((d->Channel->CCR & DMA_CCR_EN) != 0) ? 1U : 0U;
+
+	if(en != 0 && d->Enabled == 0){
+		d->Reload = (uint16_t)d->Channel->CNDTR;
+	}
+
+	d->Enabled = en;
+}
+
+
+/**
+  * @brief Simulation DMA start function, configures channel like HAL_DMA_Start_IT with ADC data register as source
+  * @param  sim     - pointer to simulation structure
+  * @param  hdma    - DMA handle of ADC1
+  * @param  memory  - storage
+  * @param  length  - number of transfers
+  */
+static void ADC_SimStartDma(ADC_SimTypeDef* sim, DMA_HandleTypeDef* hdma, void* memory, uint32_t length){
+
+	ADC_SimDmaTypeDef* d = &sim->Dma;
+
+	d->Channel = (hdma != NULL) ? hdma->Instance : DMA1_Channel1;
+	d->Memory  = memory;
+	d->Enabled = 0;			// re-latching number of transfers
+
+	CLEAR_BIT(d->Channel->CCR, DMA_CCR_EN);
+
+	if(hdma != NULL){
+		hdma->State     = HAL_DMA_STATE_BUSY;
+		d->Channel->CCR = hdma->Init.Direction | hdma->Init.PeriphInc | hdma->Init.MemInc | hdma->Init.PeriphDataAlignment
+		                | hdma->Init.MemDataAlignment | hdma->Init.Mode | hdma->Init.Priority;
+	}
+
+	d->Channel->CNDTR = length;
+
+	SET_BIT(d->Channel->CCR, DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE | DMA_CCR_EN);
+}
+
+
+/**
+  * @brief Simulation scan start function
+  * @param  sim     - pointer to simulation structure
+  * @param  adc     - 0: ADC1, 1: ADC2
+  * @param  time    - start of first conversion
+  */
+static void ADC_SimStartScan(ADC_SimTypeDef* sim, uint8_t adc, uint64_t time){
+
+	ADC_SimAdcTypeDef* a = &sim->Adc[adc];
+
+	a->Busy    = 1;
+	a->Rank    = 0;
+	a->ConvEnd = time + ADC_SimConversionTime(sim, adc, ADC_SimChannel(&ADC_SimRegs.Adc[adc], 0));
+}
+
+
+/**
+  * @brief Simulation skip function, moves continuous conversions over whole scans ending before limit in one step
+  * 	   Only data register of last skipped scan would be observable, so skipped scans are not sampled
+  * @param  sim     - pointer to simulation structure
+  * @param  adc     - 0: ADC1, 1: ADC2
+  * @param  limit   - time of next observable event
+  */
+static void ADC_SimSkipScans(ADC_SimTypeDef* sim, uint8_t adc, uint64_t limit){
+
+	ADC_SimAdcTypeDef* a    = &sim->Adc[adc];
+	ADC_TypeDef*       regs = &ADC_SimRegs.Adc[adc];
+
+	// only continuous scans follow each other without trigger
+	if((regs->CR2 & ADC_CR2_CONT) == 0 || a->TriggerPeriod != 0){
+		return;
+	}
+
+	uint8_t  ranks = ADC_SimRanks(regs);
+	uint64_t scan  = 0;
+
+	for(uint8_t r = 0; r < ranks; ++r){
+		scan += ADC_SimConversionTime(sim, adc, ADC_SimChannel(regs, r));
+	}
+
+	uint64_t start = a->ConvEnd - ADC_SimConversionTime(sim, adc, ADC_SimChannel(regs, 0));
+
+	if(limit <= start || limit == ADC_SIM_NEVER){
+		return;
+	}
+
+	uint64_t skipped = (limit - start) / scan;
+
+	// keeping last scan before limit, so data registers hold its values
+	if(skipped < 2){
+		return;
+	}
+
+	skipped -= 1U;
+
+	a->ConvEnd     += skipped * scan;
+	a->Conversions += skipped * ranks;
+
+	if(adc == 0 && (regs->CR2 & ADC_CR2_DMA) != 0){
+		ADC_SimLose(sim, skipped * ranks);
+	}
+}
+
+
+/**
+  * @brief Simulation conversion complete function, writes data register, requests DMA and schedules next conversion
+  * @param  sim     - pointer to simulation structure
+  * @param  adc     - 0: ADC1, 1: ADC2
+  */
+static void ADC_SimComplete(ADC_SimTypeDef* sim, uint8_t adc){
+
+	ADC_SimAdcTypeDef* a     = &sim->Adc[adc];
+	ADC_TypeDef*       regs  = &ADC_SimRegs.Adc[adc];
+	uint32_t           data  = ADC_SimSample(sim, adc, ADC_SimChannel(regs, a->Rank));
+
+	data = ADC_SimAlign(regs, data);
+
+	// dual regular simultaneous mode | Slave's conversion is placed in upper half-word of Master's data register
+	if(adc == 0 && ADC_SimIsDual()){
+		uint16_t slave = ADC_SimSample(sim, 1, ADC_SimChannel(ADC2, a->Rank));
+
+		slave = (uint16_t)ADC_SimAlign(ADC2, slave);
+
+		ADC2->DR = slave;
+		SET_BIT(ADC2->SR, ADC_SR_EOC);
+		sim->Adc[1].Conversions++;
+
+		data |= (uint32_t)slave << 16;
+	}
+
+	regs->DR = data;
+	SET_BIT(regs->SR, ADC_SR_EOC);
+	a->Conversions++;
+
+	if(adc == 0 && (regs->CR2 & ADC_CR2_DMA) != 0){
+		ADC_SimTransfer(sim, data);
+	}
+
+	// scheduling next conversion | continuous mode starts next scan right away
+	if(++a->Rank >= ADC_SimRanks(regs)){
+		a->Rank = 0;
+
+		if((regs->CR2 & ADC_CR2_CONT) == 0 || a->TriggerPeriod != 0){
+			a->Busy = 0;
+			return;
+		}
+	}
+
+	a->ConvEnd += ADC_SimConversionTime(sim, adc, ADC_SimChannel(regs, a->Rank));
+}
+
+
+/**
+  * @brief Simulation DMA transfer function
+  * @param  sim     - pointer to simulation structure
+  * @param  data    - content of ADC1 data register
+  */
+static void ADC_SimTransfer(ADC_SimTypeDef* sim, uint32_t data){
+
+	ADC_SimDmaTypeDef*   d  = &sim->Dma;
+	DMA_Channel_TypeDef* ch = d->Channel;
+
+	// channel disabled, normal mode finished or ADC overrun | conversion is overwritten by next one
+	if(d->Enabled == 0 || ch->CNDTR == 0 || d->Memory == NULL || sim->Overrun != 0){
+		ADC_SimLose(sim, 1);
+		return;
+	}
+
+	// first transfer after fault | fault recovered
+	for(uint8_t f = 0; f < ADC_SIM_FAULTS; ++f){
+
+		ADC_SimFaultTypeDef* fault = &sim->Faults[f];
+
+		if(fault->Active != 0){
+			uint64_t recovery = sim->Now - fault->Start;
+
+			fault->Active    = 0;
+			fault->Blackout += recovery;
+			fault->Recovered++;
+
+			if(recovery > fault->RecoveryMax){
+				fault->RecoveryMax = recovery;
+			}
+		}
+	}
+
+	uint32_t index = d->Reload - ch->CNDTR;
+
+	// memory data size | word in dual mode, byte in storage packed to bytes
+	if((ch->CCR & DMA_CCR_MSIZE_1) != 0){
+		((uint32_t*)d->Memory)[index] = data;
+	}else if((ch->CCR & DMA_CCR_MSIZE_0) != 0){
+		((uint16_t*)d->Memory)[index] = (uint16_t)data;
+	}else{
+		((uint8_t*)d->Memory)[index]  = (uint8_t)data;
+	}
+
+	ch->CNDTR--;
+	d->Transfers++;
+
+	// half transfer
+	if(d->Reload - ch->CNDTR == d->Reload / 2U){
+		SET_BIT(DMA1->ISR, DMA_ISR_HTIF1);
+
+		if((ch->CCR & DMA_CCR_HTIE) != 0){
+			d->HalfDue = sim->Now + sim->IrqLatency;
+		}
+	}
+
+	// transfer complete | circular mode reloads counter
+	if(ch->CNDTR == 0){
+		SET_BIT(DMA1->ISR, DMA_ISR_TCIF1);
+
+		if((ch->CCR & DMA_CCR_TCIE) != 0){
+			d->FullDue = sim->Now + sim->IrqLatency;
+		}
+
+		if((ch->CCR & DMA_CCR_CIRC) != 0){
+			ch->CNDTR = d->Reload;
+		}
+	}
+}
+
+
+/**
+  * @brief Simulation interrupt delivery function, behaves like HAL DMA interrupt handler of ADC
+  * @param  sim       - pointer to simulation structure
+  * @retval delivered - 1 if interrupt was delivered
+  */
+static uint8_t ADC_SimDeliver(ADC_SimTypeDef* sim){
+
+	ADC_SimDmaTypeDef*   d    = &sim->Dma;
+	DMA_Channel_TypeDef* ch   = d->Channel;
+	ADC_HandleTypeDef*   hadc = sim->Adc[0].hadc;
+
+	if(d->HalfDue <= sim->Now && d->HalfDue <= d->FullDue){
+		d->HalfDue = ADC_SIM_NEVER;
+
+		if((ch->CCR & DMA_CCR_HTIE) == 0 || hadc == NULL){
+			return 1;
+		}
+
+		// normal mode | HAL disables half transfer interrupt
+		if((ch->CCR & DMA_CCR_CIRC) == 0){
+			CLEAR_BIT(ch->CCR, DMA_CCR_HTIE);
+		}
+
+		d->Interrupts++;
+		HAL_ADC_ConvHalfCpltCallback(hadc);
+
+		return 1;
+	}
+
+	if(d->FullDue <= sim->Now){
+		d->FullDue = ADC_SIM_NEVER;
+
+		if((ch->CCR & DMA_CCR_TCIE) == 0 || hadc == NULL){
+			return 1;
+		}
+
+		// normal mode | HAL disables transfer complete and error interrupts, transfer is no longer ongoing
+		if((ch->CCR & DMA_CCR_CIRC) == 0){
+			CLEAR_BIT(ch->CCR, DMA_CCR_TCIE | DMA_CCR_TEIE);
+
+			if(hadc->DMA_Handle != NULL){
+				hadc->DMA_Handle->State = HAL_DMA_STATE_READY;
+			}
+		}
+
+		d->Interrupts++;
+		HAL_ADC_ConvCpltCallback(hadc);
+
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+  * @brief Simulation lose function, counts conversions not transferred by DMA
+  * @param  sim         - pointer to simulation structure
+  * @param  conversions - number of lost conversions
+  */
+static void ADC_SimLose(ADC_SimTypeDef* sim, uint64_t conversions){
+
+	sim->Lost += conversions;
+
+	for(uint8_t f = 0; f < ADC_SIM_FAULTS; ++f){
+		if(sim->Faults[f].Active != 0){
+			sim->Faults[f].Lost += conversions;
+		}
+	}
+}
+
+
+/**
+  * @brief Simulation memory-to-memory completion function, copies block and calls transfer complete callback like HAL
+  * @param  sim     - pointer to simulation structure
+  */
+static void ADC_SimCompleteCopy(ADC_SimTypeDef* sim){
+
+	ADC_SimCopyTypeDef* c      = &sim->Copy;
+	DMA_HandleTypeDef*  hdma   = c->hdma;
+	uint32_t            ccr    = hdma->Instance->CCR;
+	uint8_t             source = ((ccr & DMA_CCR_PSIZE_1) != 0) ? 4U : ((ccr & DMA_CCR_PSIZE_0) != 0) ? 2U : 1U;
+	uint8_t             target = ((ccr & DMA_CCR_MSIZE_1) != 0) ? 4U : ((ccr & DMA_CCR_MSIZE_0) != 0) ? 2U : 1U;
+
+	for(uint32_t i = 0; i < c->Length; ++i){
+
+		uint32_t data = 0;
+
+		// little-endian data | narrower destination keeps lower bytes of source
+		memcpy(&data, (const uint8_t*)c->Source + i * source, source);
+		memcpy((uint8_t*)c->Destination + i * target, &data, target);
+	}
+
+	c->Transfers += c->Length;
+	c->Blocks++;
+	c->hdma       = NULL;
+	c->Due        = ADC_SIM_NEVER;
+
+	hdma->State   = HAL_DMA_STATE_READY;
+
+	if(hdma->XferCpltCallback != NULL){
+		hdma->XferCpltCallback(hdma);
+	}
+}
+
+
+/**
+  * @brief Simulation inject function, puts simulated peripherals into faulty state
+  * @param  sim     - pointer to simulation structure
+  * @param  type    - type of fault
+  */
+static void ADC_SimInject(ADC_SimTypeDef* sim, ADC_SimFaultType type){
+
+	ADC_SimFaultTypeDef* fault = &sim->Faults[type];
+	ADC_HandleTypeDef*   hadc  = sim->Adc[0].hadc;
+	DMA_Channel_TypeDef* ch    = sim->Dma.Channel;
+
+	fault->Injected++;
+
+	// calibration failure is armed now and becomes active when calibration is called
+	if(type == ADC_SIM_FAULT_CALIBRATION){
+		sim->CalibrationFails++;
+		return;
+	}
+
+	if(fault->Active == 0){
+		fault->Active = 1;
+		fault->Start  = sim->Now;
+	}
+
+	switch(type){
+
+		case ADC_SIM_FAULT_DMA_ERROR:
+
+			// hardware disables channel, HAL handler disables its interrupts and reports error to ADC
+			SET_BIT(DMA1->ISR, DMA_ISR_TEIF1);
+
+			if((ch->CCR & DMA_CCR_TEIE) != 0 && hadc != NULL){
+				CLEAR_BIT(ch->CCR, DMA_CCR_EN | DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE);
+
+				sim->Dma.HalfDue = ADC_SIM_NEVER;
+				sim->Dma.FullDue = ADC_SIM_NEVER;
+
+				ADC_SimLatchDma(sim);
+
+				if(hadc->DMA_Handle != NULL){
+					hadc->DMA_Handle->State = HAL_DMA_STATE_READY;
+				}
+
+				hadc->ErrorCode |= HAL_ADC_ERROR_DMA;
+				HAL_ADC_ErrorCallback(hadc);
+			}else{
+				CLEAR_BIT(ch->CCR, DMA_CCR_EN);
+			}
+			break;
+
+		case ADC_SIM_FAULT_OVR:
+
+			// conversions and DMA requests stop, scan in progress is abandoned
+			sim->Overrun     = 1;
+			sim->Adc[0].Busy = 0;
+
+			// overrun interrupt reports error | otherwise driver has to detect flag
+			if(sim->OverrunInterrupt != 0 && hadc != NULL){
+				hadc->ErrorCode |= HAL_ADC_ERROR_OVR;
+				HAL_ADC_ErrorCallback(hadc);
+			}
+			break;
+
+		case ADC_SIM_FAULT_STUCK:
+
+			// conversion in progress never ends | no interrupt, no error
+			if(sim->Adc[0].Busy != 0){
+				sim->Adc[0].ConvEnd = ADC_SIM_NEVER;
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+
+/**
+  * @brief Simulation random interval function | xorshift64 generator
+  * @param  sim     - pointer to simulation structure
+  * @param  mean    - mean interval [cycles]
+  * @retval cycles  - interval uniformly distributed in [1, 2 * mean]
+  */
+static uint64_t ADC_SimRandomInterval(ADC_SimTypeDef* sim, uint64_t mean){
+
+	return 1U + ADC_SimRandom(sim) % (2U * mean);
+}
+
+
+/**
+  * @brief Simulation pseudo-random generator function | xorshift64
+  * @param  sim     - pointer to simulation structure
+  * @retval x       - next state of generator
+  */
+static uint64_t ADC_SimRandom(ADC_SimTypeDef* sim){
+
+	uint64_t x = sim->Seed;
+
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+
+	sim->Seed = x;
+
+	return x;
+}
+
+
+/**
+  * @brief Simulation flash operation function, checks access, advances virtual time and counts down scheduled power loss
+  * @param  sim     - pointer to simulation structure
+  * @param  address - first address of operation
+  * @param  length  - number of bytes of operation
+  * @param  cycles  - duration of operation [cycles] | core is stalled, DMA and interrupts keep running
+  * @retval allowed - 1 if operation is performed (also torn one, PowerLost is set then), 0 if it is rejected
+  */
+static uint8_t ADC_SimFlashOperation(ADC_SimTypeDef* sim, uint32_t address, uint32_t length, uint64_t cycles){
+
+	if(sim->Flash.Locked != 0 || sim->Flash.PowerLost != 0 ||
+	   address < ADC_SIM_FLASH_BASE || address + length > ADC_SIM_FLASH_BASE + ADC_SIM_FLASH_SIZE){
+		return 0;
+	}
+
+	ADC_SimAdvance(sim, cycles);
+
+	if(sim->Flash.PowerLossAfter != 0 && --sim->Flash.PowerLossAfter == 0){
+		sim->Flash.PowerLost = 1;
+	}
+
+	return 1;
+}
+
+#endif
@@ -0,0 +1,643 @@
+/**
+  ******************************************************************************
+  * @file      adc_store.c
+  * @author    Bartosz Rychlicki
+  * @Title     Flash key/value store for ADC driver configuration and calibration
+  * @brief     This file contains functions' bodies of mount (index rebuild and recovery), append, compaction and page rotation
+  ******************************************************************************
+  * @attention Page header (16 bytes): magic, erase count (2 half-words), sequence (2 half-words), sequence check, erase count check,
+  * 		   reserved. Checks are inverted XOR of both half-words and are programmed after checked value.
+  * 		   Record: key, length [bytes], data padded to half-word with 0xFF, CRC-16/CCITT of key, length and data.
+  * 		   Half-word 0x0000 in place of key is filler | torn record is zeroed, F1/F3 flash allows programming 0 over any value.
+  * 		   Half-word programming and page erase of F1/F3 flash are used.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_store.h"
+#include <string.h>
+
+#if !defined(STM32F1_FAMILY) && !defined(STM32F3_FAMILY)
+	#error "ADC store requires half-word programmed, page erased flash (F1, F3)"
+#endif
+
+#if (ADC_STORE_PAGES < 3)
+	#error "ADC store requires at least 3 pages"
+#endif
+
+// Private typedefs
+typedef enum{
+
+	ADC_STORE_PAGE_ERASED    = 0,				// whole page is erased
+	ADC_STORE_PAGE_FORMATTED = 1,				// header holds erase count, page is not opened yet
+	ADC_STORE_PAGE_OPEN      = 2,				// header holds sequence, page holds records
+	ADC_STORE_PAGE_DIRTY     = 3				// torn erase, format or open | page has to be erased
+
+}ADC_StorePageState;
+
+// Private Macros
+#define ADC_STORE_PAGE_OFFSET(__PAGE__)		((uint32_t)(__PAGE__) * ADC_STORE_PAGE_SIZE)
+#define ADC_STORE_READ(__OFFSET__)			((uint16_t)__ADC_FLASH_READ16(ADC_STORE_BASE + (__OFFSET__)))
+#define ADC_STORE_NEXT(__PAGE__)			((uint8_t)(((__PAGE__) + 1U) % ADC_STORE_PAGES))
+#define ADC_STORE_DELETED					0U		// length of record removing key
+#define ADC_STORE_FILLER					0U		// key of zeroed half-word | skipped by scan
+
+// Private functions prototypes
+static ADC_StorePageState ADC_StorePageRead(uint8_t page, uint32_t* sequence, uint32_t* erases);
+static void               ADC_StoreScan(ADC_StoreTypeDef* store, uint8_t page);
+static HAL_StatusTypeDef  ADC_StoreAppend(ADC_StoreTypeDef* store, uint16_t key, const uint8_t* data, uint32_t source, uint16_t length);
+static HAL_StatusTypeDef  ADC_StoreRotate(ADC_StoreTypeDef* store);
+static HAL_StatusTypeDef  ADC_StoreCompact(ADC_StoreTypeDef* store, uint8_t page);
+static HAL_StatusTypeDef  ADC_StoreFormat(ADC_StoreTypeDef* store, uint8_t page, uint8_t erase);
+static HAL_StatusTypeDef  ADC_StoreOpen(ADC_StoreTypeDef* store, uint8_t page);
+static HAL_StatusTypeDef  ADC_StoreProgram(uint32_t offset, uint16_t value);
+static uint16_t           ADC_StoreRecordCrc(uint32_t offset, const uint8_t* data, uint16_t key, uint16_t length);
+static uint8_t            ADC_StoreBlank(uint32_t offset, uint32_t from);
+
+
+/**
+  * @brief Store mount function, rebuilds RAM index and recovers from power loss | formats empty region
+  * 	   Records of pages are indexed from the oldest page to active one, so the latest valid record of key wins.
+  * 	   Torn pages are erased and compaction interrupted by power loss is finished.
+  * @param  store   - pointer to store structure
+  * @retval status  - HAL status if store is usable
+  */
+HAL_StatusTypeDef ADC_StoreMount(ADC_StoreTypeDef* store){
+
+	// checking if correct parameters were provided
+	if(store == NULL){
+		return HAL_ERROR;
+	}
+
+	ADC_StorePageState state[ADC_STORE_PAGES];
+	uint32_t           sequence[ADC_STORE_PAGES];
+	uint32_t           wear   = 0;
+	uint8_t            opened = 0;
+
+	memset(store, 0, sizeof(ADC_StoreTypeDef));
+
+	// reading headers | active page holds the highest sequence
+	for(uint8_t p = 0; p < ADC_STORE_PAGES; ++p){
+		state[p] = ADC_StorePageRead(p, &sequence[p], &store->Erases[p]);
+
+		if(state[p] == ADC_STORE_PAGE_FORMATTED || state[p] == ADC_STORE_PAGE_OPEN){
+			wear = (store->Erases[p] > wear) ? store->Erases[p] : wear;
+		}
+
+		if(state[p] == ADC_STORE_PAGE_OPEN && (opened == 0 || sequence[p] > store->Sequence)){
+			store->Active   = p;
+			store->Sequence = sequence[p];
+			opened          = 1;
+		}
+	}
+
+	// erase count of page with lost header is estimated by the most worn page
+	for(uint8_t p = 0; p < ADC_STORE_PAGES; ++p){
+		if(state[p] == ADC_STORE_PAGE_ERASED || state[p] == ADC_STORE_PAGE_DIRTY){
+			store->Erases[p] = wear;
+		}
+	}
+
+	HAL_FLASH_Unlock();
+
+	HAL_StatusTypeDef status = HAL_OK;
+
+	// torn pages are erased | their content is duplicated in newer pages or not committed
+	for(uint8_t p = 0; p < ADC_STORE_PAGES && status == HAL_OK; ++p){
+		if(state[p] == ADC_STORE_PAGE_DIRTY){
+			status   = ADC_StoreFormat(store, p, 1);
+			state[p] = ADC_STORE_PAGE_FORMATTED;
+		}
+	}
+
+	if(status == HAL_OK && opened == 0){
+
+		// empty region | first page becomes active
+		store->Sequence = 0;
+		status = ADC_StoreOpen(store, 0);
+
+	}else if(status == HAL_OK){
+
+		// indexing pages in ring order | oldest page follows active one
+		for(uint8_t i = 1; i <= ADC_STORE_PAGES; ++i){
+			uint8_t p = (uint8_t)((store->Active + i) % ADC_STORE_PAGES);
+
+			if(state[p] == ADC_STORE_PAGE_OPEN){
+				ADC_StoreScan(store, p);
+			}
+		}
+
+		// page after active one has to be erased | finishing compaction interrupted by power loss
+		uint8_t next = ADC_STORE_NEXT(store->Active);
+
+		if(state[next] == ADC_STORE_PAGE_OPEN){
+			status = ADC_StoreCompact(store, next);
+		}
+	}
+
+	HAL_FLASH_Lock();
+
+	store->Mounted = (status == HAL_OK) ? 1U : 0U;
+
+	return status;
+}
+
+
+/**
+  * @brief Store read function | O(1) lookup in RAM index
+  * @param  store   - pointer to mounted store structure
+  * @param  key     - key of record
+  * @param  data    - pointer to destination | size bytes at most are copied
+  * @param  size    - size of destination [bytes]
+  * @param  length  - pointer to stored length [bytes] | can be NULL
+  * @retval status  - HAL_ERROR if key is not stored or record is longer than destination
+  */
+HAL_StatusTypeDef ADC_StoreRead(ADC_StoreTypeDef* store, uint16_t key, void* data, uint16_t size, uint16_t* length){
+
+	// checking if correct parameters were provided
+	if(store == NULL || store->Mounted == 0 || key == ADC_STORE_FILLER || key >= ADC_STORE_KEYS || (data == NULL && size != 0)){
+		return HAL_ERROR;
+	}
+
+	uint32_t offset = store->Index[key];
+
+	if(offset == 0){
+		return HAL_ERROR;
+	}
+
+	uint16_t stored = ADC_STORE_READ(offset + 2U);
+	uint8_t* dst    = (uint8_t*)data;
+
+	if(length != NULL){
+		*length = stored;
+	}
+
+	for(uint16_t i = 0; i < stored && i < size; i += 2U){
+		uint16_t halfWord = ADC_STORE_READ(offset + 4U + i);
+
+		dst[i] = (uint8_t)halfWord;
+
+		if(i + 1U < stored && i + 1U < size){
+			dst[i + 1U] = (uint8_t)(halfWord >> 8);
+		}
+	}
+
+	return (stored <= size) ? HAL_OK : HAL_ERROR;
+}
+
+
+/**
+  * @brief Store write function, appends record of key | rotates pages when active page is full
+  * 	   Previous value of key stays readable until CRC of new record is programmed. Unchanged value is not rewritten.
+  * @param  store   - pointer to mounted store structure
+  * @param  key     - key of record
+  * @param  data    - pointer to value
+  * @param  length  - length of value [bytes] | 1 ... ADC_STORE_MAX_LENGTH
+  * @retval status  - HAL_ERROR if flash operation failed or live records do not fit region
+  */
+HAL_StatusTypeDef ADC_StoreWrite(ADC_StoreTypeDef* store, uint16_t key, const void* data, uint16_t length){
+
+	// checking if correct parameters were provided
+	if(store == NULL || store->Mounted == 0 || key == ADC_STORE_FILLER || key >= ADC_STORE_KEYS || data == NULL ||
+	   length == ADC_STORE_DELETED || length > ADC_STORE_MAX_LENGTH){
+		return HAL_ERROR;
+	}
+
+	// skipping unchanged value | saves wear of calibration written on every boot
+	uint32_t       offset = store->Index[key];
+	const uint8_t* value  = (const uint8_t*)data;
+
+	if(offset != 0 && ADC_STORE_READ(offset + 2U) == length){
+
+		uint16_t i = 0;
+
+		for(; i < length; i += 2U){
+			uint16_t halfWord = (i + 1U < length) ? (uint16_t)(value[i] | (value[i + 1U] << 8)) : (uint16_t)(0xFF00U | value[i]);
+
+			if(ADC_STORE_READ(offset + 4U + i) != halfWord){
+				break;
+			}
+		}
+
+		if(i >= length){
+			return HAL_OK;
+		}
+	}
+
+	HAL_FLASH_Unlock();
+
+	HAL_StatusTypeDef status = ADC_StoreAppend(store, key, value, 0, length);
+
+	HAL_FLASH_Lock();
+
+	return status;
+}
+
+
+/**
+  * @brief Store delete function, appends record of zero length | key is removed from index
+  * @param  store   - pointer to mounted store structure
+  * @param  key     - key of record
+  * @retval status  - HAL status of flash operation | HAL_OK if key is not stored
+  */
+HAL_StatusTypeDef ADC_StoreDelete(ADC_StoreTypeDef* store, uint16_t key){
+
+	// checking if correct parameters were provided
+	if(store == NULL || store->Mounted == 0 || key == ADC_STORE_FILLER || key >= ADC_STORE_KEYS){
+		return HAL_ERROR;
+	}
+
+	if(store->Index[key] == 0){
+		return HAL_OK;
+	}
+
+	HAL_FLASH_Unlock();
+
+	HAL_StatusTypeDef status = ADC_StoreAppend(store, key, NULL, 0, ADC_STORE_DELETED);
+
+	HAL_FLASH_Lock();
+
+	return status;
+}
+
+
+/**
+  * @brief Store wear function
+  * @param  store   - pointer to mounted store structure
+  * @retval erases  - erase count of the most worn page | pages are rotated, so counts stay close, lost header is estimated
+  */
+uint32_t ADC_StoreWear(const ADC_StoreTypeDef* store){
+
+	uint32_t wear = 0;
+
+	for(uint8_t p = 0; p < ADC_STORE_PAGES; ++p){
+		wear = (store->Erases[p] > wear) ? store->Erases[p] : wear;
+	}
+
+	return wear;
+}
+
+
+/**
+  * @brief CRC-16/CCITT function | polynomial 0x1021, bitwise, no table in flash
+  * @param  crc     - initial value (0xFFFF) or CRC of previous data
+  * @param  data    - pointer to data
+  * @param  length  - number of bytes
+  * @retval crc     - updated CRC
+  */
+uint16_t ADC_StoreCrc(uint16_t crc, const uint8_t* data, uint16_t length){
+
+	for(uint16_t i = 0; i < length; ++i){
+		crc ^= (uint16_t)data[i] << 8;
+
+		for(uint8_t b = 0; b < 8; ++b){
+			crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+
+/**
+  * @brief Store page header function, classifies page
+  * @param  page     - page of region
+  * @param  sequence - pointer to sequence of open page
+  * @param  erases   - pointer to erase count of formatted or open page
+  * @retval state    - state of page
+  */
+static ADC_StorePageState ADC_StorePageRead(uint8_t page, uint32_t* sequence, uint32_t* erases){
+
+	uint32_t offset = ADC_STORE_PAGE_OFFSET(page);
+	uint16_t low    = ADC_STORE_READ(offset + 6U);
+	uint16_t high   = ADC_STORE_READ(offset + 8U);
+	uint16_t check  = ADC_STORE_READ(offset + 10U);
+
+	*sequence = ((uint32_t)high << 16) | low;
+	*erases   = ((uint32_t)ADC_STORE_READ(offset + 4U) << 16) | ADC_STORE_READ(offset + 2U);
+
+	// erased page or torn erase/format
+	if(ADC_STORE_READ(offset) != ADC_STORE_MAGIC){
+		return (ADC_StoreBlank(offset, 0) != 0) ? ADC_STORE_PAGE_ERASED : ADC_STORE_PAGE_DIRTY;
+	}
+
+	if(ADC_STORE_READ(offset + 12U) != (uint16_t)~((uint16_t)*erases ^ (uint16_t)(*erases >> 16))){
+		return ADC_STORE_PAGE_DIRTY;
+	}
+
+	// torn erase may keep magic of page holding records
+	if(low == 0xFFFFU && high == 0xFFFFU && check == 0xFFFFU){
+		return (ADC_StoreBlank(offset, ADC_STORE_HEADER_SIZE) != 0) ? ADC_STORE_PAGE_FORMATTED : ADC_STORE_PAGE_DIRTY;
+	}
+
+	return (check == (uint16_t)~(low ^ high)) ? ADC_STORE_PAGE_OPEN : ADC_STORE_PAGE_DIRTY;
+}
+
+
+/**
+  * @brief Store scan function, indexes valid records of open page | sets head if page is active
+  * 	   Record with broken CRC (torn write) is skipped. Implausible key or length of active page is torn header of the last
+  * 	   record, it is zeroed up to the last programmed half-word, so head follows it. Flash has to be unlocked.
+  * @param  store   - pointer to store structure
+  * @param  page    - open page of region
+  */
+static void ADC_StoreScan(ADC_StoreTypeDef* store, uint8_t page){
+
+	uint32_t base = ADC_STORE_PAGE_OFFSET(page);
+	uint32_t pos  = ADC_STORE_HEADER_SIZE;
+
+	while(pos + 6U <= ADC_STORE_PAGE_SIZE){
+
+		uint16_t key    = ADC_STORE_READ(base + pos);
+		uint16_t length = ADC_STORE_READ(base + pos + 2U);
+
+		// end of records
+		if(key == 0xFFFFU){
+			break;
+		}
+
+		if(key == ADC_STORE_FILLER){
+			pos += 2U;
+			continue;
+		}
+
+		if(key >= ADC_STORE_KEYS || length > ADC_STORE_MAX_LENGTH || pos + ADC_STORE_RECORD_SIZE(length) > ADC_STORE_PAGE_SIZE){
+
+			uint32_t last = ADC_STORE_PAGE_SIZE;
+
+			// space after torn header is unknown on other pages
+			if(page != store->Active){
+				pos = ADC_STORE_PAGE_SIZE;
+				break;
+			}
+
+			while(last > pos && ADC_STORE_READ(base + last - 2U) == 0xFFFFU){
+				last -= 2U;
+			}
+
+			for(; pos < last; pos += 2U){
+				HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, ADC_STORE_BASE + base + pos, 0U);
+			}
+
+			break;
+		}
+
+		uint32_t offset = base + pos;
+
+		if(ADC_StoreRecordCrc(offset, NULL, key, length) == ADC_STORE_READ(offset + ADC_STORE_RECORD_SIZE(length) - 2U)){
+			store->Index[key] = (length == ADC_STORE_DELETED) ? 0U : (uint16_t)offset;
+		}
+
+		pos += ADC_STORE_RECORD_SIZE(length);
+	}
+
+	if(page == store->Active){
+		store->Head = (uint16_t)((pos < ADC_STORE_PAGE_SIZE) ? pos : ADC_STORE_PAGE_SIZE);
+	}
+}
+
+
+/**
+  * @brief Store append function, programs record to active page | CRC is programmed last and commits record
+  * @param  store   - pointer to store structure
+  * @param  key     - key of record
+  * @param  data    - pointer to value in RAM | NULL if value is copied from flash
+  * @param  source  - offset of copied record | used if data is NULL
+  * @param  length  - length of value [bytes]
+  * @retval status  - HAL status of flash operation
+  */
+static HAL_StatusTypeDef ADC_StoreAppend(ADC_StoreTypeDef* store, uint16_t key, const uint8_t* data, uint32_t source, uint16_t length){
+
+	uint16_t size  = ADC_STORE_RECORD_SIZE(length);
+	uint16_t limit = (data == NULL && source != 0) ? ADC_STORE_PAGE_SIZE : (ADC_STORE_PAGE_SIZE - ADC_STORE_RESERVE);	// copies may use reserve
+
+	// rotating pages until record fits | each rotation frees the oldest page
+	for(uint8_t r = 0; store->Head + size > limit; ++r){
+		if(r == ADC_STORE_PAGES || ADC_StoreRotate(store) != HAL_OK){
+			return HAL_ERROR;
+		}
+	}
+
+	uint32_t offset = ADC_STORE_PAGE_OFFSET(store->Active) + store->Head;
+	uint16_t crc    = (data != NULL || source == 0) ? ADC_StoreRecordCrc(0, data, key, length) : ADC_STORE_READ(source + size - 2U);
+
+	store->Head += size;		// space is consumed also by failed record
+
+	if(ADC_StoreProgram(offset, key) != HAL_OK || ADC_StoreProgram(offset + 2U, length) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	for(uint16_t i = 0; i < length; i += 2U){
+
+		uint16_t halfWord;
+
+		if(data == NULL){
+			halfWord = ADC_STORE_READ(source + 4U + i);
+		}else{
+			halfWord = (i + 1U < length) ? (uint16_t)(data[i] | (data[i + 1U] << 8)) : (uint16_t)(0xFF00U | data[i]);	// padding keeps cell erased
+		}
+
+		if(ADC_StoreProgram(offset + 4U + i, halfWord) != HAL_OK){
+			return HAL_ERROR;
+		}
+	}
+
+	if(ADC_StoreProgram(offset + size - 2U, crc) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	store->Index[key] = (length == ADC_STORE_DELETED) ? 0U : (uint16_t)offset;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Store rotate function, opens erased page after active one and compacts the oldest page following it
+  * @param  store   - pointer to store structure
+  * @retval status  - HAL status of flash operations
+  */
+static HAL_StatusTypeDef ADC_StoreRotate(ADC_StoreTypeDef* store){
+
+	if(ADC_StoreOpen(store, ADC_STORE_NEXT(store->Active)) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	uint32_t sequence;
+	uint32_t erases;
+	uint8_t  oldest = ADC_STORE_NEXT(store->Active);
+
+	if(ADC_StorePageRead(oldest, &sequence, &erases) == ADC_STORE_PAGE_FORMATTED){
+		return HAL_OK;
+	}
+
+	return ADC_StoreCompact(store, oldest);
+}
+
+
+/**
+  * @brief Store compact function, copies live records of page to active page and erases page
+  * 	   Copies are committed before erase, so power loss leaves duplicates, which mount resolves by page order
+  * @param  store   - pointer to store structure
+  * @param  page    - page following active one
+  * @retval status  - HAL status of flash operations
+  */
+static HAL_StatusTypeDef ADC_StoreCompact(ADC_StoreTypeDef* store, uint8_t page){
+
+	uint32_t first = ADC_STORE_PAGE_OFFSET(page);
+
+	for(uint16_t key = ADC_STORE_FILLER + 1U; key < ADC_STORE_KEYS; ++key){
+
+		uint32_t offset = store->Index[key];
+
+		if(offset == 0 || offset < first || offset >= first + ADC_STORE_PAGE_SIZE){
+			continue;
+		}
+
+		// live records of one page always fit opened page | with reserve absorbing copy torn by power loss
+		if(store->Head + ADC_STORE_RECORD_SIZE(ADC_STORE_READ(offset + 2U)) > ADC_STORE_PAGE_SIZE ||
+		   ADC_StoreAppend(store, key, NULL, offset, ADC_STORE_READ(offset + 2U)) != HAL_OK){
+			return HAL_ERROR;
+		}
+	}
+
+	return ADC_StoreFormat(store, page, 1);
+}
+
+
+/**
+  * @brief Store format function, erases page and programs its erase count and magic
+  * @param  store   - pointer to store structure
+  * @param  page    - page of region
+  * @param  erase   - 1 if page has to be erased first
+  * @retval status  - HAL status of flash operations
+  */
+static HAL_StatusTypeDef ADC_StoreFormat(ADC_StoreTypeDef* store, uint8_t page, uint8_t erase){
+
+	uint32_t offset = ADC_STORE_PAGE_OFFSET(page);
+
+	if(erase != 0){
+
+		FLASH_EraseInitTypeDef eraseInit = {0};
+		uint32_t               pageError = 0;
+
+		eraseInit.TypeErase   = FLASH_TYPEERASE_PAGES;
+		eraseInit.PageAddress = ADC_STORE_BASE + offset;
+		eraseInit.NbPages     = 1;
+
+		if(HAL_FLASHEx_Erase(&eraseInit, &pageError) != HAL_OK){
+			return HAL_ERROR;
+		}
+
+		store->Erases[page]++;
+	}
+
+	uint16_t low  = (uint16_t)store->Erases[page];
+	uint16_t high = (uint16_t)(store->Erases[page] >> 16);
+
+	// magic is programmed last | marks complete header
+	if(ADC_StoreProgram(offset + 2U, low) != HAL_OK || ADC_StoreProgram(offset + 4U, high) != HAL_OK ||
+	   ADC_StoreProgram(offset + 12U, (uint16_t)~(low ^ high)) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	return ADC_StoreProgram(offset, ADC_STORE_MAGIC);
+}
+
+
+/**
+  * @brief Store open function, programs next sequence to header of page and makes it active
+  * @param  store   - pointer to store structure
+  * @param  page    - erased or formatted page
+  * @retval status  - HAL status of flash operations
+  */
+static HAL_StatusTypeDef ADC_StoreOpen(ADC_StoreTypeDef* store, uint8_t page){
+
+	uint32_t offset   = ADC_STORE_PAGE_OFFSET(page);
+	uint32_t sequence = store->Sequence + 1U;
+	uint16_t low      = (uint16_t)sequence;
+	uint16_t high     = (uint16_t)(sequence >> 16);
+
+	if(ADC_STORE_READ(offset) != ADC_STORE_MAGIC && ADC_StoreFormat(store, page, 0) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	// sequence check is programmed last | marks opened page
+	if(ADC_StoreProgram(offset + 6U, low) != HAL_OK || ADC_StoreProgram(offset + 8U, high) != HAL_OK ||
+	   ADC_StoreProgram(offset + 10U, (uint16_t)~(low ^ high)) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	store->Active   = page;
+	store->Sequence = sequence;
+	store->Head     = ADC_STORE_HEADER_SIZE;
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Store program function | half-word of region
+  * @param  offset  - offset in region
+  * @param  value   - programmed value | erased value is skipped
+  * @retval status  - HAL status of flash operation
+  */
+static HAL_StatusTypeDef ADC_StoreProgram(uint32_t offset, uint16_t value){
+
+	if(value == 0xFFFFU){
+		return HAL_OK;
+	}
+
+	return HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, ADC_STORE_BASE + offset, value);
+}
+
+
+/**
+  * @brief Store record CRC function | CRC of key, length and value, never equal to erased half-word
+  * @param  offset  - offset of record in region | value is read from flash if data is NULL
+  * @param  data    - pointer to value in RAM | can be NULL
+  * @param  key     - key of record
+  * @param  length  - length of value [bytes]
+  * @retval crc     - CRC of record
+  */
+static uint16_t ADC_StoreRecordCrc(uint32_t offset, const uint8_t* data, uint16_t key, uint16_t length){
+
+	uint8_t  head[4] = { (uint8_t)key, (uint8_t)(key >> 8), (uint8_t)length, (uint8_t)(length >> 8) };
+	uint16_t crc     = ADC_StoreCrc(0xFFFFU, head, sizeof(head));
+
+	if(data != NULL){
+		crc = ADC_StoreCrc(crc, data, length);
+	}else{
+		for(uint16_t i = 0; i < length; i += 2U){
+			uint16_t halfWord = ADC_STORE_READ(offset + 4U + i);
+			uint8_t  bytes[2] = { (uint8_t)halfWord, (uint8_t)(halfWord >> 8) };
+
+			crc = ADC_StoreCrc(crc, bytes, (i + 1U < length) ? 2U : 1U);
+		}
+	}
+
+	// CRC equal to erased half-word would commit record torn before CRC
+	return (crc == 0xFFFFU) ? 0U : crc;
+}
+
+
+/**
+  * @brief Store blank function, checks if end of page is erased
+  * @param  offset  - offset of page in region
+  * @param  from    - first checked byte of page
+  * @retval blank   - 1 if all half-words from given byte to end of page are erased
+  */
+static uint8_t ADC_StoreBlank(uint32_t offset, uint32_t from){
+
+	for(uint32_t i = from; i < ADC_STORE_PAGE_SIZE; i += 2U){
+		if(ADC_STORE_READ(offset + i) != 0xFFFFU){
+			return 0;
+		}
+	}
+
+	return 1;
+}
@@ -0,0 +1,362 @@
+
+/**
+  ******************************************************************************
+  * @file      adc_tuning.c
+  * @author    Bartosz Rychlicki
+  * @Title     Sampling time auto-tuning for ADC driver
+  * @brief     This file contains functions' bodies of settling error measurement, sampling time selection and persistence
+  ******************************************************************************
+  * @attention Regular sequence, continuous mode and DMA requests are restored after tuning, only SMPx fields are changed
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_tuning.h"
+#include <stddef.h>
+#include <string.h>
+
+// Private functions prototypes
+static HAL_StatusTypeDef ADC_TuningChannel(ADC_HandleTypeDef* hadc, uint8_t previous, uint8_t channel, uint16_t target, uint8_t* code, uint16_t* error);
+static HAL_StatusTypeDef ADC_TuningMeasure(ADC_HandleTypeDef* hadc, uint8_t previous, uint8_t channel, uint32_t* first, uint32_t* second);
+static HAL_StatusTypeDef ADC_TuningConvert(ADC_HandleTypeDef* hadc, uint8_t channel, uint16_t* value);
+
+
+/**
+  * @brief Tuning init function, applies persisted result or tunes sampling times and stores result
+  * 	   Persisted result is used only if it is valid, was tuned for the same target and covers all converted channels
+  * @param  hadc    - pointer to ADC handle | conversions are stopped
+  * @param  cadc    - pointer to ADC channels structure | ranks are detected by function
+  * @param  tune    - pointer to tuning result
+  * @param  target  - maximal settling error [LSB]
+  * @retval status  - HAL status of ADC_TuningApply or ADC_TuningRun | failed store does not change it
+  */
+HAL_StatusTypeDef ADC_TuningInit(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef* cadc, ADC_TuningTypeDef* tune, uint16_t target){
+
+	// checking if correct parameters were provided
+	if(hadc == NULL || cadc == NULL || tune == NULL){
+		return HAL_ERROR;
+	}
+
+	if(ADC_ConfigGetRanksOfChannels(hadc, cadc, NULL) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	// loading persisted result
+	if(ADC_TuningLoadCallback(hadc, tune) == HAL_OK && tune->Magic == ADC_TUNING_MAGIC && tune->Target == target &&
+	   tune->Checksum == ADC_TuningChecksum(tune)){
+
+		uint32_t converted = 0;	// bit mask of converted channels
+
+		for(int i = 0; i < cadc->NbrOfConversions; ++i){
+			converted |= 1UL << (cadc->ranks[i] & (ADC_TUNING_CHANNELS - 1U));
+		}
+
+		if((tune->Tuned & converted) == converted){
+			return ADC_TuningApply(hadc, tune);
+		}
+	}
+
+	HAL_StatusTypeDef status = ADC_TuningRun(hadc, cadc, tune, target);
+
+	// storing result | target not met by some channel is also stored, the longest sampling time is applied to it
+	// failed store keeps applied result, it is reported by ADC_TuningStoreErrorCallback and tuning runs again at next start
+	if((status == HAL_OK || status == HAL_TIMEOUT) && ADC_TuningStoreCallback(hadc, tune) != HAL_OK){
+		ADC_TuningStoreErrorCallback(hadc, tune);
+	}
+
+	return status;
+}
+
+
+/**
+  * @brief Tuning run function, measures settling error of every converted channel and applies the shortest sampling time meeting target
+  * 	   Each channel is converted right after channel preceding it in scan, which is converted with the longest sampling time
+  * @param  hadc    - pointer to ADC handle | conversions are stopped, software trigger is selected
+  * @param  cadc    - pointer to ADC channels structure | ranks are detected by function
+  * @param  tune    - pointer to tuning result
+  * @param  target  - maximal settling error [LSB]
+  * @retval status  - HAL_OK if all channels met target, HAL_TIMEOUT if some channel did not meet target with the longest sampling time,
+  * 				  HAL_BUSY if conversions are in progress, HAL_ERROR if parameters are incorrect or conversion failed
+  */
+HAL_StatusTypeDef ADC_TuningRun(ADC_HandleTypeDef* hadc, ADC_ChannelsTypeDef* cadc, ADC_TuningTypeDef* tune, uint16_t target){
+
+	// checking if correct parameters were provided
+	if(hadc == NULL || cadc == NULL || tune == NULL){
+		return HAL_ERROR;
+	}
+
+	// tuning reprograms regular sequence | conversions have to be stopped
+	if(__ADC_IS_CONV_STARTED(hadc) != 0){
+		return HAL_BUSY;
+	}
+
+	if(ADC_ConfigGetRanksOfChannels(hadc, cadc, NULL) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	memset(tune, 0, sizeof(ADC_TuningTypeDef));
+	tune->Target = target;
+
+	// saving regular sequence, continuous mode and DMA requests
+	uint32_t sqr1 = hadc->Instance->SQR1;
+	uint32_t sqr3 = hadc->Instance->SQR3;
+	uint32_t ctrl = __ADC_CONV_CTRL(hadc);
+
+	HAL_StatusTypeDef status = HAL_OK;
+
+	for(int i = 0; i < cadc->NbrOfConversions; ++i){
+
+		uint8_t  channel  = cadc->ranks[i] & (ADC_TUNING_CHANNELS - 1U);
+		uint8_t  previous = cadc->ranks[(i + cadc->NbrOfConversions - 1) % cadc->NbrOfConversions] & (ADC_TUNING_CHANNELS - 1U);	// rank 0 follows last rank
+		uint8_t  code     = 0;
+		uint16_t error    = 0;
+
+		// channel preceded by itself | sampling capacitor already holds its value
+		if(previous != channel){
+
+			HAL_StatusTypeDef result = ADC_TuningChannel(hadc, previous, channel, target, &code, &error);
+
+			if(result == HAL_ERROR){
+				status = HAL_ERROR;
+				break;
+			}
+
+			if(result == HAL_TIMEOUT){
+				status = HAL_TIMEOUT;
+			}
+		}
+
+		// channel converted in more ranks | the longest of required sampling times
+		if((tune->Tuned & (1UL << channel)) == 0 || code > tune->Code[channel]){
+			tune->Code[channel]  = code;
+			tune->Error[channel] = error;
+		}
+
+		tune->Tuned |= 1UL << channel;
+	}
+
+	HAL_ADC_Stop(hadc);
+
+	// restoring regular sequence | sampling times are kept tuned
+	hadc->Instance->SQR1   = sqr1;
+	hadc->Instance->SQR3   = sqr3;
+	__ADC_CONV_CTRL(hadc)  = ctrl;
+
+	if(status == HAL_ERROR){
+		tune->Magic = 0;	// channels tuned before failure keep tested sampling times, result is not valid
+		return HAL_ERROR;
+	}
+
+	tune->Magic    = ADC_TUNING_MAGIC;
+	tune->Checksum = ADC_TuningChecksum(tune);
+
+	ADC_TuningApply(hadc, tune);
+
+	return status;
+}
+
+
+/**
+  * @brief Tuning apply function, writes sampling times of tuned channels | ADC should be stopped (F3/G4/L4/H7: ADSTART = 0)
+  * @param  hadc    - pointer to ADC handle
+  * @param  tune    - pointer to tuning result
+  * @retval status  - HAL_ERROR if result is not valid
+  */
+HAL_StatusTypeDef ADC_TuningApply(ADC_HandleTypeDef* hadc, const ADC_TuningTypeDef* tune){
+
+	// checking if correct parameters were provided and result is valid
+	if(hadc == NULL || tune == NULL || tune->Magic != ADC_TUNING_MAGIC || tune->Checksum != ADC_TuningChecksum(tune)){
+		return HAL_ERROR;
+	}
+
+	for(uint8_t channel = 0; channel < ADC_TUNING_CHANNELS; ++channel){
+		if((tune->Tuned & (1UL << channel)) != 0){
+			__ADC_SET_SAMPLETIME(hadc, channel, tune->Code[channel] & (ADC_TUNING_CODES - 1U));
+		}
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Tuning checksum function | FNV-1a of all fields preceding checksum
+  * @param  tune    - pointer to tuning result
+  * @retval checksum
+  */
+uint32_t ADC_TuningChecksum(const ADC_TuningTypeDef* tune){
+
+	const uint8_t* data = (const uint8_t*)tune;
+	uint32_t       hash = 2166136261UL;
+
+	for(size_t i = 0; i < offsetof(ADC_TuningTypeDef, Checksum); ++i){
+		hash = (hash ^ data[i]) * 16777619UL;
+	}
+
+	return hash;
+}
+
+
+/**
+  * @brief Empty implementation of tuning load callback | should copy persisted result (e.g. from flash) to tune
+  * @param  hadc    - pointer to ADC handle, whose result is loaded
+  * @param  tune    - pointer to tuning result
+  * @retval status  - HAL_OK if result was loaded | validated by ADC_TuningInit
+  */
+__weak HAL_StatusTypeDef ADC_TuningLoadCallback(ADC_HandleTypeDef* hadc, ADC_TuningTypeDef* tune){
+
+	UNUSED(hadc);      // unused variables to avoid warnings
+	UNUSED(tune);
+
+	return HAL_ERROR;  // nothing persisted | tuning is run
+}
+
+
+/**
+  * @brief Empty implementation of tuning store callback | should persist result (e.g. in flash), so next start skips tuning
+  * @param  hadc    - pointer to ADC handle, whose result is stored
+  * @param  tune    - pointer to tuning result
+  * @retval status  - HAL_OK if result was stored
+  */
+__weak HAL_StatusTypeDef ADC_TuningStoreCallback(ADC_HandleTypeDef* hadc, const ADC_TuningTypeDef* tune){
+
+	UNUSED(hadc);      // unused variables to avoid warnings
+	UNUSED(tune);
+
+	return HAL_ERROR;  // no storage | store is reported as failed
+}
+
+
+/**
+  * @brief Empty implementation of tuning store error callback | called by ADC_TuningInit when result applied to ADC was not stored
+  * @param  hadc    - pointer to ADC handle, whose result was not stored
+  * @param  tune    - pointer to applied tuning result
+  */
+__weak void ADC_TuningStoreErrorCallback(ADC_HandleTypeDef* hadc, const ADC_TuningTypeDef* tune){
+
+	UNUSED(hadc);      // unused variables to avoid warnings
+	UNUSED(tune);
+}
+
+
+/**
+  * @brief Tuning channel function, selects the shortest sampling time of channel meeting target | reference is taken
+  * 	   from consecutive conversion of channel with the longest sampling time, sampling capacitor holds its value already
+  * @param  hadc     - pointer to ADC handle
+  * @param  previous - channel preceding tuned channel in scan
+  * @param  channel  - tuned channel
+  * @param  target   - maximal settling error [LSB]
+  * @param  code     - pointer to selected SMPx code
+  * @param  error    - pointer to settling error with selected code [LSB]
+  * @retval status   - HAL_TIMEOUT if target was not met with the longest sampling time, HAL_ERROR if conversion failed
+  */
+static HAL_StatusTypeDef ADC_TuningChannel(ADC_HandleTypeDef* hadc, uint8_t previous, uint8_t channel, uint16_t target, uint8_t* code, uint16_t* error){
+
+	uint32_t first;
+	uint32_t reference;
+
+	// preceding channel is settled | step from its value is the one seen in scan
+	__ADC_SET_SAMPLETIME(hadc, previous, ADC_TUNING_CODES - 1U);
+	__ADC_SET_SAMPLETIME(hadc, channel,  ADC_TUNING_CODES - 1U);
+
+	if(ADC_TuningMeasure(hadc, previous, channel, &first, &reference) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	// the shortest sampling time first | settling error falls with sampling time
+	for(uint8_t c = 0; c < ADC_TUNING_CODES; ++c){
+
+		__ADC_SET_SAMPLETIME(hadc, channel, c);
+
+		// only conversion right after preceding channel carries settling error | consecutive one is not needed
+		if(ADC_TuningMeasure(hadc, previous, channel, &first, NULL) != HAL_OK){
+			return HAL_ERROR;
+		}
+
+		uint32_t diff = (first > reference) ? (first - reference) : (reference - first);
+
+		*code  = c;
+		*error = (uint16_t)((diff + ADC_TUNING_REPEATS / 2U) / ADC_TUNING_REPEATS);
+
+		if(*error <= target){
+			return HAL_OK;
+		}
+	}
+
+	return HAL_TIMEOUT;
+}
+
+
+/**
+  * @brief Tuning measure function, converts preceding channel and one or two consecutive conversions of tuned channel
+  * @param  hadc     - pointer to ADC handle
+  * @param  previous - channel preceding tuned channel in scan
+  * @param  channel  - tuned channel
+  * @param  first    - pointer to sum of first conversions of tuned channel | ADC_TUNING_REPEATS conversions
+  * @param  second   - pointer to sum of second conversions of tuned channel | NULL: second conversion is skipped
+  * @retval status   - HAL status if all conversions succeeded
+  */
+static HAL_StatusTypeDef ADC_TuningMeasure(ADC_HandleTypeDef* hadc, uint8_t previous, uint8_t channel, uint32_t* first, uint32_t* second){
+
+	uint16_t value;
+
+	*first = 0;
+
+	if(second != NULL){
+		*second = 0;
+	}
+
+	for(int i = 0; i < ADC_TUNING_REPEATS; ++i){
+
+		if(ADC_TuningConvert(hadc, previous, &value) != HAL_OK){
+			return HAL_ERROR;
+		}
+
+		if(ADC_TuningConvert(hadc, channel, &value) != HAL_OK){
+			return HAL_ERROR;
+		}
+
+		*first += value;
+
+		if(second == NULL){
+			continue;
+		}
+
+		if(ADC_TuningConvert(hadc, channel, &value) != HAL_OK){
+			return HAL_ERROR;
+		}
+
+		*second += value;
+	}
+
+	return HAL_OK;
+}
+
+
+/**
+  * @brief Tuning convert function, performs single software-triggered conversion of channel
+  * @param  hadc    - pointer to ADC handle
+  * @param  channel - converted channel
+  * @param  value   - pointer to converted value
+  * @retval status  - HAL status if conversion finished within ADC_TUNING_TIMEOUT
+  */
+static HAL_StatusTypeDef ADC_TuningConvert(ADC_HandleTypeDef* hadc, uint8_t channel, uint16_t* value){
+
+	__ADC_SET_SINGLE_CONVERSION(hadc, channel);
+
+	if(HAL_ADC_Start(hadc) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	if(HAL_ADC_PollForConversion(hadc, ADC_TUNING_TIMEOUT) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	*value = __ADC_DUAL_MASTER_DATA(__ADC_READ_DATA(hadc));	// lower half-word | Master's data register holds Slave's data in upper half-word
+
+	return HAL_OK;
+}
@@ -22,6 +22,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "adc_driver.h"
+#include "adc_console.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -47,11 +48,14 @@ DMA_HandleTypeDef hdma_adc1;
 UART_HandleTypeDef huart2;
 
 /* USER CODE BEGIN PV */
-// Variables for ADC1
+// Console on USART2 | printf (_write) and log macros are sent by TX DMA channel
+DMA_HandleTypeDef hdma_usart2_tx;
+
+// Variables for ADC1 | dual mode DMA storage sized to 1 converted channel
 ADC_ChannelsTypeDef  cadc1;
-ADC_BufferTypeDef badc1;
+ADC_BUFFER_DEFINE_MULTIMODE(badc1, 1, ADC_AVERAGED_MEASURES);
 
-// Variables for ADC2
+// Variables for ADC2 | converted without DMA, so no DMA storage is needed
 ADC_ChannelsTypeDef  cadc2;
 ADC_BufferTypeDef badc2;
 
@@ -112,6 +116,17 @@ int main(void)
   MX_ADC1_Init();
   MX_ADC2_Init();
   /* USER CODE BEGIN 2 */
+  // Console | text written before init is only queued, so it is initialized first
+  HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 3, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+  HAL_NVIC_SetPriority(USART2_IRQn, 3, 0);
+  HAL_NVIC_EnableIRQ(USART2_IRQn);
+
+  hdma_usart2_tx.Instance = DMA1_Channel7;
+
+  if(ADC_ConsoleInit(&ADC_Console, &huart2, &hdma_usart2_tx) != HAL_OK){
+	  Error_Handler();
+  }
 
   /* USER CODE END 2 */
 
@@ -391,6 +406,21 @@ static void MX_GPIO_Init(void)
 }
 
 /* USER CODE BEGIN 4 */
+/**
+  * @brief Console transmission complete | next part of ring is sent
+  */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart){
+
+	ADC_ConsoleTxCplt(&ADC_Console, huart);
+}
+
+/**
+  * @brief Console transmission error | aborted part of ring is counted as dropped
+  */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart){
+
+	ADC_ConsoleError(&ADC_Console, huart);
+}
 
 /* USER CODE END 4 */
 
@@ -29,6 +29,7 @@
 #include <time.h>
 #include <sys/time.h>
 #include <sys/times.h>
+#include "adc_console.h"
 
 
 /* Variables */
@@ -80,11 +81,12 @@ __attribute__((weak)) int _read(int file, char *ptr, int len)
 __attribute__((weak)) int _write(int file, char *ptr, int len)
 {
   (void)file;
-  int DataIdx;
 
-  for (DataIdx = 0; DataIdx < len; DataIdx++)
+  /* stdout and stderr are queued to console ring (adc_console.h), never blocks | text not fitting ring is dropped and counted */
+  /* nothing is sent until ADC_ConsoleInit (main.c) | text written before it waits in ring or is dropped once ring is full */
+  if (len > 0)
   {
-    __io_putchar(*ptr++);
+    ADC_ConsoleWrite(&ADC_Console, ptr, (uint32_t)len);
   }
   return len;
 }
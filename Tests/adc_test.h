@@ -0,0 +1,46 @@
+/**
+  ******************************************************************************
+  * @file    adc_test.h
+  * @author  Bartosz Rychlicki
+
+  * @Title   Assertions of host tests
+
+  * @brief   This file contains macros of host tests (Tests/Makefile), which build driver with ADC_SIM and check results of
+  * 		 simulated scenarios. Failed assertion prints its location and condition, test continues, so one run reports
+  * 		 all failures. TEST_RESULT returns exit code of test program.
+  ******************************************************************************
+  * @attention Host only | never included by firmware sources
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TESTS_ADC_TEST_H_
+#define TESTS_ADC_TEST_H_
+
+#pragma once
+
+/* Includes ----------------------------------------------------------------------------*/
+#include <stdio.h>
+
+
+/* Macros ------------------------------------------------------------------------------ */
+#define 			TEST_ASSERT(__CONDITION__)																					\
+						do{ TestChecks++; if(!(__CONDITION__)){ TestFailures++; printf("%s:%d: FAIL %s\n", __FILE__, __LINE__, #__CONDITION__); } }while(0)
+
+#define 			TEST_ASSERT_EQUAL(__EXPECTED__, __ACTUAL__)																	\
+						do{ unsigned long long __e = (unsigned long long)(__EXPECTED__), __a = (unsigned long long)(__ACTUAL__); TestChecks++;	\
+							if(__e != __a){ TestFailures++; printf("%s:%d: FAIL %s == %s (%llu != %llu)\n", __FILE__, __LINE__, #__EXPECTED__, #__ACTUAL__, __e, __a); } }while(0)
+
+#define 			TEST_RESULT(__NAME__)																						\
+						(printf("%s: %u checks, %u failures\n", (__NAME__), TestChecks, TestFailures), (TestFailures != 0U) ? 1 : 0)
+
+
+/* Variables -------------------------------------------------------------------------- */
+static unsigned TestChecks;						// number of evaluated assertions
+static unsigned TestFailures;					// number of failed assertions
+
+
+#endif /* TESTS_ADC_TEST_H_ */
@@ -0,0 +1,198 @@
+/**
+  ******************************************************************************
+  * @file      stm32_stub.c
+  * @author    Bartosz Rychlicki
+  * @Title     Minimal HAL of family builds of driver on host
+  * @brief     This file contains register instances of stubs (plain memory) and HAL functions called by adc_driver.c:
+  * 		   - start functions set ADSTART (F4: ADON and STRT), stop functions clear them
+  * 		   - calibration and DMA abort succeed, values read from data registers
+  * 		   - StubReset clears all registers between test cases
+  ******************************************************************************
+  * @attention No conversions are simulated, family builds check register encoding of driver macros only.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "stm32_stub.h"
+#include <string.h>
+
+// Register instances
+#if defined(STM32F3_FAMILY)
+StubAdcBlock_TypeDef StubAdcBlock;
+#else
+ADC_TypeDef          StubAdc[3];
+ADC_Common_TypeDef   StubAdcCommon;
+#endif
+
+DMA_TypeDef          StubDmaFlags;
+
+#if defined(STM32F4_FAMILY) || defined(STM32H7_FAMILY)
+DMA_Stream_TypeDef   StubDma[8];
+#else
+DMA_Channel_TypeDef  StubDma[8];
+#endif
+
+#if defined(STM32H7_FAMILY)
+BDMA_Channel_TypeDef StubBdma[8];
+#endif
+
+uint32_t             StubPrimask;
+
+// Private functions prototypes
+static void StubStart(ADC_HandleTypeDef* hadc);
+static void StubStop(ADC_HandleTypeDef* hadc);
+
+
+/**
+  * @brief Reset function, clears registers of all instances | state after reset of device
+  */
+void StubReset(void){
+
+	#if defined(STM32F3_FAMILY)
+		memset(&StubAdcBlock, 0, sizeof(StubAdcBlock));
+	#else
+		memset(StubAdc, 0, sizeof(StubAdc));
+		memset(&StubAdcCommon, 0, sizeof(StubAdcCommon));
+	#endif
+
+	#if defined(STM32H7_FAMILY)
+		memset(StubBdma, 0, sizeof(StubBdma));
+	#endif
+
+	memset(StubDma, 0, sizeof(StubDma));
+	memset(&StubDmaFlags, 0, sizeof(StubDmaFlags));
+	StubPrimask = 0;
+}
+
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc){
+
+	StubStart(hadc);
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc){
+
+	StubStop(hadc);
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length){
+
+	UNUSED(pData);
+
+	if(hadc->DMA_Handle != NULL){
+		__HAL_DMA_SET_COUNTER(hadc->DMA_Handle, Length);
+		hadc->DMA_Handle->State = HAL_DMA_STATE_BUSY;
+	}
+
+	StubStart(hadc);
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef* hadc){
+
+	if(hadc->DMA_Handle != NULL){
+		hadc->DMA_Handle->State = HAL_DMA_STATE_READY;
+	}
+
+	StubStop(hadc);
+
+	return HAL_OK;
+}
+
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef* hadc){
+
+	return hadc->Instance->DR;
+}
+
+
+HAL_StatusTypeDef HAL_ADCEx_MultiModeStart_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length){
+
+	return HAL_ADC_Start_DMA(hadc, pData, Length);
+}
+
+
+HAL_StatusTypeDef HAL_ADCEx_MultiModeStop_DMA(ADC_HandleTypeDef* hadc){
+
+	return HAL_ADC_Stop_DMA(hadc);
+}
+
+
+uint32_t HAL_ADCEx_MultiModeGetValue(ADC_HandleTypeDef* hadc){
+
+	UNUSED(hadc);
+
+	#if defined(STM32F3_FAMILY)
+		return StubAdcBlock.Common.CDR;
+	#else
+		return StubAdcCommon.CDR;
+	#endif
+}
+
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef* hdma){
+
+	hdma->State = HAL_DMA_STATE_READY;
+
+	return HAL_OK;
+}
+
+
+#if defined(STM32H7_FAMILY)
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* hadc, uint32_t CalibrationMode, uint32_t SingleDiff){
+
+	UNUSED(hadc);
+	UNUSED(CalibrationMode);
+	UNUSED(SingleDiff);
+
+	return HAL_OK;
+}
+#elif !defined(STM32F4_FAMILY)
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* hadc, uint32_t SingleDiff){
+
+	UNUSED(hadc);
+	UNUSED(SingleDiff);
+
+	return HAL_OK;
+}
+#endif
+
+
+/**
+  * @brief Start function, sets bits which start regular conversions of family
+  */
+static void StubStart(ADC_HandleTypeDef* hadc){
+
+	#if defined(STM32F4_FAMILY)
+		SET_BIT(hadc->Instance->CR2, ADC_CR2_ADON);
+		SET_BIT(hadc->Instance->SR, ADC_SR_STRT);				// set by hardware on SWSTART
+	#else
+		SET_BIT(hadc->Instance->CR, ADC_CR_ADSTART);
+	#endif
+}
+
+
+/**
+  * @brief Stop function, clears bits which start regular conversions of family
+  */
+static void StubStop(ADC_HandleTypeDef* hadc){
+
+	#if defined(STM32F4_FAMILY)
+		CLEAR_BIT(hadc->Instance->CR2, ADC_CR2_ADON);
+		CLEAR_BIT(hadc->Instance->SR, ADC_SR_STRT);
+	#else
+		CLEAR_BIT(hadc->Instance->CR, ADC_CR_ADSTART);
+	#endif
+}
@@ -0,0 +1,200 @@
+/**
+  ******************************************************************************
+  * @file      stm32_stub.h
+  * @author    Bartosz Rychlicki
+  * @Title     Minimal HAL of family builds of driver on host
+  * @brief     This file contains replacement of main.h and HAL used by adc_driver.c built for families other than F1
+  * 		   (forced by -include in Tests/Makefile):
+  * 		   - core macros (register access, __weak, PRIMASK) and HAL status, handle and DMA handle typedefs
+  * 		   - prototypes of HAL functions called by driver, defined by stm32_stub.c
+  * 		   - registers, bits and family specific HAL of detected family (stm32f3xx.h, stm32f4xx.h, stm32g4xx.h,
+  * 		     stm32l4xx.h, stm32h7xx.h in this directory)
+  ******************************************************************************
+  * @attention Registers are plain memory (instances of stm32_stub.c cleared by StubReset), so hardware write semantics
+  * 		   (write 1 or write 0 to clear) are applied by tests, e.g. TestClearFlags of test_families.c.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TESTS_STM32_STUB_H_
+#define TESTS_STM32_STUB_H_
+
+#pragma once
+
+#define __MAIN_H												// main.h of F1 board (Core/Inc) is replaced by this file
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include "stm32_family.h"
+
+
+/* Core Macros ------------------------------------------------------------------------- */
+#define __IO					volatile
+#define __I						volatile const
+#define __O						volatile
+#define __weak					__attribute__((weak))
+#define UNUSED(X)				(void)(X)
+
+#define SET_BIT(REG, BIT)		((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)		((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)		((REG) & (BIT))
+#define WRITE_REG(REG, VAL)		((REG) = (VAL))
+#define READ_REG(REG)			((REG))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)		WRITE_REG((REG), (((READ_REG(REG)) & (~(CLEARMASK))) | (SETMASK)))
+
+#define __CLZ(X)				((uint8_t)__builtin_clz(X))
+#define __UNALIGNED_UINT32_READ(PTR)	(((const struct __attribute__((packed)){ uint32_t v; }*)(const void*)(PTR))->v)
+
+extern uint32_t StubPrimask;
+
+static inline uint32_t __get_PRIMASK(void){ return StubPrimask; }
+static inline void __set_PRIMASK(uint32_t primask){ StubPrimask = primask; }
+static inline void __disable_irq(void){ StubPrimask = 1U; }
+static inline void __enable_irq(void){ StubPrimask = 0U; }
+static inline void __ISB(void){ }
+static inline void __DSB(void){ }
+
+
+/* Typedefs --------------------------------------------------------------------------- */
+typedef enum{
+	HAL_OK       = 0x00U,
+	HAL_ERROR    = 0x01U,
+	HAL_BUSY     = 0x02U,
+	HAL_TIMEOUT  = 0x03U
+}HAL_StatusTypeDef;
+
+typedef enum{
+	HAL_UNLOCKED = 0x00U,
+	HAL_LOCKED   = 0x01U
+}HAL_LockTypeDef;
+
+typedef enum{
+	HAL_DMA_STATE_RESET   = 0x00U,
+	HAL_DMA_STATE_READY   = 0x01U,
+	HAL_DMA_STATE_BUSY    = 0x02U,
+	HAL_DMA_STATE_TIMEOUT = 0x03U
+}HAL_DMA_StateTypeDef;
+
+
+/* Family registers and HAL ------------------------------------------------------------ */
+#if defined(STM32F3_FAMILY)
+	#include "stm32f3xx.h"
+#elif defined(STM32F4_FAMILY)
+	#include "stm32f4xx.h"
+#elif defined(STM32G4_FAMILY)
+	#include "stm32g4xx.h"
+#elif defined(STM32L4_FAMILY)
+	#include "stm32l4xx.h"
+#elif defined(STM32H7_FAMILY)
+	#include "stm32h7xx.h"
+#else
+	#error "stubs cover F3, F4, G4, L4 and H7 families | F1 is built against simulation (adc_sim.h)"
+#endif
+
+
+/* HAL Typedefs ----------------------------------------------------------------------- */
+typedef struct{
+	uint32_t Request;
+	uint32_t Direction;
+	uint32_t PeriphInc;
+	uint32_t MemInc;
+	uint32_t PeriphDataAlignment;
+	uint32_t MemDataAlignment;
+	uint32_t Mode;
+	uint32_t Priority;
+}DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef{
+
+	STUB_DMA_INSTANCE*   Instance;							// channel, stream or BDMA channel of family
+
+	DMA_InitTypeDef      Init;
+
+	HAL_LockTypeDef      Lock;
+
+	__IO HAL_DMA_StateTypeDef State;
+
+	void*                Parent;
+
+	void (*XferCpltCallback)(struct __DMA_HandleTypeDef* hdma);
+	void (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef* hdma);
+	void (*XferErrorCallback)(struct __DMA_HandleTypeDef* hdma);
+	void (*XferAbortCallback)(struct __DMA_HandleTypeDef* hdma);
+
+	__IO uint32_t        ErrorCode;
+
+	uint32_t             ChannelIndex;						// index of flags of channel or stream | 0 ... 7
+
+}DMA_HandleTypeDef;
+
+typedef struct{
+	uint32_t Resolution;
+	uint32_t DataAlign;
+	uint32_t ContinuousConvMode;
+	uint32_t NbrOfConversion;
+}ADC_InitTypeDef;
+
+typedef struct{
+
+	ADC_TypeDef*         Instance;
+
+	ADC_InitTypeDef      Init;
+
+	DMA_HandleTypeDef*   DMA_Handle;
+
+	HAL_LockTypeDef      Lock;
+
+	__IO uint32_t        State;
+
+	__IO uint32_t        ErrorCode;
+
+}ADC_HandleTypeDef;
+
+
+/* HAL Macros -------------------------------------------------------------------------- */
+#define HAL_DMA_ERROR_NONE			0x00U
+#define HAL_ADC_ERROR_NONE			0x00U
+#define HAL_ADC_ERROR_OVR			0x02U
+#define HAL_ADC_ERROR_DMA			0x04U
+
+#define DMA_NORMAL					0x00U
+#define DMA_CIRCULAR				0x20U
+#define DMA_MINC_ENABLE				0x80U
+
+
+/* HAL Functions Prototypes | stm32_stub.c -------------------------------------------- */
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length);
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef* hadc);
+uint32_t          HAL_ADC_GetValue(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADCEx_MultiModeStart_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length);
+HAL_StatusTypeDef HAL_ADCEx_MultiModeStop_DMA(ADC_HandleTypeDef* hadc);
+uint32_t          HAL_ADCEx_MultiModeGetValue(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef* hdma);
+
+#if defined(STM32H7_FAMILY)
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* hadc, uint32_t CalibrationMode, uint32_t SingleDiff);
+#elif !defined(STM32F4_FAMILY)
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* hadc, uint32_t SingleDiff);
+#endif
+
+void              StubReset(void);
+
+void              HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc);
+void              HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc);
+void              HAL_ADC_ErrorCallback(ADC_HandleTypeDef* hadc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_STM32_STUB_H_ */
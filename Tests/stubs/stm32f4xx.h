@@ -0,0 +1,144 @@
+/**
+  ******************************************************************************
+  * @file      stm32f4xx.h
+  * @author    Bartosz Rychlicki
+  * @Title     Minimal registers of F4 family for host build of driver
+  * @brief     This file contains layout and bits of ADC, ADC common and DMA stream registers read or written by F4 macros
+  * 		   of adc_driver.h, instances placed in plain memory (stm32_stub.c) and F4 HAL DMA macros, which select flags
+  * 		   of stream by its position in controller like HAL does
+  ******************************************************************************
+  * @attention Offsets and bit positions follow reference manual RM0090, registers not used by driver are reserved words.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TESTS_STM32F4XX_H_
+#define TESTS_STM32F4XX_H_
+
+#pragma once
+
+/* Typedefs --------------------------------------------------------------------------- */
+typedef struct{
+	__IO uint32_t SR;			// 0x00
+	__IO uint32_t CR1;			// 0x04
+	__IO uint32_t CR2;			// 0x08
+	__IO uint32_t SMPR1;		// 0x0C
+	__IO uint32_t SMPR2;		// 0x10
+	uint32_t      RESERVED1[6];	// 0x14 - 0x28 | JOFR1 - JOFR4, HTR, LTR
+	__IO uint32_t SQR1;			// 0x2C
+	__IO uint32_t SQR2;			// 0x30
+	__IO uint32_t SQR3;			// 0x34
+	uint32_t      RESERVED2[5];	// 0x38 - 0x48 | JSQR, JDR1 - JDR4
+	__IO uint32_t DR;			// 0x4C
+}ADC_TypeDef;
+
+typedef struct{
+	__IO uint32_t CSR;			// 0x300
+	__IO uint32_t CCR;			// 0x304
+	__IO uint32_t CDR;			// 0x308
+}ADC_Common_TypeDef;
+
+typedef struct{
+	__IO uint32_t CR;
+	__IO uint32_t NDTR;
+	__IO uint32_t PAR;
+	__IO uint32_t M0AR;
+	__IO uint32_t M1AR;
+	__IO uint32_t FCR;
+}DMA_Stream_TypeDef;
+
+typedef struct{
+	__IO uint32_t LISR;
+	__IO uint32_t HISR;
+	__IO uint32_t LIFCR;
+	__IO uint32_t HIFCR;
+}DMA_TypeDef;
+
+#define STUB_DMA_INSTANCE				DMA_Stream_TypeDef
+
+/* Instances | stm32_stub.c ------------------------------------------------------------ */
+extern ADC_TypeDef        StubAdc[3];
+extern ADC_Common_TypeDef StubAdcCommon;
+extern DMA_Stream_TypeDef StubDma[8];
+extern DMA_TypeDef        StubDmaFlags;
+
+#define ADC1							(&StubAdc[0])
+#define ADC2							(&StubAdc[1])
+#define ADC3							(&StubAdc[2])
+#define ADC123_COMMON					(&StubAdcCommon)
+#define ADC								ADC123_COMMON
+#define DMA2							(&StubDmaFlags)
+#define DMA2_Stream0					(&StubDma[0])
+#define DMA2_Stream1					(&StubDma[1])
+
+/* ADC bits --------------------------------------------------------------------------- */
+#define ADC_SR_AWD						(0x1U << 0U)
+#define ADC_SR_EOC_Pos					1U
+#define ADC_SR_EOC						(0x1U << ADC_SR_EOC_Pos)
+#define ADC_SR_STRT_Pos					4U
+#define ADC_SR_STRT						(0x1U << ADC_SR_STRT_Pos)
+#define ADC_SR_OVR_Pos					5U
+#define ADC_SR_OVR						(0x1U << ADC_SR_OVR_Pos)
+
+#define ADC_CR1_RES_Pos					24U
+#define ADC_CR1_RES						(0x3U << ADC_CR1_RES_Pos)
+
+#define ADC_CR2_ADON					(0x1U << 0U)
+#define ADC_CR2_CONT_Pos				1U
+#define ADC_CR2_CONT					(0x1U << ADC_CR2_CONT_Pos)
+#define ADC_CR2_DMA_Pos					8U
+#define ADC_CR2_DMA						(0x1U << ADC_CR2_DMA_Pos)
+#define ADC_CR2_DDS						(0x1U << 9U)
+#define ADC_CR2_ALIGN					(0x1U << 11U)
+#define ADC_CR2_SWSTART					(0x1U << 30U)
+
+#define ADC_SQR1_L_Pos					20U
+#define ADC_SQR1_L_Msk					(0xFU << ADC_SQR1_L_Pos)
+#define ADC_SQR1_L						ADC_SQR1_L_Msk
+#define ADC_SQR1_SQ13_Pos				0U
+#define ADC_SQR1_SQ14_Pos				5U
+#define ADC_SQR1_SQ15_Pos				10U
+#define ADC_SQR1_SQ16_Pos				15U
+#define ADC_SQR2_SQ7_Pos				0U
+#define ADC_SQR2_SQ8_Pos				5U
+#define ADC_SQR2_SQ9_Pos				10U
+#define ADC_SQR2_SQ10_Pos				15U
+#define ADC_SQR2_SQ11_Pos				20U
+#define ADC_SQR2_SQ12_Pos				25U
+#define ADC_SQR3_SQ1_Pos				0U
+#define ADC_SQR3_SQ1					(0x1FU << ADC_SQR3_SQ1_Pos)
+#define ADC_SQR3_SQ2_Pos				5U
+#define ADC_SQR3_SQ3_Pos				10U
+#define ADC_SQR3_SQ4_Pos				15U
+#define ADC_SQR3_SQ5_Pos				20U
+#define ADC_SQR3_SQ6_Pos				25U
+
+#define ADC_CCR_MULTI					(0x1FU << 0U)
+
+/* DMA bits and HAL macros | flags of streams 0 - 3 in LISR/LIFCR, streams 4 - 7 in HISR/HIFCR -------------- */
+#define DMA_SxCR_EN						(0x1U << 0U)
+#define DMA_IT_TC						(0x1U << 4U)
+#define DMA_IT_HT						(0x1U << 3U)
+#define DMA_IT_TE						(0x1U << 2U)
+#define DMA_MDATAALIGN_BYTE				0x00000U
+#define DMA_MDATAALIGN_HALFWORD			0x02000U
+#define DMA_MDATAALIGN_WORD				0x04000U
+
+#define STUB_DMA_STREAM(__HANDLE__)							((uint32_t)((__HANDLE__)->Instance - &StubDma[0]))
+#define STUB_DMA_FLAG_SHIFT(__HANDLE__)						(((const uint8_t[4]){ 0U, 6U, 16U, 22U })[STUB_DMA_STREAM(__HANDLE__) & 3U])
+
+#define __HAL_DMA_ENABLE(__HANDLE__)						((__HANDLE__)->Instance->CR |= DMA_SxCR_EN)
+#define __HAL_DMA_DISABLE(__HANDLE__)						((__HANDLE__)->Instance->CR &= ~DMA_SxCR_EN)
+#define __HAL_DMA_ENABLE_IT(__HANDLE__, __IT__)				((__HANDLE__)->Instance->CR |= (__IT__))
+#define __HAL_DMA_GET_COUNTER(__HANDLE__)					((__HANDLE__)->Instance->NDTR)
+#define __HAL_DMA_SET_COUNTER(__HANDLE__, __COUNTER__)		((__HANDLE__)->Instance->NDTR = (uint16_t)(__COUNTER__))
+#define __HAL_DMA_GET_TC_FLAG_INDEX(__HANDLE__)				(0x20U << STUB_DMA_FLAG_SHIFT(__HANDLE__))
+#define __HAL_DMA_GET_HT_FLAG_INDEX(__HANDLE__)				(0x10U << STUB_DMA_FLAG_SHIFT(__HANDLE__))
+#define __HAL_DMA_GET_TE_FLAG_INDEX(__HANDLE__)				(0x08U << STUB_DMA_FLAG_SHIFT(__HANDLE__))
+#define __HAL_DMA_CLEAR_FLAG(__HANDLE__, __FLAG__)																	\
+						((STUB_DMA_STREAM(__HANDLE__) < 4U) ? (DMA2->LIFCR = (__FLAG__)) : (DMA2->HIFCR = (__FLAG__)))
+
+#endif /* TESTS_STM32F4XX_H_ */
@@ -0,0 +1,187 @@
+/**
+  ******************************************************************************
+  * @file      stm32h7xx.h
+  * @author    Bartosz Rychlicki
+  * @Title     Minimal registers of H7 family for host build of driver
+  * @brief     This file contains layout and bits of ADC, ADC common, DMA stream and BDMA channel registers read or written
+  * 		   by H7 macros of adc_driver.h, instances placed in plain memory (stm32_stub.c) and H7 HAL DMA macros, which
+  * 		   select stream or BDMA channel by instance like HAL does (ADC1/ADC2 on DMA1/DMA2, ADC3 on BDMA)
+  ******************************************************************************
+  * @attention Offsets and bit positions follow reference manual RM0433, registers not used by driver are reserved words.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TESTS_STM32H7XX_H_
+#define TESTS_STM32H7XX_H_
+
+#pragma once
+
+/* Typedefs --------------------------------------------------------------------------- */
+typedef struct{
+	__IO uint32_t ISR;			// 0x00
+	__IO uint32_t IER;			// 0x04
+	__IO uint32_t CR;			// 0x08
+	__IO uint32_t CFGR;			// 0x0C
+	__IO uint32_t CFGR2;		// 0x10
+	__IO uint32_t SMPR1;		// 0x14
+	__IO uint32_t SMPR2;		// 0x18
+	uint32_t      RESERVED1[5];	// 0x1C - 0x2C | PCSEL, LTR1, HTR1
+	__IO uint32_t SQR1;			// 0x30
+	__IO uint32_t SQR2;			// 0x34
+	__IO uint32_t SQR3;			// 0x38
+	__IO uint32_t SQR4;			// 0x3C
+	__IO uint32_t DR;			// 0x40
+}ADC_TypeDef;
+
+typedef struct{
+	__IO uint32_t CSR;			// 0x300
+	uint32_t      RESERVED;
+	__IO uint32_t CCR;			// 0x308
+	__IO uint32_t CDR;			// 0x30C
+}ADC_Common_TypeDef;
+
+typedef struct{
+	__IO uint32_t CR;
+	__IO uint32_t NDTR;
+	__IO uint32_t PAR;
+	__IO uint32_t M0AR;
+	__IO uint32_t M1AR;
+	__IO uint32_t FCR;
+}DMA_Stream_TypeDef;
+
+typedef struct{
+	__IO uint32_t CCR;
+	__IO uint32_t CNDTR;
+	__IO uint32_t CPAR;
+	__IO uint32_t CM0AR;
+	__IO uint32_t CM1AR;
+}BDMA_Channel_TypeDef;
+
+typedef struct{
+	__IO uint32_t LISR;
+	__IO uint32_t HISR;
+	__IO uint32_t LIFCR;
+	__IO uint32_t HIFCR;
+}DMA_TypeDef;
+
+#define STUB_DMA_INSTANCE				void						// DMA_Stream_TypeDef or BDMA_Channel_TypeDef
+
+/* Instances | stm32_stub.c ------------------------------------------------------------ */
+extern ADC_TypeDef          StubAdc[3];
+extern ADC_Common_TypeDef   StubAdcCommon;
+extern DMA_Stream_TypeDef   StubDma[8];
+extern BDMA_Channel_TypeDef StubBdma[8];
+extern DMA_TypeDef          StubDmaFlags;
+
+#define ADC1							(&StubAdc[0])
+#define ADC2							(&StubAdc[1])
+#define ADC3							(&StubAdc[2])
+#define ADC12_COMMON					(&StubAdcCommon)
+#define DMA1							(&StubDmaFlags)
+#define DMA1_Stream0					(&StubDma[0])
+#define DMA1_Stream1					(&StubDma[1])
+#define BDMA_Channel0					(&StubBdma[0])
+#define BDMA_Channel1					(&StubBdma[1])
+
+#define IS_DMA_STREAM_INSTANCE(INSTANCE)	(((DMA_Stream_TypeDef*)(INSTANCE) >= &StubDma[0]) && ((DMA_Stream_TypeDef*)(INSTANCE) <= &StubDma[7]))
+#define IS_BDMA_CHANNEL_INSTANCE(INSTANCE)	(((BDMA_Channel_TypeDef*)(INSTANCE) >= &StubBdma[0]) && ((BDMA_Channel_TypeDef*)(INSTANCE) <= &StubBdma[7]))
+
+#define __LL_ADC_COMMON_INSTANCE(__ADCx__)	(ADC12_COMMON)
+
+/* ADC bits --------------------------------------------------------------------------- */
+#define ADC_ISR_EOC_Pos					2U
+#define ADC_ISR_EOC						(0x1UL << ADC_ISR_EOC_Pos)
+#define ADC_ISR_EOS						(0x1UL << 3U)
+#define ADC_ISR_OVR_Pos					4U
+#define ADC_ISR_OVR						(0x1UL << ADC_ISR_OVR_Pos)
+
+#define ADC_CR_ADSTART_Pos				2U
+#define ADC_CR_ADSTART					(0x1UL << ADC_CR_ADSTART_Pos)
+#define ADC_CR_ADSTP					(0x1UL << 4U)
+
+#define ADC_CFGR_DMNGT_Pos				0U
+#define ADC_CFGR_DMNGT					(0x3UL << ADC_CFGR_DMNGT_Pos)
+#define ADC_CFGR_DMNGT_0				(0x1UL << ADC_CFGR_DMNGT_Pos)
+#define ADC_CFGR_RES_Pos				2U
+#define ADC_CFGR_RES					(0x7UL << ADC_CFGR_RES_Pos)
+#define ADC_CFGR_CONT_Pos				13U
+#define ADC_CFGR_CONT					(0x1UL << ADC_CFGR_CONT_Pos)
+
+#define ADC_CFGR2_ROVSE					(0x1UL << 0U)
+#define ADC_CFGR2_OVSS_Pos				5U
+#define ADC_CFGR2_OVSS					(0xFUL << ADC_CFGR2_OVSS_Pos)
+#define ADC_CFGR2_OVSR_Pos				16U
+#define ADC_CFGR2_OVSR					(0x3FFUL << ADC_CFGR2_OVSR_Pos)
+#define ADC_CFGR2_LSHIFT_Pos			28U
+#define ADC_CFGR2_LSHIFT				(0xFUL << ADC_CFGR2_LSHIFT_Pos)
+
+#define ADC_SQR1_L_Pos					0U
+#define ADC_SQR1_L_Msk					(0xFUL << ADC_SQR1_L_Pos)
+#define ADC_SQR1_L						ADC_SQR1_L_Msk
+#define ADC_SQR1_SQ1_Pos				6U
+#define ADC_SQR1_SQ1					(0x1FUL << ADC_SQR1_SQ1_Pos)
+#define ADC_SQR1_SQ2_Pos				12U
+#define ADC_SQR1_SQ3_Pos				18U
+#define ADC_SQR1_SQ4_Pos				24U
+#define ADC_SQR2_SQ5_Pos				0U
+#define ADC_SQR2_SQ6_Pos				6U
+#define ADC_SQR2_SQ7_Pos				12U
+#define ADC_SQR2_SQ8_Pos				18U
+#define ADC_SQR2_SQ9_Pos				24U
+#define ADC_SQR3_SQ10_Pos				0U
+#define ADC_SQR3_SQ11_Pos				6U
+#define ADC_SQR3_SQ12_Pos				12U
+#define ADC_SQR3_SQ13_Pos				18U
+#define ADC_SQR3_SQ14_Pos				24U
+#define ADC_SQR4_SQ15_Pos				0U
+#define ADC_SQR4_SQ16_Pos				6U
+
+#define ADC_CCR_DUAL					(0x1FUL << 0U)
+
+// resolution codes of HAL | revision V encoding
+#define ADC_RESOLUTION_16B				(0x0UL << ADC_CFGR_RES_Pos)
+#define ADC_RESOLUTION_14B				(0x5UL << ADC_CFGR_RES_Pos)
+#define ADC_RESOLUTION_12B				(0x6UL << ADC_CFGR_RES_Pos)
+#define ADC_RESOLUTION_10B				(0x3UL << ADC_CFGR_RES_Pos)
+#define ADC_RESOLUTION_8B				(0x7UL << ADC_CFGR_RES_Pos)
+
+#define ADC_SINGLE_ENDED				0x7FU
+#define ADC_CALIB_OFFSET_LINEARITY		(0x1UL << 16U)
+
+static inline void LL_ADC_SetResolution(ADC_TypeDef* ADCx, uint32_t Resolution){ MODIFY_REG(ADCx->CFGR, ADC_CFGR_RES, Resolution); }
+
+/* DMA bits and HAL macros | stream or BDMA channel selected by instance -------------- */
+#define DMA_SxCR_EN						(0x1UL << 0U)
+#define BDMA_CCR_EN						(0x1UL << 0U)
+#define DMA_IT_TC						(0x1UL << 4U)				// stream bits of CR | BDMA channel bits are shifted by HAL
+#define DMA_IT_HT						(0x1UL << 3U)
+#define DMA_IT_TE						(0x1UL << 2U)
+#define DMA_MDATAALIGN_BYTE				0x00000U
+#define DMA_MDATAALIGN_HALFWORD			0x02000U
+#define DMA_MDATAALIGN_WORD				0x04000U
+
+#define __HAL_DMA_ENABLE(__HANDLE__)																					\
+						((IS_DMA_STREAM_INSTANCE((__HANDLE__)->Instance) != 0U) ? (((DMA_Stream_TypeDef*)(__HANDLE__)->Instance)->CR |= DMA_SxCR_EN) :		\
+						                                                          (((BDMA_Channel_TypeDef*)(__HANDLE__)->Instance)->CCR |= BDMA_CCR_EN))
+#define __HAL_DMA_DISABLE(__HANDLE__)																					\
+						((IS_DMA_STREAM_INSTANCE((__HANDLE__)->Instance) != 0U) ? (((DMA_Stream_TypeDef*)(__HANDLE__)->Instance)->CR &= ~DMA_SxCR_EN) :		\
+						                                                          (((BDMA_Channel_TypeDef*)(__HANDLE__)->Instance)->CCR &= ~BDMA_CCR_EN))
+#define __HAL_DMA_ENABLE_IT(__HANDLE__, __IT__)																		\
+						((IS_DMA_STREAM_INSTANCE((__HANDLE__)->Instance) != 0U) ? (((DMA_Stream_TypeDef*)(__HANDLE__)->Instance)->CR |= (__IT__)) :		\
+						                                                          (((BDMA_Channel_TypeDef*)(__HANDLE__)->Instance)->CCR |= ((__IT__) >> 1U)))
+#define __HAL_DMA_GET_COUNTER(__HANDLE__)																				\
+						((IS_DMA_STREAM_INSTANCE((__HANDLE__)->Instance) != 0U) ? (((DMA_Stream_TypeDef*)(__HANDLE__)->Instance)->NDTR) :			\
+						                                                          (((BDMA_Channel_TypeDef*)(__HANDLE__)->Instance)->CNDTR))
+#define __HAL_DMA_SET_COUNTER(__HANDLE__, __COUNTER__)																\
+						((IS_DMA_STREAM_INSTANCE((__HANDLE__)->Instance) != 0U) ? (((DMA_Stream_TypeDef*)(__HANDLE__)->Instance)->NDTR = (uint16_t)(__COUNTER__)) :	\
+						                                                          (((BDMA_Channel_TypeDef*)(__HANDLE__)->Instance)->CNDTR = (uint16_t)(__COUNTER__)))
+#define __HAL_DMA_GET_TC_FLAG_INDEX(__HANDLE__)			(0x20UL << (6U * ((__HANDLE__)->ChannelIndex & 1U)))
+#define __HAL_DMA_GET_HT_FLAG_INDEX(__HANDLE__)			(0x10UL << (6U * ((__HANDLE__)->ChannelIndex & 1U)))
+#define __HAL_DMA_GET_TE_FLAG_INDEX(__HANDLE__)			(0x08UL << (6U * ((__HANDLE__)->ChannelIndex & 1U)))
+#define __HAL_DMA_CLEAR_FLAG(__HANDLE__, __FLAG__)		(DMA1->LIFCR = (__FLAG__))
+
+#endif /* TESTS_STM32H7XX_H_ */
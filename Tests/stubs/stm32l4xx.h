@@ -0,0 +1,148 @@
+/**
+  ******************************************************************************
+  * @file      stm32l4xx.h
+  * @author    Bartosz Rychlicki
+  * @Title     Minimal registers of L4 family for host build of driver
+  * @brief     This file contains layout and bits of ADC, ADC common and DMA channel registers read or written by L4 macros
+  * 		   of adc_driver.h, instances placed in plain memory (stm32_stub.c) and L4 HAL DMA macros | layout of G4 with
+  * 		   ALIGN at bit 5 of CFGR
+  ******************************************************************************
+  * @attention Offsets and bit positions follow reference manual RM0351, registers not used by driver are reserved words.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TESTS_STM32L4XX_H_
+#define TESTS_STM32L4XX_H_
+
+#pragma once
+
+/* Typedefs --------------------------------------------------------------------------- */
+typedef struct{
+	__IO uint32_t ISR;			// 0x00
+	__IO uint32_t IER;			// 0x04
+	__IO uint32_t CR;			// 0x08
+	__IO uint32_t CFGR;			// 0x0C
+	__IO uint32_t CFGR2;		// 0x10
+	__IO uint32_t SMPR1;		// 0x14
+	__IO uint32_t SMPR2;		// 0x18
+	uint32_t      RESERVED1[5];	// 0x1C - 0x2C | TR1, TR2, TR3
+	__IO uint32_t SQR1;			// 0x30
+	__IO uint32_t SQR2;			// 0x34
+	__IO uint32_t SQR3;			// 0x38
+	__IO uint32_t SQR4;			// 0x3C
+	__IO uint32_t DR;			// 0x40
+}ADC_TypeDef;
+
+typedef struct{
+	__IO uint32_t CSR;			// 0x300
+	uint32_t      RESERVED;
+	__IO uint32_t CCR;			// 0x308
+	__IO uint32_t CDR;			// 0x30C
+}ADC_Common_TypeDef;
+
+typedef struct{
+	__IO uint32_t CCR;
+	__IO uint32_t CNDTR;
+	__IO uint32_t CPAR;
+	__IO uint32_t CMAR;
+}DMA_Channel_TypeDef;
+
+typedef struct{
+	__IO uint32_t ISR;
+	__IO uint32_t IFCR;
+}DMA_TypeDef;
+
+#define STUB_DMA_INSTANCE				DMA_Channel_TypeDef
+
+/* Instances | stm32_stub.c ------------------------------------------------------------ */
+extern ADC_TypeDef         StubAdc[3];
+extern ADC_Common_TypeDef  StubAdcCommon;
+extern DMA_Channel_TypeDef StubDma[8];
+extern DMA_TypeDef         StubDmaFlags;
+
+#define ADC1							(&StubAdc[0])
+#define ADC2							(&StubAdc[1])
+#define ADC3							(&StubAdc[2])
+#define ADC123_COMMON					(&StubAdcCommon)
+#define DMA1							(&StubDmaFlags)
+#define DMA1_Channel1					(&StubDma[0])
+#define DMA1_Channel2					(&StubDma[1])
+
+#define ADC_MULTIMODE_SUPPORT
+#define __LL_ADC_COMMON_INSTANCE(__ADCx__)	(ADC123_COMMON)
+
+/* ADC bits --------------------------------------------------------------------------- */
+#define ADC_ISR_EOC_Pos					2U
+#define ADC_ISR_EOC						(0x1UL << ADC_ISR_EOC_Pos)
+#define ADC_ISR_EOS						(0x1UL << 3U)
+#define ADC_ISR_OVR_Pos					4U
+#define ADC_ISR_OVR						(0x1UL << ADC_ISR_OVR_Pos)
+
+#define ADC_CR_ADSTART_Pos				2U
+#define ADC_CR_ADSTART					(0x1UL << ADC_CR_ADSTART_Pos)
+#define ADC_CR_ADSTP					(0x1UL << 4U)
+
+#define ADC_CFGR_DMAEN					(0x1UL << 0U)
+#define ADC_CFGR_DMACFG_Pos				1U
+#define ADC_CFGR_DMACFG					(0x1UL << ADC_CFGR_DMACFG_Pos)
+#define ADC_CFGR_RES_Pos				3U
+#define ADC_CFGR_RES					(0x3UL << ADC_CFGR_RES_Pos)
+#define ADC_CFGR_CONT_Pos				13U
+#define ADC_CFGR_CONT					(0x1UL << ADC_CFGR_CONT_Pos)
+#define ADC_CFGR_ALIGN					(0x1UL << 5U)
+
+#define ADC_CFGR2_ROVSE					(0x1UL << 0U)
+#define ADC_CFGR2_OVSR_Pos				2U
+#define ADC_CFGR2_OVSR					(0x7UL << ADC_CFGR2_OVSR_Pos)
+#define ADC_CFGR2_OVSS_Pos				5U
+#define ADC_CFGR2_OVSS					(0xFUL << ADC_CFGR2_OVSS_Pos)
+
+#define ADC_SQR1_L_Pos					0U
+#define ADC_SQR1_L_Msk					(0xFUL << ADC_SQR1_L_Pos)
+#define ADC_SQR1_L						ADC_SQR1_L_Msk
+#define ADC_SQR1_SQ1_Pos				6U
+#define ADC_SQR1_SQ1					(0x1FUL << ADC_SQR1_SQ1_Pos)
+#define ADC_SQR1_SQ2_Pos				12U
+#define ADC_SQR1_SQ3_Pos				18U
+#define ADC_SQR1_SQ4_Pos				24U
+#define ADC_SQR2_SQ5_Pos				0U
+#define ADC_SQR2_SQ6_Pos				6U
+#define ADC_SQR2_SQ7_Pos				12U
+#define ADC_SQR2_SQ8_Pos				18U
+#define ADC_SQR2_SQ9_Pos				24U
+#define ADC_SQR3_SQ10_Pos				0U
+#define ADC_SQR3_SQ11_Pos				6U
+#define ADC_SQR3_SQ12_Pos				12U
+#define ADC_SQR3_SQ13_Pos				18U
+#define ADC_SQR3_SQ14_Pos				24U
+#define ADC_SQR4_SQ15_Pos				0U
+#define ADC_SQR4_SQ16_Pos				6U
+
+#define ADC_CCR_DUAL					(0x1FUL << 0U)
+
+#define ADC_SINGLE_ENDED				0x7FU
+
+/* DMA bits and HAL macros ------------------------------------------------------------ */
+#define DMA_CCR_EN						(0x1UL << 0U)
+#define DMA_IT_TC						(0x1UL << 1U)
+#define DMA_IT_HT						(0x1UL << 2U)
+#define DMA_IT_TE						(0x1UL << 3U)
+#define DMA_MDATAALIGN_BYTE				0x000U
+#define DMA_MDATAALIGN_HALFWORD			0x400U
+#define DMA_MDATAALIGN_WORD				0x800U
+
+#define __HAL_DMA_ENABLE(__HANDLE__)						((__HANDLE__)->Instance->CCR |= DMA_CCR_EN)
+#define __HAL_DMA_DISABLE(__HANDLE__)						((__HANDLE__)->Instance->CCR &= ~DMA_CCR_EN)
+#define __HAL_DMA_ENABLE_IT(__HANDLE__, __IT__)				((__HANDLE__)->Instance->CCR |= (__IT__))
+#define __HAL_DMA_GET_COUNTER(__HANDLE__)					((__HANDLE__)->Instance->CNDTR)
+#define __HAL_DMA_SET_COUNTER(__HANDLE__, __COUNTER__)		((__HANDLE__)->Instance->CNDTR = (uint16_t)(__COUNTER__))
+#define __HAL_DMA_GET_TC_FLAG_INDEX(__HANDLE__)				(0x2UL << (4U * (__HANDLE__)->ChannelIndex))
+#define __HAL_DMA_GET_HT_FLAG_INDEX(__HANDLE__)				(0x4UL << (4U * (__HANDLE__)->ChannelIndex))
+#define __HAL_DMA_GET_TE_FLAG_INDEX(__HANDLE__)				(0x8UL << (4U * (__HANDLE__)->ChannelIndex))
+#define __HAL_DMA_CLEAR_FLAG(__HANDLE__, __FLAG__)			(DMA1->IFCR = (__FLAG__))
+
+#endif /* TESTS_STM32L4XX_H_ */
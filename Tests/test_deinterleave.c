@@ -0,0 +1,258 @@
+/**
+  ******************************************************************************
+  * @file      test_deinterleave.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of equivalence of DMA and CPU dual mode de-interleaving
+  * @brief     This file contains comparison of ADC_DeinterleaveStart paths with model of dual mode words (lower half-word
+  * 		   Master, upper half-word Slave):
+  * 		   - CPU only de-interleaving (no spare channel), parameters and limits of blocks
+  * 		   - Master's block copied by simulated memory-to-memory channel (word to half-word truncation), Slave's by CPU
+  * 		   - CPU fallback of block started while channel is busy, Blocks and Fallbacks accounting
+  * 		   - random blocks of circular storage with random time between them, both paths mixed
+  ******************************************************************************
+  * @attention Spare channel copies block at end of transfer (ADC_SIM_COPY_CYCLES per transfer), so Master's buffer is
+  * 		   checked to stay untouched until completion callback sets Ready.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_deinterleave.h"
+#include "adc_sim.h"
+#include "adc_test.h"
+#include <string.h>
+
+// Private Macros
+#define TEST_LENGTH				128U					// transfers of dual mode storage
+#define TEST_UNTOUCHED			0xDEADU					// content of buffers not written yet
+#define TEST_ROUNDS				2000U
+
+// Private functions prototypes
+static uint32_t TestRandom(void);
+static void     TestFill(void);
+static uint8_t  TestMatches(uint16_t offset, uint16_t transfers, uint8_t isMaster);
+static void     TestCpuOnly(void);
+static void     TestDmaCopy(void);
+static void     TestFallback(void);
+static void     TestRandomBlocks(void);
+
+// Private variables
+static uint32_t TestSeed = 0x1F123BB5U;
+
+static ADC_SimTypeDef          sim;
+static DMA_HandleTypeDef       hdmaCopy;
+static ADC_DeinterleaveTypeDef dint;
+
+static uint32_t          words[TEST_LENGTH];			// dual mode DMA storage
+static uint16_t          master[TEST_LENGTH];
+static uint16_t          slave[TEST_LENGTH];
+
+static ADC_BufferTypeDef badc = {
+	.BufferMultiMode  = words,
+	.BufferLength     = TEST_LENGTH,
+	.AveragedMeasures = 1
+};
+
+
+int main(void){
+
+	TestCpuOnly();
+	TestDmaCopy();
+	TestFallback();
+	TestRandomBlocks();
+
+	return TEST_RESULT("test_deinterleave");
+}
+
+
+/**
+  * @brief CPU only | both buffers are written before return, parameters and block limits are checked
+  */
+static void TestCpuOnly(void){
+
+	ADC_BufferTypeDef independent = { .BufferLength = TEST_LENGTH };
+
+	ADC_SimInit(&sim, 6);
+	TestFill();
+
+	TEST_ASSERT(ADC_DeinterleaveInit(NULL, NULL, master, slave, TEST_LENGTH) == HAL_ERROR);
+	TEST_ASSERT(ADC_DeinterleaveInit(&dint, NULL, NULL, slave, TEST_LENGTH) == HAL_ERROR);
+	TEST_ASSERT(ADC_DeinterleaveInit(&dint, NULL, master, slave, 0) == HAL_ERROR);
+	TEST_ASSERT(ADC_DeinterleaveInit(&dint, NULL, master, slave, TEST_LENGTH) == HAL_OK);
+
+	TEST_ASSERT(ADC_DeinterleaveStart(&dint, &independent, 0, 4) == HAL_ERROR);
+	TEST_ASSERT(ADC_DeinterleaveStart(&dint, &badc, TEST_LENGTH - 4U, 5) == HAL_ERROR);
+	TEST_ASSERT(TestMatches(0, TEST_LENGTH, 1) == 0);
+
+	TEST_ASSERT(ADC_DeinterleaveStart(&dint, &badc, 0, TEST_LENGTH / 2U) == HAL_OK);
+	TEST_ASSERT(ADC_DeinterleaveStart(&dint, &badc, TEST_LENGTH / 2U, TEST_LENGTH / 2U) == HAL_OK);
+
+	TEST_ASSERT_EQUAL(1, dint.Ready);
+	TEST_ASSERT_EQUAL(2, dint.Blocks);
+	TEST_ASSERT_EQUAL(0, dint.Fallbacks);
+	TEST_ASSERT(TestMatches(0, TEST_LENGTH, 1) != 0);
+	TEST_ASSERT(TestMatches(0, TEST_LENGTH, 0) != 0);
+}
+
+
+/**
+  * @brief DMA copy | Slave is extracted before return, Master's block arrives with completion callback
+  */
+static void TestDmaCopy(void){
+
+	uint16_t half = TEST_LENGTH / 2U;
+
+	ADC_SimInit(&sim, 6);
+	TestFill();
+
+	memset(&hdmaCopy, 0, sizeof(hdmaCopy));
+	hdmaCopy.Instance = DMA1_Channel2;
+	hdmaCopy.State    = HAL_DMA_STATE_READY;
+
+	TEST_ASSERT(ADC_DeinterleaveInit(&dint, &hdmaCopy, master, slave, TEST_LENGTH) == HAL_OK);
+	TEST_ASSERT_EQUAL(DMA_CCR_MEM2MEM, DMA1_Channel2->CCR & DMA_CCR_MEM2MEM);
+	TEST_ASSERT_EQUAL(DMA_PDATAALIGN_WORD | DMA_MDATAALIGN_HALFWORD, DMA1_Channel2->CCR & (DMA_CCR_PSIZE | DMA_CCR_MSIZE));
+
+	TEST_ASSERT(ADC_DeinterleaveStart(&dint, &badc, half, half) == HAL_OK);
+
+	TEST_ASSERT_EQUAL(0, dint.Ready);
+	TEST_ASSERT_EQUAL(HAL_DMA_STATE_BUSY, hdmaCopy.State);
+	TEST_ASSERT(TestMatches(half, half, 0) != 0);
+	TEST_ASSERT_EQUAL(TEST_UNTOUCHED, master[half]);
+
+	ADC_SimAdvance(&sim, (uint64_t)half * ADC_SIM_COPY_CYCLES - 1U);
+	TEST_ASSERT_EQUAL(0, dint.Ready);
+
+	ADC_SimAdvance(&sim, 1);
+
+	TEST_ASSERT_EQUAL(1, dint.Ready);
+	TEST_ASSERT_EQUAL(1, dint.Blocks);
+	TEST_ASSERT_EQUAL(0, dint.Fallbacks);
+	TEST_ASSERT_EQUAL(HAL_DMA_STATE_READY, hdmaCopy.State);
+	TEST_ASSERT(TestMatches(half, half, 1) != 0);
+	TEST_ASSERT_EQUAL(TEST_UNTOUCHED, master[half - 1U]);	// outside of block
+}
+
+
+/**
+  * @brief Fallback | block started while channel copies previous one is extracted by CPU, both blocks end up equal to model
+  */
+static void TestFallback(void){
+
+	uint16_t half = TEST_LENGTH / 2U;
+
+	ADC_SimInit(&sim, 6);
+	TestFill();
+
+	hdmaCopy.State = HAL_DMA_STATE_READY;
+	TEST_ASSERT(ADC_DeinterleaveInit(&dint, &hdmaCopy, master, slave, TEST_LENGTH) == HAL_OK);
+
+	TEST_ASSERT(ADC_DeinterleaveStart(&dint, &badc, 0, half) == HAL_OK);
+	TEST_ASSERT(ADC_DeinterleaveStart(&dint, &badc, half, half) == HAL_OK);
+
+	// second block extracted by CPU | first one still copied by DMA
+	TEST_ASSERT_EQUAL(1, dint.Ready);
+	TEST_ASSERT_EQUAL(1, dint.Blocks);
+	TEST_ASSERT_EQUAL(1, dint.Fallbacks);
+	TEST_ASSERT(TestMatches(half, half, 1) != 0);
+	TEST_ASSERT_EQUAL(TEST_UNTOUCHED, master[0]);
+
+	ADC_SimAdvance(&sim, (uint64_t)half * ADC_SIM_COPY_CYCLES);
+
+	TEST_ASSERT_EQUAL(2, dint.Blocks);
+	TEST_ASSERT_EQUAL(1, sim.Copy.Blocks);
+	TEST_ASSERT(TestMatches(0, TEST_LENGTH, 1) != 0);
+	TEST_ASSERT(TestMatches(0, TEST_LENGTH, 0) != 0);
+}
+
+
+/**
+  * @brief Random blocks | halves of circular storage with random time between them, every block counted once
+  */
+static void TestRandomBlocks(void){
+
+	uint32_t started = 0;
+	uint16_t half    = TEST_LENGTH / 2U;
+
+	ADC_SimInit(&sim, 6);
+
+	hdmaCopy.State = HAL_DMA_STATE_READY;
+	TEST_ASSERT(ADC_DeinterleaveInit(&dint, &hdmaCopy, master, slave, TEST_LENGTH) == HAL_OK);
+
+	for(uint32_t r = 0; r < TEST_ROUNDS; ++r){
+
+		TestFill();
+
+		// both halves | time between them shorter or longer than DMA copy
+		for(uint16_t offset = 0; offset < TEST_LENGTH; offset += half){
+
+			TEST_ASSERT(ADC_DeinterleaveStart(&dint, &badc, offset, half) == HAL_OK);
+			started++;
+
+			ADC_SimAdvance(&sim, TestRandom() % (2U * half * ADC_SIM_COPY_CYCLES));
+		}
+
+		// finishing copy in progress before storage is refilled
+		ADC_SimAdvance(&sim, (uint64_t)half * ADC_SIM_COPY_CYCLES);
+
+		TEST_ASSERT(TestMatches(0, TEST_LENGTH, 1) != 0);
+		TEST_ASSERT(TestMatches(0, TEST_LENGTH, 0) != 0);
+	}
+
+	TEST_ASSERT_EQUAL(started, dint.Blocks);
+	TEST_ASSERT_EQUAL(started, dint.Fallbacks + sim.Copy.Blocks);
+	TEST_ASSERT(dint.Fallbacks > TEST_ROUNDS / 4U);
+	TEST_ASSERT(sim.Copy.Blocks > TEST_ROUNDS / 4U);
+	TEST_ASSERT_EQUAL((uint64_t)sim.Copy.Blocks * half, sim.Copy.Transfers);
+}
+
+
+/**
+  * @brief Fill function, writes random dual mode words and marks Master's and Slave's buffers as untouched
+  */
+static void TestFill(void){
+
+	for(uint16_t i = 0; i < TEST_LENGTH; ++i){
+		words[i]  = TestRandom();
+		master[i] = TEST_UNTOUCHED;
+		slave[i]  = TEST_UNTOUCHED;
+	}
+}
+
+
+/**
+  * @brief Model function, compares part of Master's or Slave's buffer with half-words of dual mode words
+  * @param  offset    - first compared transfer
+  * @param  transfers - number of compared transfers
+  * @param  isMaster  - 1: Master's buffer (lower half-words), 0: Slave's buffer (upper half-words)
+  * @retval matches   - 1 if whole part is equal to model
+  */
+static uint8_t TestMatches(uint16_t offset, uint16_t transfers, uint8_t isMaster){
+
+	for(uint16_t i = offset; i < offset + transfers; ++i){
+
+		uint16_t expected = isMaster ? (uint16_t)(words[i] & 0xFFFFU) : (uint16_t)(words[i] >> 16);
+
+		if((isMaster ? master[i] : slave[i]) != expected){
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+
+/**
+  * @brief Pseudo-random generator | xorshift32
+  */
+static uint32_t TestRandom(void){
+
+	TestSeed ^= TestSeed << 13;
+	TestSeed ^= TestSeed >> 17;
+	TestSeed ^= TestSeed << 5;
+
+	return TestSeed;
+}
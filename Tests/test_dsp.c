@@ -0,0 +1,217 @@
+/**
+  ******************************************************************************
+  * @file      test_dsp.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of equivalence of SIMD and reference DSP kernels
+  * @brief     This file contains comparison of kernels of adc_dsp.c built twice: reference kernels (ADC_Dsp*) and SIMD kernels
+  * 		   with emulated intrinsics (ADC_DSP_EMULATE, renamed to ADC_DspSimd* by Makefile). Both are checked against
+  * 		   exact 64-bit model on random samples of full range 0 ... 0xFFFF, odd and even lengths, and extreme values.
+  ******************************************************************************
+  * @attention ADC_DspFir is checked within its documented limit: right-aligned 12-bit samples (0 ... 0x0FFF) and sum of
+  * 		   |coeffs| * 0x0FFF not exceeding 32-bit accumulator (16 full-scale taps).
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_dsp.h"
+#include "adc_test.h"
+
+// Private Macros
+#define TEST_LENGTH				301U					// the longest random array | odd
+#define TEST_ROUNDS				20000U
+#define TEST_FIR_FULL_SCALE		16U						// taps of ADC_DspFir with full-scale coefficients and samples
+#define TEST_RIGHT_ALIGNED		0x0FFFU					// the highest right-aligned 12-bit sample
+
+// SIMD kernels | adc_dsp.c built with ADC_DSP_EMULATE and renamed symbols
+uint32_t ADC_DspSimdSum(const uint16_t* x, uint16_t n);
+uint64_t ADC_DspSimdSumSquares(const uint16_t* x, uint16_t n);
+int32_t  ADC_DspSimdFir(const int16_t* coeffs, const uint16_t* x, uint16_t taps);
+int16_t  ADC_DspSimdFirQ15(const int16_t* coeffs, const uint16_t* x, uint16_t taps);
+
+// Private functions prototypes
+static uint32_t TestRandom(void);
+static void     TestKernels(const int16_t* coeffs, const uint16_t* x, uint16_t n, uint8_t fir);
+static uint32_t ModelSum(const uint16_t* x, uint16_t n);
+static uint64_t ModelSumSquares(const uint16_t* x, uint16_t n);
+static int32_t  ModelFir(const int16_t* coeffs, const uint16_t* x, uint16_t taps);
+static int16_t  ModelFirQ15(const int16_t* coeffs, const uint16_t* x, uint16_t taps);
+
+// Private variables
+static uint32_t TestSeed = 0x2545F491U;
+static uint16_t samples[UINT16_MAX];
+static int16_t  coeffs[TEST_LENGTH];
+
+
+int main(void){
+
+	// random full-range samples and coefficients | lengths 0 ... TEST_LENGTH, odd and even
+	for(uint32_t r = 0; r < TEST_ROUNDS; ++r){
+
+		uint16_t n = (uint16_t)(TestRandom() % (TEST_LENGTH + 1U));
+
+		for(uint16_t i = 0; i < n; ++i){
+			samples[i] = (uint16_t)TestRandom();
+			coeffs[i]  = (int16_t)TestRandom();
+		}
+
+		TestKernels(coeffs, samples, n, 0);
+
+		// right-aligned samples | full-scale coefficients up to accumulator limit, scaled coefficients beyond it
+		int32_t bound = (n <= TEST_FIR_FULL_SCALE) ? 32768 : (int32_t)(32768U * TEST_FIR_FULL_SCALE / n);
+
+		for(uint16_t i = 0; i < n; ++i){
+			samples[i] = (uint16_t)(TestRandom() & TEST_RIGHT_ALIGNED);
+			coeffs[i]  = (int16_t)((int32_t)(TestRandom() % (2U * (uint32_t)bound)) - bound);
+		}
+
+		TestKernels(coeffs, samples, n, 1);
+	}
+
+	// extremes | MSB set in every sample, odd and even lengths
+	static const uint16_t extremes[] = { 0x0000U, 0x7FFFU, 0x8000U, 0xFFF0U, 0xFFFFU };
+
+	for(uint8_t e = 0; e < sizeof(extremes) / sizeof(extremes[0]); ++e){
+		for(uint16_t n = 0; n <= 33U; ++n){
+			for(uint16_t i = 0; i < n; ++i){
+				samples[i] = extremes[e];
+				coeffs[i]  = (i & 1U) ? INT16_MIN : INT16_MAX;
+			}
+
+			TestKernels(coeffs, samples, n, 0);
+		}
+	}
+
+	// documented limit of ADC_DspFir | 16 full-scale taps of the highest right-aligned sample, both signs
+	for(uint16_t n = 1; n <= TEST_FIR_FULL_SCALE; ++n){
+		for(uint16_t i = 0; i < n; ++i){
+			samples[i] = TEST_RIGHT_ALIGNED;
+			coeffs[i]  = INT16_MIN;
+		}
+
+		TestKernels(coeffs, samples, n, 1);
+
+		for(uint16_t i = 0; i < n; ++i){
+			coeffs[i] = INT16_MAX;
+		}
+
+		TestKernels(coeffs, samples, n, 1);
+	}
+
+	// the longest array | 32-bit sum of 65535 full-scale samples does not wrap
+	for(uint32_t i = 0; i < UINT16_MAX; ++i){
+		samples[i] = 0xFFFFU;
+	}
+
+	TEST_ASSERT_EQUAL(ModelSum(samples, UINT16_MAX),        ADC_DspSimdSum(samples, UINT16_MAX));
+	TEST_ASSERT_EQUAL(ModelSum(samples, UINT16_MAX),        ADC_DspSum(samples, UINT16_MAX));
+	TEST_ASSERT_EQUAL(ModelSumSquares(samples, UINT16_MAX), ADC_DspSimdSumSquares(samples, UINT16_MAX));
+	TEST_ASSERT_EQUAL(ModelSumSquares(samples, UINT16_MAX), ADC_DspSumSquares(samples, UINT16_MAX));
+
+	return TEST_RESULT("test_dsp");
+}
+
+
+/**
+  * @brief Kernels comparison function | failures are reported once per kernel and case to keep output short
+  * @param  coeffs  - pointer to coefficients
+  * @param  x       - pointer to samples
+  * @param  n       - number of samples and taps
+  * @param  fir     - 1: samples are right-aligned, ADC_DspFir is checked as well
+  */
+static void TestKernels(const int16_t* coeffs, const uint16_t* x, uint16_t n, uint8_t fir){
+
+	static uint8_t reported[8];
+
+	uint8_t ok[8] = {
+		ADC_DspSimdSum(x, n)               == ModelSum(x, n),
+		ADC_DspSum(x, n)                   == ModelSum(x, n),
+		ADC_DspSimdSumSquares(x, n)        == ModelSumSquares(x, n),
+		ADC_DspSumSquares(x, n)            == ModelSumSquares(x, n),
+		ADC_DspSimdFirQ15(coeffs, x, n)    == ModelFirQ15(coeffs, x, n),
+		ADC_DspFirQ15(coeffs, x, n)        == ModelFirQ15(coeffs, x, n),
+		!fir || ADC_DspSimdFir(coeffs, x, n) == ModelFir(coeffs, x, n),
+		!fir || ADC_DspFir(coeffs, x, n)     == ModelFir(coeffs, x, n)
+	};
+
+	static const char* names[8] = { "simd sum", "sum", "simd squares", "squares", "simd q15", "q15", "simd fir", "fir" };
+
+	for(uint8_t k = 0; k < 8U; ++k){
+		TestChecks++;
+
+		if(ok[k] == 0){
+			TestFailures++;
+
+			if(reported[k] == 0){
+				reported[k] = 1;
+				printf("%s:%d: FAIL %s n=%u fir=%u\n", __FILE__, __LINE__, names[k], (unsigned)n, (unsigned)fir);
+			}
+		}
+	}
+}
+
+
+/**
+  * @brief Pseudo-random generator | xorshift32, deterministic across hosts
+  */
+static uint32_t TestRandom(void){
+
+	TestSeed ^= TestSeed << 13;
+	TestSeed ^= TestSeed >> 17;
+	TestSeed ^= TestSeed << 5;
+
+	return TestSeed;
+}
+
+
+/**
+  * @brief Exact models | 64-bit arithmetic, no SIMD tricks
+  */
+static uint32_t ModelSum(const uint16_t* x, uint16_t n){
+
+	uint64_t sum = 0;
+
+	for(uint32_t i = 0; i < n; ++i){
+		sum += x[i];
+	}
+
+	return (uint32_t)sum;
+}
+
+static uint64_t ModelSumSquares(const uint16_t* x, uint16_t n){
+
+	uint64_t sum = 0;
+
+	for(uint32_t i = 0; i < n; ++i){
+		sum += (uint64_t)x[i] * x[i];
+	}
+
+	return sum;
+}
+
+static int32_t ModelFir(const int16_t* coeffs, const uint16_t* x, uint16_t taps){
+
+	int64_t acc = 0;
+
+	for(uint32_t i = 0; i < taps; ++i){
+		acc += (int64_t)coeffs[i] * x[i];
+	}
+
+	return (int32_t)(acc >> 15);
+}
+
+static int16_t ModelFirQ15(const int16_t* coeffs, const uint16_t* x, uint16_t taps){
+
+	int64_t acc = 0;
+
+	for(uint32_t i = 0; i < taps; ++i){
+		acc += (int64_t)coeffs[i] * ((int32_t)x[i] - 32768);
+	}
+
+	acc >>= 15;
+
+	return (acc > INT16_MAX) ? INT16_MAX : (acc < INT16_MIN) ? INT16_MIN : (int16_t)acc;
+}
@@ -0,0 +1,425 @@
+/**
+  ******************************************************************************
+  * @file      test_families.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of family macros of driver against register stubs
+  * @brief     This file contains checks of adc_driver.c built for F3, F4, G4, L4 and H7 devices with minimal registers of
+  * 		   Tests/stubs instead of simulation (built once per family by Makefile):
+  * 		   - ADC_SetOversampling / ADC_GetOversampling round trip through real CFGR2 macros, raw OVSR field compared
+  * 		     with reference encoding (G4/L4: log2(ratio) - 1, H7: ratio - 1), rejected configurations keep CFGR2
+  * 		   - averaging offloaded to oversampler by ADC_Init
+  * 		   - __ADC_CLEAR_OVERRUN with every combination of other SR/ISR flags | only OVR is cleared
+  * 		   - dual mode detected from common CCR, not from CSR next to it
+  * 		   - overrun restart by ADC_CheckOverrun on DMA channel, DMA stream and BDMA channel (H7 ADC3) | counter of
+  * 		     used instance re-loaded, neighbouring instance untouched, OVR cleared without clearing other flags
+  ******************************************************************************
+  * @attention Registers are plain memory, so clearing of flags (F4 SR: write 0, ISR of others: write 1) is applied by
+  * 		   TestClearFlags, and conversions are stopped (ADSTART = 0) before overrun restart, which would wait for ADSTART
+  * 		   to be cleared by hardware.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_driver.h"
+#include "adc_test.h"
+#include <string.h>
+
+// Private Macros
+#define TEST_CHANNELS			4U
+#define TEST_UNUSED_CFGR2		(0x3UL << 9U)			// TROVS and ROVSM | kept by oversampler configuration
+
+#if defined(STM32F4_FAMILY)
+	#define TEST_NAME			"test_family_f4"
+	#define TEST_FLAGS_REG		SR
+	#define TEST_FLAGS			0x3FU					// AWD, EOC, JEOC, JSTRT, STRT, OVR
+	#define TEST_OVR			ADC_SR_OVR
+	#define TEST_WRITE_ZERO		1						// rc_w0
+	#define TEST_CTRL_REG		CR2
+	#define TEST_DMA_SETUP		(ADC_CR2_ADON | ADC_CR2_DMA | ADC_CR2_DDS | ADC_CR2_CONT)
+	#define TEST_COMMON			ADC
+	#define TEST_DUAL			ADC_CCR_MULTI
+	#define TEST_STREAM			1						// DMA instances are streams
+#else
+	#define TEST_FLAGS_REG		ISR
+	#define TEST_FLAGS			0x7FFU					// ADRDY, EOSMP, EOC, EOS, OVR, JEOC, JEOS, AWD1 - AWD3, JQOVF
+	#define TEST_OVR			ADC_ISR_OVR
+	#define TEST_WRITE_ZERO		0						// rc_w1
+	#define TEST_CTRL_REG		CFGR
+#endif
+
+#if defined(STM32F3_FAMILY)
+	#define TEST_NAME			"test_family_f3"
+	#define TEST_DMA_SETUP		(ADC_CFGR_DMAEN | ADC_CFGR_DMACFG | ADC_CFGR_CONT)
+	#define TEST_COMMON			ADC12_COMMON
+	#define TEST_DUAL			ADC_CCR_DUAL_Msk
+	#define TEST_STREAM			0
+#elif defined(STM32H7_FAMILY)
+	#define TEST_NAME			"test_family_h7"
+	#define TEST_MAX_RATIO		1024U					// reference manual | any ratio
+	#define TEST_MAX_SHIFT		11U
+	#define TEST_POW2			0
+	#define TEST_DMA_SETUP		(ADC_CFGR_DMNGT | ADC_CFGR_CONT)	// DMA circular
+	#define TEST_COMMON			__LL_ADC_COMMON_INSTANCE(ADC1)
+	#define TEST_DUAL			ADC_CCR_DUAL
+	#define TEST_STREAM			1
+#elif defined(STM32G4_FAMILY) || defined(STM32L4_FAMILY)
+	#if defined(STM32G4_FAMILY)
+		#define TEST_NAME		"test_family_g4"
+	#else
+		#define TEST_NAME		"test_family_l4"
+	#endif
+	#define TEST_MAX_RATIO		256U					// reference manual | power of 2
+	#define TEST_MAX_SHIFT		8U
+	#define TEST_POW2			1
+	#define TEST_DMA_SETUP		(ADC_CFGR_DMAEN | ADC_CFGR_DMACFG | ADC_CFGR_CONT)
+	#define TEST_COMMON			__LL_ADC_COMMON_INSTANCE(ADC1)
+	#define TEST_DUAL			ADC_CCR_DUAL
+	#define TEST_STREAM			0
+#endif
+
+// Private functions prototypes
+#if (ADC_HW_OVERSAMPLER == 1)
+static void     TestOversampling(void);
+static void     TestOffload(void);
+static uint32_t TestOvsrReference(uint16_t ratio);
+#endif
+static void     TestClearOverrun(void);
+static void     TestMultimode(void);
+static void     TestOverrunRestart(void* instance, void* neighbour);
+static void     TestSetup(void* instance);
+static uint32_t TestClearFlags(uint32_t before, uint32_t written);
+
+// Private variables
+static ADC_HandleTypeDef   hadc;
+static DMA_HandleTypeDef   hdma;
+static ADC_ChannelsTypeDef cadc;
+
+ADC_BUFFER_DEFINE_EX(badcFamily, TEST_CHANNELS, 1, 8);
+ADC_BUFFER_DEFINE(badcOffload, TEST_CHANNELS, 8);
+
+
+int main(void){
+
+	#if (ADC_HW_OVERSAMPLER == 1)
+		TestOversampling();
+		TestOffload();
+	#endif
+
+	TestClearOverrun();
+	TestMultimode();
+
+	#if defined(STM32H7_FAMILY)
+		TestOverrunRestart(DMA1_Stream0, DMA1_Stream1);		// ADC1/ADC2 | DMA1/DMA2 stream
+		TestOverrunRestart(BDMA_Channel0, BDMA_Channel1);		// ADC3 | BDMA channel
+	#elif defined(STM32F4_FAMILY)
+		TestOverrunRestart(DMA2_Stream0, DMA2_Stream1);
+	#else
+		TestOverrunRestart(DMA1_Channel1, DMA1_Channel2);
+	#endif
+
+	return TEST_RESULT(TEST_NAME);
+}
+
+
+#if (ADC_HW_OVERSAMPLER == 1)
+
+/**
+  * @brief Oversampling | every ratio and shift at every resolution, accepted configuration is encoded like reference manual
+  * 	   and read back, rejected one leaves CFGR2 untouched
+  */
+static void TestOversampling(void){
+
+	#if defined(STM32H7_FAMILY)
+		static const uint8_t resolutions[] = { 16, 14, 12, 10, 8 };
+	#else
+		static const uint8_t resolutions[] = { 12, 10, 8, 6 };
+	#endif
+
+	TEST_ASSERT_EQUAL(1, ADC_HW_OVERSAMPLER);
+	TEST_ASSERT_EQUAL(TEST_MAX_RATIO, ADC_OVERSAMPLING_MAX_RATIO);
+	TEST_ASSERT_EQUAL(TEST_MAX_SHIFT, ADC_OVERSAMPLING_MAX_SHIFT);
+
+	TestSetup(&StubDma[0]);
+
+	for(uint8_t res = 0; res < sizeof(resolutions); ++res){
+
+		uint8_t  bits = resolutions[res];
+		uint32_t full = (1UL << bits) - 1U;
+
+		__ADC_SET_RESOLUTION(&hadc, bits);
+		TEST_ASSERT_EQUAL(full, __ADC_RESOLUTION(&hadc));
+
+		for(uint16_t ratio = 1; ratio <= TEST_MAX_RATIO + 1U; ++ratio){
+			for(uint8_t shift = 0; shift <= TEST_MAX_SHIFT + 1U; ++shift){
+
+				uint8_t valid = (ratio <= TEST_MAX_RATIO) && (shift <= TEST_MAX_SHIFT) &&
+				                ((TEST_POW2 == 0) || ((ratio & (ratio - 1U)) == 0)) && (((full * ratio) >> shift) <= 0xFFFFU);
+
+				uint16_t readRatio;
+				uint8_t  readShift;
+
+				hadc.Instance->CFGR2 = TEST_UNUSED_CFGR2 | ADC_CFGR2_ROVSE | ADC_CFGR2_OVSS;	// previous configuration
+
+				HAL_StatusTypeDef status = ADC_SetOversampling(&hadc, ratio, shift);
+
+				if(valid == 0){
+					if(status != HAL_ERROR || hadc.Instance->CFGR2 != (TEST_UNUSED_CFGR2 | ADC_CFGR2_ROVSE | ADC_CFGR2_OVSS)){
+						TEST_ASSERT(status == HAL_ERROR);
+						TEST_ASSERT_EQUAL(TEST_UNUSED_CFGR2 | ADC_CFGR2_ROVSE | ADC_CFGR2_OVSS, hadc.Instance->CFGR2);
+					}
+					continue;
+				}
+
+				uint32_t expected = TEST_UNUSED_CFGR2;
+
+				if(ratio > 1U){
+					expected |= ADC_CFGR2_ROVSE | (TestOvsrReference(ratio) << ADC_CFGR2_OVSR_Pos) | ((uint32_t)shift << ADC_CFGR2_OVSS_Pos);
+				}
+
+				TEST_ASSERT(ADC_GetOversampling(&hadc, &readRatio, &readShift) == HAL_OK);
+
+				// single check per configuration | failures print raw register
+				if(status != HAL_OK || hadc.Instance->CFGR2 != expected || readRatio != ratio || readShift != ((ratio > 1U) ? shift : 0U)){
+					TEST_ASSERT(status == HAL_OK);
+					TEST_ASSERT_EQUAL(expected, hadc.Instance->CFGR2);
+					TEST_ASSERT_EQUAL(ratio, readRatio);
+					TEST_ASSERT_EQUAL((ratio > 1U) ? shift : 0U, readShift);
+				}
+			}
+		}
+	}
+
+	TEST_ASSERT(ADC_SetOversampling(&hadc, 0, 0) == HAL_ERROR);
+
+	// conversions in progress | oversampler is not written
+	hadc.Instance->CFGR2 = 0;
+	SET_BIT(hadc.Instance->CR, ADC_CR_ADSTART);
+
+	TEST_ASSERT(ADC_SetOversampling(&hadc, 4, 1) == HAL_BUSY);
+	TEST_ASSERT_EQUAL(0, hadc.Instance->CFGR2);
+}
+
+
+/**
+  * @brief Offload | ADC_Init programs oversampler with unshifted ratio of averaged measures and sizes storage to single scan
+  */
+static void TestOffload(void){
+
+	uint16_t ratio;
+	uint8_t  shift;
+
+	#if defined(STM32H7_FAMILY)
+		TestSetup(DMA1_Stream0);
+		hadc.Init.Resolution = ADC_RESOLUTION_12B;			// 16-bit sum of 8 measures fits storage up to 13 bits
+	#else
+		TestSetup(DMA1_Channel1);
+	#endif
+
+	TEST_ASSERT(ADC_Init(&hadc, &badcOffload, &cadc) == HAL_OK);
+
+	TEST_ASSERT(ADC_GetOversampling(&hadc, &ratio, &shift) == HAL_OK);
+	TEST_ASSERT_EQUAL(8, ratio);
+	TEST_ASSERT_EQUAL(0, shift);
+	TEST_ASSERT_EQUAL(TestOvsrReference(8), (hadc.Instance->CFGR2 & ADC_CFGR2_OVSR) >> ADC_CFGR2_OVSR_Pos);
+	TEST_ASSERT(__ADC_IS_HW_AVERAGING(&hadc, &badcOffload));
+	TEST_ASSERT_EQUAL(badcOffload.BufferLength, __HAL_DMA_GET_COUNTER(&hdma));
+}
+
+#endif
+
+
+/**
+  * @brief Overrun flag | clearing OVR keeps every combination of other flags, which are serviced by HAL and DMA
+  */
+static void TestClearOverrun(void){
+
+	TestSetup(&StubDma[0]);
+
+	for(uint32_t others = 0; others <= TEST_FLAGS; ++others){
+
+		if((others & TEST_OVR) != 0U){
+			continue;
+		}
+
+		uint32_t before = others | TEST_OVR;
+
+		hadc.Instance->TEST_FLAGS_REG = before;
+		TEST_ASSERT_EQUAL(1, __ADC_IS_OVERRUN(&hadc));
+
+		__ADC_CLEAR_OVERRUN(&hadc);
+		hadc.Instance->TEST_FLAGS_REG = TestClearFlags(before, hadc.Instance->TEST_FLAGS_REG);
+
+		// single check per combination | failures print raw register
+		if(hadc.Instance->TEST_FLAGS_REG != others || __ADC_IS_OVERRUN(&hadc) != 0U){
+			TEST_ASSERT_EQUAL(others, hadc.Instance->TEST_FLAGS_REG);
+			TEST_ASSERT_EQUAL(0, __ADC_IS_OVERRUN(&hadc));
+		}
+	}
+
+	hadc.Instance->TEST_FLAGS_REG = TEST_FLAGS & ~TEST_OVR;
+	TEST_ASSERT_EQUAL(0, __ADC_IS_OVERRUN(&hadc));
+}
+
+
+/**
+  * @brief Dual mode | detected from DUAL/MULTI field of common CCR only, status register of common block is ignored
+  */
+static void TestMultimode(void){
+
+	TestSetup(&StubDma[0]);
+
+	TEST_COMMON->CSR = 0xFFFFFFFFU;
+	TEST_ASSERT_EQUAL(0, __ADC_IS_DMA_MULTIMODE(&hadc));
+
+	TEST_COMMON->CCR = 0x6U & TEST_DUAL;						// regular simultaneous mode
+	TEST_ASSERT_EQUAL(1, __ADC_IS_DMA_MULTIMODE(&hadc));
+
+	TEST_COMMON->CCR = (uint32_t)~TEST_DUAL;
+	TEST_ASSERT_EQUAL(0, __ADC_IS_DMA_MULTIMODE(&hadc));
+}
+
+
+/**
+  * @brief Overrun restart | fast path re-loads counter of DMA instance serving ADC, re-enables it and starts conversions
+  * @param  instance  - DMA channel, stream or BDMA channel of ADC
+  * @param  neighbour - following instance of the same controller | has to stay untouched
+  */
+static void TestOverrunRestart(void* instance, void* neighbour){
+
+	uint8_t before[32];											// copy of neighbour | larger than any channel or stream
+	size_t  size = (size_t)((uint8_t*)neighbour - (uint8_t*)instance);
+
+	TestSetup(instance);
+
+	TEST_ASSERT(ADC_Init(&hadc, &badcFamily, &cadc) == HAL_OK);
+	TEST_ASSERT_EQUAL(badcFamily.BufferLength, __HAL_DMA_GET_COUNTER(&hdma));
+
+	// overrun | conversions stopped, DMA counter in the middle of storage
+	__HAL_DMA_SET_COUNTER(&hdma, 5U);
+	#if !defined(STM32F4_FAMILY)
+		CLEAR_BIT(hadc.Instance->CR, ADC_CR_ADSTART);
+	#endif
+
+	uint32_t flags = TEST_FLAGS;
+
+	hadc.Instance->TEST_FLAGS_REG = flags;
+	memset(neighbour, 0xA5, size);
+	memcpy(before, neighbour, size);
+
+	TEST_ASSERT(ADC_CheckOverrun(&hadc, &badcFamily) == HAL_BUSY);
+
+	// OVR cleared | other flags stay set
+	TEST_ASSERT_EQUAL(flags & ~TEST_OVR, TestClearFlags(flags, hadc.Instance->TEST_FLAGS_REG));
+
+	TEST_ASSERT_EQUAL(1, badcFamily.Overruns);
+	TEST_ASSERT_EQUAL(1, badcFamily.Discontinuous);
+	TEST_ASSERT_EQUAL(badcFamily.BufferLength, __HAL_DMA_GET_COUNTER(&hdma));
+	TEST_ASSERT(memcmp(before, neighbour, size) == 0);
+	TEST_ASSERT_EQUAL(HAL_DMA_STATE_BUSY, hdma.State);
+
+	// DMA requests restarted | F4 toggles DMA bit, others issue ADSTART
+	#if defined(STM32F4_FAMILY)
+		TEST_ASSERT(READ_BIT(hadc.Instance->CR2, ADC_CR2_DMA) != 0U);
+	#else
+		TEST_ASSERT(READ_BIT(hadc.Instance->CR, ADC_CR_ADSTART) != 0U);
+	#endif
+
+	#if defined(STM32H7_FAMILY)
+		if(IS_BDMA_CHANNEL_INSTANCE(instance)){
+			TEST_ASSERT_EQUAL(badcFamily.BufferLength, ((BDMA_Channel_TypeDef*)instance)->CNDTR);
+			TEST_ASSERT(READ_BIT(((BDMA_Channel_TypeDef*)instance)->CCR, BDMA_CCR_EN) != 0U);
+
+			// BDMA channel is disabled immediately | no wait on enable bit, which is still set in plain memory
+			__ADC_DMA_WAIT_DISABLED(&hdma);
+			__ADC_DMA_SET_COUNTER(&hdma, 7U);
+			TEST_ASSERT_EQUAL(7, ((BDMA_Channel_TypeDef*)instance)->CNDTR);
+		}else{
+			TEST_ASSERT_EQUAL(badcFamily.BufferLength, ((DMA_Stream_TypeDef*)instance)->NDTR);
+			TEST_ASSERT(READ_BIT(((DMA_Stream_TypeDef*)instance)->CR, DMA_SxCR_EN) != 0U);
+		}
+	#elif (TEST_STREAM == 1)
+		TEST_ASSERT(READ_BIT(((DMA_Stream_TypeDef*)instance)->CR, DMA_SxCR_EN | DMA_IT_TC | DMA_IT_HT | DMA_IT_TE) ==
+		            (DMA_SxCR_EN | DMA_IT_TC | DMA_IT_HT | DMA_IT_TE));
+	#else
+		TEST_ASSERT(READ_BIT(((DMA_Channel_TypeDef*)instance)->CCR, DMA_CCR_EN | DMA_IT_TC | DMA_IT_HT | DMA_IT_TE) ==
+		            (DMA_CCR_EN | DMA_IT_TC | DMA_IT_HT | DMA_IT_TE));
+	#endif
+
+	badcFamily.Overruns      = 0;
+	badcFamily.Discontinuous = 0;
+}
+
+
+/**
+  * @brief Setup function, configures circular DMA scan of 4 channels on cleared registers of ADC1
+  * @param  instance - DMA channel, stream or BDMA channel of ADC
+  */
+static void TestSetup(void* instance){
+
+	StubReset();
+
+	memset(&hadc, 0, sizeof(hadc));
+	memset(&hdma, 0, sizeof(hdma));
+	memset(&cadc, 0, sizeof(cadc));
+
+	hadc.Instance              = ADC1;
+	hadc.DMA_Handle            = &hdma;
+	hdma.Instance              = instance;
+	hdma.Parent                = &hadc;
+	hdma.Init.Mode             = DMA_CIRCULAR;
+	hdma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	hdma.State                 = HAL_DMA_STATE_READY;
+
+	#if defined(STM32H7_FAMILY)
+		hadc.Init.Resolution = ADC_RESOLUTION_16B;
+	#endif
+
+	ADC1->TEST_CTRL_REG = TEST_DMA_SETUP;
+	ADC1->SQR1          = (TEST_CHANNELS - 1U) << ADC_SQR1_L_Pos;
+}
+
+
+#if (ADC_HW_OVERSAMPLER == 1)
+
+/**
+  * @brief Reference encoding of OVSR field | reference manuals of G4/L4 (RM0440, RM0351) and H7 (RM0433)
+  * @param  ratio - oversampling ratio
+  * @retval ovsr  - raw field value
+  */
+static uint32_t TestOvsrReference(uint16_t ratio){
+
+	#if defined(STM32H7_FAMILY)
+		return (uint32_t)ratio - 1U;							// 0: x1, 1: x2, ... 1023: x1024
+	#else
+		uint32_t log2 = 0;
+
+		while((1UL << (log2 + 1U)) <= ratio){
+			log2++;
+		}
+
+		return log2 - 1U;										// 000: x2, 001: x4, ... 111: x256
+	#endif
+}
+
+#endif
+
+
+/**
+  * @brief Clear semantics of status register | F4 SR (rc_w0): flags written with 0 are cleared, ISR of others (rc_w1):
+  * 	   flags written with 1 are cleared, other flags are kept
+  * @param  before  - flags before write
+  * @param  written - value written to register (plain memory)
+  * @retval flags   - flags of hardware after write
+  */
+static uint32_t TestClearFlags(uint32_t before, uint32_t written){
+
+	#if (TEST_WRITE_ZERO == 1)
+		return before & written;
+	#else
+		return before & ~written;
+	#endif
+}
@@ -0,0 +1,181 @@
+/**
+  ******************************************************************************
+  * @file      test_history.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of equivalence of word-wide and reference history transposition
+  * @brief     This file contains comparison of adc_history.c built twice: reference push (sample by sample) and push with
+  * 		   PKHBT/PKHTB transposition of pairs of scans with emulated intrinsics (ADC_DSP_EMULATE, renamed to
+  * 		   ADC_HistorySimd* by Makefile). Both are checked against model of interleaved stream on random blocks:
+  * 		   - odd and even number of channels, depths 2 ... 64, blocks ending inside scan, misaligned blocks
+  * 		   - storage of both builds identical after every push, windows of every rank equal to latest complete scans
+  * 		     (whole-depth window of block ended inside scan holds sample of scan in progress, as documented)
+  ******************************************************************************
+  * @attention Word-wide path runs only for even number of channels, aligned block, scan boundary and even head, so number
+  * 		   of pushes meeting these conditions is checked too.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_history.h"
+#include "adc_test.h"
+#include <string.h>
+
+// Private Macros
+#define TEST_CHANNELS			8U						// the most channels of random history
+#define TEST_DEPTH				64U						// the deepest random history
+#define TEST_BLOCK				96U						// the longest random block [transfers]
+#define TEST_STREAM				4096U					// samples pushed per round
+#define TEST_ROUNDS				300U
+
+// Word-wide history | adc_history.c built with ADC_DSP_EMULATE and renamed symbols
+HAL_StatusTypeDef ADC_HistorySimdInit(ADC_HistoryTypeDef* hist, uint16_t* storage, uint8_t channels, uint16_t depth);
+HAL_StatusTypeDef ADC_HistorySimdPush(ADC_HistoryTypeDef* hist, const uint16_t* block, uint16_t transfers);
+const uint16_t*   ADC_HistorySimdWindow(ADC_HistoryTypeDef* hist, uint8_t rank, uint16_t samples);
+
+// Private functions prototypes
+static uint32_t TestRandom(void);
+static void     TestRound(uint8_t channels, uint16_t depth);
+static void     TestCompare(uint8_t channels, uint16_t depth, uint32_t pushed);
+
+// Private variables
+static uint32_t TestSeed = 0x6C8E9CF5U;
+static unsigned widePushes;								// pushes meeting conditions of word-wide path
+static uint8_t  offset;									// first pushed half-word of stream | 1: blocks start at odd half-word
+
+static uint16_t stream[TEST_STREAM + 2U] __attribute__((aligned(4)));	// interleaved samples | 2 spare for misalignment
+static uint16_t storageRef[ADC_HISTORY_STORAGE_LENGTH(TEST_CHANNELS, TEST_DEPTH)]  __attribute__((aligned(4)));
+static uint16_t storageSimd[ADC_HISTORY_STORAGE_LENGTH(TEST_CHANNELS, TEST_DEPTH)] __attribute__((aligned(4)));
+
+static ADC_HistoryTypeDef histRef;
+static ADC_HistoryTypeDef histSimd;
+
+
+int main(void){
+
+	static const uint16_t depths[] = { 2, 4, 8, 16, 32, 64 };
+
+	// rejected parameters | depth not power of 2, too many channels
+	TEST_ASSERT(ADC_HistorySimdInit(&histSimd, storageSimd, 4, 12) == HAL_ERROR);
+	TEST_ASSERT(ADC_HistorySimdInit(&histSimd, storageSimd, ADC_MAX_CHANNELS + 1U, 8) == HAL_ERROR);
+	TEST_ASSERT(ADC_HistorySimdPush(&histSimd, NULL, 4) == HAL_ERROR);
+
+	for(uint32_t r = 0; r < TEST_ROUNDS; ++r){
+
+		uint8_t  channels = (uint8_t)(1U + TestRandom() % TEST_CHANNELS);
+		uint16_t depth    = depths[TestRandom() % (sizeof(depths) / sizeof(depths[0]))];
+
+		TestRound(channels, depth);
+	}
+
+	// every channel count and depth with whole aligned pairs of scans only | word-wide path from first push
+	for(uint8_t channels = 2; channels <= TEST_CHANNELS; channels += 2U){
+		TestRound(channels, 2);
+	}
+
+	TEST_ASSERT(widePushes > TEST_ROUNDS);
+
+	return TEST_RESULT("test_history");
+}
+
+
+/**
+  * @brief Round function, pushes random blocks of random stream to both builds and compares them after every push
+  * @param  channels - number of converted channels
+  * @param  depth    - samples kept per channel
+  */
+static void TestRound(uint8_t channels, uint16_t depth){
+
+	memset(storageRef,  0, sizeof(storageRef));
+	memset(storageSimd, 0, sizeof(storageSimd));
+
+	TEST_ASSERT(ADC_HistoryInit(&histRef, storageRef, channels, depth) == HAL_OK);
+	TEST_ASSERT(ADC_HistorySimdInit(&histSimd, storageSimd, channels, depth) == HAL_OK);
+
+	for(uint32_t i = 0; i < TEST_STREAM + 2U; ++i){
+		stream[i] = (uint16_t)TestRandom();
+	}
+
+	uint32_t pushed = 0;
+
+	offset = (uint8_t)(TestRandom() & 1U);
+
+	while(pushed + TEST_BLOCK <= TEST_STREAM){
+
+		// whole pairs of scans in half of pushes | word-wide path, otherwise any length
+		uint16_t transfers = (TestRandom() & 1U) ? (uint16_t)(2U * channels * (1U + TestRandom() % 4U))
+		                                         : (uint16_t)(TestRandom() % (TEST_BLOCK + 1U));
+
+		if(transfers > TEST_BLOCK){
+			transfers = 2U * channels;
+		}
+
+		const uint16_t* block = &stream[offset + pushed];
+
+		if(histSimd.Rank == 0 && (channels & 1U) == 0 && (histSimd.Head & 1U) == 0 && ((uintptr_t)block & 3U) == 0 &&
+		   transfers >= 2U * channels){
+			widePushes++;
+		}
+
+		TEST_ASSERT(ADC_HistoryPush(&histRef, block, transfers) == HAL_OK);
+		TEST_ASSERT(ADC_HistorySimdPush(&histSimd, block, transfers) == HAL_OK);
+
+		pushed += transfers;
+
+		TestCompare(channels, depth, pushed);
+	}
+}
+
+
+/**
+  * @brief Compare function, checks state and storage of both builds and windows of every rank against interleaved stream
+  * @param  channels - number of converted channels
+  * @param  depth    - samples kept per channel
+  * @param  pushed   - number of pushed samples
+  */
+static void TestCompare(uint8_t channels, uint16_t depth, uint32_t pushed){
+
+	uint32_t scans   = pushed / channels;
+	uint16_t samples = (scans < depth) ? (uint16_t)scans : depth;
+	uint32_t base    = (scans - samples) * channels;		// first sample of oldest scan in windows
+
+	TEST_ASSERT_EQUAL(scans, histRef.Scans);
+	TEST_ASSERT_EQUAL(histRef.Scans, histSimd.Scans);
+	TEST_ASSERT_EQUAL(histRef.Head,  histSimd.Head);
+	TEST_ASSERT_EQUAL(histRef.Rank,  histSimd.Rank);
+	TEST_ASSERT(memcmp(storageRef, storageSimd, ADC_HISTORY_STORAGE_LENGTH(channels, depth) * sizeof(uint16_t)) == 0);
+
+	for(uint8_t r = 0; r < channels; ++r){
+
+		const uint16_t* window = ADC_HistorySimdWindow(&histSimd, r, samples);
+
+		// window of whole depth after block ended inside scan | oldest sample of ranks below Rank is replaced by scan in progress
+		uint16_t first = (samples == depth && r < histSimd.Rank) ? 1U : 0U;
+
+		if(first != 0){
+			TEST_ASSERT_EQUAL(stream[offset + scans * channels + r], window[0]);
+		}
+
+		for(uint16_t k = first; k < samples; ++k){
+			if(window[k] != stream[offset + base + (uint32_t)k * channels + r]){
+				TEST_ASSERT_EQUAL(stream[offset + base + (uint32_t)k * channels + r], window[k]);
+			}
+		}
+	}
+}
+
+
+/**
+  * @brief Pseudo-random generator | xorshift32
+  */
+static uint32_t TestRandom(void){
+
+	TestSeed ^= TestSeed << 13;
+	TestSeed ^= TestSeed >> 17;
+	TestSeed ^= TestSeed << 5;
+
+	return TestSeed;
+}
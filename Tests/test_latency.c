@@ -0,0 +1,256 @@
+/**
+  ******************************************************************************
+  * @file      test_latency.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of block latency tracking
+  * @brief     This file contains checks of adc_latency.c statistics with virtual clock and known stamps:
+  * 		   - log2 histogram bins, min, max, mean and deadline misses of marked latencies
+  * 		   - ADC_LatencyPercentile bounds, limited to maximal latency, overflow to last bin
+  * 		   - latency across wrap of 32-bit time, ADC_LatencyConsume against latest capture
+  * 		   - ADC_LatencyFormat lines of used stages, truncation, ADC_LatencyReset keeping names and deadlines
+  ******************************************************************************
+  * @attention Virtual clock is set by test before every capture and mark, so every latency is exact.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_latency.h"
+#include "adc_test.h"
+#include <string.h>
+
+// Private Macros
+#define TEST_FILTER				0U						// stage indices
+#define TEST_CONSUMER			1U
+#define TEST_DEADLINE			2000U					// deadline of filter stage [cycles]
+
+// Private functions prototypes
+static uint32_t TestClock(void);
+static void     TestMark(uint32_t capture, uint32_t latency, uint32_t times);
+static void     TestHistogram(void);
+static void     TestPercentile(void);
+static void     TestWrapAndConsume(void);
+static void     TestFormat(void);
+
+// Private variables
+static ADC_LatencyTypeDef lat;
+
+static uint32_t now;									// virtual time [cycles]
+
+
+int main(void){
+
+	TestHistogram();
+	TestPercentile();
+	TestWrapAndConsume();
+	TestFormat();
+
+	return TEST_RESULT("test_latency");
+}
+
+
+/**
+  * @brief Histogram | latency of k bits lands in bin k, latency 0 in bin 0, deadline is exclusive
+  */
+static void TestHistogram(void){
+
+	ADC_LatencyStageTypeDef st;
+
+	TEST_ASSERT(ADC_LatencyInit(NULL, TestClock) == HAL_ERROR);
+	TEST_ASSERT(ADC_LatencyInit(&lat, TestClock) == HAL_OK);
+	TEST_ASSERT(ADC_LatencyConfigStage(&lat, ADC_LATENCY_MAX_STAGES, "bad", 0) == HAL_ERROR);
+	TEST_ASSERT(ADC_LatencyConfigStage(&lat, TEST_FILTER, "filter", TEST_DEADLINE) == HAL_OK);
+
+	TestMark(500U, 0U,    1);							// bin 0
+	TestMark(500U, 1U,    1);							// bin 1 | [1, 2)
+	TestMark(500U, 127U,  1);							// bin 7 | [64, 128)
+	TestMark(500U, 128U,  1);							// bin 8 | [128, 256)
+	TestMark(500U, 2000U, 1);							// at deadline | not missed
+	TestMark(500U, 2001U, 1);							// bin 11 | missed
+
+	TEST_ASSERT(ADC_LatencyGetStage(&lat, TEST_FILTER, &st) == HAL_OK);
+	TEST_ASSERT(ADC_LatencyGetStage(&lat, ADC_LATENCY_MAX_STAGES, &st) == HAL_ERROR);
+
+	TEST_ASSERT_EQUAL(6, st.Count);
+	TEST_ASSERT_EQUAL(1, st.Misses);
+	TEST_ASSERT_EQUAL(0, st.Min);
+	TEST_ASSERT_EQUAL(2001U, st.Max);
+	TEST_ASSERT_EQUAL(0U + 1U + 127U + 128U + 2000U + 2001U, st.Sum);
+
+	TEST_ASSERT_EQUAL(1, st.Bins[0]);
+	TEST_ASSERT_EQUAL(1, st.Bins[1]);
+	TEST_ASSERT_EQUAL(1, st.Bins[7]);
+	TEST_ASSERT_EQUAL(1, st.Bins[8]);
+	TEST_ASSERT_EQUAL(2, st.Bins[11]);					// [1024, 2048)
+
+	uint32_t total = 0;
+
+	for(uint8_t k = 0; k < ADC_LATENCY_BINS; ++k){
+		total += st.Bins[k];
+	}
+
+	TEST_ASSERT_EQUAL(st.Count, total);
+
+	// latency above range of histogram | counted in last bin
+	TestMark(500U, 1UL << 30, 1);
+	ADC_LatencyGetStage(&lat, TEST_FILTER, &st);
+
+	TEST_ASSERT_EQUAL(1, st.Bins[ADC_LATENCY_BINS - 1U]);
+	TEST_ASSERT_EQUAL(1UL << 30, st.Max);
+	TEST_ASSERT_EQUAL(2, st.Misses);
+}
+
+
+/**
+  * @brief Percentile | upper bound of bin holding percentile, limited to maximal latency
+  */
+static void TestPercentile(void){
+
+	ADC_LatencyStageTypeDef st;
+
+	ADC_LatencyReset(&lat);
+	ADC_LatencyGetStage(&lat, TEST_FILTER, &st);
+
+	TEST_ASSERT_EQUAL(0, ADC_LatencyPercentile(&st, 990));
+
+	// 90 blocks of 100 cycles, 9 of 1000, 1 of 5000
+	TestMark(0U, 100U,  90);
+	TestMark(0U, 1000U, 9);
+	TestMark(0U, 5000U, 1);
+
+	ADC_LatencyGetStage(&lat, TEST_FILTER, &st);
+
+	TEST_ASSERT_EQUAL(100, st.Count);
+	TEST_ASSERT_EQUAL(1, st.Misses);
+	TEST_ASSERT_EQUAL(90, st.Bins[7]);
+	TEST_ASSERT_EQUAL(9, st.Bins[10]);
+	TEST_ASSERT_EQUAL(1, st.Bins[13]);
+
+	TEST_ASSERT_EQUAL(127U,  ADC_LatencyPercentile(&st, 500));	// [64, 128)
+	TEST_ASSERT_EQUAL(127U,  ADC_LatencyPercentile(&st, 900));
+	TEST_ASSERT_EQUAL(1023U, ADC_LatencyPercentile(&st, 901));	// 91st block | [512, 1024)
+	TEST_ASSERT_EQUAL(1023U, ADC_LatencyPercentile(&st, 990));
+	TEST_ASSERT_EQUAL(5000U, ADC_LatencyPercentile(&st, 1000));	// bound 8191 limited to maximum
+	TEST_ASSERT_EQUAL(0U,    ADC_LatencyPercentile(&st, 0));	// first non-empty bin not required
+
+	// single latency in last bin | percentile is maximum
+	ADC_LatencyReset(&lat);
+	TestMark(0U, 0xFFFFFFF0U, 1);
+	ADC_LatencyGetStage(&lat, TEST_FILTER, &st);
+
+	TEST_ASSERT_EQUAL(0xFFFFFFF0U, ADC_LatencyPercentile(&st, 990));
+}
+
+
+/**
+  * @brief Wrap and consume | latency is exact across wrap of 32-bit time, consumer marks against latest capture
+  */
+static void TestWrapAndConsume(void){
+
+	ADC_LatencyStageTypeDef st;
+
+	ADC_LatencyReset(&lat);
+	ADC_LatencyConfigStage(&lat, TEST_CONSUMER, "consumer", 0);
+
+	now = 0xFFFFFFF0U;
+	uint32_t capture = ADC_LatencyCapture(&lat);
+
+	now = 0x10U;
+	TEST_ASSERT_EQUAL(0x20U, ADC_LatencyMark(&lat, TEST_FILTER, capture));
+	TEST_ASSERT_EQUAL(0, ADC_LatencyMark(&lat, ADC_LATENCY_MAX_STAGES, capture));
+
+	now = 0x100U;
+	ADC_LatencyCapture(&lat);
+
+	now = 0x150U;
+	TEST_ASSERT_EQUAL(0x50U, ADC_LatencyConsume(&lat, TEST_CONSUMER));
+
+	TEST_ASSERT_EQUAL(2, lat.Captures);
+	TEST_ASSERT_EQUAL(0x100U, lat.LastCapture);
+
+	// consumer without deadline | never missed
+	now = 0x100000U;
+	ADC_LatencyConsume(&lat, TEST_CONSUMER);
+	ADC_LatencyGetStage(&lat, TEST_CONSUMER, &st);
+
+	TEST_ASSERT_EQUAL(2, st.Count);
+	TEST_ASSERT_EQUAL(0, st.Misses);
+	TEST_ASSERT_EQUAL(0x50U, st.Min);
+	TEST_ASSERT_EQUAL(0x100000U - 0x100U, st.Max);
+}
+
+
+/**
+  * @brief Text export | configured or marked stages only, values of known stamps, truncation to size
+  */
+static void TestFormat(void){
+
+	char     text[256];
+	uint16_t length;
+
+	ADC_LatencyReset(&lat);
+
+	TestMark(0U, 100U,  90);
+	TestMark(0U, 1000U, 9);
+	TestMark(0U, 5000U, 1);
+
+	// mean = (90 * 100 + 9 * 1000 + 5000) / 100 | stage 2 never used, stage 3 marked without name
+	static const char expected[] = "filter n=100 min=100 avg=230 p99=1023 max=5000 miss=1/2000\r\n"
+	                               "consumer n=0 min=0 avg=0 p99=0 max=0 miss=0/0\r\n"
+	                               "stage n=1 min=7 avg=7 p99=7 max=7 miss=0/0\r\n";
+
+	now = 7U;
+	ADC_LatencyMark(&lat, 3U, 0U);
+
+	length = ADC_LatencyFormat(&lat, text, sizeof(text));
+
+	TEST_ASSERT_EQUAL(strlen(expected), length);
+	TEST_ASSERT(strcmp(text, expected) == 0);
+
+	// truncated inside second line
+	memset(text, 'x', sizeof(text));
+	length = ADC_LatencyFormat(&lat, text, 70U);
+
+	TEST_ASSERT_EQUAL(69, length);
+	TEST_ASSERT_EQUAL('\0', text[69]);
+	TEST_ASSERT(strncmp(text, expected, 69) == 0);
+	TEST_ASSERT_EQUAL('x', text[70]);
+
+	TEST_ASSERT_EQUAL(0, ADC_LatencyFormat(&lat, text, 0U));
+	TEST_ASSERT_EQUAL(0, ADC_LatencyFormat(&lat, NULL, sizeof(text)));
+
+	// reset keeps names and deadlines
+	ADC_LatencyReset(&lat);
+	ADC_LatencyFormat(&lat, text, sizeof(text));
+
+	TEST_ASSERT(strcmp(text, "filter n=0 min=0 avg=0 p99=0 max=0 miss=0/2000\r\n"
+	                         "consumer n=0 min=0 avg=0 p99=0 max=0 miss=0/0\r\n") == 0);
+}
+
+
+/**
+  * @brief Virtual clock of latency tracker
+  */
+static uint32_t TestClock(void){
+
+	return now;
+}
+
+
+/**
+  * @brief Mark function, marks filter stage with known latency
+  * @param  capture - capture stamp
+  * @param  latency - time of mark since capture [cycles]
+  * @param  times   - number of marks
+  */
+static void TestMark(uint32_t capture, uint32_t latency, uint32_t times){
+
+	now = capture + latency;
+
+	for(uint32_t i = 0; i < times; ++i){
+		TEST_ASSERT_EQUAL(latency, ADC_LatencyMark(&lat, TEST_FILTER, capture));
+	}
+}
@@ -0,0 +1,295 @@
+/**
+  ******************************************************************************
+  * @file      test_modbus.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of Modbus RTU slave frame handling
+  * @brief     This file contains request frames fed to adc_modbus.c through ADC_ModbusRxEvent, as UART idle-line reception
+  * 		   would deliver them, and checks of transmitted responses and counters:
+  * 		   - valid read of input registers, answered with image of simulated ADC
+  * 		   - wrong CRC and too short frame, dropped without response
+  * 		   - other slave address and broadcast, ignored without response
+  * 		   - unsupported function, exception 0x01
+  * 		   - register range beyond image, exception 0x02
+  * 		   - quantity 0 or above 125 and wrong length of request, exception 0x03
+  ******************************************************************************
+  * @attention UART HAL functions are stubbed, transmission is captured and completed at once. ADC runs on simulation
+  * 		   with 4 channels at constant levels, so served values are exact. Served context is taken from context pool
+  * 		   (ADC_ContextCreate).
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_sim.h"
+#include "adc_context.h"
+#include "adc_modbus.h"
+#include "adc_test.h"
+#include <string.h>
+
+// Private Macros
+#define TEST_ADDRESS			17U
+#define TEST_CHANNELS			4U
+
+// Private functions prototypes
+static void     TestSetup(void);
+static uint16_t TestRequest(const uint8_t* frame, uint16_t size, uint8_t corruptCrc);
+static void     TestException(const uint8_t* frame, uint16_t size, uint8_t function, uint8_t code);
+static uint16_t TestRegister(uint16_t index);
+
+// Private variables
+static const uint8_t TEST_SCAN[TEST_CHANNELS] = { 5, 7, 2, 9 };	// channels in rank order
+
+static ADC_SimTypeDef      sim;
+static ADC_HandleTypeDef   hadc;
+static DMA_HandleTypeDef   hdma;
+static ADC_ChannelsTypeDef cadc;
+static ADC_ContextTypeDef* ctx;						// from context pool (ADC_ContextCreate)
+
+static ADC_ModbusTypeDef   mb;
+static UART_HandleTypeDef  huart;
+static DMA_HandleTypeDef   hdmaRx;
+static DMA_HandleTypeDef   hdmaTx;
+static DMA_Channel_TypeDef channelRx;
+static DMA_Channel_TypeDef channelTx;
+
+static uint8_t  response[ADC_MODBUS_FRAME_SIZE];		// last transmitted frame
+static uint16_t responseLength;
+static uint8_t  receiving;								// 1: reception is armed
+
+ADC_BUFFER_DEFINE_EX(badc, TEST_CHANNELS, 5, 16);
+
+
+int main(void){
+
+	TestSetup();
+
+	// valid request | averaged values of ranks 0 ... 3
+	static const uint8_t averaged[] = { TEST_ADDRESS, 0x04, 0x00, 0x10, 0x00, 0x04 };
+
+	TEST_ASSERT_EQUAL(3U + 2U * 4U + 2U, TestRequest(averaged, sizeof(averaged), 0));
+	TEST_ASSERT_EQUAL(TEST_ADDRESS, response[0]);
+	TEST_ASSERT_EQUAL(0x04, response[1]);
+	TEST_ASSERT_EQUAL(8, response[2]);
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		TEST_ASSERT_EQUAL(100U * TEST_SCAN[r], TestRegister(r));
+	}
+
+	// valid request | scaled value of rank 0 in mV, status and number of ranks
+	static const uint8_t scaled[] = { TEST_ADDRESS, 0x04, 0x00, 0x00, 0x00, 0x01 };
+	static const uint8_t status[] = { TEST_ADDRESS, 0x04, 0x00, 0x20, 0x00, 0x02 };
+
+	TEST_ASSERT_EQUAL(7, TestRequest(scaled, sizeof(scaled), 0));
+	TEST_ASSERT_EQUAL(403, TestRegister(0));					// 500 * 3.3 V / 4095 * 1000
+
+	TEST_ASSERT_EQUAL(9, TestRequest(status, sizeof(status), 0));
+	TEST_ASSERT(TestRegister(0) & ADC_MODBUS_STATUS_VALID);
+	TEST_ASSERT_EQUAL(TEST_CHANNELS, TestRegister(1));
+
+	// valid request | the last registers of image
+	static const uint8_t last[] = { TEST_ADDRESS, 0x04, 0x00, ADC_MODBUS_REGISTERS - 2U, 0x00, 0x02 };
+
+	TEST_ASSERT_EQUAL(9, TestRequest(last, sizeof(last), 0));
+
+	uint32_t requests = mb.Requests;
+
+	// wrong CRC and too short frame | dropped, reception restarted
+	TEST_ASSERT_EQUAL(0, TestRequest(averaged, sizeof(averaged), 1));
+	TEST_ASSERT_EQUAL(0, TestRequest(averaged, 1, 0));
+	TEST_ASSERT_EQUAL(2, mb.CrcErrors);
+
+	// other slave and broadcast | ignored
+	static const uint8_t other[]     = { TEST_ADDRESS + 1U, 0x04, 0x00, 0x10, 0x00, 0x04 };
+	static const uint8_t broadcast[] = { 0x00, 0x04, 0x00, 0x10, 0x00, 0x04 };
+
+	TEST_ASSERT_EQUAL(0, TestRequest(other, sizeof(other), 0));
+	TEST_ASSERT_EQUAL(0, TestRequest(broadcast, sizeof(broadcast), 0));
+	TEST_ASSERT_EQUAL(2, mb.Ignored);
+	TEST_ASSERT_EQUAL(requests, mb.Requests);
+
+	// unsupported functions | read holding registers, write single register
+	static const uint8_t holding[] = { TEST_ADDRESS, 0x03, 0x00, 0x00, 0x00, 0x01 };
+	static const uint8_t write[]   = { TEST_ADDRESS, 0x06, 0x00, 0x00, 0x12, 0x34 };
+
+	TestException(holding, sizeof(holding), 0x03, ADC_MODBUS_ILLEGAL_FUNCTION);
+	TestException(write,   sizeof(write),   0x06, ADC_MODBUS_ILLEGAL_FUNCTION);
+
+	// registers beyond image
+	static const uint8_t beyond[]  = { TEST_ADDRESS, 0x04, 0x00, ADC_MODBUS_REGISTERS - 1U, 0x00, 0x02 };
+	static const uint8_t outside[] = { TEST_ADDRESS, 0x04, 0x01, 0x00, 0x00, 0x01 };
+
+	TestException(beyond,  sizeof(beyond),  0x04, ADC_MODBUS_ILLEGAL_ADDRESS);
+	TestException(outside, sizeof(outside), 0x04, ADC_MODBUS_ILLEGAL_ADDRESS);
+
+	// quantity out of 1 ... 125 and request with extra byte
+	static const uint8_t none[]  = { TEST_ADDRESS, 0x04, 0x00, 0x00, 0x00, 0x00 };
+	static const uint8_t many[]  = { TEST_ADDRESS, 0x04, 0x00, 0x00, 0x00, 126 };
+	static const uint8_t extra[] = { TEST_ADDRESS, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00 };
+
+	TestException(none,  sizeof(none),  0x04, ADC_MODBUS_ILLEGAL_VALUE);
+	TestException(many,  sizeof(many),  0x04, ADC_MODBUS_ILLEGAL_VALUE);
+	TestException(extra, sizeof(extra), 0x04, ADC_MODBUS_ILLEGAL_VALUE);
+
+	TEST_ASSERT_EQUAL(7, mb.Exceptions);
+	TEST_ASSERT_EQUAL(requests + 7U, mb.Requests);
+	TEST_ASSERT_EQUAL(1, receiving);							// slave listens after every frame
+
+	return TEST_RESULT("test_modbus");
+}
+
+
+/**
+  * @brief Request function, delivers frame with appended CRC to slave as idle-line reception event
+  * @param  frame      - pointer to request without CRC
+  * @param  size       - length of request without CRC | below 2: frame is delivered without CRC
+  * @param  corruptCrc - 1: CRC is inverted
+  * @retval length     - length of transmitted response | 0 if slave did not respond
+  */
+static uint16_t TestRequest(const uint8_t* frame, uint16_t size, uint8_t corruptCrc){
+
+	uint16_t crc = ADC_ModbusCrc(frame, size);
+
+	TEST_ASSERT_EQUAL(1, receiving);
+
+	memcpy(mb.RxFrame, frame, size);
+
+	if(size >= 2U){
+		mb.RxFrame[size]      = (uint8_t)(crc ^ (corruptCrc ? 0xFFFFU : 0U));
+		mb.RxFrame[size + 1U] = (uint8_t)((crc ^ (corruptCrc ? 0xFFFFU : 0U)) >> 8);
+		size += 2U;
+	}
+
+	receiving      = 0;
+	responseLength = 0;
+
+	ADC_ModbusRxEvent(&mb, &huart, size);
+
+	// response ends with its CRC, low byte first
+	if(responseLength != 0){
+		TEST_ASSERT_EQUAL(ADC_ModbusCrc(response, responseLength - 2U), response[responseLength - 2U] | (response[responseLength - 1U] << 8));
+	}
+
+	return responseLength;
+}
+
+
+/**
+  * @brief Exception check function | response has function with MSB set and exception code
+  */
+static void TestException(const uint8_t* frame, uint16_t size, uint8_t function, uint8_t code){
+
+	TEST_ASSERT_EQUAL(5, TestRequest(frame, size, 0));
+	TEST_ASSERT_EQUAL(TEST_ADDRESS, response[0]);
+	TEST_ASSERT_EQUAL(function | 0x80U, response[1]);
+	TEST_ASSERT_EQUAL(code, response[2]);
+}
+
+
+/**
+  * @brief Register function | value of index-th register of last response
+  */
+static uint16_t TestRegister(uint16_t index){
+
+	return (uint16_t)((response[3U + 2U * index] << 8) | response[4U + 2U * index]);
+}
+
+
+/**
+  * @brief Setup function, starts 4 channels scanned at 1 kHz, context and Modbus slave, runs acquisition until image is valid
+  */
+static void TestSetup(void){
+
+	ADC_SimInit(&sim, 6);
+
+	hadc.Instance              = ADC1;
+	hadc.DMA_Handle            = &hdma;
+	hdma.Instance              = DMA1_Channel1;
+	hdma.Parent                = &hadc;
+	hdma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	hdma.Init.Mode             = DMA_CIRCULAR;
+	hdma.Init.MemInc           = DMA_MINC_ENABLE;
+
+	ADC1->SQR1 = ((TEST_CHANNELS - 1U) << ADC_SQR1_L_Pos);
+	ADC1->CR1  = ADC_CR1_SCAN;
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		ADC1->SQR3  |= (uint32_t)TEST_SCAN[r] << (5U * r);
+		ADC1->SMPR2 |= 7U << (3U * TEST_SCAN[r]);
+	}
+
+	for(uint8_t ch = 0; ch < ADC_SIM_CHANNELS; ++ch){
+		sim.Adc[0].Level[ch] = 100U * ch;
+	}
+
+	sim.Adc[0].TriggerPeriod = 72000U;						// 1 kHz scans
+
+	TEST_ASSERT(ADC_Init(&hadc, &badc, &cadc) == HAL_OK);
+	ctx = ADC_ContextCreate(&hadc, &badc, &cadc, 3.3f);
+	TEST_ASSERT(ctx != NULL);
+
+	hdmaRx.Instance = &channelRx;
+	hdmaTx.Instance = &channelTx;
+
+	TEST_ASSERT(ADC_ModbusInit(&mb, &huart, &hdmaRx, &hdmaTx, ctx, TEST_ADDRESS, 1000.0f) == HAL_OK);
+	TEST_ASSERT(ADC_ModbusStart(&mb) == HAL_OK);
+
+	ADC_SimAdvance(&sim, 72000U * 100U);					// 100 ms | image refreshed by completed blocks
+
+	TEST_ASSERT(mb.Refreshes > 0U);
+}
+
+
+/* Callbacks and HAL stubs ----------------------------------------------------------- */
+void ADC_BlockCpltCallback(ADC_HandleTypeDef* h, ADC_BufferTypeDef* b, uint16_t offset, uint16_t transfers){
+
+	UNUSED(h); UNUSED(b); UNUSED(offset); UNUSED(transfers);
+
+	ADC_ModbusRefresh(&mb);
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* h, uint8_t* data, uint16_t size){
+
+	UNUSED(h); UNUSED(data); UNUSED(size);
+
+	if(receiving != 0){
+		return HAL_BUSY;
+	}
+
+	receiving = 1;
+
+	return HAL_OK;
+}
+
+HAL_UART_RxEventTypeTypeDef HAL_UARTEx_GetRxEventType(UART_HandleTypeDef* h){
+
+	UNUSED(h);
+
+	return HAL_UART_RXEVENT_IDLE;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* h, const uint8_t* data, uint16_t size){
+
+	memcpy(response, data, size);
+	responseLength = size;
+
+	ADC_ModbusTxCplt(&mb, h);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef* h){
+
+	UNUSED(h);
+
+	receiving = 0;
+
+	return HAL_OK;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state){
+
+	UNUSED(port); UNUSED(pin); UNUSED(state);
+}
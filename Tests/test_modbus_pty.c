@@ -0,0 +1,429 @@
+/**
+  ******************************************************************************
+  * @file      test_modbus_pty.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of Modbus RTU slave against master on pseudo-terminal
+  * @brief     This file contains minimal Modbus master, which sends read input registers (0x04) requests over pty
+  * 		   (posix_openpt) to adc_modbus.c served on other side of pty, as serial line between PLC and device would:
+  * 		   - reads of averaged and scaled registers, values and CRC checked by master with its own table CRC
+  * 		   - request written in two parts without gap, received as one frame
+  * 		   - request torn by gap longer than idle line, both parts dropped by slave without response
+  * 		   - exception response to request beyond image, polling of many requests in sequence
+  ******************************************************************************
+  * @attention UART of slave is emulated on pty: reception to idle line ends frame when no byte arrives for
+  * 		   TEST_IDLE_MS, transmission writes frame to pty. Master and slave run in one thread, slave is polled after
+  * 		   every write of master. ADC runs on simulation with 4 channels at constant levels. Test is skipped when
+  * 		   host provides no pseudo-terminals.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#define _GNU_SOURCE										// posix_openpt, ptsname, cfmakeraw
+
+#include "adc_sim.h"
+#include "adc_context.h"
+#include "adc_modbus.h"
+#include "adc_test.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#undef  CR1												// output delay flag of termios.h | name of ADC register
+
+// Private Macros
+#define TEST_ADDRESS			17U
+#define TEST_CHANNELS			4U
+#define TEST_IDLE_MS			5						// idle line of slave UART [ms]
+#define TEST_TIMEOUT_MS			200						// response timeout of master [ms]
+#define TEST_POLLS				100U					// requests of polling sequence
+
+// Private functions prototypes
+static uint8_t  TestOpen(void);
+static void     TestSetup(void);
+static void     TestSlavePoll(int timeout);
+static uint16_t TestMasterCrc(const uint8_t* data, uint16_t length);
+static uint16_t TestMasterWrite(uint16_t start, uint16_t quantity, uint8_t* frame);
+static int      TestMasterRead(uint16_t quantity, uint16_t* registers);
+static int      TestMasterTransaction(uint16_t start, uint16_t quantity, uint16_t* registers);
+
+// Private variables
+static const uint8_t TEST_SCAN[TEST_CHANNELS] = { 5, 7, 2, 9 };	// channels in rank order
+
+static ADC_SimTypeDef      sim;
+static ADC_HandleTypeDef   hadc;
+static DMA_HandleTypeDef   hdma;
+static ADC_ChannelsTypeDef cadc;
+static ADC_ContextTypeDef  ctx;
+
+static ADC_ModbusTypeDef   mb;
+static UART_HandleTypeDef  huart;
+static DMA_HandleTypeDef   hdmaRx;
+static DMA_HandleTypeDef   hdmaTx;
+static DMA_Channel_TypeDef channelRx;
+static DMA_Channel_TypeDef channelTx;
+
+static int      master = -1;							// pty side of master (PLC)
+static int      slave  = -1;							// pty side of slave UART
+
+static uint8_t* rxData;									// reception armed by HAL_UARTEx_ReceiveToIdle_DMA
+static uint16_t rxSize;
+
+ADC_BUFFER_DEFINE_EX(badc, TEST_CHANNELS, 5, 16);
+
+
+int main(void){
+
+	uint16_t registers[ADC_MODBUS_REGISTERS];
+	uint8_t  frame[8];
+
+	if(TestOpen() == 0){
+		printf("test_modbus_pty: no pseudo-terminal, skipped\n");
+		return 0;
+	}
+
+	TestSetup();
+
+	// averaged values of ranks 0 ... 3 and scaled value of rank 0 in mV
+	TEST_ASSERT_EQUAL(0, TestMasterTransaction(0x10, TEST_CHANNELS, registers));
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		TEST_ASSERT_EQUAL(100U * TEST_SCAN[r], registers[r]);
+	}
+
+	TEST_ASSERT_EQUAL(0, TestMasterTransaction(0x00, 1, registers));
+	TEST_ASSERT_EQUAL(403, registers[0]);					// 500 * 3.3 V / 4095 * 1000
+
+	// request in two writes without gap | one frame
+	uint16_t length = TestMasterWrite(0x10, 1, frame);
+
+	TEST_ASSERT_EQUAL(3, write(master, frame, 3));
+	TEST_ASSERT_EQUAL(length - 3, write(master, &frame[3], length - 3U));
+	TestSlavePoll(TEST_TIMEOUT_MS);
+
+	TEST_ASSERT_EQUAL(0, TestMasterRead(1, registers));
+	TEST_ASSERT_EQUAL(100U * TEST_SCAN[0], registers[0]);
+
+	// request torn by idle line | two frames with wrong CRC, no response
+	uint32_t crcErrors = mb.CrcErrors;
+
+	TEST_ASSERT_EQUAL(3, write(master, frame, 3));
+	TestSlavePoll(TEST_TIMEOUT_MS);
+	TEST_ASSERT_EQUAL(length - 3, write(master, &frame[3], length - 3U));
+	TestSlavePoll(TEST_TIMEOUT_MS);
+
+	TEST_ASSERT_EQUAL(crcErrors + 2U, mb.CrcErrors);
+	TEST_ASSERT_EQUAL(-1, TestMasterRead(1, registers));		// timeout of master
+
+	// registers beyond image | exception 0x02
+	TEST_ASSERT_EQUAL(ADC_MODBUS_ILLEGAL_ADDRESS, TestMasterTransaction(ADC_MODBUS_REGISTERS - 1U, 2, registers));
+
+	// polling sequence | every request answered
+	uint32_t requests = mb.Requests;
+	unsigned failed   = 0;
+
+	for(uint16_t i = 0; i < TEST_POLLS; ++i){
+
+		ADC_SimAdvance(&sim, 72000U);						// 1 ms of acquisition between polls
+
+		if(TestMasterTransaction(0x10, TEST_CHANNELS, registers) != 0 || registers[1] != 100U * TEST_SCAN[1]){
+			failed++;
+		}
+	}
+
+	TEST_ASSERT_EQUAL(0, failed);
+	TEST_ASSERT_EQUAL(requests + TEST_POLLS, mb.Requests);
+
+	close(slave);
+	close(master);
+
+	return TEST_RESULT("test_modbus_pty");
+}
+
+
+/**
+  * @brief Open function, creates pty pair in raw mode
+  * @retval opened  - 1 if pty is available
+  */
+static uint8_t TestOpen(void){
+
+	struct termios tio;
+
+	master = posix_openpt(O_RDWR | O_NOCTTY);
+
+	if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0){
+		return 0;
+	}
+
+	slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+
+	if(slave < 0 || tcgetattr(slave, &tio) != 0){
+		return 0;
+	}
+
+	// binary frames | no echo, no line editing, no translation of CR LF
+	cfmakeraw(&tio);
+
+	return (tcsetattr(slave, TCSANOW, &tio) == 0) ? 1U : 0U;
+}
+
+
+/**
+  * @brief Setup function, starts 4 channels scanned at 1 kHz, context and Modbus slave, runs acquisition until image is valid
+  */
+static void TestSetup(void){
+
+	ADC_SimInit(&sim, 6);
+
+	hadc.Instance              = ADC1;
+	hadc.DMA_Handle            = &hdma;
+	hdma.Instance              = DMA1_Channel1;
+	hdma.Parent                = &hadc;
+	hdma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	hdma.Init.Mode             = DMA_CIRCULAR;
+	hdma.Init.MemInc           = DMA_MINC_ENABLE;
+
+	ADC1->SQR1 = ((TEST_CHANNELS - 1U) << ADC_SQR1_L_Pos);
+	ADC1->CR1  = ADC_CR1_SCAN;
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		ADC1->SQR3  |= (uint32_t)TEST_SCAN[r] << (5U * r);
+		ADC1->SMPR2 |= 7U << (3U * TEST_SCAN[r]);
+	}
+
+	for(uint8_t ch = 0; ch < ADC_SIM_CHANNELS; ++ch){
+		sim.Adc[0].Level[ch] = 100U * ch;
+	}
+
+	sim.Adc[0].TriggerPeriod = 72000U;						// 1 kHz scans
+
+	TEST_ASSERT(ADC_Init(&hadc, &badc, &cadc) == HAL_OK);
+	TEST_ASSERT(ADC_ContextInit(&ctx, &hadc, &badc, &cadc, 3.3f) == HAL_OK);
+
+	hdmaRx.Instance = &channelRx;
+	hdmaTx.Instance = &channelTx;
+
+	TEST_ASSERT(ADC_ModbusInit(&mb, &huart, &hdmaRx, &hdmaTx, &ctx, TEST_ADDRESS, 1000.0f) == HAL_OK);
+	TEST_ASSERT(ADC_ModbusStart(&mb) == HAL_OK);
+
+	ADC_SimAdvance(&sim, 72000U * 100U);					// 100 ms | image refreshed by completed blocks
+
+	TEST_ASSERT(mb.Refreshes > 0U);
+}
+
+
+/**
+  * @brief Slave poll function, emulates UART reception to idle line | frame ends when no byte arrives for TEST_IDLE_MS
+  * @param  timeout - time to wait for first byte [ms]
+  */
+static void TestSlavePoll(int timeout){
+
+	struct pollfd pfd = { .fd = slave, .events = POLLIN };
+	uint16_t      size = 0;
+
+	if(rxData == NULL){
+		return;
+	}
+
+	while(size < rxSize && poll(&pfd, 1, (size == 0) ? timeout : TEST_IDLE_MS) > 0){
+
+		ssize_t n = read(slave, &rxData[size], rxSize - size);
+
+		if(n <= 0){
+			break;
+		}
+
+		size += (uint16_t)n;
+	}
+
+	if(size != 0){
+		rxData = NULL;									// reception ends | re-armed by slave
+		ADC_ModbusRxEvent(&mb, &huart, size);
+	}
+}
+
+
+/**
+  * @brief Master CRC function | CRC-16/MODBUS computed with lookup table, independent of slave's bitwise CRC
+  */
+static uint16_t TestMasterCrc(const uint8_t* data, uint16_t length){
+
+	static uint16_t table[256];
+
+	if(table[1] == 0){
+		for(uint16_t i = 0; i < 256U; ++i){
+
+			uint16_t c = i;
+
+			for(uint8_t b = 0; b < 8; ++b){
+				c = (c & 1U) ? (uint16_t)((c >> 1) ^ 0xA001U) : (uint16_t)(c >> 1);
+			}
+
+			table[i] = c;
+		}
+	}
+
+	uint16_t crc = 0xFFFFU;
+
+	for(uint16_t i = 0; i < length; ++i){
+		crc = (uint16_t)((crc >> 8) ^ table[(crc ^ data[i]) & 0xFFU]);
+	}
+
+	return crc;
+}
+
+
+/**
+  * @brief Master request function, builds read input registers request with CRC, low byte first
+  * @retval length  - length of request
+  */
+static uint16_t TestMasterWrite(uint16_t start, uint16_t quantity, uint8_t* frame){
+
+	frame[0] = TEST_ADDRESS;
+	frame[1] = 0x04;
+	frame[2] = (uint8_t)(start >> 8);
+	frame[3] = (uint8_t)start;
+	frame[4] = (uint8_t)(quantity >> 8);
+	frame[5] = (uint8_t)quantity;
+
+	uint16_t crc = TestMasterCrc(frame, 6);
+
+	frame[6] = (uint8_t)crc;
+	frame[7] = (uint8_t)(crc >> 8);
+
+	return 8;
+}
+
+
+/**
+  * @brief Master response function, reads response until it is complete or timeout elapses
+  * @param  quantity  - number of requested registers
+  * @param  registers - pointer to returned values
+  * @retval result    - 0: registers read, exception code, -1: timeout, -2: corrupted response
+  */
+static int TestMasterRead(uint16_t quantity, uint16_t* registers){
+
+	struct pollfd pfd = { .fd = master, .events = POLLIN };
+	uint8_t       frame[ADC_MODBUS_FRAME_SIZE];
+	uint16_t      size     = 0;
+	uint16_t      expected = 5U + 2U * quantity;
+
+	while(size < expected && poll(&pfd, 1, TEST_TIMEOUT_MS) > 0){
+
+		ssize_t n = read(master, &frame[size], sizeof(frame) - size);
+
+		if(n <= 0){
+			break;
+		}
+
+		size += (uint16_t)n;
+
+		// exception response is shorter
+		if(size >= 2U && (frame[1] & 0x80U) != 0){
+			expected = 5U;
+		}
+	}
+
+	if(size == 0){
+		return -1;
+	}
+
+	if(size != expected || frame[0] != TEST_ADDRESS || TestMasterCrc(frame, size - 2U) != (frame[size - 2U] | (frame[size - 1U] << 8))){
+		return -2;
+	}
+
+	if((frame[1] & 0x80U) != 0){
+		return frame[2];
+	}
+
+	if(frame[1] != 0x04 || frame[2] != 2U * quantity){
+		return -2;
+	}
+
+	for(uint16_t i = 0; i < quantity; ++i){
+		registers[i] = (uint16_t)((frame[3U + 2U * i] << 8) | frame[4U + 2U * i]);
+	}
+
+	return 0;
+}
+
+
+/**
+  * @brief Master transaction function, writes request, lets slave serve it and reads response
+  * @retval result  - result of TestMasterRead
+  */
+static int TestMasterTransaction(uint16_t start, uint16_t quantity, uint16_t* registers){
+
+	uint8_t  frame[8];
+	uint16_t length = TestMasterWrite(start, quantity, frame);
+
+	if(write(master, frame, length) != length){
+		return -2;
+	}
+
+	TestSlavePoll(TEST_TIMEOUT_MS);
+
+	return TestMasterRead(quantity, registers);
+}
+
+
+/* Callbacks and HAL stubs of slave UART on pty -------------------------------------- */
+void ADC_BlockCpltCallback(ADC_HandleTypeDef* h, ADC_BufferTypeDef* b, uint16_t offset, uint16_t transfers){
+
+	UNUSED(h); UNUSED(b); UNUSED(offset); UNUSED(transfers);
+
+	ADC_ModbusRefresh(&mb);
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* h, uint8_t* data, uint16_t size){
+
+	UNUSED(h);
+
+	if(rxData != NULL){
+		return HAL_BUSY;
+	}
+
+	rxData = data;
+	rxSize = size;
+
+	return HAL_OK;
+}
+
+HAL_UART_RxEventTypeTypeDef HAL_UARTEx_GetRxEventType(UART_HandleTypeDef* h){
+
+	UNUSED(h);
+
+	return HAL_UART_RXEVENT_IDLE;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* h, const uint8_t* data, uint16_t size){
+
+	if(write(slave, data, size) != size){
+		return HAL_ERROR;
+	}
+
+	tcdrain(slave);
+	ADC_ModbusTxCplt(&mb, h);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef* h){
+
+	UNUSED(h);
+
+	rxData = NULL;
+
+	return HAL_OK;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state){
+
+	UNUSED(port); UNUSED(pin); UNUSED(state);
+}
@@ -0,0 +1,222 @@
+/**
+  ******************************************************************************
+  * @file      test_pool.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of static block pools
+  * @brief     This file contains checks of adc_pool.c allocation, release and report:
+  * 		   - context pool of ADC_ContextCreate, exhausted after ADC_CONTEXT_POOL_SIZE contexts, destroyed context reused
+  * 		   - release of pointer inside block, before or beyond storage and of block never allocated, rejected
+  * 		   - double release rejected, Used, Peak and Failures accounting, released block reused first
+  * 		   - ADC_PoolFormat lines in order of first use and truncation to size of output buffer
+  ******************************************************************************
+  * @attention ADC runs on simulation with 4 channels, contexts need initialized ADC only. Pools stay in report list
+  * 		   for whole program, so checks of report follow allocations of all pools.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_sim.h"
+#include "adc_context.h"
+#include "adc_pool.h"
+#include "adc_test.h"
+#include <string.h>
+
+// Private Macros
+#define TEST_CHANNELS			4U
+#define TEST_BLOCK_SIZE			12U						// rounded up to 16 bytes by ADC_POOL_DEFINE_BLOCKS
+#define TEST_BLOCKS				3U
+
+// Private functions prototypes
+static void TestContextPool(void);
+static void TestBlockPool(void);
+static void TestInitPool(void);
+static void TestFormat(void);
+
+// Private variables
+static const uint8_t TEST_SCAN[TEST_CHANNELS] = { 5, 7, 2, 9 };	// channels in rank order
+
+static ADC_SimTypeDef      sim;
+static ADC_HandleTypeDef   hadc;
+static DMA_HandleTypeDef   hdma;
+static ADC_ChannelsTypeDef cadc;
+
+static uint32_t            initStorage[4];				// storage of pool initialized by ADC_PoolInit
+static uint16_t            initNext[2];
+static ADC_PoolTypeDef     initPool;
+
+ADC_BUFFER_DEFINE_EX(badc, TEST_CHANNELS, 5, 16);
+ADC_POOL_DEFINE_BLOCKS(TestBlocks, TEST_BLOCK_SIZE, TEST_BLOCKS);
+
+
+int main(void){
+
+	TestContextPool();
+	TestBlockPool();
+	TestInitPool();
+	TestFormat();
+
+	return TEST_RESULT("test_pool");
+}
+
+
+/**
+  * @brief Context pool | exhausted after ADC_CONTEXT_POOL_SIZE contexts, destroyed context is reused, double release fails
+  */
+static void TestContextPool(void){
+
+	ADC_SimInit(&sim, 6);
+
+	hadc.Instance              = ADC1;
+	hadc.DMA_Handle            = &hdma;
+	hdma.Instance              = DMA1_Channel1;
+	hdma.Parent                = &hadc;
+	hdma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	hdma.Init.Mode             = DMA_CIRCULAR;
+	hdma.Init.MemInc           = DMA_MINC_ENABLE;
+
+	ADC1->SQR1 = ((TEST_CHANNELS - 1U) << ADC_SQR1_L_Pos);
+	ADC1->CR1  = ADC_CR1_SCAN;
+	ADC1->CR2  = ADC_CR2_CONT;
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		ADC1->SQR3  |= (uint32_t)TEST_SCAN[r] << (5U * r);
+		ADC1->SMPR2 |= 7U << (3U * TEST_SCAN[r]);
+	}
+
+	TEST_ASSERT(ADC_Init(&hadc, &badc, &cadc) == HAL_OK);
+
+	ADC_ContextTypeDef* ctx   = ADC_ContextCreate(&hadc, &badc, &cadc, 3.3f);
+	ADC_ContextTypeDef* spare = ADC_ContextCreate(&hadc, &badc, &cadc, 3.3f);
+
+	TEST_ASSERT(ctx != NULL);
+	TEST_ASSERT(spare != NULL && spare != ctx);
+	TEST_ASSERT(ADC_ContextCreate(&hadc, &badc, &cadc, 3.3f) == NULL);
+	TEST_ASSERT(ADC_ContextDestroy(spare) == HAL_OK);
+	TEST_ASSERT(ADC_ContextDestroy(spare) == HAL_ERROR);
+	TEST_ASSERT(ADC_ContextCreate(&hadc, &badc, &cadc, 3.3f) == spare);
+}
+
+
+/**
+  * @brief Block pool | release of foreign pointers is rejected without changing accounting
+  */
+static void TestBlockPool(void){
+
+	TEST_ASSERT_EQUAL(16, TestBlocks.BlockSize);
+
+	uint8_t* a = ADC_PoolAlloc(&TestBlocks);
+	uint8_t* b = ADC_PoolAlloc(&TestBlocks);
+
+	TEST_ASSERT(a != NULL && b == a + 16);
+	TEST_ASSERT_EQUAL(0, (uintptr_t)a % 8U);
+	TEST_ASSERT_EQUAL(2, TestBlocks.Used);
+	TEST_ASSERT_EQUAL(2, TestBlocks.Fresh);
+
+	// block never allocated | inside storage, beyond Fresh
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, b + 16) == HAL_ERROR);
+
+	uint8_t* c = ADC_PoolAlloc(&TestBlocks);
+
+	TEST_ASSERT(c == b + 16);
+	TEST_ASSERT(ADC_PoolAlloc(&TestBlocks) == NULL);
+	TEST_ASSERT(ADC_PoolAlloc(&TestBlocks) == NULL);
+	TEST_ASSERT_EQUAL(3, TestBlocks.Used);
+	TEST_ASSERT_EQUAL(3, TestBlocks.Peak);
+	TEST_ASSERT_EQUAL(2, TestBlocks.Failures);
+
+	// misaligned pointers | inside allocated block
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, a + 1) == HAL_ERROR);
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, b + 8) == HAL_ERROR);
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, c + 15) == HAL_ERROR);
+
+	// out of range pointers | before storage, end of storage, far beyond storage
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, a - 16) == HAL_ERROR);
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, c + 16) == HAL_ERROR);
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, c + 16 * 1000) == HAL_ERROR);
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, NULL) == HAL_ERROR);
+	TEST_ASSERT(ADC_PoolFree(NULL, a) == HAL_ERROR);
+
+	TEST_ASSERT_EQUAL(3, TestBlocks.Used);
+
+	// double release | released block is reused first
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, b) == HAL_OK);
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, b) == HAL_ERROR);
+	TEST_ASSERT_EQUAL(2, TestBlocks.Used);
+	TEST_ASSERT_EQUAL(3, TestBlocks.Peak);
+
+	TEST_ASSERT(ADC_PoolFree(&TestBlocks, a) == HAL_OK);
+	TEST_ASSERT(ADC_PoolAlloc(&TestBlocks) == a);
+	TEST_ASSERT(ADC_PoolAlloc(&TestBlocks) == b);
+	TEST_ASSERT(ADC_PoolAlloc(&TestBlocks) == NULL);
+
+	TEST_ASSERT_EQUAL(3, TestBlocks.Used);
+	TEST_ASSERT_EQUAL(3, TestBlocks.Peak);
+	TEST_ASSERT_EQUAL(3, TestBlocks.Failures);
+}
+
+
+/**
+  * @brief Pool with caller-provided storage | parameters are validated, accounting starts from zero
+  */
+static void TestInitPool(void){
+
+	TEST_ASSERT(ADC_PoolInit(&initPool, initStorage, initNext, 8U, 0U, "init") == HAL_ERROR);
+	TEST_ASSERT(ADC_PoolInit(&initPool, initStorage, NULL, 8U, 2U, "init") == HAL_ERROR);
+	TEST_ASSERT(ADC_PoolInit(&initPool, initStorage, initNext, 0U, 2U, "init") == HAL_ERROR);
+	TEST_ASSERT(ADC_PoolInit(&initPool, initStorage, initNext, 8U, 2U, "init") == HAL_OK);
+
+	void* a = ADC_PoolAlloc(&initPool);
+
+	TEST_ASSERT(a == (void*)initStorage);
+	TEST_ASSERT(ADC_PoolFree(&initPool, a) == HAL_OK);
+	TEST_ASSERT_EQUAL(0, initPool.Used);
+	TEST_ASSERT_EQUAL(1, initPool.Peak);
+	TEST_ASSERT_EQUAL(0, initPool.Failures);
+}
+
+
+/**
+  * @brief Pool report | one line per pool in order of first use, output truncated to size with terminating zero
+  */
+static void TestFormat(void){
+
+	char     text[256];
+	char     expected[256];
+	uint16_t length;
+
+	snprintf(expected, sizeof(expected),
+	         "ADC_ContextPool used=2 peak=2/2 block=%u fail=1\r\n"
+	         "TestBlocks used=3 peak=3/3 block=16 fail=3\r\n"
+	         "init used=0 peak=1/2 block=8 fail=0\r\n",
+	         (unsigned)sizeof(ADC_ContextTypeDef));
+
+	length = ADC_PoolFormat(text, sizeof(text));
+
+	TEST_ASSERT_EQUAL(strlen(expected), length);
+	TEST_ASSERT(strcmp(text, expected) == 0);
+
+	// truncation | inside first line, at end of first line, one character of last line missing
+	uint16_t first = (uint16_t)(strchr(expected, '\n') - expected + 1);
+	uint16_t sizes[] = { 10U, (uint16_t)(first + 1U), (uint16_t)strlen(expected) };
+
+	for(uint8_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i){
+
+		memset(text, 'x', sizeof(text));
+		length = ADC_PoolFormat(text, sizes[i]);
+
+		TEST_ASSERT_EQUAL(sizes[i] - 1U, length);
+		TEST_ASSERT_EQUAL('\0', text[length]);
+		TEST_ASSERT(strncmp(text, expected, length) == 0);
+		TEST_ASSERT_EQUAL('x', text[sizes[i]]);
+	}
+
+	// buffer of terminating zero only | no buffer
+	TEST_ASSERT_EQUAL(0, ADC_PoolFormat(text, 1U));
+	TEST_ASSERT_EQUAL('\0', text[0]);
+	TEST_ASSERT_EQUAL(0, ADC_PoolFormat(text, 0U));
+	TEST_ASSERT_EQUAL(0, ADC_PoolFormat(NULL, sizeof(text)));
+}
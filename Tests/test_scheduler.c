@@ -0,0 +1,271 @@
+/**
+  ******************************************************************************
+  * @file      test_scheduler.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of cooperative scheduler
+  * @brief     This file contains checks of adc_scheduler.c dispatching with virtual clock:
+  * 		   - events of higher priority run first, events of one priority in order of posting
+  * 		   - post stamps and execution times taken from scheduler clock, also across wrap of 32-bit time
+  * 		   - handler above its budget is counted and reported by ADC_SchedOverrunCallback, handler at budget is not
+  * 		   - event posted to full queue is dropped and counted, HighWater keeps maximal queue depth
+  ******************************************************************************
+  * @attention Virtual clock advances only inside handlers, by execution time passed as handler argument, so every
+  * 		   measured time is exact.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_scheduler.h"
+#include "adc_test.h"
+#include <string.h>
+
+// Private Macros
+#define TEST_TRACE_LENGTH			32U
+
+// Private functions prototypes
+static uint32_t TestClock(void);
+static void     TestHandler(const ADC_EventTypeDef* event, void* arg);
+static void     TestRegister(void);
+static void     TestPriorities(void);
+static void     TestBudget(void);
+static void     TestQueueFull(void);
+
+// Private variables
+static ADC_SchedTypeDef sched;
+
+static uint32_t now;									// virtual time [cycles]
+
+static ADC_EventTypeDef trace[TEST_TRACE_LENGTH];			// dispatched events in order of execution
+static uint8_t          traceLength;
+
+static uint32_t overrunCalls;							// calls of ADC_SchedOverrunCallback
+static uint8_t  overrunId;								// arguments of last call
+static uint32_t overrunCycles;
+
+static uint32_t cost[ADC_SCHED_MAX_HANDLERS];			// execution time of handler [cycles] | argument of handler
+
+
+int main(void){
+
+	TestRegister();
+	TestPriorities();
+	TestBudget();
+	TestQueueFull();
+
+	return TEST_RESULT("test_scheduler");
+}
+
+
+/**
+  * @brief Register | priority and number of handlers are validated, ids are given in order
+  */
+static void TestRegister(void){
+
+	uint8_t id;
+
+	TEST_ASSERT(ADC_SchedInit(NULL, TestClock) == HAL_ERROR);
+	TEST_ASSERT(ADC_SchedInit(&sched, TestClock) == HAL_OK);
+
+	TEST_ASSERT(ADC_SchedRegister(&sched, TestHandler, NULL, ADC_SCHED_PRIORITIES, 0, &id) == HAL_ERROR);
+	TEST_ASSERT(ADC_SchedRegister(&sched, NULL, NULL, 0, 0, &id) == HAL_ERROR);
+
+	for(uint8_t i = 0; i < ADC_SCHED_MAX_HANDLERS; ++i){
+		TEST_ASSERT(ADC_SchedRegister(&sched, TestHandler, &cost[i], 0, 0, &id) == HAL_OK);
+		TEST_ASSERT_EQUAL(i, id);
+	}
+
+	TEST_ASSERT(ADC_SchedRegister(&sched, TestHandler, NULL, 0, 0, &id) == HAL_ERROR);
+	TEST_ASSERT(ADC_SchedPost(&sched, ADC_SCHED_MAX_HANDLERS, ADC_EVENT_USER, NULL, 0, 0) == HAL_ERROR);
+	TEST_ASSERT_EQUAL(0, ADC_SchedRunOnce(&sched));
+}
+
+
+/**
+  * @brief Priorities | highest non-empty priority first, FIFO within priority, stamps of post time
+  */
+static void TestPriorities(void){
+
+	uint8_t low, mid, high;
+
+	ADC_SchedInit(&sched, TestClock);
+	traceLength = 0;
+	now         = 1000U;
+
+	ADC_SchedRegister(&sched, TestHandler, &cost[0], 2, 0, &low);
+	ADC_SchedRegister(&sched, TestHandler, &cost[1], 1, 0, &mid);
+	ADC_SchedRegister(&sched, TestHandler, &cost[2], 0, 0, &high);
+
+	cost[low] = 10U; cost[mid] = 20U; cost[high] = 30U;
+
+	// interleaved posts | offset carries order of posting
+	TEST_ASSERT(ADC_SchedPost(&sched, low,  ADC_EVENT_HALF,  NULL, 0, 8) == HAL_OK);
+	now += 5U;
+	TEST_ASSERT(ADC_SchedPost(&sched, mid,  ADC_EVENT_AWD,   NULL, 1, 0) == HAL_OK);
+	TEST_ASSERT(ADC_SchedPost(&sched, low,  ADC_EVENT_FULL,  NULL, 2, 8) == HAL_OK);
+	TEST_ASSERT(ADC_SchedPost(&sched, high, ADC_EVENT_TIMER, NULL, 3, 0) == HAL_OK);
+	TEST_ASSERT(ADC_SchedPost(&sched, mid,  ADC_EVENT_USER,  NULL, 4, 0) == HAL_OK);
+	TEST_ASSERT(ADC_SchedPost(&sched, high, ADC_EVENT_USER,  NULL, 5, 0) == HAL_OK);
+
+	TEST_ASSERT_EQUAL(6, ADC_SchedPending(&sched));
+
+	// high posted between runs preempts remaining mid and low events
+	TEST_ASSERT_EQUAL(1, ADC_SchedRunOnce(&sched));
+	TEST_ASSERT_EQUAL(1, ADC_SchedRunOnce(&sched));
+	TEST_ASSERT_EQUAL(1, ADC_SchedRunOnce(&sched));
+	TEST_ASSERT(ADC_SchedPost(&sched, high, ADC_EVENT_USER, NULL, 6, 0) == HAL_OK);
+
+	while(ADC_SchedRunOnce(&sched) != 0){}
+
+	static const uint16_t order[] = { 3, 5, 1, 6, 4, 0, 2 };
+
+	TEST_ASSERT_EQUAL(sizeof(order) / sizeof(order[0]), traceLength);
+
+	for(uint8_t i = 0; i < traceLength; ++i){
+		TEST_ASSERT_EQUAL(order[i], trace[i].Offset);
+	}
+
+	TEST_ASSERT_EQUAL(1000U, trace[5].Stamp);				// first low event | posted before clock moved
+	TEST_ASSERT_EQUAL(ADC_EVENT_HALF, trace[5].Type);
+	TEST_ASSERT_EQUAL(8, trace[5].Transfers);
+	TEST_ASSERT_EQUAL(1005U, trace[0].Stamp);
+	TEST_ASSERT_EQUAL(1005U + 30U + 30U + 20U, trace[3].Stamp);	// posted after three runs
+
+	TEST_ASSERT_EQUAL(7, sched.Dispatched);
+	TEST_ASSERT_EQUAL(3, sched.Handlers[high].Runs);
+	TEST_ASSERT_EQUAL(2, sched.Handlers[mid].Runs);
+	TEST_ASSERT_EQUAL(2, sched.Handlers[low].Runs);
+	TEST_ASSERT_EQUAL(0, ADC_SchedPending(&sched));
+}
+
+
+/**
+  * @brief Budget | execution above budget is overrun, execution at budget is not, times are exact across clock wrap
+  */
+static void TestBudget(void){
+
+	uint8_t bounded, unlimited;
+
+	ADC_SchedInit(&sched, TestClock);
+	traceLength  = 0;
+	overrunCalls = 0;
+	now          = 0xFFFFFF00U;						// handler runs across wrap of 32-bit time
+
+	ADC_SchedRegister(&sched, TestHandler, &cost[0], 0, 300U, &bounded);
+	ADC_SchedRegister(&sched, TestHandler, &cost[1], 1, 0U,   &unlimited);
+
+	cost[bounded]   = 300U;
+	cost[unlimited] = 100000U;
+
+	ADC_SchedPost(&sched, bounded, ADC_EVENT_USER, NULL, 0, 0);
+	ADC_SchedRunOnce(&sched);
+
+	TEST_ASSERT_EQUAL(300U, sched.Handlers[bounded].CyclesLast);
+	TEST_ASSERT_EQUAL(0, sched.Handlers[bounded].Overruns);
+	TEST_ASSERT_EQUAL(0, overrunCalls);
+
+	cost[bounded] = 301U;
+
+	ADC_SchedPost(&sched, bounded, ADC_EVENT_USER, NULL, 0, 0);
+	ADC_SchedPost(&sched, unlimited, ADC_EVENT_USER, NULL, 0, 0);
+	ADC_SchedRunOnce(&sched);
+	ADC_SchedRunOnce(&sched);
+
+	TEST_ASSERT_EQUAL(1, sched.Handlers[bounded].Overruns);
+	TEST_ASSERT_EQUAL(301U, sched.Handlers[bounded].CyclesMax);
+	TEST_ASSERT_EQUAL(1, overrunCalls);
+	TEST_ASSERT_EQUAL(bounded, overrunId);
+	TEST_ASSERT_EQUAL(301U, overrunCycles);
+
+	// unlimited handler is never overrun
+	TEST_ASSERT_EQUAL(100000U, sched.Handlers[unlimited].CyclesLast);
+	TEST_ASSERT_EQUAL(0, sched.Handlers[unlimited].Overruns);
+	TEST_ASSERT_EQUAL(2, sched.Handlers[bounded].Runs);
+}
+
+
+/**
+  * @brief Full queue | posts above queue length are dropped and counted per priority, other queues are not affected
+  */
+static void TestQueueFull(void){
+
+	uint8_t flood, other;
+
+	ADC_SchedInit(&sched, TestClock);
+	traceLength = 0;
+
+	ADC_SchedRegister(&sched, TestHandler, &cost[0], 1, 0, &flood);
+	ADC_SchedRegister(&sched, TestHandler, &cost[1], 2, 0, &other);
+
+	cost[flood] = 1U;
+	cost[other] = 1U;
+
+	for(uint16_t i = 0; i < ADC_SCHED_QUEUE_LENGTH; ++i){
+		TEST_ASSERT(ADC_SchedPost(&sched, flood, ADC_EVENT_USER, NULL, i, 0) == HAL_OK);
+	}
+
+	TEST_ASSERT(ADC_SchedPost(&sched, flood, ADC_EVENT_USER, NULL, 100, 0) == HAL_BUSY);
+	TEST_ASSERT(ADC_SchedPost(&sched, flood, ADC_EVENT_USER, NULL, 101, 0) == HAL_BUSY);
+	TEST_ASSERT(ADC_SchedPost(&sched, other, ADC_EVENT_USER, NULL, 200, 0) == HAL_OK);
+
+	TEST_ASSERT_EQUAL(2, sched.Queues[1].Dropped);
+	TEST_ASSERT_EQUAL(ADC_SCHED_QUEUE_LENGTH, sched.Queues[1].HighWater);
+	TEST_ASSERT_EQUAL(0, sched.Queues[2].Dropped);
+	TEST_ASSERT_EQUAL(1, sched.Queues[2].HighWater);
+
+	// one slot released | next post is accepted again
+	ADC_SchedRunOnce(&sched);
+	TEST_ASSERT(ADC_SchedPost(&sched, flood, ADC_EVENT_USER, NULL, 102, 0) == HAL_OK);
+
+	while(ADC_SchedRunOnce(&sched) != 0){}
+
+	// dropped events never run | accepted ones in order of posting
+	TEST_ASSERT_EQUAL(ADC_SCHED_QUEUE_LENGTH + 2U, traceLength);
+
+	for(uint16_t i = 0; i < ADC_SCHED_QUEUE_LENGTH; ++i){
+		TEST_ASSERT_EQUAL(i, trace[i].Offset);
+	}
+
+	TEST_ASSERT_EQUAL(102, trace[ADC_SCHED_QUEUE_LENGTH].Offset);
+	TEST_ASSERT_EQUAL(200, trace[ADC_SCHED_QUEUE_LENGTH + 1U].Offset);
+
+	TEST_ASSERT_EQUAL(2, sched.Queues[1].Dropped);
+	TEST_ASSERT_EQUAL(ADC_SCHED_QUEUE_LENGTH, sched.Queues[1].HighWater);
+	TEST_ASSERT_EQUAL(0, ADC_SchedPending(&sched));
+}
+
+
+/* Callbacks ------------------------------------------------------------------------- */
+void ADC_SchedOverrunCallback(ADC_SchedTypeDef* s, uint8_t id, uint32_t cycles){
+
+	UNUSED(s);
+
+	overrunCalls++;
+	overrunId     = id;
+	overrunCycles = cycles;
+}
+
+
+/**
+  * @brief Virtual clock of scheduler
+  */
+static uint32_t TestClock(void){
+
+	return now;
+}
+
+
+/**
+  * @brief Handler | logs event and advances virtual clock by its execution time
+  */
+static void TestHandler(const ADC_EventTypeDef* event, void* arg){
+
+	if(traceLength < TEST_TRACE_LENGTH){
+		trace[traceLength++] = *event;
+	}
+
+	now += *(const uint32_t*)arg;
+}
@@ -0,0 +1,730 @@
+/**
+  ******************************************************************************
+  * @file      test_sim.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of fault recovery on simulated ADC and DMA
+  * @brief     This file contains scenarios of driver recovery paths run on virtual-time simulation (adc_sim.c):
+  * 		   - fault mix: 10 minutes, DMA error, OVR and stuck conversion about once per second each, two calibration
+  * 		     failures at init, consumer and ADC_Supervise every 1 ms
+  * 		   - overrun minute: one minute with about 10 overruns per second, polled OVR flag and OVR interrupt
+  * 		   - endurance hour: one hour of DMA errors, OVR and stuck conversions about once per 10 seconds each, consumer and
+  * 		     ADC_Supervise every 1 ms | 32-bit cycle counter (__ADC_CYCLES) wraps about 60 times
+  * 		   - normal mode stop: DMA in normal mode re-armed by fast path, HAL_ADC_Stop_DMA has to abort re-armed channel
+  * 		   - averaging offload: same signal averaged by oversampler (ADC_OffloadAveraging) and in software, equal results of
+  * 		     ADC_Averaging, ADC_GetValue and ADC_InlineAveraged, 8 times fewer DMA transfers and storage of single scan
+  * 		   - resolution switch: 12 -> 8 -> 12 bits on running ADC, scaling of first values after each switch and of context
+  * 		     rescaled by ADC_ContextRescale, storage packed to bytes rejects resolution above 8 bits
+  * 		   - alignment: left- and right-aligned runs of the same input at 12 and 8 bits, matching averaged, scaled and
+  * 		     Q15 values of driver and context
+  * 		   - accessor positions: ADC_InlineLatest and ADC_InlineAveraged against ADC_ReadChannel, ADC_Averaging and
+  * 		     ADC_Context* functions at random DMA positions | stops inside scan, latest scan wrapped to end of storage,
+  * 		     averaged scans wrapped across end of storage
+  ******************************************************************************
+  * @attention 4 channels with the longest sampling time, ADC clock divided by 6 -> one conversion takes 1512 cycles
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_driver.h"
+#include "adc_sim.h"
+#include "adc_context.h"
+#include "adc_test.h"
+#include <math.h>
+#include <string.h>
+
+// Private Macros
+#define TEST_CORE_CLOCK			72000000ULL				// [Hz]
+#define TEST_PERIOD				72000U					// consumer period [cycles] | 1 ms
+#define TEST_CONSUMER_CYCLES	3000U					// execution time of consumer [cycles]
+#define TEST_CHANNELS			4U
+#define TEST_MEASURES			8U						// averaging depth of offload scenario
+#define TEST_POSITIONS			600U					// random stops of accessor positions scenario per averaging depth
+
+// Private functions prototypes
+static HAL_StatusTypeDef TestSetup(ADC_BufferTypeDef* badc, uint8_t overrunInterrupt, uint32_t mode);
+static uint32_t          TestConsumer(void* arg);
+static void              TestFaultMix(void);
+static void              TestOverrunMinute(uint8_t overrunInterrupt);
+static void              TestEnduranceHour(void);
+static void              TestNormalModeStop(void);
+static void              TestOffloadAveraging(void);
+static void              TestResolutionSwitch(void);
+static void              TestAlignment(void);
+static void              TestAccessorPositions(void);
+static void              TestCheckScaling(const ADC_ContextTypeDef* ctx, ADC_BufferTypeDef* badc, uint8_t bits, uint8_t rank, uint16_t expected);
+static uint16_t          TestSignal(uint8_t adc, uint8_t channel, uint64_t time, void* arg);
+
+// Private variables
+static const uint8_t     TEST_SCAN[TEST_CHANNELS] = { 5, 7, 2, 9 };	// channels in rank order
+
+static ADC_SimTypeDef      sim;
+static ADC_HandleTypeDef   hadc;
+static DMA_HandleTypeDef   hdma;
+static ADC_ChannelsTypeDef cadc;
+static ADC_BufferTypeDef*  active;						// buffer of running scenario
+
+static uint8_t  supervise;								// 1: consumer calls ADC_Supervise
+static unsigned readErrors;								// failed ADC_ReadChannel calls
+static unsigned misaligned;								// samples of completed blocks not in rank order
+static unsigned discontinuous;							// completed blocks flagged after restart
+
+ADC_BUFFER_DEFINE_EX(badcMix, TEST_CHANNELS, 5, 16);
+ADC_BUFFER_DEFINE_EX(badcPolled, TEST_CHANNELS, 5, 16);
+ADC_BUFFER_DEFINE_EX(badcInterrupt, TEST_CHANNELS, 5, 16);
+ADC_BUFFER_DEFINE_EX(badcHour, TEST_CHANNELS, 5, 16);
+ADC_BUFFER_DEFINE_EX(badcNormal, TEST_CHANNELS, 5, 16);
+ADC_BUFFER_DEFINE(badcOffload, TEST_CHANNELS, TEST_MEASURES);
+ADC_BUFFER_DEFINE_EX(badcSoftware, TEST_CHANNELS, 1, TEST_MEASURES);	// averaging depth set after init | no offload
+ADC_BUFFER_DEFINE_EX(badcResolution, TEST_CHANNELS, 1, 8);	// averaging depth set after init | no offload
+ADC_BUFFER_DEFINE_PACKED(badcPacked, TEST_CHANNELS, 4);
+ADC_BUFFER_DEFINE_EX(badcAligned, TEST_CHANNELS, 1, 8);	// averaging depth set after init | no offload
+ADC_BUFFER_DEFINE_EX(badcPositions, TEST_CHANNELS, 1, 5);	// storage of 5 scans | averaged scans wrap
+
+
+int main(void){
+
+	TestFaultMix();
+	TestOverrunMinute(0);
+	TestOverrunMinute(1);
+	TestEnduranceHour();
+	TestNormalModeStop();
+	TestOffloadAveraging();
+	TestResolutionSwitch();
+	TestAlignment();
+	TestAccessorPositions();
+
+	return TEST_RESULT("test_sim");
+}
+
+
+/**
+  * @brief Block complete callback | checks that every sample of completed block belongs to its rank
+  */
+void ADC_BlockCpltCallback(ADC_HandleTypeDef* h, ADC_BufferTypeDef* badc, uint16_t offset, uint16_t transfers){
+
+	UNUSED(h);
+
+	if(badc->Discontinuous != 0){
+		discontinuous++;
+	}
+
+	for(uint16_t i = 0; i < transfers; ++i){
+		if(badc->BufferADC[offset + i] != 100U * TEST_SCAN[(offset + i) % TEST_CHANNELS]){
+			misaligned++;
+		}
+	}
+}
+
+
+/**
+  * @brief Fault mix scenario | every DMA error and OVR is recovered within one conversion, stuck conversion within
+  * 	   two supervision periods, calibration failures at init are absorbed by retries
+  */
+static void TestFaultMix(void){
+
+	ADC_SimInit(&sim, 6);
+	sim.OverrunInterrupt = 1;
+	supervise            = 1;
+
+	// two failed calibrations before init
+	ADC_SimFaultAt(&sim, ADC_SIM_FAULT_CALIBRATION, 0);
+	ADC_SimAdvance(&sim, 0);
+	ADC_SimFaultAt(&sim, ADC_SIM_FAULT_CALIBRATION, 0);
+	ADC_SimAdvance(&sim, 0);
+
+	TEST_ASSERT(TestSetup(&badcMix, 1, DMA_CIRCULAR) == HAL_OK);
+	TEST_ASSERT_EQUAL(2, sim.Faults[ADC_SIM_FAULT_CALIBRATION].Injected);
+
+	ADC_SimFaultRandom(&sim, ADC_SIM_FAULT_DMA_ERROR, TEST_CORE_CLOCK, 1234);
+	ADC_SimFaultRandom(&sim, ADC_SIM_FAULT_OVR,       TEST_CORE_CLOCK, 99);
+	ADC_SimFaultRandom(&sim, ADC_SIM_FAULT_STUCK,     TEST_CORE_CLOCK, 7);
+
+	ADC_SimRun(&sim, TEST_CORE_CLOCK * 600U, TEST_PERIOD, TestConsumer, NULL);
+
+	uint32_t conversion = ADC_SimConversionTime(&sim, 0, TEST_SCAN[0]);
+	TEST_ASSERT_EQUAL(1512, conversion);
+
+	for(uint8_t f = ADC_SIM_FAULT_DMA_ERROR; f <= ADC_SIM_FAULT_STUCK; ++f){
+
+		if(f == ADC_SIM_FAULT_CALIBRATION){
+			continue;
+		}
+
+		const ADC_SimFaultTypeDef* fault = &sim.Faults[f];
+
+		// about once per second | injection landing on unrecovered fault of same type is recovered with it
+		TEST_ASSERT(fault->Injected > 500U && fault->Injected < 700U);
+		TEST_ASSERT(fault->Injected - fault->Recovered <= 1U);
+	}
+
+	TEST_ASSERT(sim.Faults[ADC_SIM_FAULT_DMA_ERROR].RecoveryMax <= conversion);
+	TEST_ASSERT(sim.Faults[ADC_SIM_FAULT_OVR].RecoveryMax       <= conversion);
+	TEST_ASSERT(sim.Faults[ADC_SIM_FAULT_STUCK].RecoveryMax     <= 2U * TEST_PERIOD + conversion);
+
+	TEST_ASSERT(badcMix.Errors >= sim.Faults[ADC_SIM_FAULT_DMA_ERROR].Recovered);
+	TEST_ASSERT_EQUAL(0, readErrors);
+	TEST_ASSERT_EQUAL(0, misaligned);
+}
+
+
+/**
+  * @brief Overrun minute scenario | every overrun is counted and recovered, blocks stay rank-aligned
+  * 	   Polled OVR flag is recovered by next consumer run, OVR interrupt within one conversion
+  * @param  overrunInterrupt - 1: overrun reported by HAL_ADC_ErrorCallback, 0: driver polls OVR flag
+  */
+static void TestOverrunMinute(uint8_t overrunInterrupt){
+
+	ADC_BufferTypeDef* badc = (overrunInterrupt != 0) ? &badcInterrupt : &badcPolled;
+
+	ADC_SimInit(&sim, 6);
+	supervise = 0;
+
+	TEST_ASSERT(TestSetup(badc, overrunInterrupt, DMA_CIRCULAR) == HAL_OK);
+
+	ADC_SimFaultRandom(&sim, ADC_SIM_FAULT_OVR, TEST_CORE_CLOCK / 10U, 99);
+	ADC_SimRun(&sim, TEST_CORE_CLOCK * 60U, TEST_PERIOD, TestConsumer, NULL);
+
+	const ADC_SimFaultTypeDef* fault = &sim.Faults[ADC_SIM_FAULT_OVR];
+	uint32_t conversion = ADC_SimConversionTime(&sim, 0, TEST_SCAN[0]);
+
+	TEST_ASSERT(fault->Injected > 500U && fault->Injected < 700U);
+	TEST_ASSERT(fault->Injected - fault->Recovered <= 1U);
+	TEST_ASSERT_EQUAL(fault->Recovered, badc->Overruns);
+
+	if(overrunInterrupt != 0){
+		TEST_ASSERT(fault->RecoveryMax <= conversion);
+	}else{
+		TEST_ASSERT(fault->RecoveryMax <= TEST_PERIOD + conversion);
+		TEST_ASSERT(fault->Recovered != 0U && fault->Blackout / fault->Recovered <= TEST_PERIOD / 2U + conversion);
+	}
+
+	// blackout share [0.01 %] | 0.54 % polled, 0.02 % with interrupt
+	TEST_ASSERT(fault->Blackout * 10000U / sim.Now <= ((overrunInterrupt != 0) ? 2U : 60U));
+
+	TEST_ASSERT(discontinuous > 0U && discontinuous <= badc->Overruns);
+	TEST_ASSERT_EQUAL(0, readErrors);
+	TEST_ASSERT_EQUAL(0, misaligned);
+}
+
+
+/**
+  * @brief Endurance hour scenario | long run keeps every fault recovered, blocks rank-aligned and transfer counters
+  * 	   consistent after wraps of 32-bit cycle timer
+  */
+static void TestEnduranceHour(void){
+
+	ADC_SimInit(&sim, 6);
+	supervise = 1;
+
+	TEST_ASSERT(TestSetup(&badcHour, 1, DMA_CIRCULAR) == HAL_OK);
+
+	ADC_SimFaultRandom(&sim, ADC_SIM_FAULT_DMA_ERROR, TEST_CORE_CLOCK * 10U, 4321);
+	ADC_SimFaultRandom(&sim, ADC_SIM_FAULT_OVR,       TEST_CORE_CLOCK * 10U, 77);
+	ADC_SimFaultRandom(&sim, ADC_SIM_FAULT_STUCK,     TEST_CORE_CLOCK * 10U, 3);
+
+	ADC_SimRun(&sim, TEST_CORE_CLOCK * 3600U, TEST_PERIOD, TestConsumer, NULL);
+
+	uint32_t conversion = ADC_SimConversionTime(&sim, 0, TEST_SCAN[0]);
+
+	TEST_ASSERT(sim.Now >= TEST_CORE_CLOCK * 3600U);
+
+	for(uint8_t f = ADC_SIM_FAULT_DMA_ERROR; f <= ADC_SIM_FAULT_STUCK; ++f){
+
+		if(f == ADC_SIM_FAULT_CALIBRATION){
+			continue;
+		}
+
+		const ADC_SimFaultTypeDef* fault = &sim.Faults[f];
+
+		// about once per 10 seconds
+		TEST_ASSERT(fault->Injected > 300U && fault->Injected < 430U);
+		TEST_ASSERT(fault->Injected - fault->Recovered <= 1U);
+	}
+
+	TEST_ASSERT(sim.Faults[ADC_SIM_FAULT_DMA_ERROR].RecoveryMax <= conversion);
+	TEST_ASSERT(sim.Faults[ADC_SIM_FAULT_OVR].RecoveryMax       <= conversion);
+	TEST_ASSERT(sim.Faults[ADC_SIM_FAULT_STUCK].RecoveryMax     <= 2U * TEST_PERIOD + conversion);
+
+	// every block of the hour is delivered | interrupt per 8 scans, about 1.5 blocks per ms minus blackouts
+	uint64_t blocks = sim.Now / ((uint64_t)conversion * TEST_CHANNELS * 8U);
+	TEST_ASSERT(badcHour.FullBlocks + badcHour.HalfBlocks >= blocks * 99U / 100U);
+
+	TEST_ASSERT(badcHour.Errors >= sim.Faults[ADC_SIM_FAULT_DMA_ERROR].Recovered);
+	TEST_ASSERT_EQUAL(sim.Faults[ADC_SIM_FAULT_OVR].Recovered, badcHour.Overruns);
+	TEST_ASSERT_EQUAL(0, readErrors);
+	TEST_ASSERT_EQUAL(0, misaligned);
+}
+
+
+/**
+  * @brief Normal mode stop scenario | HAL transfer complete handler leaves DMA handle READY, re-armed channel has to be
+  * 	   marked BUSY again, otherwise HAL_ADC_Stop_DMA skips HAL_DMA_Abort and channel keeps writing storage
+  */
+static void TestNormalModeStop(void){
+
+	uint16_t value;
+
+	ADC_SimInit(&sim, 6);
+	supervise = 0;
+
+	TEST_ASSERT(TestSetup(&badcNormal, 1, DMA_NORMAL) == HAL_OK);
+
+	ADC_SimRun(&sim, TEST_CORE_CLOCK / 10U, TEST_PERIOD, TestConsumer, NULL);
+
+	// rank alignment is not checked | F1 continuous scan keeps running while DMA waits for re-arm
+	TEST_ASSERT(badcNormal.FullBlocks > 10U);
+	TEST_ASSERT_EQUAL(0, readErrors);
+
+	// read re-arms completed transfer or leaves ongoing one
+	TEST_ASSERT(ADC_ReadChannel(&hadc, &cadc, &badcNormal, TEST_SCAN[1], &value) == HAL_OK);
+	TEST_ASSERT_EQUAL(HAL_DMA_STATE_BUSY, hdma.State);
+
+	HAL_ADC_Stop_DMA(&hadc);
+	TEST_ASSERT_EQUAL(0, DMA1_Channel1->CCR & DMA_CCR_EN);
+	TEST_ASSERT_EQUAL(HAL_DMA_STATE_READY, hdma.State);
+}
+
+
+/**
+  * @brief Averaging offload scenario | ramp repeating every 8 conversions of channel gives the same average of any 8
+  * 	   consecutive conversions, so sum of oversampler and average of software storage have to match exactly
+  */
+static void TestOffloadAveraging(void){
+
+	uint32_t           conversions[ADC_SIM_CHANNELS];	// conversions of each channel | phase of ramp
+	uint64_t           transfers[2];
+	uint16_t           averaged[2][TEST_CHANNELS];
+	float              scaled[2][TEST_CHANNELS];
+	uint16_t           ratio;
+	uint8_t            shift;
+	ADC_ContextTypeDef ctx;
+
+	ADC_BufferTypeDef* runs[2] = { &badcOffload, &badcSoftware };
+
+	// storage of offloaded averaging holds single scan of sums
+	TEST_ASSERT_EQUAL(1, ADC_AVERAGING_SCANS(TEST_MEASURES));
+	TEST_ASSERT_EQUAL(TEST_CHANNELS, badcOffload.BufferLength);
+	TEST_ASSERT_EQUAL(TEST_CHANNELS * TEST_MEASURES, badcSoftware.BufferLength);
+
+	for(uint8_t run = 0; run < 2; ++run){
+
+		ADC_SimInit(&sim, 6);
+		supervise = 0;
+		memset(conversions, 0, sizeof(conversions));
+
+		TEST_ASSERT(TestSetup(runs[run], 0, DMA_CIRCULAR) == HAL_OK);
+		TEST_ASSERT(ADC_GetOversampling(&hadc, &ratio, &shift) == HAL_OK);
+		TEST_ASSERT_EQUAL((run == 0) ? TEST_MEASURES : 1U, ratio);
+		TEST_ASSERT_EQUAL(0, shift);
+
+		// depth of offloaded averaging is locked by oversampler
+		if(run == 0){
+			TEST_ASSERT(ADC_SetAveragedMeasures(&badcOffload, &cadc, 4) == HAL_BUSY);
+		}
+		else{
+			TEST_ASSERT(ADC_SetAveragedMeasures(&badcSoftware, &cadc, TEST_MEASURES) == HAL_OK);
+		}
+
+		sim.Adc[0].Signal    = TestSignal;
+		sim.Adc[0].SignalArg = conversions;
+
+		ADC_SimRun(&sim, TEST_CORE_CLOCK / 10U, TEST_PERIOD, TestConsumer, NULL);
+		TEST_ASSERT(ADC_ContextInit(&ctx, &hadc, runs[run], &cadc, 3.3f) == HAL_OK);
+
+		transfers[run] = sim.Dma.Transfers;
+
+		for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+
+			uint16_t value;
+
+			TEST_ASSERT(ADC_Averaging(&hadc, runs[run], &cadc, TEST_SCAN[r], &averaged[run][r]) == HAL_OK);
+			TEST_ASSERT(ADC_GetValue(&hadc, &cadc, runs[run], 3.3f, TEST_SCAN[r], &scaled[run][r]) == HAL_OK);
+
+			value = ADC_InlineAveraged(&ctx, TEST_SCAN[r]);
+
+			TEST_ASSERT_EQUAL(100U * TEST_SCAN[r] + 35U, averaged[run][r]);
+			TEST_ASSERT_EQUAL(averaged[run][r], value);
+			TEST_ASSERT(fabsf(ADC_InlineScaled(&ctx, TEST_SCAN[r]) - scaled[run][r]) < 1e-5f);
+		}
+
+		HAL_ADC_Stop_DMA(&hadc);
+		TEST_ASSERT_EQUAL(0, readErrors);
+	}
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		TEST_ASSERT_EQUAL(averaged[1][r], averaged[0][r]);
+		TEST_ASSERT(scaled[0][r] == scaled[1][r]);
+	}
+
+	// one transfer per 8 conversions | difference of partial oversampled conversion at end of run
+	TEST_ASSERT(transfers[0] * TEST_MEASURES <= transfers[1] + TEST_MEASURES * TEST_CHANNELS);
+	TEST_ASSERT(transfers[0] * TEST_MEASURES + TEST_MEASURES * TEST_CHANNELS >= transfers[1]);
+}
+
+
+/**
+  * @brief Resolution switch scenario | storage is rescaled at switch, so first values keep their scale, samples converted
+  * 	   before switch back to 12 bits lose truncated bits until storage is refilled
+  */
+static void TestResolutionSwitch(void){
+
+	ADC_ContextTypeDef ctx;
+	uint16_t           value;
+
+	ADC_SimInit(&sim, 6);
+	supervise = 0;
+
+	TEST_ASSERT(TestSetup(&badcResolution, 0, DMA_CIRCULAR) == HAL_OK);
+	TEST_ASSERT(ADC_SetAveragedMeasures(&badcResolution, &cadc, 4) == HAL_OK);
+
+	uint32_t scan = ADC_SimConversionTime(&sim, 0, TEST_SCAN[0]) * TEST_CHANNELS;
+
+	ADC_SimRun(&sim, TEST_CORE_CLOCK / 100U, TEST_PERIOD, TestConsumer, NULL);
+	TEST_ASSERT(ADC_ContextInit(&ctx, &hadc, &badcResolution, &cadc, 3.3f) == HAL_OK);
+	TEST_ASSERT_EQUAL(4, ctx.Q15Shift);
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		TestCheckScaling(&ctx, &badcResolution, 12, r, 100U * TEST_SCAN[r]);
+	}
+
+	// 8 bits | stored samples are shifted with resolution, first scan converted at 8 bits has the same values
+	TEST_ASSERT(ADC_SetResolution(&hadc, &badcResolution, 7) == HAL_ERROR);
+	TEST_ASSERT(ADC_SetResolution(&hadc, &badcResolution, 8) == HAL_OK);
+	TEST_ASSERT_EQUAL(1, badcResolution.Discontinuous);
+	TEST_ASSERT_EQUAL(255, __ADC_RESOLUTION(&hadc));
+	TEST_ASSERT(ADC_ContextRescale(&ctx, &hadc, 3.3f) == HAL_OK);
+	TEST_ASSERT_EQUAL(8, ctx.Q15Shift);
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		TestCheckScaling(&ctx, &badcResolution, 8, r, (100U * TEST_SCAN[r]) >> 4);
+	}
+
+	ADC_SimAdvance(&sim, scan + 1U);
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		TEST_ASSERT_EQUAL((100U * TEST_SCAN[r]) >> 4, ADC_InlineLatest(&ctx, TEST_SCAN[r]));
+		TestCheckScaling(&ctx, &badcResolution, 8, r, (100U * TEST_SCAN[r]) >> 4);
+	}
+
+	// back to 12 bits | first scan is exact, average holds truncated samples of 8-bit scans until storage is refilled
+	TEST_ASSERT(ADC_SetResolution(&hadc, &badcResolution, 12) == HAL_OK);
+	TEST_ASSERT(ADC_ContextRescale(&ctx, &hadc, 3.3f) == HAL_OK);
+	TEST_ASSERT_EQUAL(4, ctx.Q15Shift);
+
+	ADC_SimAdvance(&sim, scan + 1U);
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+
+		uint16_t exact     = 100U * TEST_SCAN[r];
+		uint16_t truncated = (uint16_t)((exact >> 4) << 4);
+
+		TEST_ASSERT_EQUAL(exact, ADC_InlineLatest(&ctx, TEST_SCAN[r]));
+		TestCheckScaling(&ctx, &badcResolution, 12, r, (uint16_t)((exact + 3U * truncated) / 4U));
+	}
+
+	ADC_SimAdvance(&sim, 8U * scan);
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		TestCheckScaling(&ctx, &badcResolution, 12, r, 100U * TEST_SCAN[r]);
+	}
+
+	TEST_ASSERT(ADC_ReadChannel(&hadc, &cadc, &badcResolution, TEST_SCAN[1], &value) == HAL_OK);
+	TEST_ASSERT_EQUAL(100U * TEST_SCAN[1], value);
+	TEST_ASSERT_EQUAL(0, readErrors);
+
+	// storage packed to bytes | 8 bits set while ADC is stopped, higher resolution does not fit bytes
+	HAL_ADC_Stop_DMA(&hadc);
+	hdma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+
+	TEST_ASSERT(ADC_SetResolution(&hadc, &badcPacked, 8) == HAL_OK);
+	TEST_ASSERT(ADC_Init(&hadc, &badcPacked, &cadc) == HAL_OK);
+
+	active = &badcPacked;
+	ADC_SimRun(&sim, TEST_CORE_CLOCK / 100U, TEST_PERIOD, TestConsumer, NULL);
+
+	TEST_ASSERT(ADC_SetResolution(&hadc, &badcPacked, 10) == HAL_ERROR);
+	TEST_ASSERT(ADC_SetResolution(&hadc, &badcPacked, 12) == HAL_ERROR);
+	TEST_ASSERT(ADC_SetResolution(&hadc, &badcPacked, 6) == HAL_OK);
+	TEST_ASSERT(ADC_SetResolution(&hadc, &badcPacked, 8) == HAL_OK);
+	TEST_ASSERT_EQUAL(255, __ADC_RESOLUTION(&hadc));
+
+	ADC_SimAdvance(&sim, 8U * scan);
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		TEST_ASSERT(ADC_Averaging(&hadc, &badcPacked, &cadc, TEST_SCAN[r], &value) == HAL_OK);
+		TEST_ASSERT_EQUAL((100U * TEST_SCAN[r]) >> 4, value);
+	}
+
+	HAL_ADC_Stop_DMA(&hadc);
+	TEST_ASSERT(ADC_SetResolution(&hadc, &badcPacked, 12) == HAL_ERROR);
+	TEST_ASSERT_EQUAL(0, readErrors);
+}
+
+
+/**
+  * @brief Alignment scenario | left-aligned data holds value shifted to MSB, so full scale and Q15 shift follow alignment
+  * 	   and scaled and Q15 values of both alignments are the same
+  */
+static void TestAlignment(void){
+
+	static const uint8_t resolutions[2] = { 12, 8 };
+
+	ADC_ContextTypeDef ctx;
+	uint16_t           averaged[2][TEST_CHANNELS];
+	float              scaled[2][TEST_CHANNELS];
+	int16_t            q15[2][TEST_CHANNELS];
+
+	for(uint8_t res = 0; res < 2; ++res){
+
+		uint8_t bits  = resolutions[res];
+		uint8_t shift = 16U - bits;							// left alignment of resolution
+
+		for(uint8_t left = 0; left < 2; ++left){
+
+			ADC_SimInit(&sim, 6);
+			supervise                    = 0;
+			badcAligned.AveragedMeasures = 1;			// depth of previous run would be offloaded by init
+
+			TEST_ASSERT(TestSetup(&badcAligned, 0, DMA_CIRCULAR) == HAL_OK);
+			TEST_ASSERT(ADC_SetAveragedMeasures(&badcAligned, &cadc, 4) == HAL_OK);
+			TEST_ASSERT(ADC_SetResolution(&hadc, &badcAligned, bits) == HAL_OK);
+
+			// alignment of running ADC | storage is refilled by run
+			if(left != 0){
+				SET_BIT(ADC1->CR2, ADC_CR2_ALIGN);
+			}
+
+			ADC_SimRun(&sim, TEST_CORE_CLOCK / 100U, TEST_PERIOD, TestConsumer, NULL);
+			TEST_ASSERT(ADC_ContextInit(&ctx, &hadc, &badcAligned, &cadc, 3.3f) == HAL_OK);
+
+			TEST_ASSERT_EQUAL(((1UL << bits) - 1U) << (left ? shift : 0U), __ADC_DATA_MAX(&hadc));
+			TEST_ASSERT_EQUAL(__ADC_DATA_MAX(&hadc), __ADC_FULL_SCALE(&hadc));
+			TEST_ASSERT_EQUAL(left ? 0U : shift, ctx.Q15Shift);
+
+			for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+
+				TEST_ASSERT(ADC_Averaging(&hadc, &badcAligned, &cadc, TEST_SCAN[r], &averaged[left][r]) == HAL_OK);
+				TEST_ASSERT(ADC_GetValue(&hadc, &cadc, &badcAligned, 3.3f, TEST_SCAN[r], &scaled[left][r]) == HAL_OK);
+
+				q15[left][r] = ADC_InlineQ15(&ctx, TEST_SCAN[r]);
+
+				TEST_ASSERT_EQUAL(averaged[left][r], ADC_InlineAveraged(&ctx, TEST_SCAN[r]));
+				TEST_ASSERT(fabsf(ADC_InlineScaled(&ctx, TEST_SCAN[r]) - scaled[left][r]) < 1e-5f);
+			}
+
+			HAL_ADC_Stop_DMA(&hadc);
+			TEST_ASSERT_EQUAL(0, readErrors);
+		}
+
+		// same input | left-aligned average is right-aligned one shifted to MSB
+		for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+			TEST_ASSERT_EQUAL((100U * TEST_SCAN[r]) >> (12U - bits), averaged[0][r]);
+			TEST_ASSERT_EQUAL((uint32_t)averaged[0][r] << shift, averaged[1][r]);
+			TEST_ASSERT(fabsf(scaled[0][r] - scaled[1][r]) < 1e-5f);
+			TEST_ASSERT_EQUAL(q15[0][r], q15[1][r]);
+		}
+	}
+}
+
+
+/**
+  * @brief Accessor positions scenario | context accessors compute latest and first averaged scan from DMA counter on their
+  * 	   own, so they are compared with out-of-line API and with model of storage at random stops of running DMA
+  */
+static void TestAccessorPositions(void){
+
+	static const uint8_t depths[2] = { 1, 3 };
+
+	uint32_t           conversions[ADC_SIM_CHANNELS];
+	uint32_t           seed = 0x2545F491U;
+	unsigned           insideScan = 0;					// stops with scan partially written
+	unsigned           wrappedLatest = 0;				// stops with latest scan at end of storage
+	unsigned           wrappedWindow = 0;				// stops with averaged scans wrapped across end of storage
+	ADC_ContextTypeDef ctx;
+
+	ADC_SimInit(&sim, 6);
+	supervise = 0;
+	memset(conversions, 0, sizeof(conversions));
+
+	TEST_ASSERT(TestSetup(&badcPositions, 0, DMA_CIRCULAR) == HAL_OK);
+
+	sim.Adc[0].Signal    = TestSignal;
+	sim.Adc[0].SignalArg = conversions;
+
+	uint32_t conversion = ADC_SimConversionTime(&sim, 0, TEST_SCAN[0]);
+	uint16_t scans      = badcPositions.BufferLength / TEST_CHANNELS;
+
+	// storage filled once | every scan holds converted samples
+	ADC_SimAdvance(&sim, (uint64_t)conversion * badcPositions.BufferLength + 1U);
+	TEST_ASSERT(ADC_ContextInit(&ctx, &hadc, &badcPositions, &cadc, 3.3f) == HAL_OK);
+
+	for(uint8_t d = 0; d < 2; ++d){
+
+		uint8_t measures = depths[d];
+
+		TEST_ASSERT(ADC_SetAveragedMeasures(&badcPositions, &cadc, measures) == HAL_OK);
+
+		for(uint32_t i = 0; i < TEST_POSITIONS; ++i){
+
+			// random stop | not aligned to conversions
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+
+			ADC_SimAdvance(&sim, 1U + seed % (3U * conversion));
+
+			uint32_t written = badcPositions.BufferLength - __HAL_DMA_GET_COUNTER(&hdma);
+			uint16_t current = (uint16_t)(written / TEST_CHANNELS);
+			uint16_t latest  = (uint16_t)((current + scans - 1U) % scans);
+			uint16_t first   = (uint16_t)((current + scans - measures) % scans);
+
+			insideScan    += (written % TEST_CHANNELS) != 0;
+			wrappedLatest += (current == 0);
+			wrappedWindow += (measures > 1 && first + measures > scans);
+
+			for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+
+				uint8_t  channel = TEST_SCAN[r];
+				uint16_t read;
+				uint16_t averaged;
+				uint32_t sum = 0;
+
+				for(uint8_t k = 0; k < measures; ++k){
+					sum += badcPositions.BufferADC[((first + k) % scans) * TEST_CHANNELS + r];
+				}
+
+				TEST_ASSERT(ADC_ReadChannel(&hadc, &cadc, &badcPositions, channel, &read) == HAL_OK);
+				TEST_ASSERT(ADC_Averaging(&hadc, &badcPositions, &cadc, channel, &averaged) == HAL_OK);
+
+				TEST_ASSERT_EQUAL(sum / measures, averaged);
+				TEST_ASSERT_EQUAL(averaged, read);
+				TEST_ASSERT_EQUAL(averaged, ADC_InlineAveraged(&ctx, channel));
+				TEST_ASSERT_EQUAL(averaged, ADC_ContextAveraged(&ctx, channel));
+
+				TEST_ASSERT_EQUAL(badcPositions.BufferADC[latest * TEST_CHANNELS + r], ADC_InlineLatest(&ctx, channel));
+				TEST_ASSERT_EQUAL(ADC_InlineLatest(&ctx, channel), ADC_ContextLatest(&ctx, channel));
+
+				// latest scan is average of single measure
+				if(measures == 1){
+					TEST_ASSERT_EQUAL(averaged, ADC_InlineLatest(&ctx, channel));
+				}
+			}
+		}
+	}
+
+	// every kind of position was reached
+	TEST_ASSERT(insideScan    > TEST_POSITIONS / 2U);
+	TEST_ASSERT(wrappedLatest > TEST_POSITIONS / 10U);
+	TEST_ASSERT(wrappedWindow > TEST_POSITIONS / 10U);
+
+	HAL_ADC_Stop_DMA(&hadc);
+}
+
+
+/**
+  * @brief Scaling check function, compares averaged and scaled values of driver and context with expected value
+  * @param  ctx      - pointer to context of running ADC
+  * @param  badc     - pointer to ADC buffer structure
+  * @param  bits     - resolution of expected value
+  * @param  rank     - rank of checked channel
+  * @param  expected - expected average
+  */
+static void TestCheckScaling(const ADC_ContextTypeDef* ctx, ADC_BufferTypeDef* badc, uint8_t bits, uint8_t rank, uint16_t expected){
+
+	uint16_t value;
+	float    scaled;
+	float    full = (float)((1UL << bits) - 1U);
+
+	TEST_ASSERT(ADC_Averaging(&hadc, badc, &cadc, TEST_SCAN[rank], &value) == HAL_OK);
+	TEST_ASSERT(ADC_GetValue(&hadc, &cadc, badc, 3.3f, TEST_SCAN[rank], &scaled) == HAL_OK);
+
+	TEST_ASSERT_EQUAL(expected, value);
+	TEST_ASSERT_EQUAL(expected, ADC_InlineAveraged(ctx, TEST_SCAN[rank]));
+	TEST_ASSERT(fabsf(scaled - 3.3f * (float)expected / full) < 1e-5f);
+	TEST_ASSERT(fabsf(ADC_InlineScaled(ctx, TEST_SCAN[rank]) - scaled) < 1e-5f);
+	TEST_ASSERT_EQUAL(__ADC_Q15((uint32_t)expected << ctx->Q15Shift), ADC_InlineQ15(ctx, TEST_SCAN[rank]));
+}
+
+
+/**
+  * @brief Signal of offload scenario | ramp of 8 steps per channel, advanced by every conversion of channel
+  */
+static uint16_t TestSignal(uint8_t adc, uint8_t channel, uint64_t time, void* arg){
+
+	uint32_t* conversions = (uint32_t*)arg;
+
+	UNUSED(adc);
+	UNUSED(time);
+
+	return (uint16_t)(100U * channel + 10U * (conversions[channel]++ % TEST_MEASURES));
+}
+
+
+/**
+  * @brief Setup function, configures scan of 4 channels with DMA and starts driver
+  * @param  badc             - pointer to ADC buffer structure of scenario
+  * @param  overrunInterrupt - 1: overrun reported by HAL_ADC_ErrorCallback, 0: driver polls OVR flag
+  * @param  mode             - DMA_CIRCULAR or DMA_NORMAL | normal mode is re-armed by ADC_ReadChannel
+  * @retval status           - status of ADC_Init
+  */
+static HAL_StatusTypeDef TestSetup(ADC_BufferTypeDef* badc, uint8_t overrunInterrupt, uint32_t mode){
+
+	memset(&hadc, 0, sizeof(hadc));
+	memset(&hdma, 0, sizeof(hdma));
+	memset(&cadc, 0, sizeof(cadc));
+
+	active        = badc;
+	readErrors    = 0;
+	misaligned    = 0;
+	discontinuous = 0;
+
+	sim.OverrunInterrupt = overrunInterrupt;
+
+	hadc.Instance               = ADC1;
+	hadc.DMA_Handle             = &hdma;
+	hdma.Instance               = DMA1_Channel1;
+	hdma.Parent                 = &hadc;
+	hdma.Init.MemDataAlignment  = DMA_MDATAALIGN_HALFWORD;
+	hdma.Init.Mode              = mode;
+	hdma.Init.MemInc            = DMA_MINC_ENABLE;
+
+	ADC1->SQR1 = ((TEST_CHANNELS - 1U) << ADC_SQR1_L_Pos);
+	ADC1->CR1  = ADC_CR1_SCAN;
+	ADC1->CR2  = ADC_CR2_CONT;
+
+	for(uint8_t r = 0; r < TEST_CHANNELS; ++r){
+		ADC1->SQR3 |= (uint32_t)TEST_SCAN[r] << (5U * r);
+		ADC1->SMPR2 |= 7U << (3U * TEST_SCAN[r]);				// 239.5 cycles
+	}
+
+	for(uint8_t ch = 0; ch < ADC_SIM_CHANNELS; ++ch){
+		sim.Adc[0].Level[ch] = 100U * ch;
+	}
+
+	return ADC_Init(&hadc, badc, &cadc);
+}
+
+
+/**
+  * @brief Consumer | reads one channel every period, supervises acquisition in fault mix
+  */
+static uint32_t TestConsumer(void* arg){
+
+	uint16_t value;
+
+	UNUSED(arg);
+
+	if(supervise != 0){
+		ADC_Supervise(&hadc, active);
+	}
+
+	if(ADC_ReadChannel(&hadc, &cadc, active, TEST_SCAN[1], &value) != HAL_OK){
+		readErrors++;
+	}
+
+	return TEST_CONSUMER_CYCLES;
+}
@@ -0,0 +1,235 @@
+/**
+  ******************************************************************************
+  * @file      test_store.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host test of flash store under power loss
+  * @brief     This file contains randomised write sweeps of adc_store.c on emulated flash (adc_sim.c):
+  * 		   - writes without power loss, every key keeps its latest value across remounts
+  * 		   - writes with power loss after 5 ... 2000 flash operations (half-word programs, page erases), one third
+  * 		     of reboots loses power again during remount; after every reboot each key holds its old or new value
+  ******************************************************************************
+  * @attention Keys 1 ... 5 with values of 1 ... 120 bytes, value of write is derived from its seed, so it is verified
+  * 		   byte by byte without keeping copies.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include "adc_store.h"
+#include "adc_test.h"
+#include <string.h>
+
+// Private Macros
+#define TEST_KEYS				5U						// keys 1 ... TEST_KEYS
+#define TEST_MAX_LENGTH			120U
+#define TEST_WRITES				3000U
+#define TEST_TRIALS				20000U
+#define TEST_LOSS_MIN			5U						// operations until power loss
+#define TEST_LOSS_MAX			2000U
+
+// Private typedefs
+typedef struct{
+
+	uint32_t Seed;										// value of key is derived from seed
+	uint16_t Length;									// 0: key is not stored
+
+}TestValueTypeDef;
+
+// Private functions prototypes
+static uint32_t TestRandom(void);
+static void     TestFill(uint8_t* data, uint16_t length, uint32_t seed);
+static uint8_t  TestHolds(uint16_t key, const TestValueTypeDef* value);
+static void     TestWrites(void);
+static void     TestPowerLoss(void);
+
+// Private variables
+static uint32_t         TestSeed = 0x9E3779B9U;
+static ADC_SimTypeDef   sim;
+static ADC_StoreTypeDef store;
+static TestValueTypeDef values[TEST_KEYS + 1U];
+
+
+int main(void){
+
+	ADC_SimInit(&sim, 6);
+
+	TEST_ASSERT(ADC_StoreMount(&store) == HAL_OK);
+
+	TestWrites();
+	TestPowerLoss();
+
+	return TEST_RESULT("test_store");
+}
+
+
+/**
+  * @brief Writes without power loss | every key is checked after every write and after periodic remounts
+  */
+static void TestWrites(void){
+
+	uint8_t  data[TEST_MAX_LENGTH];
+	unsigned wrong = 0;
+
+	for(uint32_t w = 0; w < TEST_WRITES; ++w){
+
+		uint16_t key    = (uint16_t)(1U + TestRandom() % TEST_KEYS);
+		uint16_t length = (uint16_t)(1U + TestRandom() % TEST_MAX_LENGTH);
+		uint32_t seed   = TestRandom();
+
+		TestFill(data, length, seed);
+
+		if(ADC_StoreWrite(&store, key, data, length) != HAL_OK){
+			wrong++;
+			continue;
+		}
+
+		values[key].Seed   = seed;
+		values[key].Length = length;
+
+		if(w % 97U == 0U){
+			TEST_ASSERT(ADC_StoreMount(&store) == HAL_OK);
+		}
+
+		for(uint16_t k = 1; k <= TEST_KEYS; ++k){
+			wrong += (TestHolds(k, &values[k]) == 0U);
+		}
+	}
+
+	TEST_ASSERT_EQUAL(0, wrong);
+
+	// deleted key is not found after remount
+	TEST_ASSERT(ADC_StoreDelete(&store, 3) == HAL_OK);
+	values[3].Length = 0;
+
+	TEST_ASSERT(ADC_StoreMount(&store) == HAL_OK);
+	TEST_ASSERT(TestHolds(3, &values[3]) != 0U);
+
+	// pages wear evenly | every page was erased
+	for(uint8_t p = 0; p < ADC_STORE_PAGES; ++p){
+		TEST_ASSERT(store.Erases[p] > 0U);
+	}
+}
+
+
+/**
+  * @brief Writes with power loss | every key holds its old or new value after reboot
+  */
+static void TestPowerLoss(void){
+
+	uint8_t  data[TEST_MAX_LENGTH];
+	unsigned losses  = 0;
+	unsigned kept    = 0;
+	unsigned corrupt = 0;
+	unsigned failed  = 0;
+
+	for(uint32_t t = 0; t < TEST_TRIALS; ++t){
+
+		uint16_t key    = (uint16_t)(1U + TestRandom() % TEST_KEYS);
+		uint16_t length = (uint16_t)(1U + TestRandom() % TEST_MAX_LENGTH);
+		uint32_t seed   = TestRandom();
+
+		TestFill(data, length, seed);
+
+		// next power loss | counts operations of following writes until it happens
+		if(sim.Flash.PowerLossAfter == 0){
+			ADC_SimFlashPowerLoss(&sim, TEST_LOSS_MIN + TestRandom() % (TEST_LOSS_MAX - TEST_LOSS_MIN + 1U));
+		}
+
+		HAL_StatusTypeDef status = ADC_StoreWrite(&store, key, data, length);
+		uint8_t           lost   = sim.Flash.PowerLost;
+
+		if(lost != 0){
+			losses++;
+
+			ADC_SimFlashPowerUp(&sim);
+
+			// reboot | power may be lost again while mount repairs torn page
+			if(TestRandom() % 3U == 0U){
+				ADC_SimFlashPowerLoss(&sim, 1U + TestRandom() % 50U);
+				(void)ADC_StoreMount(&store);
+				ADC_SimFlashPowerUp(&sim);
+			}
+
+			if(ADC_StoreMount(&store) != HAL_OK){
+				failed++;
+				break;
+			}
+
+		}else if(status != HAL_OK){
+			failed++;
+			break;
+		}
+
+		TestValueTypeDef written = { .Seed = seed, .Length = length };
+
+		for(uint16_t k = 1; k <= TEST_KEYS; ++k){
+
+			if(k == key && TestHolds(k, &written) != 0U){
+				values[k] = written;
+				kept     += (lost != 0);
+			}else if(TestHolds(k, &values[k]) == 0U || (k == key && lost == 0)){
+				corrupt++;
+			}
+		}
+	}
+
+	TEST_ASSERT_EQUAL(0, failed);
+	TEST_ASSERT_EQUAL(0, corrupt);
+	TEST_ASSERT(losses > TEST_TRIALS / 40U);			// about one loss per 1000 operations, write takes ~60
+	TEST_ASSERT(kept > 0U && kept < losses);			// power loss lands before and after commit of record
+
+	printf("test_store: %u power losses, %u writes committed before loss\n", losses, kept);
+}
+
+
+/**
+  * @brief Check function | key holds given value, or is not stored if length of value is 0
+  */
+static uint8_t TestHolds(uint16_t key, const TestValueTypeDef* value){
+
+	uint8_t  data[TEST_MAX_LENGTH];
+	uint8_t  expected[TEST_MAX_LENGTH];
+	uint16_t length = 0;
+
+	HAL_StatusTypeDef status = ADC_StoreRead(&store, key, data, sizeof(data), &length);
+
+	if(value->Length == 0){
+		return (status != HAL_OK);
+	}
+
+	if(status != HAL_OK || length != value->Length){
+		return 0;
+	}
+
+	TestFill(expected, length, value->Seed);
+
+	return (memcmp(data, expected, length) == 0);
+}
+
+
+/**
+  * @brief Fill function | value derived from seed
+  */
+static void TestFill(uint8_t* data, uint16_t length, uint32_t seed){
+
+	for(uint16_t i = 0; i < length; ++i){
+		seed   = seed * 1664525U + 1013904223U;
+		data[i] = (uint8_t)(seed >> 24);
+	}
+}
+
+
+/**
+  * @brief Pseudo-random generator | xorshift32, deterministic across hosts
+  */
+static uint32_t TestRandom(void){
+
+	TestSeed ^= TestSeed << 13;
+	TestSeed ^= TestSeed >> 17;
+	TestSeed ^= TestSeed << 5;
+
+	return TestSeed;
+}
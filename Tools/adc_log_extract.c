@@ -0,0 +1,228 @@
+/**
+  ******************************************************************************
+  * @file      adc_log_extract.c
+  * @author    Bartosz Rychlicki
+  * @Title     Host extractor of ADC trend log
+  * @brief     This file contains host program, which decodes binary dump of region ADC_LOG (adc_logger.h) to CSV
+  * 		   Build:  gcc -O2 -o adc_log_extract Tools/adc_log_extract.c
+  * 		   Dump:   st-flash read log.bin 0x0801B000 0x4000
+  * 		   Usage:  adc_log_extract log.bin [page size, default 1024] > log.csv
+  * 		   Output: interval,channel,min,max,mean rows ordered by interval | page summary is printed to stderr
+  ******************************************************************************
+  * @attention Page format is defined by adc_logger.h and adc_logger.c, constants below have to follow them.
+  * 		   Uncommitted (torn) pages fail CRC and are skipped.
+  *
+  * Copyright (c) 2025 AGH Eko-Energy.
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// Format of adc_logger.h
+#define ADC_LOGGER_MAGIC			0x1A6CU
+#define ADC_LOGGER_HEADER_SIZE		24U
+#define ADC_LOGGER_CHANNELS			16U			// ADC_MAX_CHANNELS of adc_driver.h
+
+// Private typedefs
+typedef struct{
+
+	const uint8_t* Page;
+	uint32_t       Sequence;
+
+}PageTypeDef;
+
+// Private functions prototypes
+static uint16_t Read16(const uint8_t* data);
+static uint32_t Read32(const uint8_t* data);
+static uint16_t Crc(uint16_t crc, const uint8_t* data, uint32_t length);
+static int      Varint(const uint8_t* data, uint32_t length, uint32_t* pos, uint32_t* value);
+static int      CompareSequence(const void* a, const void* b);
+static void     Decode(const uint8_t* page);
+
+
+int main(int argc, char** argv){
+
+	if(argc < 2){
+		fprintf(stderr, "usage: %s <dump of ADC_LOG region> [page size]\n", argv[0]);
+		return 2;
+	}
+
+	uint32_t pageSize = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1024U;
+	FILE*    file     = fopen(argv[1], "rb");
+
+	if(file == NULL || pageSize <= ADC_LOGGER_HEADER_SIZE){
+		fprintf(stderr, "cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	fseek(file, 0, SEEK_END);
+
+	long     size  = ftell(file);
+	uint8_t* dump  = malloc((size_t)size + 1U);
+	uint32_t pages = (uint32_t)size / pageSize;
+
+	fseek(file, 0, SEEK_SET);
+
+	if(dump == NULL || fread(dump, 1, (size_t)size, file) != (size_t)size){
+		fprintf(stderr, "cannot read %s\n", argv[1]);
+		fclose(file);
+		return 1;
+	}
+
+	fclose(file);
+
+	PageTypeDef* valid = calloc(pages + 1U, sizeof(PageTypeDef));
+	uint32_t     count = 0;
+
+	// validating pages | magic, length and CRC of header and payload
+	for(uint32_t p = 0; p < pages; ++p){
+
+		const uint8_t* page   = dump + (size_t)p * pageSize;
+		uint16_t       length = Read16(page + 14U);
+
+		if(Read16(page) != ADC_LOGGER_MAGIC || length > pageSize - ADC_LOGGER_HEADER_SIZE){
+			fprintf(stderr, "page %2u: empty\n", p);
+			continue;
+		}
+
+		uint16_t crc = Crc(Crc(0xFFFFU, page, ADC_LOGGER_HEADER_SIZE - 2U), page + ADC_LOGGER_HEADER_SIZE, length);
+
+		crc = (crc == 0xFFFFU) ? 0U : crc;
+
+		if(crc != Read16(page + ADC_LOGGER_HEADER_SIZE - 2U)){
+			fprintf(stderr, "page %2u: torn (CRC)\n", p);
+			continue;
+		}
+
+		fprintf(stderr, "page %2u: sequence %u, intervals %u ... %u, channels %u, scans %u, %u bytes, erases %u\n", p,
+				Read32(page + 4U), Read32(page + 8U), Read32(page + 8U) + Read16(page + 2U) - 1U, Read16(page + 12U),
+				Read16(page + 20U), length, Read32(page + 16U));
+
+		valid[count].Page     = page;
+		valid[count].Sequence = Read32(page + 4U);
+		count++;
+	}
+
+	// pages are written as ring | sequence restores order
+	qsort(valid, count, sizeof(PageTypeDef), CompareSequence);
+
+	printf("interval,channel,min,max,mean\n");
+
+	for(uint32_t i = 0; i < count; ++i){
+		Decode(valid[i].Page);
+	}
+
+	free(valid);
+	free(dump);
+
+	return 0;
+}
+
+
+/**
+  * @brief Page decode function, prints records of committed page | minima are delta coded from 0 at start of page
+  * @param  page    - pointer to page
+  */
+static void Decode(const uint8_t* page){
+
+	uint16_t       records  = Read16(page + 2U);
+	uint32_t       first    = Read32(page + 8U);
+	uint16_t       channels = Read16(page + 12U);
+	uint16_t       length   = Read16(page + 14U);
+	const uint8_t* payload  = page + ADC_LOGGER_HEADER_SIZE;
+	uint32_t       pos      = 0;
+	uint16_t       previous[ADC_LOGGER_CHANNELS] = {0};
+
+	if(channels == 0 || channels > ADC_LOGGER_CHANNELS){
+		return;
+	}
+
+	for(uint16_t r = 0; r < records; ++r){
+		for(uint16_t c = 0; c < channels; ++c){
+
+			uint32_t zigzag, range, mean;
+
+			if(Varint(payload, length, &pos, &zigzag) != 0 || Varint(payload, length, &pos, &range) != 0 ||
+			   Varint(payload, length, &pos, &mean) != 0){
+				fprintf(stderr, "interval %u: truncated record\n", first + r);
+				return;
+			}
+
+			uint16_t min = (uint16_t)(previous[c] + (int32_t)((zigzag >> 1) ^ (0U - (zigzag & 1U))));
+
+			previous[c] = min;
+
+			printf("%u,%u,%u,%u,%u\n", first + r, c, min, min + range, min + mean);
+		}
+	}
+}
+
+
+/**
+  * @brief Varint function, decodes 7-bit groups, least significant first
+  * @param  data    - pointer to payload
+  * @param  length  - length of payload [bytes]
+  * @param  pos     - pointer to position in payload | advanced
+  * @param  value   - pointer to decoded value
+  * @retval result  - 0 if value was decoded
+  */
+static int Varint(const uint8_t* data, uint32_t length, uint32_t* pos, uint32_t* value){
+
+	*value = 0;
+
+	for(uint8_t shift = 0; shift < 32U && *pos < length; shift += 7U){
+
+		uint8_t byte = data[(*pos)++];
+
+		*value |= (uint32_t)(byte & 0x7FU) << shift;
+
+		if((byte & 0x80U) == 0){
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+
+/**
+  * @brief CRC-16/CCITT function | same as ADC_StoreCrc
+  */
+static uint16_t Crc(uint16_t crc, const uint8_t* data, uint32_t length){
+
+	for(uint32_t i = 0; i < length; ++i){
+		crc ^= (uint16_t)data[i] << 8;
+
+		for(uint8_t b = 0; b < 8; ++b){
+			crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+
+static int CompareSequence(const void* a, const void* b){
+
+	uint32_t sa = ((const PageTypeDef*)a)->Sequence;
+	uint32_t sb = ((const PageTypeDef*)b)->Sequence;
+
+	return (sa > sb) - (sa < sb);
+}
+
+
+static uint16_t Read16(const uint8_t* data){
+
+	return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+
+static uint32_t Read32(const uint8_t* data){
+
+	return (uint32_t)Read16(data) | ((uint32_t)Read16(data + 2U) << 16);
+}